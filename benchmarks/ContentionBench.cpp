@@ -0,0 +1,115 @@
+/**
+ * @file ContentionBench.cpp
+ * @brief Throughput of several processes writing one file (fcntl lock contention)
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "records/FixedA.hpp"
+#include "records/B.hpp"
+#include <fdfile/repository/UniformFixedRepositoryImpl.hpp>
+#include <fdfile/repository/VariableFileRepositoryImpl.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+constexpr int kWritesPerProcess = 2000;
+
+/// Run child(p) in `procs` forked processes and wait for all of them
+template <typename Child> bool runProcesses(int procs, Child child) {
+    std::vector<pid_t> pids;
+    for (int p = 0; p < procs; ++p) {
+        pid_t pid = ::fork();
+        if (pid == 0)
+            ::_exit(child(p) ? 0 : 1);
+        if (pid < 0)
+            return false;
+        pids.push_back(pid);
+    }
+    bool ok = true;
+    for (pid_t pid : pids) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return ok;
+}
+
+void BM_FixedMultiProcessSave(benchmark::State& state) {
+    const int procs = static_cast<int>(state.range(0));
+    const std::string path = "./bench_contention_fixed.db";
+    for (auto _ : state) {
+        state.PauseTiming();
+        ::remove(path.c_str());
+        state.ResumeTiming();
+        const bool ok = runProcesses(procs, [&path](int p) {
+            std::error_code ec;
+            FixedRepositoryOptions opts;
+            opts.durability = Durability::Async;
+            opts.growChunkRecords = 256;
+            UniformFixedRepositoryImpl<FixedA> repo(path, opts, ec);
+            for (int i = 0; i < kWritesPerProcess && !ec; ++i) {
+                const std::string id = std::to_string(p) + "_" + std::to_string(i);
+                repo.save(FixedA("proc", i, id.c_str()), ec);
+            }
+            return !ec;
+        });
+        if (!ok)
+            state.SkipWithError("child process failed");
+    }
+    state.SetItemsProcessed(state.iterations() * procs * kWritesPerProcess);
+    ::remove(path.c_str());
+}
+
+void BM_VariableMultiProcessAppend(benchmark::State& state) {
+    const int procs = static_cast<int>(state.range(0));
+    const std::string path = "./bench_contention_var.db";
+    for (auto _ : state) {
+        state.PauseTiming();
+        ::remove(path.c_str());
+        state.ResumeTiming();
+        const bool ok = runProcesses(procs, [&path](int p) {
+            std::error_code ec;
+            std::vector<std::unique_ptr<VariableRecordBase>> protos;
+            protos.push_back(std::make_unique<B>());
+            VariableRepositoryOptions opts;
+            opts.durability = Durability::Async;
+            opts.logStructured = true;
+            VariableFileRepositoryImpl repo(path, std::move(protos), opts, ec);
+            for (int i = 0; i < kWritesPerProcess && !ec; ++i)
+                repo.save(B("proc", static_cast<long>(p) * 1000000 + i, "pw"), ec);
+            return !ec;
+        });
+        if (!ok)
+            state.SkipWithError("child process failed");
+    }
+    state.SetItemsProcessed(state.iterations() * procs * kWritesPerProcess);
+    ::remove(path.c_str());
+}
+
+} // namespace
+
+// Wall-clock time: the work happens in the children
+BENCHMARK(BM_FixedMultiProcessSave)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VariableMultiProcessAppend)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,308 @@
+/**
+ * @file FixedRepositoryBench.cpp
+ * @brief Fixed-length repository operations on files of 10^3 to 10^7 records
+ *
+ * With FDFILE_BENCH_LARGE set in the environment, the cold scan and lookup benchmarks also
+ * run on 5 * 10^7 records (a file of about 3.5 GB, plus the time to build it once).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "records/FixedA.hpp"
+#include <fdfile/repository/UniformFixedRepositoryImpl.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+using Repo = UniformFixedRepositoryImpl<FixedA>;
+
+FixedRepositoryOptions benchOptions() {
+    FixedRepositoryOptions opts;
+    opts.deleteMode = DeleteMode::Tombstone; // O(1) deletes keep the file size stable
+    opts.durability = Durability::Async;     // Measure the code path, not the disk
+    return opts;
+}
+
+std::string pathFor(size_t n) { return "./bench_fixed_" + std::to_string(n) + ".db"; }
+
+/// Removes the prepared files when the benchmark binary exits
+struct PreparedFiles {
+    std::set<size_t> sizes;
+    ~PreparedFiles() {
+        for (size_t n : sizes) {
+            ::remove(pathFor(n).c_str());
+            ::remove((pathFor(n) + ".idx").c_str()); // BM_FixedColdLookup
+            ::remove((pathFor(n) + ".ctl").c_str()); // Tombstone and Async map it
+        }
+    }
+};
+PreparedFiles prepared;
+
+/// File with records "0" .. "n-1", built once per size and shared by the benchmarks
+std::string prepare(size_t n) {
+    const std::string path = pathFor(n);
+    if (prepared.sizes.insert(n).second) {
+        ::remove(path.c_str());
+        std::error_code ec;
+        FixedRepositoryOptions opts = benchOptions();
+        opts.growChunkRecords = 1 << 16;
+        Repo repo(path, opts, ec);
+        constexpr size_t kChunk = 1 << 16;
+        std::vector<FixedA> recs;
+        std::vector<const FixedA*> ptrs;
+        for (size_t base = 0; base < n && !ec; base += kChunk) {
+            recs.clear();
+            ptrs.clear();
+            for (size_t i = base; i < std::min(n, base + kChunk); ++i)
+                recs.emplace_back("user", static_cast<int64_t>(i), std::to_string(i).c_str());
+            for (const auto& r : recs)
+                ptrs.push_back(&r);
+            repo.saveAll(ptrs, ec);
+        }
+        repo.compact(ec); // Drop the preallocated tail
+    }
+    return path;
+}
+
+void BM_FixedSave(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::error_code ec;
+    Repo repo(prepare(n), benchOptions(), ec);
+    size_t i = 0;
+    for (auto _ : state) {
+        // Overwrites an existing record in place
+        FixedA rec("updated", static_cast<int64_t>(i), std::to_string(i % n).c_str());
+        benchmark::DoNotOptimize(repo.save(rec, ec));
+        i += 7919;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FixedFindById(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::error_code ec;
+    Repo repo(prepare(n), benchOptions(), ec);
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < 1024; ++i)
+        ids.push_back(std::to_string((i * 2654435761u) % n));
+    size_t i = 0;
+    for (auto _ : state) {
+        auto rec = repo.findById(ids[i++ & 1023], ec);
+        benchmark::DoNotOptimize(rec.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FixedFindAll(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::error_code ec;
+    Repo repo(prepare(n), benchOptions(), ec);
+    for (auto _ : state) {
+        auto all = repo.findAll(ec);
+        benchmark::DoNotOptimize(all.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+void BM_FixedDeleteById(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    std::error_code ec;
+    Repo repo(prepare(n), benchOptions(), ec);
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string id = std::to_string(i % n);
+        benchmark::DoNotOptimize(repo.deleteById(id, ec));
+        state.PauseTiming();
+        repo.save(FixedA("user", static_cast<int64_t>(i % n), id.c_str()), ec); // Refill
+        state.ResumeTiming();
+        i += 7919;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FixedOpen(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n);
+    for (auto _ : state) {
+        std::error_code ec;
+        Repo repo(path, benchOptions(), ec); // Builds the ID index
+        benchmark::DoNotOptimize(repo.count(ec));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+/// Open (index rebuild) and findAll() with FixedRepositoryOptions::scanThreads
+void BM_FixedOpenThreads(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n);
+    FixedRepositoryOptions opts = benchOptions();
+    opts.scanThreads = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        std::error_code ec;
+        Repo repo(path, opts, ec);
+        auto all = repo.findAll(ec);
+        benchmark::DoNotOptimize(all.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+/// Records with age in a window of 100: Ordered field index (indexed=1) or forEach() filter
+void BM_FixedRangeQuery(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const bool indexed = state.range(1) != 0;
+    FixedRepositoryOptions opts = benchOptions();
+    if (indexed)
+        opts.fieldIndexes = {{"age", FieldIndexKind::Ordered}};
+    std::error_code ec;
+    Repo repo(prepare(n), opts, ec);
+    size_t i = 0;
+    for (auto _ : state) {
+        const int64_t lo = static_cast<int64_t>(i % (n - 100));
+        size_t hits = 0;
+        if (indexed) {
+            auto session = repo.readSession(ec);
+            hits = session.findInRange("age", lo, lo + 99, ec).size();
+        } else {
+            repo.forEach(
+                [&](const RecordView<FixedA>& v) {
+                    std::error_code vec;
+                    const int64_t age = v.num("age", vec);
+                    hits += age >= lo && age <= lo + 99;
+                },
+                ec);
+        }
+        benchmark::DoNotOptimize(hits);
+        i += 7919;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Drop the clean, unmapped pages of a file from the page cache so the next access is cold
+void evictPageCache(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    (void)::fdatasync(fd);
+#ifdef POSIX_FADV_DONTNEED
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    ::close(fd);
+}
+
+/// Open (index rebuild) and forEach() on a cold page cache
+/// hint: 0 none, 1 MappingOptions::scanHints, 2 MappingOptions::populate, 3 hugePages
+void BM_FixedColdScan(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n);
+    FixedRepositoryOptions opts = benchOptions();
+    opts.mapping.scanHints = state.range(1) == 1;
+    opts.mapping.populate = state.range(1) == 2;
+    opts.mapping.hugePages = state.range(1) == 3;
+    for (auto _ : state) {
+        state.PauseTiming();
+        evictPageCache(path);
+        state.ResumeTiming();
+        std::error_code ec;
+        Repo repo(path, opts, ec);
+        int64_t sum = 0;
+        repo.forEach(
+            [&](const RecordView<FixedA>& v) {
+                std::error_code vec;
+                sum += v.num("age", vec);
+            },
+            ec);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+/// 1000 findById() on a cold page cache (persistent index, so open does not scan)
+/// hint: 0 AccessPattern::Normal, 1 AccessPattern::Random, 2 Random + hugePages
+void BM_FixedColdLookup(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n);
+    FixedRepositoryOptions opts = benchOptions();
+    opts.persistentIndex = true;
+    opts.mapping.pattern = state.range(1) == 0 ? AccessPattern::Normal : AccessPattern::Random;
+    opts.mapping.hugePages = state.range(1) == 2;
+    {
+        std::error_code ec;
+        Repo warm(path, opts, ec); // Builds the sidecar once
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        evictPageCache(path);
+        state.ResumeTiming();
+        std::error_code ec;
+        Repo repo(path, opts, ec);
+        for (int k = 0; k < 1000; ++k) {
+            benchmark::DoNotOptimize(repo.findById(std::to_string(i % n), ec));
+            i += 7919;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+/// Records of the multi-GB file used by the cold benchmarks with FDFILE_BENCH_LARGE
+constexpr int64_t kLargeRecords = 50000000;
+
+/// Register the cold benchmarks on the multi-GB file (opt-in: slow to prepare, needs disk)
+const bool largeRegistered = [] {
+    if (!std::getenv("FDFILE_BENCH_LARGE"))
+        return false;
+    benchmark::RegisterBenchmark("BM_FixedColdScan", BM_FixedColdScan)
+        ->ArgsProduct({{kLargeRecords}, {0, 1, 2, 3}})
+        ->ArgNames({"records", "hint"})
+        ->Iterations(1)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("BM_FixedColdLookup", BM_FixedColdLookup)
+        ->ArgsProduct({{kLargeRecords}, {0, 1, 2}})
+        ->ArgNames({"records", "hint"})
+        ->Iterations(3)
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+    return true;
+}();
+
+} // namespace
+
+BENCHMARK(BM_FixedSave)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_FixedFindById)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_FixedFindAll)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FixedDeleteById)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_FixedOpen)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FixedOpenThreads)
+    ->ArgsProduct({{100000, 1000000, 10000000}, {1, 2, 4, 8}})
+    ->ArgNames({"records", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FixedRangeQuery)
+    ->ArgsProduct({{1000, 100000, 1000000}, {0, 1}})
+    ->ArgNames({"records", "indexed"});
+BENCHMARK(BM_FixedColdScan)
+    ->ArgsProduct({{1000000, 10000000}, {0, 1, 2, 3}})
+    ->ArgNames({"records", "hint"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FixedColdLookup)
+    ->ArgsProduct({{1000000, 10000000}, {0, 1, 2}})
+    ->ArgNames({"records", "hint"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,127 @@
+/**
+ * @file NumericCodecBench.cpp
+ * @brief FD_NUM field encode/decode: fixed-width codec vs. the former snprintf/stoull path
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fdfile/record/FieldMeta.hpp>
+#include <fdfile/util/NumericCodec.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+constexpr size_t kValues = 4096;
+
+std::vector<int64_t> makeValues() {
+    std::mt19937_64 rng(12345);
+    std::vector<int64_t> values(kValues);
+    for (auto& v : values)
+        v = static_cast<int64_t>(rng()) >> (rng() % 63); // mix of short and long values
+    return values;
+}
+
+std::vector<char> makeEncoded(const std::vector<int64_t>& values) {
+    std::vector<char> out(values.size() * detail::FIXED_INT64_LEN);
+    for (size_t i = 0; i < values.size(); ++i)
+        detail::encodeFixedInt64(values[i], out.data() + i * detail::FIXED_INT64_LEN);
+    return out;
+}
+
+// Previous FieldMeta::get implementation
+void legacyEncode(int64_t val, char* buf) {
+    char sign = (val >= 0) ? '+' : '-';
+    uint64_t absVal =
+        (val >= 0) ? static_cast<uint64_t>(val) : static_cast<uint64_t>(-(val + 1)) + 1;
+    char tmp[detail::FIXED_INT64_LEN + 1];
+    std::snprintf(tmp, sizeof(tmp), "%c%019llu", sign, static_cast<unsigned long long>(absVal));
+    std::memcpy(buf, tmp, detail::FIXED_INT64_LEN);
+}
+
+// Previous FieldMeta::set implementation
+int64_t legacyDecode(const char* buf) {
+    char tmp[detail::FIXED_INT64_LEN + 1];
+    std::memcpy(tmp, buf, detail::FIXED_INT64_LEN);
+    tmp[detail::FIXED_INT64_LEN] = '\0';
+    if (tmp[0] != '+' && tmp[0] != '-')
+        throw std::runtime_error("Invalid numeric field: sign must be '+' or '-'");
+    uint64_t absVal = std::stoull(tmp + 1);
+    return tmp[0] == '-' ? -static_cast<int64_t>(absVal) : static_cast<int64_t>(absVal);
+}
+
+void BM_EncodeLegacy(benchmark::State& state) {
+    auto values = makeValues();
+    char buf[detail::FIXED_INT64_LEN];
+    size_t i = 0;
+    for (auto _ : state) {
+        legacyEncode(values[i++ % kValues], buf);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeLegacy);
+
+void BM_EncodeFixed(benchmark::State& state) {
+    auto values = makeValues();
+    char buf[detail::FIXED_INT64_LEN];
+    size_t i = 0;
+    for (auto _ : state) {
+        detail::encodeFixedInt64(values[i++ % kValues], buf);
+        benchmark::DoNotOptimize(buf);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeFixed);
+
+void BM_DecodeLegacy(benchmark::State& state) {
+    auto encoded = makeEncoded(makeValues());
+    size_t i = 0;
+    for (auto _ : state) {
+        int64_t v = legacyDecode(encoded.data() + (i++ % kValues) * detail::FIXED_INT64_LEN);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeLegacy);
+
+void BM_DecodeFixed(benchmark::State& state) {
+    auto encoded = makeEncoded(makeValues());
+    std::error_code ec;
+    size_t i = 0;
+    for (auto _ : state) {
+        int64_t v = 0;
+        bool ok = detail::decodeFixedInt64(
+            encoded.data() + (i++ % kValues) * detail::FIXED_INT64_LEN, detail::FIXED_INT64_LEN,
+            v, ec);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeFixed);
+
+// Whole-field path as used by FixedRecordBase::deserialize
+void BM_FieldMetaSet(benchmark::State& state) {
+    auto encoded = makeEncoded(makeValues());
+    int64_t member = 0;
+    auto field = makeNumField("value", member);
+    std::error_code ec;
+    size_t i = 0;
+    for (auto _ : state) {
+        field.set(encoded.data() + (i++ % kValues) * detail::FIXED_INT64_LEN, ec);
+        benchmark::DoNotOptimize(member);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FieldMetaSet);
+
+} // namespace
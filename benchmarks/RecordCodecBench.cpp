@@ -0,0 +1,100 @@
+/**
+ * @file RecordCodecBench.cpp
+ * @brief Record encoding hot paths: fixed-record serialize/deserialize and text line codec
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "records/FixedA.hpp"
+#include <fdfile/util/textFormatUtil.hpp>
+
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+const std::string kLine =
+    R"(B { "name": "user_12345", "id": 12345, "pw": "pass \"word\" 12345" })";
+
+std::vector<std::pair<std::string, std::pair<bool, std::string>>> makeFields() {
+    return {{"name", {true, "user_12345"}},
+            {"id", {false, "12345"}},
+            {"pw", {true, "pass \"word\" 12345"}}};
+}
+
+void BM_FixedSerialize(benchmark::State& state) {
+    FixedA rec("alice", 1234567890, "id_000001");
+    std::vector<char> buf(rec.recordSize());
+    for (auto _ : state) {
+        rec.serialize(buf.data());
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buf.size()));
+}
+BENCHMARK(BM_FixedSerialize);
+
+void BM_FixedDeserialize(benchmark::State& state) {
+    FixedA src("alice", 1234567890, "id_000001");
+    std::vector<char> buf(src.recordSize());
+    src.serialize(buf.data());
+    FixedA dst;
+    std::error_code ec;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dst.deserialize(buf.data(), ec));
+        benchmark::DoNotOptimize(dst.age);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buf.size()));
+}
+BENCHMARK(BM_FixedDeserialize);
+
+void BM_ParseLine(benchmark::State& state) {
+    std::string type;
+    std::unordered_map<std::string, std::pair<bool, std::string>> kv;
+    std::error_code ec;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(util::parseLine(kLine, type, kv, ec));
+        benchmark::DoNotOptimize(kv.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kLine.size()));
+}
+BENCHMARK(BM_ParseLine);
+
+void BM_ParseLineView(benchmark::State& state) {
+    std::string_view type;
+    util::KvViews kv;
+    std::error_code ec;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(util::parseLineView(kLine, type, kv, ec));
+        benchmark::DoNotOptimize(kv.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kLine.size()));
+}
+BENCHMARK(BM_ParseLineView);
+
+void BM_FormatLine(benchmark::State& state) {
+    const auto fields = makeFields();
+    for (auto _ : state) {
+        std::string line = util::formatLine("B", fields);
+        benchmark::DoNotOptimize(line.data());
+    }
+}
+BENCHMARK(BM_FormatLine);
+
+void BM_AppendFormattedLine(benchmark::State& state) {
+    const auto fields = makeFields();
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        util::appendFormattedLine(out, "B", fields);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_AppendFormattedLine);
+
+} // namespace
@@ -0,0 +1,86 @@
+/**
+ * @file TextScanBench.cpp
+ * @brief Quoted-string scan and escape over long text fields: scalar vs. dispatched SIMD kernel
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fdfile/util/SimdScan.hpp>
+#include <fdfile/util/textFormatUtil.hpp>
+
+#include <random>
+#include <string>
+
+using namespace FdFile;
+
+namespace {
+
+// Free text with a special character every ~200 bytes on average
+std::string makeText(size_t len) {
+    std::mt19937 rng(99);
+    std::string s(len, 'x');
+    for (auto& c : s) {
+        const unsigned r = rng() % 200;
+        c = r == 0 ? '"' : r == 1 ? '\n' : static_cast<char>('a' + rng() % 26);
+    }
+    return s;
+}
+
+template <detail::ScanSet S> void scanAll(detail::ScanKernel kernel, const std::string& s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while ((p = kernel(p, end)) < end)
+        ++p;
+    benchmark::DoNotOptimize(p);
+}
+
+void BM_FindScalar(benchmark::State& state) {
+    const std::string text = makeText(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        scanAll<detail::ScanSet::NeedsEscape>(
+            &detail::findScanCharScalar<detail::ScanSet::NeedsEscape>, text);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindScalar)->Arg(1 << 12)->Arg(1 << 16);
+
+void BM_FindDispatched(benchmark::State& state) {
+    const std::string text = makeText(static_cast<size_t>(state.range(0)));
+    state.SetLabel(detail::activeScanKernelName());
+    for (auto _ : state)
+        scanAll<detail::ScanSet::NeedsEscape>(
+            &detail::findScanChar<detail::ScanSet::NeedsEscape>, text);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindDispatched)->Arg(1 << 12)->Arg(1 << 16);
+
+void BM_EscapeLongField(benchmark::State& state) {
+    const std::string text = makeText(static_cast<size_t>(state.range(0)));
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        util::appendEscaped(out, text);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EscapeLongField)->Arg(1 << 12)->Arg(1 << 16);
+
+void BM_ParseLongField(benchmark::State& state) {
+    const std::string text = makeText(static_cast<size_t>(state.range(0)));
+    std::vector<std::pair<std::string, std::pair<bool, std::string>>> fields = {
+        {"desc", {true, text}}, {"id", {false, "1"}}};
+    std::string line = util::formatLine("Doc", fields);
+    line.pop_back();
+
+    util::KvViews kv;
+    std::string_view type;
+    std::error_code ec;
+    for (auto _ : state) {
+        bool ok = util::parseLineView(line, type, kv, ec);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(line.size()));
+}
+BENCHMARK(BM_ParseLongField)->Arg(1 << 12)->Arg(1 << 16);
+
+} // namespace
@@ -0,0 +1,65 @@
+/**
+ * @file VariableFormatBench.cpp
+ * @brief Variable repository file size and cold load time: text vs. binary format
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "records/B.hpp"
+#include <fdfile/repository/VariableFileRepositoryImpl.hpp>
+
+#include <sys/stat.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+std::unique_ptr<VariableFileRepositoryImpl> openRepo(const std::string& path, VariableFormat format,
+                                                     std::error_code& ec) {
+    std::vector<std::unique_ptr<VariableRecordBase>> protos;
+    protos.push_back(std::make_unique<B>());
+    VariableRepositoryOptions opts;
+    opts.format = format;
+    opts.durability = Durability::Async;
+    opts.logStructured = true;
+    return std::make_unique<VariableFileRepositoryImpl>(path, std::move(protos), opts, ec);
+}
+
+std::string prepare(VariableFormat format, size_t n) {
+    const std::string path = std::string("./bench_varfmt_") +
+                             (format == VariableFormat::Binary ? "bin" : "txt") + "_" +
+                             std::to_string(n) + ".db";
+    ::remove(path.c_str());
+    std::error_code ec;
+    auto repo = openRepo(path, format, ec);
+    for (size_t i = 0; i < n; ++i) {
+        B rec("user_" + std::to_string(i), static_cast<long>(i), "password \"" + std::to_string(i));
+        repo->save(rec, ec);
+    }
+    return path;
+}
+
+void BM_VariableLoad(benchmark::State& state, VariableFormat format) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(format, n);
+    struct stat st{};
+    ::stat(path.c_str(), &st);
+
+    for (auto _ : state) {
+        std::error_code ec;
+        auto repo = openRepo(path, format, ec);
+        benchmark::DoNotOptimize(repo->count(ec)); // Parses the whole file
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.counters["file_bytes"] = static_cast<double>(st.st_size);
+    ::remove(path.c_str());
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_VariableLoad, Text, VariableFormat::Text)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_VariableLoad, Binary, VariableFormat::Binary)->Arg(1000)->Arg(100000);
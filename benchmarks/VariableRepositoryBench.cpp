@@ -0,0 +1,104 @@
+/**
+ * @file VariableRepositoryBench.cpp
+ * @brief Variable-length repository load and update: rewrite vs. log-structured files
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "records/B.hpp"
+#include <fdfile/repository/VariableFileRepositoryImpl.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+std::unique_ptr<VariableFileRepositoryImpl> openRepo(const std::string& path, bool logStructured,
+                                                     std::error_code& ec, size_t scanThreads = 1) {
+    std::vector<std::unique_ptr<VariableRecordBase>> protos;
+    protos.push_back(std::make_unique<B>());
+    VariableRepositoryOptions opts;
+    opts.durability = Durability::Async;
+    opts.logStructured = logStructured;
+    opts.scanThreads = scanThreads;
+    return std::make_unique<VariableFileRepositoryImpl>(path, std::move(protos), opts, ec);
+}
+
+std::string prepare(size_t n, bool logStructured) {
+    const std::string path = std::string("./bench_var_") + (logStructured ? "log" : "rw") + "_" +
+                             std::to_string(n) + ".db";
+    ::remove(path.c_str());
+    std::error_code ec;
+    auto repo = openRepo(path, logStructured, ec);
+    std::vector<B> recs;
+    recs.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        recs.emplace_back("user_" + std::to_string(i), static_cast<long>(i), "pw");
+    std::vector<const VariableRecordBase*> ptrs;
+    for (const auto& r : recs)
+        ptrs.push_back(&r);
+    repo->saveAll(ptrs, ec);
+    return path;
+}
+
+/// Cold open plus a full parse of a text file
+void BM_VariableOpenLoad(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n, /*logStructured=*/false);
+    for (auto _ : state) {
+        std::error_code ec;
+        auto repo = openRepo(path, false, ec);
+        benchmark::DoNotOptimize(repo->count(ec));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    ::remove(path.c_str());
+}
+
+/// BM_VariableOpenLoad with VariableRepositoryOptions::scanThreads
+void BM_VariableOpenLoadThreads(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t threads = static_cast<size_t>(state.range(1));
+    const std::string path = prepare(n, /*logStructured=*/false);
+    for (auto _ : state) {
+        std::error_code ec;
+        auto repo = openRepo(path, false, ec, threads);
+        benchmark::DoNotOptimize(repo->count(ec));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    ::remove(path.c_str());
+}
+
+/// save() of an existing ID: a rewrite without logStructured, an append with it
+void BM_VariableUpdate(benchmark::State& state, bool logStructured) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::string path = prepare(n, logStructured);
+    std::error_code ec;
+    auto repo = openRepo(path, logStructured, ec);
+    size_t i = 0;
+    for (auto _ : state) {
+        B rec("updated_" + std::to_string(i), static_cast<long>(i % n), "pw2");
+        benchmark::DoNotOptimize(repo->save(rec, ec));
+        i += 7919;
+    }
+    state.SetItemsProcessed(state.iterations());
+    repo.reset();
+    ::remove(path.c_str());
+}
+
+} // namespace
+
+BENCHMARK(BM_VariableOpenLoad)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VariableOpenLoadThreads)
+    ->ArgsProduct({{100000, 1000000}, {1, 2, 4, 8}})
+    ->ArgNames({"records", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_VariableUpdate, Rewrite, false)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_CAPTURE(BM_VariableUpdate, LogStructured, true)->RangeMultiplier(10)->Range(1000, 1000000);
@@ -31,6 +31,11 @@ class A : public FdFile::VariableRecordBase {
         return std::make_unique<A>(*this);
     }
 
+    // 저장소가 dynamic_cast 없이 복사할 수 있도록 VariableRecordBase 타입으로 복제한다.
+    std::unique_ptr<FdFile::VariableRecordBase> cloneVariable() const override {
+        return std::make_unique<A>(*this);
+    }
+
     void
     toKv(std::vector<std::pair<std::string, std::pair<bool, std::string>>>& out) const override {
         // formatLine과 짝이 맞는 key 순서로 직렬화한다.
@@ -57,4 +62,26 @@ class A : public FdFile::VariableRecordBase {
         userId = tmp;
         return true;
     }
+
+    // 저장소 로드/재작성 경로에서 쓰는 할당 없는 버전. 뷰는 호출 동안만 유효하다.
+    void toKvView(FdFile::util::KvViews& out) const override {
+        out.clear();
+        out.add("name", true, name);
+        out.add("id", false, out.store(std::to_string(userId)));
+    }
+
+    bool fromKvView(const FdFile::util::KvViews& kv, std::error_code& ec) override {
+        ec.clear();
+        const auto* n = kv.find("name");
+        const auto* i = kv.find("id");
+        if (!n || !i)
+            return false;
+
+        long tmp = 0;
+        if (!FdFile::util::parseLongStrict(i->value, tmp, ec))
+            return false;
+        name.assign(n->value.data(), n->value.size());
+        userId = tmp;
+        return true;
+    }
 };
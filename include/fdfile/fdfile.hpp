@@ -39,14 +39,19 @@
 #include "record/RecordBase.hpp"
 #include "record/FieldMeta.hpp"
 #include "record/FixedRecordBase.hpp"
+#include "record/RecordView.hpp"
 #include "record/VariableRecordBase.hpp"
 
 // =============================================================================
 // Repository Types
 // =============================================================================
 #include "repository/RecordRepository.hpp"
+#include "repository/RepositoryOptions.hpp"
+#include "repository/RepositoryStats.hpp"
+#include "repository/ShardedRepository.hpp"
 #include "repository/UniformFixedRepositoryImpl.hpp"
 #include "repository/VariableFileRepositoryImpl.hpp"
+#include "repository/VariableFormatConverter.hpp"
 
 // =============================================================================
 // Utilities
@@ -54,6 +59,22 @@
 #include "util/UniqueFd.hpp"
 #include "util/MmapGuard.hpp"
 #include "util/FileLockGuard.hpp"
+#include "util/GroupCommitFlusher.hpp"
+#include "util/SlotHashTable.hpp"
+#include "util/FileStat.hpp"
+#include "util/IdIndexFile.hpp"
+#include "util/LruCache.hpp"
+#include "util/ThreadGate.hpp"
+#include "util/ControlFile.hpp"
+#include "util/AsyncWriteQueue.hpp"
+#include "util/ParallelScan.hpp"
+#include "util/ShardManifest.hpp"
+#include "util/FieldIndex.hpp"
+#include "util/NumericCodec.hpp"
+#include "util/Crc32c.hpp"
+#include "util/BinaryCodec.hpp"
+#include "util/SimdScan.hpp"
+#include "util/WriteBatch.hpp"
 #include "util/textFormatUtil.hpp"
 
 /**
@@ -64,7 +85,7 @@
  * 
  * Key components:
  * - Record types: RecordBase, FixedRecordBase, VariableRecordBase
- * - Repositories: UniformFixedRepositoryImpl, VariableFileRepositoryImpl
+ * - Repositories: UniformFixedRepositoryImpl, VariableFileRepositoryImpl, ShardedRepository
  * - Utilities: UniqueFd, MmapGuard, FileLockGuard
  */
 namespace FdFile {
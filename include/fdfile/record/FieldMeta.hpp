@@ -12,17 +12,20 @@
 /// @file FieldMeta.hpp
 /// @brief C++17 tuple-based field metadata utilities and macros
 
+#include "../util/NumericCodec.hpp"
+
 #include <cstdint>
-#include <cstdio>
 #include <cstring>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 
 namespace FdFile {
 
 /// @brief Maximum digits for int64_t (20 characters: sign + 19 digits)
-constexpr size_t INT64_FIELD_LEN = 20;
+constexpr size_t INT64_FIELD_LEN = detail::FIXED_INT64_LEN;
 
 // =============================================================================
 // FieldMeta Template
@@ -39,46 +42,43 @@ template <size_t Len, bool IsStr> struct FieldMeta {
     static constexpr bool isString = IsStr;     ///< String type flag
 
     /// @brief Serialize field value to buffer
-    /// @param buf Output buffer (must be at least Len bytes)
+    /// @param buf Output buffer (exactly Len bytes are written)
     void get(char* buf) const {
         if constexpr (IsStr) {
             // 고정 길이 문자열 필드는 원본 바이트를 그대로 복사한다.
             // padding/zero-fill 정책은 상위 레코드 초기화 로직에서 책임진다.
             std::memcpy(buf, ptr, Len);
         } else {
-            int64_t val = *static_cast<int64_t*>(ptr);
             // 숫자 필드는 부호 + 19자리 zero-padding 고정 포맷으로 직렬화한다.
             // 예) +0000000000000000025, -0000000000000000025
-            char sign = (val >= 0) ? '+' : '-';
-            // INT64_MIN 절대값 처리 시 overflow를 피하기 위해 unsigned 경유 계산을 사용한다.
-            uint64_t absVal =
-                (val >= 0) ? static_cast<uint64_t>(val) : static_cast<uint64_t>(-(val + 1)) + 1;
-            std::snprintf(buf, Len + 1, "%c%019llu", sign, static_cast<unsigned long long>(absVal));
+            static_assert(Len == detail::FIXED_INT64_LEN, "numeric fields are 20 bytes wide");
+            detail::encodeFixedInt64(*static_cast<int64_t*>(ptr), buf);
         }
     }
 
     /// @brief Deserialize field value from buffer
-    /// @param buf Input buffer
-    /// @throws std::runtime_error If sign character is invalid
-    void set(const char* buf) {
+    /// @param buf Input buffer (Len bytes are read)
+    /// @param ec Error code set if a numeric field is malformed or out of range
+    /// @return true on success (the member is untouched on failure)
+    bool set(const char* buf, std::error_code& ec) {
         if constexpr (IsStr) {
-            // 역직렬화 시 기존 버퍼를 먼저 0으로 지워 trailing garbage를 제거한다.
-            std::memset(ptr, 0, Len);
             std::memcpy(ptr, buf, Len);
+            return true;
         } else {
             // 숫자 필드는 첫 글자 부호 검증을 강제해 손상된 레코드를 조기에 차단한다.
-            char sign = buf[0];
-            if (sign != '+' && sign != '-') {
+            return detail::decodeFixedInt64(buf, Len, *static_cast<int64_t*>(ptr), ec);
+        }
+    }
+
+    /// @brief Deserialize field value from buffer
+    /// @param buf Input buffer
+    /// @throws std::runtime_error If the numeric field is malformed
+    void set(const char* buf) {
+        std::error_code ec;
+        if (!set(buf, ec)) {
+            if (ec == std::errc::invalid_argument && buf[0] != '+' && buf[0] != '-')
                 throw std::runtime_error("Invalid numeric field: sign must be '+' or '-'");
-            }
-            // 절대값 파트는 unsigned로 파싱하여 INT64_MIN 경계값을 안전하게 다룬다.
-            uint64_t absVal = std::stoull(buf + 1);
-            if (sign == '-') {
-                // 음수 복원 시에도 overflow 없는 경로를 유지한다.
-                *static_cast<int64_t*>(ptr) = -static_cast<int64_t>(absVal);
-            } else {
-                *static_cast<int64_t*>(ptr) = static_cast<int64_t>(absVal);
-            }
+            throw std::runtime_error("Invalid numeric field: " + ec.message());
         }
     }
 };
@@ -125,6 +125,36 @@ void defineFieldsFromTuple(Base* base, const Tuple& fields) {
                fields);
 }
 
+/// @brief Serialize every field of the tuple directly into a record buffer
+/// @param fields Field tuple
+/// @param buf Record buffer
+/// @param offsets Field offsets in declaration order
+template <typename Tuple>
+void serializeFields(const Tuple& fields, char* buf, const size_t* offsets) {
+    // 필드별 분기/중간 버퍼 없이 선언 순서대로 각 오프셋에 바로 기록한다.
+    size_t i = 0;
+    std::apply([&](const auto&... f) { (f.get(buf + offsets[i++]), ...); }, fields);
+}
+
+/// @brief Deserialize every field of the tuple directly from a record buffer
+/// @param fields Field tuple
+/// @param buf Record buffer
+/// @param offsets Field offsets in declaration order
+/// @param ec Error code set by the first malformed field
+/// @return true if every field was decoded (stops at the first failure)
+template <typename Tuple>
+bool deserializeFields(const Tuple& fields, const char* buf, const size_t* offsets,
+                       std::error_code& ec) {
+    size_t i = 0;
+    return std::apply(
+        [&](const auto&... f) {
+            return (const_cast<std::remove_const_t<std::remove_reference_t<decltype(f)>>&>(f).set(
+                        buf + offsets[i++], ec) &&
+                    ...);
+        },
+        fields);
+}
+
 /// @brief Get field value by index from tuple
 template <typename Tuple> void getFieldByIndex(const Tuple& fields, size_t idx, char* buf) {
     // 인덱스 기반 접근을 유지해 serialize 루프에서 조건 분기 비용을 최소화한다.
@@ -183,10 +213,16 @@ template <typename Tuple> void setFieldByIndex(const Tuple& fields, size_t idx,
     void __setFieldValue(size_t idx, const char* buf) {                                            \
         FdFile::setFieldByIndex(fields(), idx, buf);                                               \
     }                                                                                              \
+    void __serializeFields(char* buf, const size_t* offsets) const {                               \
+        FdFile::serializeFields(fields(), buf, offsets);                                           \
+    }                                                                                              \
+    bool __deserializeFields(const char* buf, const size_t* offsets, std::error_code& ec) {        \
+        return FdFile::deserializeFields(fields(), buf, offsets, ec);                              \
+    }                                                                                              \
     const char* typeName() const {                                                                 \
         return TypeNameStr;                                                                        \
     }                                                                                              \
-    std::string getId() const {                                                                    \
+    const std::string& getId() const {                                                             \
         return id_;                                                                                \
     }                                                                                              \
     void setId(const std::string& id) {                                                            \
@@ -197,9 +233,11 @@ template <typename Tuple> void setFieldByIndex(const Tuple& fields, size_t idx,
     std::string id_;                                                                               \
     void defineLayout() {                                                                          \
         /* 레이아웃 정의 순서(타입 -> id -> 사용자 필드)는 파일 포맷 호환성의 핵심 계약이다. */             \
-        this->defineStart();                                                                       \
-        this->defineType(TypeLen);                                                                 \
-        this->defineId(IdLen);                                                                     \
-        FdFile::defineFieldsFromTuple(this, fields());                                             \
-        this->defineEnd();                                                                         \
+        /* 레이아웃은 타입당 한 번만 만들어지고 이후 인스턴스는 포인터만 공유한다. */                      \
+        this->defineLayoutOnce([this](FdFile::detail::FixedLayout& l) {                            \
+            l.defineType(TypeLen);                                                                 \
+            l.defineId(IdLen);                                                                     \
+            FdFile::defineFieldsFromTuple(&l, fields());                                           \
+            l.defineEnd();                                                                         \
+        });                                                                                        \
     }
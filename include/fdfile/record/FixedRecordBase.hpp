@@ -6,22 +6,114 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
 #include <vector>
 
 namespace FdFile {
 
+/// @brief Marker written to the first byte of the type field of a deleted slot
+/// @details Type names are identifiers, so '#' can never start a live record. Builds without
+///          tombstone support read such a slot as a record (see docs/fixed-records.md).
+constexpr char FIXED_TOMBSTONE_MARK = '#';
+
+namespace detail {
+
+/// @brief Serialized layout of one fixed-length record type
+/// @details Built once per record type (see FixedRecordBase::defineLayoutOnce) and shared by
+///          every instance, so constructing a record never allocates.
+struct FixedLayout {
+    /// @brief Field information structure
+    struct FieldInfo {
+        std::string key; ///< Field key (name)
+        size_t offset;   ///< Offset within record
+        size_t length;   ///< Field length
+        bool isString;   ///< String flag (true: string, false: numeric)
+    };
+
+    std::string formatTemplate;       ///< Serialization template (pre-calculated delimiters)
+    std::vector<FieldInfo> fields;    ///< Field information list
+    std::vector<size_t> fieldOffsets; ///< Field offsets in declaration order
+    size_t typeOffset = 0;            ///< Type field offset
+    size_t typeLen = 0;               ///< Type field length
+    size_t idOffset = 0;              ///< ID field offset
+    size_t idLen = 0;                 ///< ID field length
+    size_t totalSize = 0;             ///< Total record size
+    bool defined = false;             ///< Layout definition complete flag
+
+    /// @brief Define type field
+    /// @param len Type field length
+    void defineType(size_t len) {
+        typeOffset = totalSize;
+        typeLen = len;
+        totalSize += len;
+        formatTemplate.append(len, '\0');
+    }
+
+    /// @brief Define ID field
+    /// @details Adds JSON-style delimiters (",id:\"", "\"{") around ID field.
+    /// @param len ID field length
+    void defineId(size_t len) {
+        const char prefix[] = ",id:\"";
+        totalSize += sizeof(prefix) - 1;
+        formatTemplate += prefix;
+        idOffset = totalSize;
+        idLen = len;
+        totalSize += len;
+        formatTemplate.append(len, '\0');
+        const char suffix[] = "\"{";
+        totalSize += sizeof(suffix) - 1;
+        formatTemplate += suffix;
+    }
+
+    /// @brief Define a data field
+    /// @details Adds delimiters for field key-value and calculates record size.
+    /// @param key Field key (name)
+    /// @param valLen Field value length
+    /// @param isString String flag (adds quotes around value if true)
+    void defineField(const char* key, size_t valLen, bool isString) {
+        if (!fields.empty()) {
+            totalSize += 1;
+            formatTemplate += ",";
+        }
+        std::string prefix = std::string(key) + ":";
+        if (isString)
+            prefix += "\"";
+
+        totalSize += prefix.size();
+        formatTemplate += prefix;
+
+        fields.push_back(FieldInfo{key, totalSize, valLen, isString});
+        fieldOffsets.push_back(totalSize);
+
+        totalSize += valLen;
+        formatTemplate.append(valLen, '\0');
+
+        if (isString) {
+            totalSize += 1;
+            formatTemplate += "\"";
+        }
+    }
+
+    /// @brief End layout definition
+    /// @details Adds closing brace ("}") and marks layout as defined.
+    void defineEnd() {
+        totalSize += 1;
+        formatTemplate += "}";
+        defined = true;
+    }
+};
+
+} // namespace detail
+
 /// @brief Fixed-length binary record base class (CRTP, Zero Vtable Overhead)
 /// @details Uses CRTP (Curiously Recurring Template Pattern) for compile-time polymorphism.
 ///          Provides high-performance serialization/deserialization without vtable overhead.
-///          Record layout must be defined in constructor via `defineLayout()`.
+///          The layout is built once per Derived type via `defineLayoutOnce()`; each instance
+///          only stores a pointer to it.
 /// @tparam Derived Concrete class inheriting from this base (CRTP derived class)
 template <typename Derived> class FixedRecordBase {
-    // Allow FieldMeta utilities to access protected members
-    template <typename Base, typename Tuple>
-    friend void defineFieldsFromTuple(Base* base, const Tuple& fields);
-
   public:
     /// @brief Destructor
     /// @details Not virtual since CRTP pattern is used, but safe because objects
@@ -42,178 +134,115 @@ template <typename Derived> class FixedRecordBase {
   public:
     /// @brief Returns total record size
     /// @return Total bytes of the record (includes type, ID, and field data)
-    size_t recordSize() const { return totalSize_; }
+    size_t recordSize() const { return layout_ ? layout_->totalSize : 0; }
+
+    /// @brief Offset of the type field within a serialized record
+    size_t typeOffset() const { return layout_->typeOffset; }
+
+    /// @brief Length of the type field
+    size_t typeLength() const { return layout_->typeLen; }
+
+    /// @brief Offset of the ID field within a serialized record
+    size_t idOffset() const { return layout_->idOffset; }
+
+    /// @brief Length of the ID field
+    size_t idLength() const { return layout_->idLen; }
+
+    /// @brief Number of user fields
+    size_t fieldCount() const { return layout_->fields.size(); }
+
+    /// @brief Name of user field idx
+    const std::string& fieldName(size_t idx) const { return layout_->fields[idx].key; }
+
+    /// @brief Offset of user field idx within a serialized record
+    size_t fieldOffset(size_t idx) const { return layout_->fields[idx].offset; }
+
+    /// @brief Length of user field idx
+    size_t fieldLength(size_t idx) const { return layout_->fields[idx].length; }
+
+    /// @brief Whether user field idx is a string field (false: numeric)
+    bool fieldIsString(size_t idx) const { return layout_->fields[idx].isString; }
+
+    /// @brief Find a user field by name
+    /// @return Field index, or fieldCount() if there is no such field
+    size_t fieldIndex(std::string_view key) const {
+        const auto& fields = layout_->fields;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].key == key)
+                return i;
+        }
+        return fields.size();
+    }
 
     /// @brief Serialize object to binary data
-    /// @details Copies Type, ID, and Field data to buffer according to predefined layout.
-    ///          Statically calls `typeName()`, `id()`, `getFieldValue()` from derived class.
+    /// @details Copies the delimiter template, then writes Type, ID and every field directly
+    ///          at its offset in `buf` (no intermediate buffer).
+    ///          Statically calls `typeName()`, `getId()`, `__serializeFields()` from derived class.
     /// @param[out] buf Buffer to store serialized data. Must be at least `recordSize()` bytes.
-    /// @return true on success, false if layout undefined or buffer too small
+    /// @return true on success, false if layout undefined
     bool serialize(char* buf) const {
-        if (!layoutDefined_)
+        if (!layout_ || !layout_->defined)
             return false;
+        const detail::FixedLayout& l = *layout_;
+        const Derived& self = *static_cast<const Derived*>(this);
 
         // 1. Copy template
-        std::memcpy(buf, formatTemplate_.data(), totalSize_);
+        std::memcpy(buf, l.formatTemplate.data(), l.totalSize);
 
         // 2. Overwrite Type (calls Derived::typeName())
-        const char* tName = static_cast<const Derived*>(this)->typeName();
-        std::string tNameStr(tName);
-        size_t copyLen = std::min(tNameStr.size(), typeLen_);
-        std::memcpy(buf + typeOffset_, tNameStr.data(), copyLen);
+        const char* tName = self.typeName();
+        std::memcpy(buf + l.typeOffset, tName, ::strnlen(tName, l.typeLen));
 
         // 3. Overwrite ID (calls Derived::getId())
-        std::string idStr = static_cast<const Derived*>(this)->getId();
-        copyLen = std::min(idStr.size(), idLen_);
-        std::memcpy(buf + idOffset_, idStr.data(), copyLen);
-
-        // 4. Overwrite field data
-        for (size_t i = 0; i < fields_.size(); ++i) {
-            const auto& f = fields_[i];
-            char valBuf[1024];
-            if (f.length >= 1024)
-                return false;
-
-            std::memset(valBuf, 0, f.length);
-            // Call Derived::__getFieldValue
-            static_cast<const Derived*>(this)->__getFieldValue(i, valBuf);
-
-            std::memcpy(buf + f.offset, valBuf, f.length);
-        }
+        const std::string& idStr = self.getId();
+        std::memcpy(buf + l.idOffset, idStr.data(), std::min(idStr.size(), l.idLen));
+
+        // 4. Overwrite field data in place
+        self.__serializeFields(buf, l.fieldOffsets.data());
         return true;
     }
 
     /// @brief Deserialize binary data to object
-    /// @details Reads data from buffer and parses Type, ID, Field values.
-    ///          Statically calls `setRecordId()`, `setFieldValue()` from derived class.
+    /// @details Reads data from buffer and parses Type, ID, Field values in place.
+    ///          Statically calls `setId()`, `__deserializeFields()` from derived class.
     /// @param[in] buf Buffer containing serialized data.
-    /// @param[out] ec Error code set on failure (e.g., `std::errc::invalid_argument`)
+    /// @param[out] ec Error code set on failure (`std::errc::invalid_argument` for an undefined
+    ///            layout or malformed numeric field, `std::errc::result_out_of_range` for a
+    ///            numeric field outside int64)
     /// @return true on success, false on failure
     bool deserialize(const char* buf, std::error_code& ec) {
-        if (!layoutDefined_) {
+        if (!layout_ || !layout_->defined) {
             ec = std::make_error_code(std::errc::invalid_argument);
             return false;
         }
+        const detail::FixedLayout& l = *layout_;
+        Derived& self = *static_cast<Derived*>(this);
 
-        char tmpBuf[1024];
+        // 1. Read ID (stops at zero padding)
+        const char* idPtr = buf + l.idOffset;
+        self.setId(std::string(idPtr, ::strnlen(idPtr, l.idLen)));
 
-        // 1. Read ID
-        if (idLen_ >= 1024)
-            return false;
-        std::memset(tmpBuf, 0, sizeof(tmpBuf));
-        std::memcpy(tmpBuf, buf + idOffset_, idLen_);
-        // Call Derived::setId
-        static_cast<Derived*>(this)->setId(std::string(tmpBuf));
-
-        // 2. Read fields
-        for (size_t i = 0; i < fields_.size(); ++i) {
-            const auto& f = fields_[i];
-            if (f.length >= 1024)
-                return false;
-
-            std::memcpy(tmpBuf, buf + f.offset, f.length);
-            // Call Derived::__setFieldValue
-            static_cast<Derived*>(this)->__setFieldValue(i, tmpBuf);
-        }
-        return true;
+        // 2. Read fields (malformed numeric fields are reported through ec)
+        return self.__deserializeFields(buf, l.fieldOffsets.data(), ec);
     }
 
   protected:
-    /// @brief Field information structure
-    struct FieldInfo {
-        std::string key; ///< Field key (name)
-        size_t offset;   ///< Offset within record
-        size_t length;   ///< Field length
-        bool isString;   ///< String flag (true: string, false: numeric)
-    };
-
-    // Layout Helpers
-
-    /// @brief Start layout definition
-    /// @details Clears existing layout information.
-    void defineStart() {
-        fields_.clear();
-        layoutDefined_ = false;
-        formatTemplate_.clear();
-        totalSize_ = 0;
-    }
-
-    /// @brief Define type field
-    /// @param len Type field length
-    void defineType(size_t len) {
-        typeOffset_ = totalSize_;
-        typeLen_ = len;
-        totalSize_ += len;
-        formatTemplate_.append(len, '\0');
-    }
-
-    /// @brief Define ID field
-    /// @details Adds JSON-style delimiters (",id:\"", "\"{") around ID field.
-    /// @param len ID field length
-    void defineId(size_t len) {
-        std::string prefix = ",id:\"";
-        totalSize_ += prefix.size();
-        formatTemplate_ += prefix;
-        idOffset_ = totalSize_;
-        idLen_ = len;
-        totalSize_ += len;
-        formatTemplate_.append(len, '\0');
-        std::string suffix = "\"{";
-        totalSize_ += suffix.size();
-        formatTemplate_ += suffix;
-    }
-
-    /// @brief Define a data field
-    /// @details Adds delimiters for field key-value and calculates record size.
-    /// @param key Field key (name)
-    /// @param valLen Field value length
-    /// @param isString String flag (adds quotes around value if true)
-    void defineField(const char* key, size_t valLen, bool isString) {
-        if (!fields_.empty()) {
-            totalSize_ += 1;
-            formatTemplate_ += ",";
-        }
-        std::string k = key;
-        std::string prefix = k + ":";
-        if (isString)
-            prefix += "\"";
-
-        totalSize_ += prefix.size();
-        formatTemplate_ += prefix;
-
-        FieldInfo info;
-        info.key = k;
-        info.offset = totalSize_;
-        info.length = valLen;
-        info.isString = isString;
-        fields_.push_back(info);
-
-        totalSize_ += valLen;
-        formatTemplate_.append(valLen, '\0');
-
-        if (isString) {
-            totalSize_ += 1;
-            formatTemplate_ += "\"";
-        }
-    }
-
-    /// @brief End layout definition
-    /// @details Adds closing brace ("}") and marks layout as defined.
-    void defineEnd() {
-        totalSize_ += 1;
-        formatTemplate_ += "}";
-        layoutDefined_ = true;
+    /// @brief Bind this instance to the layout of Derived, building it on first use
+    /// @details `build` receives an empty detail::FixedLayout and must call defineType(),
+    ///          defineId(), defineField()... and defineEnd() on it. It runs once per type
+    ///          (thread-safe static initialization); later calls only store the pointer.
+    /// @param build Layout definition callback
+    template <typename Build> void defineLayoutOnce(Build&& build) {
+        static const detail::FixedLayout shared = [&] {
+            detail::FixedLayout l;
+            build(l);
+            return l;
+        }();
+        layout_ = &shared;
     }
 
   private:
-    std::string formatTemplate_;    ///< Serialization template (pre-calculated delimiters)
-    std::vector<FieldInfo> fields_; ///< Field information list
-    size_t typeOffset_ = 0;         ///< Type field offset
-    size_t typeLen_ = 0;            ///< Type field length
-    size_t idOffset_ = 0;           ///< ID field offset
-    size_t idLen_ = 0;              ///< ID field length
-    size_t totalSize_ = 0;          ///< Total record size
-    bool layoutDefined_ = false;    ///< Layout definition complete flag
+    const detail::FixedLayout* layout_ = nullptr; ///< Shared per-type layout
 };
 
 } // namespace FdFile
@@ -0,0 +1,114 @@
+#pragma once
+/// @file RecordView.hpp
+/// @brief Read-only, zero-copy view of one serialized fixed-length record
+
+#include "../util/NumericCodec.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+namespace FdFile {
+
+/// @brief Zero-copy view of a fixed-length record slot
+/// @details Points directly into the repository mapping and reads fields at the offsets
+///          defined by the record layout. No allocation or deserialization takes place.
+///          A view is only valid while the ReadSession (or forEach call) that produced it
+///          is alive.
+/// @tparam T Concrete record type (inherits from FixedRecordBase<T>)
+template <typename T> class RecordView {
+  public:
+    /// @brief Construct a view
+    /// @param data Start of the serialized record
+    /// @param layout Record instance providing the layout (offsets and lengths)
+    RecordView(const char* data, const T* layout) noexcept : data_(data), layout_(layout) {}
+
+    /// @brief Raw serialized bytes
+    const char* data() const noexcept { return data_; }
+
+    /// @brief Serialized record size
+    size_t size() const noexcept { return layout_->recordSize(); }
+
+    /// @brief Type name stored in the record
+    std::string_view typeName() const noexcept {
+        return trimmed(layout_->typeOffset(), layout_->typeLength());
+    }
+
+    /// @brief Record ID (without zero padding)
+    std::string_view id() const noexcept {
+        return trimmed(layout_->idOffset(), layout_->idLength());
+    }
+
+    /// @brief Number of user fields
+    size_t fieldCount() const noexcept { return layout_->fieldCount(); }
+
+    /// @brief String field value (without zero padding)
+    /// @param idx Field index
+    std::string_view str(size_t idx) const noexcept {
+        return trimmed(layout_->fieldOffset(idx), layout_->fieldLength(idx));
+    }
+
+    /// @brief String field value by name (empty if there is no such field)
+    std::string_view str(std::string_view key) const noexcept {
+        size_t idx = layout_->fieldIndex(key);
+        if (idx >= layout_->fieldCount())
+            return {};
+        return str(idx);
+    }
+
+    /// @brief Numeric field value
+    /// @param idx Field index
+    /// @param ec Error code set if the field is not a valid numeric field
+    /// @return Parsed value (0 on failure)
+    int64_t num(size_t idx, std::error_code& ec) const noexcept {
+        ec.clear();
+        if (layout_->fieldIsString(idx)) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return 0;
+        }
+        int64_t value = 0;
+        (void)detail::decodeFixedInt64(data_ + layout_->fieldOffset(idx), layout_->fieldLength(idx),
+                                       value, ec);
+        return value;
+    }
+
+    /// @brief Numeric field value by name
+    int64_t num(std::string_view key, std::error_code& ec) const noexcept {
+        size_t idx = layout_->fieldIndex(key);
+        if (idx >= layout_->fieldCount()) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return 0;
+        }
+        return num(idx, ec);
+    }
+
+    /// @brief Deserialize the viewed record into a full object
+    /// @param[out] out Destination record
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool materialize(T& out, std::error_code& ec) const { return out.deserialize(data_, ec); }
+
+    /// @brief Deserialize the viewed record into a new heap object
+    /// @param ec Error code set on failure
+    /// @return Record, or nullptr on failure
+    std::unique_ptr<T> toRecord(std::error_code& ec) const {
+        auto rec = std::make_unique<T>();
+        if (!rec->deserialize(data_, ec))
+            return nullptr;
+        return rec;
+    }
+
+  private:
+    std::string_view trimmed(size_t offset, size_t len) const noexcept {
+        const char* p = data_ + offset;
+        const void* nul = std::memchr(p, '\0', len);
+        return std::string_view(p, nul ? static_cast<const char*>(nul) - p : len);
+    }
+
+    const char* data_;
+    const T* layout_;
+};
+
+} // namespace FdFile
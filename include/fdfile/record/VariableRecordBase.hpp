@@ -2,6 +2,7 @@
 /// @file VariableRecordBase.hpp
 /// @brief Variable-length record base class (formerly TextRecordBase)
 
+#include "../util/textFormatUtil.hpp"
 #include "RecordBase.hpp"
 
 #include <memory>
@@ -12,6 +13,10 @@
 
 namespace FdFile {
 
+/// @brief Reserved type name of a delete marker line: `__del { "id": "<id>" }`
+/// @details Written by log-structured repositories. Record types must not use it.
+constexpr char VARIABLE_TOMBSTONE_TYPE[] = "__del";
+
 /// @brief Variable-length text record base class (JSON-style Key-Value)
 /// @details Provides virtual interface for serializing/deserializing data as JSON-style 
 ///          Key-Value pairs. Inherit from this class to implement concrete variable-length records.
@@ -39,10 +44,51 @@ class VariableRecordBase : public RecordBase {
     virtual bool fromKv(const std::unordered_map<std::string, std::pair<bool, std::string>>& kv,
                         std::error_code& ec) = 0;
 
+    /// @brief Serialize to a flat list of views (allocation-free fast path)
+    /// @details Used by the repository when writing. The default converts the output of toKv().
+    ///          Overrides may view their own members, string literals, or out.store() copies;
+    ///          the list is consumed before the record changes.
+    /// @param[out] out Field list (cleared first)
+    virtual void toKvView(util::KvViews& out) const {
+        std::vector<std::pair<std::string, std::pair<bool, std::string>>> kv;
+        toKv(kv);
+        out.clear();
+        for (const auto& f : kv)
+            out.add(out.store(f.first), f.second.first, out.store(f.second.second));
+    }
+
+    /// @brief Deserialize from a flat list of views (allocation-free fast path)
+    /// @details Used by the repository when loading; the views point into the file mapping
+    ///          and are only valid during the call. The default builds the map for fromKv().
+    /// @param[in] kv Parsed fields, in line order
+    /// @param[out] ec Error code set on failure
+    /// @return true on success, false on failure
+    virtual bool fromKvView(const util::KvViews& kv, std::error_code& ec) {
+        std::unordered_map<std::string, std::pair<bool, std::string>> map;
+        map.reserve(kv.size());
+        for (const auto& e : kv)
+            map.emplace(std::string(e.key), std::make_pair(e.isString, std::string(e.value)));
+        return fromKv(map, ec);
+    }
+
     /// @brief Clone object (Deep Copy)
     /// @details Creates and returns a copy of the current object.
     /// @return std::unique_ptr managing the cloned object
     virtual std::unique_ptr<RecordBase> clone() const = 0;
+
+    /// @brief Clone as a VariableRecordBase
+    /// @details The default downcasts the result of clone(). Overriding it with
+    ///          `return std::make_unique<Derived>(*this);` skips the RTTI check the repository
+    ///          would otherwise pay for every loaded and returned record.
+    /// @return Deep copy, or nullptr if clone() does not return a VariableRecordBase
+    virtual std::unique_ptr<VariableRecordBase> cloneVariable() const {
+        auto copy = clone();
+        if (auto* v = dynamic_cast<VariableRecordBase*>(copy.get())) {
+            (void)copy.release();
+            return std::unique_ptr<VariableRecordBase>(v);
+        }
+        return nullptr;
+    }
 };
 
 } // namespace FdFile
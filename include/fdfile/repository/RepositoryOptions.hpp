@@ -0,0 +1,258 @@
+#pragma once
+/// @file RepositoryOptions.hpp
+/// @brief Tuning options for repository implementations
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FdFile {
+
+/// @brief When a completed write must be on stable storage
+enum class Durability {
+    Strict,     ///< Every write is flushed before returning (msync(MS_SYNC) / fsync)
+    Async,      ///< Writes are handed to the kernel only (msync(MS_ASYNC) / no fsync)
+    GroupCommit ///< A background flusher batches many writes into one fdatasync
+};
+
+/// @brief Tuning for Durability::GroupCommit
+struct GroupCommitOptions {
+    /// @brief Maximum time a write may stay unflushed
+    std::chrono::milliseconds interval{10};
+
+    /// @brief Pending write count that triggers an immediate flush
+    size_t maxPendingWrites = 64;
+};
+
+/// @brief Deletion strategy for fixed-length record files
+enum class DeleteMode {
+    Compact,  ///< Shift following records down and truncate the file (dense file, O(N) delete)
+    Tombstone ///< Mark the slot deleted and reuse it for later inserts (O(1) delete)
+};
+
+/// @brief Kind of a secondary index on a fixed-record field
+enum class FieldIndexKind {
+    Hash,   ///< Equality lookups (FD_STR or FD_NUM fields)
+    Ordered ///< Equality and range lookups in value order (FD_NUM fields only)
+};
+
+/// @brief Secondary index declaration (FixedRepositoryOptions::fieldIndexes)
+struct FieldIndexSpec {
+    std::string field; ///< Field key as declared with FD_STR / FD_NUM
+    FieldIndexKind kind = FieldIndexKind::Hash;
+};
+
+/// @brief Expected access to a memory-mapped record file (madvise hint)
+enum class AccessPattern {
+    Normal,     ///< Kernel default readahead
+    Sequential, ///< Mostly full scans: read ahead aggressively
+    Random      ///< Mostly point lookups: no readahead
+};
+
+/// @brief Kernel hints for the mapping of a fixed-length record file
+/// @details All hints are best effort; none of them changes what the repository reads or
+///          writes.
+struct MappingOptions {
+    /// @brief Access pattern advised for the whole mapping
+    AccessPattern pattern = AccessPattern::Normal;
+
+    /// @brief Advise full scans as sequential
+    /// @details findAll(), forEach(), parallelForEach(), compact() and index rebuilds advise
+    ///          the mapping as sequential and needed before they start, and restore `pattern`
+    ///          when done.
+    bool scanHints = false;
+
+    /// @brief Prefault the whole file whenever it is mapped (MAP_POPULATE)
+    /// @details The first accesses after open hit memory, at the cost of reading the file
+    ///          up front. Slots added by later growth are advised as needed.
+    bool populate = false;
+
+    /// @brief Ask for transparent huge pages (MADV_HUGEPAGE) to cut TLB misses on large files
+    bool hugePages = false;
+
+    /// @brief Pin the persistent ID index (`<path>.idx`) in memory with mlock
+    /// @details Only applies with persistentIndex. Pinning fails beyond RLIMIT_MEMLOCK unless
+    ///          the process has CAP_IPC_LOCK; the index then stays pageable (see
+    ///          UniformFixedRepositoryImpl::indexPinned()).
+    bool lockIndex = false;
+};
+
+/// @brief Options for UniformFixedRepositoryImpl
+struct FixedRepositoryOptions {
+    /// @brief How deleteById() removes a record
+    /// @details DeleteMode::Tombstone deletes and slot reuse keep the file size, so the
+    ///          repository then also maps the control file `<path>.ctl` (see controlFile).
+    DeleteMode deleteMode = DeleteMode::Compact;
+
+    /// @brief Auto-compaction trigger for DeleteMode::Tombstone
+    /// @details When the fraction of tombstoned slots reaches this value after a delete,
+    ///          the file is compacted in the same call. 0 disables auto-compaction
+    ///          (call compact() explicitly).
+    double compactThreshold = 0.0;
+
+    /// @brief Number of slots reserved each time the file has to grow
+    /// @details 1 keeps the file exactly sized. Larger values preallocate zero-filled
+    ///          (empty) slots so most inserts only touch one slot and never remap. Such an
+    ///          insert keeps the file size, so the repository then also maps the control file
+    ///          `<path>.ctl` (see controlFile) and other instances detect it through the
+    ///          shared write generation.
+    size_t growChunkRecords = 1;
+
+    /// @brief Durability policy for save/delete
+    /// @details Async and GroupCommit do not msync() each write, so repeated stores to dirty
+    ///          pages never update the mtime. The repository then also maps the control file
+    ///          `<path>.ctl` (see controlFile), through which other instances see every write.
+    Durability durability = Durability::Strict;
+
+    /// @brief Flusher tuning when durability is Durability::GroupCommit
+    GroupCommitOptions groupCommit;
+
+    /// @brief Keep the ID index in a memory-mapped sidecar file (`<path>.idx`)
+    /// @details Opening a file whose sidecar matches the data file (size, mtime, inode) is
+    ///          O(1); a missing or stale sidecar is rebuilt from the data file. save/delete
+    ///          update the sidecar incrementally.
+    bool persistentIndex = false;
+
+    /// @brief Allow one instance to be used from several threads at once
+    /// @details Calls are ordered by an in-process reader/writer lock under the fcntl lock:
+    ///          reads run in parallel while the cache is current, writes run alone.
+    bool threadSafe = false;
+
+    /// @brief Share a write generation with other processes through `<path>.ctl`
+    /// @details Writers bump the generation in the mapped control file; reads that find it
+    ///          unchanged skip the stat() of the data file. Every process writing the file
+    ///          must enable this: changes by other writers are only seen after a write through
+    ///          the control file.
+    ///
+    ///          The control file is also mapped (without the stat() shortcut) when
+    ///          growChunkRecords > 1, deleteMode is Tombstone or durability is not Strict.
+    ///          Every instance writing such a file must then use the control file as well.
+    bool controlFile = false;
+
+    /// @brief Run saveAsync()/deleteAsync() on a background writer thread
+    /// @details The writer applies everything queued since its last batch inside one write
+    ///          session, so a burst of N asynchronous writes costs one lock acquisition and,
+    ///          with Durability::Strict, one flush. Also enables the in-process locking of
+    ///          threadSafe, since the writer runs alongside the caller's threads.
+    bool asyncWrites = false;
+
+    /// @brief Most operations the async writer applies per batch (0: no limit)
+    size_t asyncMaxBatch = 256;
+
+    /// @brief Threads used by index rebuilds and findAll() (1: serial, 0: one per core)
+    /// @details The slots are split into one contiguous range per thread and deserialized
+    ///          concurrently; the per-range results are merged in slot order, so the index
+    ///          and the result order match a serial scan.
+    size_t scanThreads = 1;
+
+    /// @brief Fewest slots per scan thread (smaller files use fewer threads)
+    size_t scanMinRecordsPerThread = 16384;
+
+    /// @brief Secondary indexes for findByField() / findInRange()
+    /// @details Kept in memory and updated by every write. They are built from the mapped
+    ///          slots (without deserializing records) when the file is opened and whenever
+    ///          the ID index is rebuilt after a change by another process.
+    std::vector<FieldIndexSpec> fieldIndexes;
+
+    /// @brief Access-pattern hints, prefaulting and pinning of the mapped files
+    MappingOptions mapping;
+};
+
+/// @brief On-disk encoding of variable-length record files
+enum class VariableFormat {
+    Text,  ///< One `Type { key: "value", ... }` line per record (human readable)
+    Binary ///< Dictionary-coded, varint length-prefixed frames with a CRC-32C each
+};
+
+/// @brief Options for VariableFileRepositoryImpl
+struct VariableRepositoryOptions {
+    /// @brief Encoding of the file
+    /// @details Must match an existing non-empty file (see convertVariableFile()).
+    VariableFormat format = VariableFormat::Text;
+
+    /// @brief Durability policy for save/delete
+    Durability durability = Durability::Strict;
+
+    /// @brief Flusher tuning when durability is Durability::GroupCommit
+    GroupCommitOptions groupCommit;
+
+    /// @brief Append updates and deletes instead of rewriting the file
+    /// @details An update appends the new version of the record and a delete appends a
+    ///          VARIABLE_TOMBSTONE_TYPE line; the loader keeps the last version per ID.
+    ///          Superseded lines are reclaimed by compact().
+    bool logStructured = false;
+
+    /// @brief Auto-compaction trigger for logStructured
+    /// @details When the fraction of dead lines (superseded versions and tombstones) reaches
+    ///          this value after a write, the file is compacted in the same call.
+    ///          0 disables auto-compaction (call compact() explicitly).
+    double compactThreshold = 0.0;
+
+    /// @brief Keep only an ID → file location index resident
+    /// @details Records are decoded on demand with pread(). Loading still parses every line
+    ///          once to learn its ID, but no record object outlives that.
+    bool lazyLoad = false;
+
+    /// @brief Byte budget of the decoded-record LRU cache used by lazyLoad (0 disables it)
+    /// @details A record costs its encoded size plus a fixed per-entry overhead. Point
+    ///          lookups fill the cache; full scans only read from it.
+    size_t recordCacheBytes = 0;
+
+    /// @brief Allow one instance to be used from several threads at once
+    /// @details Calls are ordered by an in-process reader/writer lock under the fcntl lock:
+    ///          reads run in parallel while the cache is current, writes run alone. lazyLoad
+    ///          reads still take turns to decode records.
+    bool threadSafe = false;
+
+    /// @brief Share a write generation with other processes through `<path>.ctl`
+    /// @details Writers bump the generation in the mapped control file; reads that find it
+    ///          unchanged skip the stat() of the data file and the file lock. Every process
+    ///          writing the file must enable this: changes by other writers are only seen
+    ///          after a write through the control file.
+    bool controlFile = false;
+
+    /// @brief Run saveAsync()/deleteAsync() on a background writer thread
+    /// @details The writer applies everything queued since its last batch inside one write
+    ///          session: appended records share one lock acquisition and, with
+    ///          Durability::Strict, one fdatasync. Also enables the in-process locking of
+    ///          threadSafe, since the writer runs alongside the caller's threads.
+    bool asyncWrites = false;
+
+    /// @brief Most operations the async writer applies per batch (0: no limit)
+    size_t asyncMaxBatch = 256;
+
+    /// @brief Threads used to parse the file when loading it (1: serial, 0: one per core)
+    /// @details The mapped text is split at line boundaries into one range per thread and
+    ///          the ranges are parsed concurrently; the parsed entries are then indexed in
+    ///          file order, so the last version of an ID still wins. Binary files are
+    ///          always loaded serially (a frame boundary cannot be found from the middle).
+    size_t scanThreads = 1;
+
+    /// @brief Fewest bytes per scan thread (smaller files use fewer threads)
+    size_t scanMinBytesPerThread = size_t{4} << 20;
+};
+
+/// @brief Options for ShardedRepository
+struct ShardedRepositoryOptions {
+    /// @brief Number of shards of a new repository
+    /// @details An existing repository keeps the count recorded in its manifest; change it
+    ///          with ShardedRepository::reshard().
+    size_t shardCount = 4;
+
+    /// @brief Run findAll(), count(), saveAll() and deleteAll() on one thread per shard
+    bool parallelFanOut = true;
+};
+
+/// @brief Counters of the lazyLoad record cache (VariableFileRepositoryImpl::cacheStats())
+struct VariableCacheStats {
+    uint64_t hits = 0;      ///< Lookups served from the LRU cache
+    uint64_t misses = 0;    ///< Lookups that had to pread and decode the record
+    uint64_t evictions = 0; ///< Records dropped to stay within recordCacheBytes
+    size_t cachedRecords = 0;
+    size_t cachedBytes = 0;
+    size_t indexedRecords = 0; ///< Live records in the ID index
+};
+
+} // namespace FdFile
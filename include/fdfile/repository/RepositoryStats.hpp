@@ -0,0 +1,270 @@
+#pragma once
+/// @file RepositoryStats.hpp
+/// @brief Operation counters and latency histograms of repository implementations
+/// @details Collection is compiled in only when FDFILE_ENABLE_STATS is defined (CMake option
+///          of the same name). Without it the instrumentation macros expand to nothing, the
+///          repositories hold no recorder and stats() returns an empty snapshot.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace FdFile {
+
+/// @brief Timed operations
+enum class StatOp : uint8_t {
+    Save,     ///< save()
+    SaveAll,  ///< saveAll()
+    FindById, ///< findById() / findByIdShared()
+    FindAll,  ///< findAll() / findAllShared() / forEach()
+    Delete,   ///< deleteById()
+    Compact,  ///< compact()
+    LockWait, ///< Time blocked acquiring the fcntl lock (F_SETLKW)
+    Sync,     ///< msync(MS_SYNC) / fdatasync issued on the caller's thread
+};
+
+/// @brief Event counters
+enum class StatCounter : uint8_t {
+    CacheHits,  ///< Validations that found the cache current
+    TailLoads,  ///< Only records appended by another process had to be indexed
+    Reloads,    ///< Full cache or index rebuilds
+    Remaps,     ///< Memory mappings created or resized (fixed repository)
+};
+
+constexpr size_t STAT_OP_COUNT = 8;
+constexpr size_t STAT_COUNTER_COUNT = 4;
+
+/// @brief Name of an operation for exporters ("save", "lock_wait", ...)
+inline const char* statOpName(StatOp op) {
+    static const char* const names[STAT_OP_COUNT] = {
+        "save", "save_all", "find_by_id", "find_all", "delete", "compact", "lock_wait", "sync"};
+    return names[static_cast<size_t>(op)];
+}
+
+/// @brief Name of a counter for exporters ("cache_hits", ...)
+inline const char* statCounterName(StatCounter c) {
+    static const char* const names[STAT_COUNTER_COUNT] = {"cache_hits", "tail_loads", "reloads",
+                                                          "remaps"};
+    return names[static_cast<size_t>(c)];
+}
+
+/// @brief Log-linear latency histogram (HDR style: 8 sub-buckets per power of two)
+/// @details Values below 16 ns get a bucket each; above, the relative bucket width is at most
+///          12.5%. Values past 2^40 ns (about 18 minutes) land in the last bucket.
+struct LatencyHistogram {
+    static constexpr size_t SUB_BUCKETS = 8;
+    static constexpr size_t LINEAR = 16;
+    static constexpr unsigned MAX_EXPONENT = 40;
+    static constexpr size_t BUCKETS = LINEAR + (MAX_EXPONENT - 3) * SUB_BUCKETS;
+
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    std::vector<uint64_t> buckets; ///< BUCKETS entries (empty when nothing was recorded)
+
+    /// @brief Bucket holding a value
+    static size_t bucketOf(uint64_t ns) {
+        if (ns < LINEAR)
+            return static_cast<size_t>(ns);
+        const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        if (msb > MAX_EXPONENT)
+            return BUCKETS - 1;
+        const size_t sub = static_cast<size_t>(ns >> (msb - 3)) & (SUB_BUCKETS - 1);
+        return LINEAR + (msb - 4) * SUB_BUCKETS + sub;
+    }
+
+    /// @brief Largest value that falls into bucket i
+    static uint64_t bucketUpperBound(size_t i) {
+        if (i < LINEAR)
+            return i;
+        const unsigned msb = static_cast<unsigned>((i - LINEAR) / SUB_BUCKETS) + 4;
+        const uint64_t sub = (i - LINEAR) % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (msb - 3)) - 1;
+    }
+
+    /// @brief Mean latency in nanoseconds (0 without samples)
+    double meanNs() const { return count ? static_cast<double>(totalNs) / count : 0.0; }
+
+    /// @brief Upper bound of the bucket holding quantile q (0..1), e.g. 0.99 for p99
+    uint64_t percentileNs(double q) const {
+        if (count == 0 || buckets.empty())
+            return 0;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank)
+                return bucketUpperBound(i) < maxNs ? bucketUpperBound(i) : maxNs;
+        }
+        return maxNs;
+    }
+};
+
+/// @brief Snapshot returned by the repositories' stats()
+struct RepositoryStats {
+    bool enabled = false; ///< false when the library was built without FDFILE_ENABLE_STATS
+    std::array<LatencyHistogram, STAT_OP_COUNT> ops{};
+    std::array<uint64_t, STAT_COUNTER_COUNT> counters{};
+
+    const LatencyHistogram& op(StatOp o) const { return ops[static_cast<size_t>(o)]; }
+    uint64_t counter(StatCounter c) const { return counters[static_cast<size_t>(c)]; }
+
+    /// @brief Fraction of cache validations that needed no reload (0 without any)
+    double cacheHitRate() const {
+        const uint64_t hits = counter(StatCounter::CacheHits);
+        const uint64_t total =
+            hits + counter(StatCounter::TailLoads) + counter(StatCounter::Reloads);
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+/// @brief Per-sample export hook: called with every timed operation and its latency
+/// @details Runs on the thread that performed the operation, possibly under the repository's
+///          locks, so it must be cheap and must not call back into the repository.
+using StatsHook = std::function<void(StatOp op, uint64_t nanos)>;
+
+namespace detail {
+
+/// @brief Lock-free collector behind RepositoryStats (relaxed atomics only)
+/// @note This class is for internal library use.
+class StatsRecorder {
+  public:
+    StatsRecorder() = default;
+
+    // Atomics are not movable: moves copy the current values
+    StatsRecorder(StatsRecorder&& other) noexcept { *this = std::move(other); }
+    StatsRecorder& operator=(StatsRecorder&& other) noexcept {
+        if (this != &other) {
+            for (size_t o = 0; o < STAT_OP_COUNT; ++o)
+                ops_[o].copyFrom(other.ops_[o]);
+            for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+                counters_[c].store(other.counters_[c].load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+            hook_ = std::move(other.hook_);
+        }
+        return *this;
+    }
+
+    void record(StatOp op, uint64_t ns) {
+        ops_[static_cast<size_t>(op)].add(ns);
+        if (hook_)
+            hook_(op, ns);
+    }
+
+    void count(StatCounter c) {
+        counters_[static_cast<size_t>(c)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Set the export hook (not synchronized: set it before sharing the repository)
+    void setHook(StatsHook hook) { hook_ = std::move(hook); }
+
+    RepositoryStats snapshot() const {
+        RepositoryStats s;
+        s.enabled = true;
+        for (size_t o = 0; o < STAT_OP_COUNT; ++o)
+            ops_[o].copyTo(s.ops[o]);
+        for (size_t c = 0; c < STAT_COUNTER_COUNT; ++c)
+            s.counters[c] = counters_[c].load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() {
+        for (auto& h : ops_)
+            h.clear();
+        for (auto& c : counters_)
+            c.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    struct AtomicHistogram {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> buckets{};
+
+        void add(uint64_t ns) {
+            buckets[LatencyHistogram::bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            totalNs.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t prev = maxNs.load(std::memory_order_relaxed);
+            while (prev < ns && !maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed))
+                ;
+        }
+
+        void copyTo(LatencyHistogram& out) const {
+            out.count = count.load(std::memory_order_relaxed);
+            out.totalNs = totalNs.load(std::memory_order_relaxed);
+            out.maxNs = maxNs.load(std::memory_order_relaxed);
+            if (out.count == 0)
+                return;
+            out.buckets.resize(LatencyHistogram::BUCKETS);
+            for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i)
+                out.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+
+        void copyFrom(const AtomicHistogram& other) {
+            count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            totalNs.store(other.totalNs.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+            maxNs.store(other.maxNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i)
+                buckets[i].store(other.buckets[i].load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+        }
+
+        void clear() {
+            count.store(0, std::memory_order_relaxed);
+            totalNs.store(0, std::memory_order_relaxed);
+            maxNs.store(0, std::memory_order_relaxed);
+            for (auto& b : buckets)
+                b.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    std::array<AtomicHistogram, STAT_OP_COUNT> ops_;
+    std::array<std::atomic<uint64_t>, STAT_COUNTER_COUNT> counters_{};
+    StatsHook hook_;
+};
+
+/// @brief Records the lifetime of the scope as one sample of an operation
+class StatsTimer {
+  public:
+    StatsTimer(StatsRecorder& recorder, StatOp op)
+        : recorder_(recorder), op_(op), start_(std::chrono::steady_clock::now()) {}
+    ~StatsTimer() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start_)
+                            .count();
+        recorder_.record(op_, static_cast<uint64_t>(ns));
+    }
+
+    StatsTimer(const StatsTimer&) = delete;
+    StatsTimer& operator=(const StatsTimer&) = delete;
+
+  private:
+    StatsRecorder& recorder_;
+    StatOp op_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail
+} // namespace FdFile
+
+#define FDFILE_STATS_CAT2(a, b) a##b
+#define FDFILE_STATS_CAT(a, b) FDFILE_STATS_CAT2(a, b)
+
+#if defined(FDFILE_ENABLE_STATS)
+/// @brief Time the rest of the enclosing scope as one sample of `op` (a StatOp enumerator)
+#define FDFILE_STATS_TIMER(recorder, op)                                                           \
+    ::FdFile::detail::StatsTimer FDFILE_STATS_CAT(fdfileStatsTimer_, __LINE__)(recorder,          \
+                                                                               ::FdFile::StatOp::op)
+/// @brief Increment a StatCounter
+#define FDFILE_STATS_COUNT(recorder, counter) (recorder).count(::FdFile::StatCounter::counter)
+#else
+#define FDFILE_STATS_TIMER(recorder, op) static_cast<void>(0)
+#define FDFILE_STATS_COUNT(recorder, counter) static_cast<void>(0)
+#endif
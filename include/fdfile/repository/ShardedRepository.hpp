@@ -0,0 +1,371 @@
+#pragma once
+/// @file ShardedRepository.hpp
+/// @brief Repository partitioned by ID hash over several shard files (Template)
+
+#include "../util/FileLockGuard.hpp"
+#include "../util/ParallelScan.hpp"
+#include "../util/ShardManifest.hpp"
+#include "../util/SlotHashTable.hpp"
+#include "RecordRepository.hpp"
+#include "RepositoryOptions.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+template <typename R, typename = void> struct HasGetId : std::false_type {};
+template <typename R>
+struct HasGetId<R, std::void_t<decltype(std::declval<const R&>().getId())>> : std::true_type {};
+
+/// @brief ID a record is routed by: getId() of fixed records, id() of variable ones
+template <typename R> std::string shardKeyOf(const R& record) {
+    if constexpr (HasGetId<R>::value)
+        return std::string(record.getId());
+    else
+        return record.id();
+}
+
+} // namespace detail
+
+/// @brief Repository split into N shard repositories, each with its own file and lock
+/// @tparam T Record type of the interface (e.g. a FixedRecordBase type or VariableRecordBase)
+/// @tparam Shard Repository type of one shard (UniformFixedRepositoryImpl<T> or
+///         VariableFileRepositoryImpl)
+///
+/// A record lives in shard `hashId(id) % N`. Writers to different shards take different
+/// fcntl locks, so writes by many processes no longer serialize on one whole-file lock, and
+/// each file only grows with its share of the records.
+///
+/// Files for a repository at `path`:
+/// - `<path>.manifest`: the layout (shard count and generation, see detail::ShardManifest)
+/// - `<path>.<generation>.<i>`: shard i, plus whatever sidecars the shard type creates
+///
+/// findAll(), count(), saveAll() and deleteAll() fan out to the shards on one thread each
+/// (ShardedRepositoryOptions::parallelFanOut). findById(), save() and deleteById() touch a
+/// single shard.
+///
+/// reshard() changes the shard count online. It holds the manifest's exclusive lock while it
+/// copies every record into a new generation of shard files, then replaces the manifest and
+/// removes the old files. Every other operation holds the shared lock, so in other instances
+/// (in this process or another) a reshard only shows up as a stall; their next operation
+/// opens the new shards.
+///
+/// @note An instance must not be used from several threads at once. Records are routed by
+///       the ID as given: IDs must fit the ID field of fixed-length records, since a
+///       truncated ID would hash to a different shard.
+template <typename T, typename Shard> class ShardedRepository : public RecordRepository<T> {
+  public:
+    /// @brief Opens (or creates) the shard repository stored at a path
+    using ShardFactory =
+        std::function<std::unique_ptr<Shard>(const std::string& path, std::error_code& ec)>;
+
+    /// @brief Constructor
+    /// @param path Base path (the manifest and shard files are named after it)
+    /// @param factory Creates each shard, e.g. with the shard's repository options. May be
+    ///        empty when Shard is constructible from `(path, ec)`.
+    /// @param options Sharding options
+    /// @param ec Error code set on failure
+    ShardedRepository(const std::string& path, ShardFactory factory,
+                      const ShardedRepositoryOptions& options, std::error_code& ec)
+        : path_(path), factory_(std::move(factory)), options_(options) {
+        ec.clear();
+        if (!factory_) {
+            if constexpr (std::is_constructible_v<Shard, const std::string&, std::error_code&>) {
+                factory_ = [](const std::string& p, std::error_code& fec) {
+                    return std::make_unique<Shard>(p, fec);
+                };
+            } else {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return;
+            }
+        }
+        if (!manifest_.open(path_ + ".manifest", options_.shardCount, ec))
+            return;
+        detail::ShardManifest::Guard guard;
+        enter(guard, ec);
+    }
+
+    /// @brief Constructor with default options and shards constructed from `(path, ec)`
+    ShardedRepository(const std::string& path, std::error_code& ec)
+        : ShardedRepository(path, nullptr, ShardedRepositoryOptions{}, ec) {}
+
+    // =========================================================================
+    // RecordRepository Interface Implementation
+    // =========================================================================
+
+    bool save(const T& record, std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return false;
+        return shards_[shardOf(detail::shardKeyOf(record))]->save(record, ec);
+    }
+
+    /// @brief Save multiple records: one saveAll() per shard, shards in parallel
+    /// @details Each shard's part is atomic as far as that shard's saveAll() is; a failure in
+    ///          one shard does not undo the others. A null entry rejects the whole batch
+    ///          (invalid_argument) before any shard is written.
+    bool saveAll(const std::vector<const T*>& records, std::error_code& ec) override {
+        ec.clear();
+        for (const T* r : records) {
+            if (!r) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+        }
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return false;
+        std::vector<std::vector<const T*>> groups(shards_.size());
+        for (const T* r : records)
+            groups[shardOf(detail::shardKeyOf(*r))].push_back(r);
+        return forEachShard(
+            [&](size_t i, std::error_code& sec) {
+                if (!groups[i].empty())
+                    shards_[i]->saveAll(groups[i], sec);
+            },
+            ec);
+    }
+
+    /// @brief Records of every shard, shard by shard (each shard in its own order)
+    std::vector<std::unique_ptr<T>> findAll(std::error_code& ec) override {
+        std::vector<std::unique_ptr<T>> res;
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return res;
+        std::vector<std::vector<std::unique_ptr<T>>> parts(shards_.size());
+        if (!forEachShard(
+                [&](size_t i, std::error_code& sec) { parts[i] = shards_[i]->findAll(sec); }, ec))
+            return res;
+        size_t total = 0;
+        for (const auto& p : parts)
+            total += p.size();
+        res.reserve(total);
+        for (auto& p : parts)
+            std::move(p.begin(), p.end(), std::back_inserter(res));
+        return res;
+    }
+
+    std::unique_ptr<T> findById(const std::string& id, std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return nullptr;
+        return shards_[shardOf(id)]->findById(id, ec);
+    }
+
+    bool deleteById(const std::string& id, std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return false;
+        return shards_[shardOf(id)]->deleteById(id, ec);
+    }
+
+    bool deleteAll(std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return false;
+        return forEachShard([&](size_t i, std::error_code& sec) { shards_[i]->deleteAll(sec); },
+                            ec);
+    }
+
+    size_t count(std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return 0;
+        std::vector<size_t> counts(shards_.size());
+        if (!forEachShard(
+                [&](size_t i, std::error_code& sec) { counts[i] = shards_[i]->count(sec); }, ec))
+            return 0;
+        size_t total = 0;
+        for (size_t c : counts)
+            total += c;
+        return total;
+    }
+
+    bool existsById(const std::string& id, std::error_code& ec) override {
+        detail::ShardManifest::Guard guard;
+        if (!enter(guard, ec))
+            return false;
+        return shards_[shardOf(id)]->existsById(id, ec);
+    }
+
+    // =========================================================================
+    // Sharding
+    // =========================================================================
+
+    /// @brief Change the number of shards, moving every record to its new shard
+    /// @details Runs under the manifest's exclusive lock: operations of other instances and
+    ///          processes wait until it returns. The records are copied one source shard at
+    ///          a time, so memory use is bounded by the largest shard. If the copy fails, the
+    ///          new files are removed and the old layout stays in use.
+    /// @param shards New shard count (at least 1)
+    /// @param ec Error code set on failure
+    /// @return true on success (also when the count is unchanged)
+    bool reshard(size_t shards, std::error_code& ec) {
+        ec.clear();
+        if (shards == 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        detail::ShardManifest::Guard guard;
+        if (!manifest_.lock(guard, detail::FileLockGuard::Mode::Exclusive, ec) || !openShards(ec))
+            return false;
+        const detail::ShardManifest::Layout current = manifest_.layout();
+        if (shards == current.shards)
+            return true;
+
+        const uint64_t nextGen = current.generation + 1;
+        removeGeneration(nextGen); // Leftovers of an interrupted reshard
+        std::vector<std::unique_ptr<Shard>> next;
+        if (!copyInto(nextGen, shards, next, ec) ||
+            !manifest_.replace(detail::ShardManifest::Layout{nextGen, shards}, ec)) {
+            next.clear();
+            removeGeneration(nextGen);
+            return false;
+        }
+        shards_.swap(next);
+        loadedGen_ = nextGen;
+        next.clear();
+        removeGeneration(current.generation);
+        return true;
+    }
+
+    /// @brief Number of shards in use
+    size_t shardCount() const noexcept { return shards_.size(); }
+
+    /// @brief Generation of the shard set in use (bumped by every reshard)
+    uint64_t generation() const noexcept { return loadedGen_; }
+
+    /// @brief Shard that holds (or would hold) a record with this ID
+    size_t shardOf(const std::string& id) const { return shardOf(id, shards_.size()); }
+
+    /// @brief Direct access to shard i, e.g. for its sessions or statistics
+    /// @note Calls on the shard bypass the manifest lock: do not hold on to it across a
+    ///       reshard by any process.
+    Shard& shard(size_t i) { return *shards_[i]; }
+
+    /// @brief File of shard i of a generation
+    static std::string shardPath(const std::string& path, uint64_t generation, size_t i) {
+        return path + "." + std::to_string(generation) + "." + std::to_string(i);
+    }
+
+  private:
+    static size_t shardOf(const std::string& id, size_t shards) {
+        return static_cast<size_t>(detail::hashId(id.data(), id.size()) % shards);
+    }
+
+    /// @brief Take the manifest's shared lock and make sure shards_ is the current set
+    bool enter(detail::ShardManifest::Guard& guard, std::error_code& ec) {
+        return manifest_.lock(guard, detail::FileLockGuard::Mode::Shared, ec) && openShards(ec);
+    }
+
+    /// @brief (Re)open the shards if the manifest names another generation (caller holds a lock)
+    bool openShards(std::error_code& ec) {
+        const detail::ShardManifest::Layout& layout = manifest_.layout();
+        if (!shards_.empty() && layout.generation == loadedGen_)
+            return true;
+        std::vector<std::unique_ptr<Shard>> opened;
+        if (!openSet(layout.generation, layout.shards, opened, ec))
+            return false;
+        shards_.swap(opened);
+        loadedGen_ = layout.generation;
+        return true;
+    }
+
+    bool openSet(uint64_t generation, size_t shards, std::vector<std::unique_ptr<Shard>>& out,
+                 std::error_code& ec) {
+        out.clear();
+        out.reserve(shards);
+        for (size_t i = 0; i < shards; ++i) {
+            auto shard = factory_(shardPath(path_, generation, i), ec);
+            if (!shard && !ec)
+                ec = std::make_error_code(std::errc::invalid_argument);
+            if (ec)
+                return false;
+            out.push_back(std::move(shard));
+        }
+        return true;
+    }
+
+    /// @brief Copy the records of shards_ into a new generation of `shards` shard files
+    bool copyInto(uint64_t generation, size_t shards, std::vector<std::unique_ptr<Shard>>& next,
+                  std::error_code& ec) {
+        if (!openSet(generation, shards, next, ec))
+            return false;
+        for (auto& source : shards_) {
+            auto records = source->findAll(ec);
+            if (ec)
+                return false;
+            std::vector<std::vector<const T*>> groups(shards);
+            for (const auto& r : records)
+                groups[shardOf(detail::shardKeyOf(*r), shards)].push_back(r.get());
+            for (size_t i = 0; i < shards; ++i) {
+                if (!groups[i].empty() && !next[i]->saveAll(groups[i], ec))
+                    return false;
+            }
+        }
+        // The copy must be durable before the manifest points at it
+        for (auto& shard : next) {
+            if (!shard->flush(ec))
+                return false;
+        }
+        return true;
+    }
+
+    /// @brief Delete every file of a generation (shards and their sidecars)
+    void removeGeneration(uint64_t generation) {
+        namespace fs = std::filesystem;
+        const fs::path base(path_);
+        const std::string prefix =
+            base.filename().string() + "." + std::to_string(generation) + ".";
+        const fs::path dir = base.parent_path().empty() ? fs::path(".") : base.parent_path();
+        std::error_code fec;
+        std::vector<fs::path> doomed;
+        for (fs::directory_iterator it(dir, fec), end; !fec && it != end; it.increment(fec)) {
+            const std::string name = it->path().filename().string();
+            if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+                name[prefix.size()] >= '0' && name[prefix.size()] <= '9')
+                doomed.push_back(it->path());
+        }
+        for (const auto& p : doomed)
+            fs::remove(p, fec);
+    }
+
+    /// @brief Run fn(i, ec) for every shard (in parallel with parallelFanOut)
+    /// @return false with the first shard's error, in shard order
+    template <typename Fn> bool forEachShard(Fn&& fn, std::error_code& ec) {
+        std::vector<std::error_code> errors(shards_.size());
+        auto run = [&](size_t i) { fn(i, errors[i]); };
+        if (options_.parallelFanOut) {
+            detail::runParallel(shards_.size(), run);
+        } else {
+            for (size_t i = 0; i < shards_.size(); ++i)
+                run(i);
+        }
+        for (const auto& e : errors) {
+            if (e) {
+                ec = e;
+                return false;
+            }
+        }
+        ec.clear();
+        return true;
+    }
+
+    std::string path_;
+    ShardFactory factory_;
+    ShardedRepositoryOptions options_;
+    detail::ShardManifest manifest_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    uint64_t loadedGen_ = 0; ///< Generation of shards_
+};
+
+} // namespace FdFile
@@ -2,20 +2,38 @@
 /// @file UniformFixedRepositoryImpl.hpp
 /// @brief Fixed-length record repository where all records have the same size (Template)
 
+#include "../record/RecordView.hpp"
+#include "../util/AsyncWriteQueue.hpp"
+#include "../util/ControlFile.hpp"
+#include "../util/FieldIndex.hpp"
 #include "../util/FileLockGuard.hpp"
+#include "../util/GroupCommitFlusher.hpp"
+#include "../util/IdIndexFile.hpp"
 #include "../util/MmapGuard.hpp"
+#include "../util/ParallelScan.hpp"
+#include "../util/ThreadGate.hpp"
 #include "../util/UniqueFd.hpp"
 #include "RecordRepository.hpp"
+#include "RepositoryOptions.hpp"
+#include "RepositoryStats.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fcntl.h>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace FdFile {
@@ -24,24 +42,66 @@ namespace FdFile {
 /// @tparam T Concrete record type (inherits from FixedRecordBase<T>)
 ///
 /// Features:
-/// - O(1) lookup via ID cache (on cache hit)
-/// - Automatic detection of external file modifications (mtime-based)
+/// - O(1) lookup via a compact ID hash index (16-byte buckets, IDs verified in the mapping)
+/// - Automatic detection of external file modifications (ns mtime and size). Through the
+///   control file, writes by other processes that removed no record only index the slots
+///   they filled. With FixedRepositoryOptions::controlFile the shared write generation also
+///   replaces the per-read fstat()
 /// - Concurrent access control via FileLock
+/// - Optional tombstone deletion with free-slot reuse (see FixedRepositoryOptions), announced
+///   to other processes through the control file
+/// - Chunked file growth; the mapping is reused until the file size changes. Inserts into
+///   preallocated slots keep the size, so they are announced through the control file
+/// - Configurable durability (Strict / Async / GroupCommit); Async and GroupCommit writes are
+///   announced through the control file
+/// - Zero-copy scans through RecordView (see readSession() / forEach())
+/// - Optional persistent sidecar ID index for O(1) open (FixedRepositoryOptions::persistentIndex)
+/// - Optional in-process reader/writer locking for instances shared between threads
+///   (FixedRepositoryOptions::threadSafe)
+/// - Optional background writer batching saveAsync()/deleteAsync() (asyncWrites)
+/// - Index rebuilds and findAll() split across threads (scanThreads), plus parallelForEach()
+/// - Operation latency histograms and cache counters with FDFILE_ENABLE_STATS (see stats())
+/// - Optional secondary hash and range indexes on record fields (fieldIndexes, findByField())
+/// - madvise access-pattern hints, prefaulting, huge pages and a pinned ID index (mapping)
+///
+/// @note Moving an instance with FixedRepositoryOptions::asyncWrites first applies every
+///       write queued on it; the moved-to instance starts its own writer thread.
 template <typename T> class UniformFixedRepositoryImpl : public RecordRepository<T> {
   public:
     /// @brief Constructor
     /// @param path File path for the repository
     /// @param ec Error code set on failure
-    UniformFixedRepositoryImpl(const std::string& path, std::error_code& ec) : path_(path) {
+    UniformFixedRepositoryImpl(const std::string& path, std::error_code& ec)
+        : UniformFixedRepositoryImpl(path, FixedRepositoryOptions{}, ec) {}
+
+    /// @brief Constructor with options
+    /// @param path File path for the repository
+    /// @param options Repository tuning options
+    /// @param ec Error code set on failure
+    UniformFixedRepositoryImpl(const std::string& path, const FixedRepositoryOptions& options,
+                               std::error_code& ec)
+        : path_(path), options_(options) {
         ec.clear();
+        if (options_.threadSafe || options_.asyncWrites)
+            gate_ = std::make_unique<detail::ThreadGate>();
 
         // 1. Calculate record size
-        T temp;
-        recordSize_ = temp.recordSize();
+        recordSize_ = layout_.recordSize();
+        typeOffset_ = layout_.typeOffset();
         if (recordSize_ == 0) {
             ec = std::make_error_code(std::errc::invalid_argument);
             return;
         }
+        // Secondary indexes must name a field; range indexes a numeric one
+        for (const auto& spec : options_.fieldIndexes) {
+            const size_t field = layout_.fieldIndex(spec.field);
+            const bool ordered = spec.kind == FieldIndexKind::Ordered;
+            if (field >= layout_.fieldCount() || (ordered && layout_.fieldIsString(field))) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return;
+            }
+            fieldIndexes_.emplace_back(field, !layout_.fieldIsString(field), ordered);
+        }
 
         // 2. Open file
         int flags = O_CREAT | O_RDWR;
@@ -54,7 +114,17 @@ template <typename T> class UniformFixedRepositoryImpl : public RecordRepository
             return;
         }
 
-        // 3. Initialize file size and mtime
+        // 3. Open the control file before the first fstat(): the cache below is current as of
+        //    the generation read here
+        if (sharesGeneration()) {
+            control_ = std::make_unique<detail::ControlFile>();
+            if (!control_->open(path_ + ".ctl", ec))
+                return;
+            knownGen_ = control_->generation();
+            knownLayout_ = control_->layoutGeneration();
+        }
+
+        // 4. Initialize file size and mtime
         struct stat st{};
         if (::fstat(fd_.get(), &st) < 0) {
             ec = std::error_code(errno, std::generic_category());
@@ -65,17 +135,40 @@ template <typename T> class UniformFixedRepositoryImpl : public RecordRepository
             return;
         }
 
-        lastMtime_ = st.st_mtime;
+        lastMtimeNs_ = detail::statMtimeNs(st);
         lastSize_ = st.st_size;
 
+        if (options_.persistentIndex) {
+            sidecar_ = std::make_unique<detail::IdIndexFile>();
+            sidecar_->setPinned(options_.mapping.lockIndex);
+            if (!sidecar_->open(path_ + ".idx", recordSize_, ec))
+                return;
+        }
+
         if (st.st_size > 0) {
             if (!remapFile(ec))
                 return;
-            rebuildCache(ec);
+        }
+        if (!loadIndex(st, ec))
+            return;
+
+        if (options_.durability == Durability::GroupCommit) {
+            flusher_ = std::make_unique<detail::GroupCommitFlusher>(
+                fd_.get(), options_.groupCommit.interval, options_.groupCommit.maxPendingWrites);
+        }
+        if (options_.asyncWrites) {
+            async_.enable(options_.asyncMaxBatch);
+            asyncQueue();
         }
     }
 
-    ~UniformFixedRepositoryImpl() = default;
+    /// @brief Destructor
+    /// @details Applies queued asynchronous writes, then stops the group-commit flusher
+    ///          (flushing pending writes) before the fd closes.
+    ~UniformFixedRepositoryImpl() {
+        async_.stop();
+        flusher_.reset();
+    }
 
     // Copy prohibited
     UniformFixedRepositoryImpl(const UniformFixedRepositoryImpl&) = delete;
@@ -85,84 +178,388 @@ template <typename T> class UniformFixedRepositoryImpl : public RecordRepository
     UniformFixedRepositoryImpl(UniformFixedRepositoryImpl&&) = default;
     UniformFixedRepositoryImpl& operator=(UniformFixedRepositoryImpl&&) = default;
 
-    // =========================================================================
-    // RecordRepository Interface Implementation
-    // =========================================================================
+  private:
+    /// @brief Locks held by a read: the file lock, plus one side of gate_ with threadSafe
+    struct ReadLock {
+        std::unique_lock<std::shared_mutex> exclusive;
+        detail::SharedGateLock shared; ///< Also stands for the shared file lock
+        detail::FileLockGuard file;
+    };
+
+    /// @brief Locks held by a write
+    struct WriteLock {
+        WriteLock() = default;
+        WriteLock(const WriteLock&) = delete;
+        WriteLock& operator=(const WriteLock&) = delete;
+        WriteLock(WriteLock&& other) noexcept
+            : exclusive(std::move(other.exclusive)), file(std::move(other.file)),
+              owner(std::exchange(other.owner, nullptr)) {}
+        WriteLock& operator=(WriteLock&& other) noexcept {
+            if (this != &other) {
+                release();
+                exclusive = std::move(other.exclusive);
+                file = std::move(other.file);
+                owner = std::exchange(other.owner, nullptr);
+            }
+            return *this;
+        }
+        ~WriteLock() { release(); }
+
+        /// @brief Announce the write to cooperating processes, then drop the locks
+        void release() noexcept {
+            if (owner)
+                owner->announceWrite();
+            owner = nullptr;
+            file.unlockIgnore();
+            if (exclusive.owns_lock())
+                exclusive.unlock();
+        }
 
-    bool save(const T& record, std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-        if (ec)
-            return false;
+        std::unique_lock<std::shared_mutex> exclusive; ///< Released after the file lock
+        detail::FileLockGuard file;
+        UniformFixedRepositoryImpl* owner = nullptr; ///< Set once the file lock is held
+    };
 
-        if (record.recordSize() != recordSize_) {
-            ec = std::make_error_code(std::errc::invalid_argument);
-            return false;
+  public:
+    class WriteSession;
+
+    /// @brief Shared-lock scope for zero-copy reads
+    /// @details Holds the shared file lock for its lifetime. Every RecordView handed out by
+    ///          the session points into the repository mapping and stays valid until the
+    ///          session is destroyed.
+    /// @note Do not call mutating repository methods while a session is alive: fcntl locks
+    ///       are per process, so they would convert and then release the session's lock,
+    ///       and growth or compaction may move the mapping. With threadSafe such a call
+    ///       blocks until the session ends (in the same thread: forever). Use upgrade().
+    class ReadSession {
+      public:
+        ReadSession() = default;
+        ReadSession(ReadSession&& other) noexcept
+            : repo_(std::exchange(other.repo_, nullptr)), lock_(std::move(other.lock_)) {}
+        ReadSession& operator=(ReadSession&& other) noexcept {
+            if (this != &other) {
+                repo_ = std::exchange(other.repo_, nullptr);
+                lock_ = std::move(other.lock_);
+            }
+            return *this;
         }
 
-        // Check for external modifications
-        if (!checkAndRefreshCache(ec))
-            return false;
+        /// @brief Whether the session holds the lock (false if readSession() failed)
+        bool valid() const noexcept { return repo_ != nullptr; }
 
-        auto idxOpt = findIdxByIdCached(record.getId());
+        /// @brief Visit every live record in slot order
+        /// @param fn Callable taking `const RecordView<T>&`; may return bool (false stops)
+        template <typename Fn> void forEach(Fn&& fn) const {
+            if (repo_)
+                repo_->scanLive(std::forward<Fn>(fn));
+        }
 
-        if (idxOpt) {
-            // Update
-            if (!remapFile(ec))
-                return false;
-            char* dst = static_cast<char*>(mmap_.data()) + (*idxOpt * recordSize_);
-            record.serialize(dst);
-            return mmap_.sync();
-        } else {
-            // Insert
-            struct stat st{};
-            ::fstat(fd_.get(), &st);
-            size_t newSize = st.st_size + recordSize_;
-            if (::ftruncate(fd_.get(), newSize) != 0) {
-                ec = std::error_code(errno, std::generic_category());
-                return false;
+        /// @brief Look up a record by ID without copying it
+        /// @return View of the record, or std::nullopt if not found
+        std::optional<RecordView<T>> findById(const std::string& id) const {
+            if (!repo_)
+                return std::nullopt;
+            auto idxOpt = repo_->findIdxByIdCached(id);
+            if (!idxOpt)
+                return std::nullopt;
+            return repo_->viewAt(*idxOpt);
+        }
+
+        /// @brief Whether a live record has the given ID
+        bool existsById(const std::string& id) const {
+            return repo_ && repo_->findIdxByIdCached(id).has_value();
+        }
+
+        /// @brief Number of live records
+        size_t count() const noexcept { return repo_ ? repo_->liveCount_ : 0; }
+
+        /// @brief Views of the records whose string field equals value, in slot order
+        /// @param ec Error code set if there is no hash index on the string field
+        std::vector<RecordView<T>> findByField(std::string_view field, std::string_view value,
+                                               std::error_code& ec) const {
+            return query([&](std::vector<size_t>& slots) {
+                return repo_->fieldSlots(field, value, slots, ec);
+            }, ec);
+        }
+
+        /// @brief Views of the records whose numeric field equals value, in slot order
+        /// @param ec Error code set if there is no index on the numeric field
+        std::vector<RecordView<T>> findByField(std::string_view field, int64_t value,
+                                               std::error_code& ec) const {
+            return query([&](std::vector<size_t>& slots) {
+                return repo_->fieldSlots(field, value, slots, ec);
+            }, ec);
+        }
+
+        /// @brief Views of the records whose numeric field lies in [lo, hi], in value order
+        /// @param ec Error code set if there is no FieldIndexKind::Ordered index on the field
+        std::vector<RecordView<T>> findInRange(std::string_view field, int64_t lo, int64_t hi,
+                                               std::error_code& ec) const {
+            return query([&](std::vector<size_t>& slots) {
+                return repo_->rangeSlots(field, lo, hi, slots, ec);
+            }, ec);
+        }
+
+        /// @brief Trade the shared lock for the exclusive one
+        /// @details Without threadSafe the file lock is converted in place, so no other
+        ///          process writes in between. With threadSafe the other reader threads have
+        ///          to leave first. Either way the cache is validated again. This session is
+        ///          released (also on failure) and its views are invalidated.
+        /// @param ec Error code set on failure (EDEADLK if another process upgrades too)
+        /// @return Write session; check valid() or ec
+        WriteSession upgrade(std::error_code& ec) {
+            ec.clear();
+            if (!repo_) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return {};
             }
-            if (!remapFile(ec))
-                return false;
+            ReadLock lock = std::move(lock_);
+            return std::exchange(repo_, nullptr)->upgradeLock(lock, ec);
+        }
 
-            char* dst = static_cast<char*>(mmap_.data()) + st.st_size;
-            record.serialize(dst);
+      private:
+        friend class UniformFixedRepositoryImpl;
+        ReadSession(UniformFixedRepositoryImpl* repo, ReadLock lock)
+            : repo_(repo), lock_(std::move(lock)) {}
 
-            // Update cache
-            size_t newIdx = st.st_size / recordSize_;
-            idCache_[record.getId()] = newIdx;
-            updateFileStats();
+        template <typename Query>
+        std::vector<RecordView<T>> query(Query&& slotsOf, std::error_code& ec) const {
+            ec.clear();
+            std::vector<size_t> slots;
+            if (!repo_) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return {};
+            }
+            if (!slotsOf(slots))
+                return {};
+            return repo_->viewsOf(slots);
+        }
 
-            return mmap_.sync();
+        UniformFixedRepositoryImpl* repo_ = nullptr;
+        ReadLock lock_;
+    };
+
+    /// @brief Exclusive-lock scope grouping several reads and writes
+    /// @details Locks and validates the cache once for any number of operations. Other
+    ///          processes see none of the session's writes until it ends, and Strict writes
+    ///          are made durable together by commit() (one flush instead of one per write).
+    ///          There is no rollback: writes that completed stay written.
+    /// @note Views handed out by forEach() are only valid until the next write in the session.
+    ///       The same restrictions on calling repository methods as for ReadSession apply.
+    class WriteSession {
+      public:
+        WriteSession() = default;
+        WriteSession(WriteSession&& other) noexcept
+            : repo_(std::exchange(other.repo_, nullptr)), lock_(std::move(other.lock_)) {}
+        WriteSession& operator=(WriteSession&& other) noexcept {
+            if (this != &other) {
+                std::error_code ignore;
+                commit(ignore);
+                repo_ = std::exchange(other.repo_, nullptr);
+                lock_ = std::move(other.lock_);
+            }
+            return *this;
+        }
+        /// @brief Commits (errors are ignored; call commit() to see them)
+        ~WriteSession() {
+            std::error_code ignore;
+            commit(ignore);
         }
-    }
 
-    bool saveAll(const std::vector<const T*>& records, std::error_code& ec) override {
-        for (const auto* r : records) {
-            if (!save(*r, ec))
-                return false;
+        /// @brief Whether the session holds the lock (false after commit() or a failed open)
+        bool valid() const noexcept { return repo_ != nullptr; }
+
+        bool save(const T& record, std::error_code& ec) {
+            return check(ec) && repo_->saveLocked(record, ec);
+        }
+        bool saveAll(const std::vector<const T*>& records, std::error_code& ec) {
+            return check(ec) && repo_->saveAllLocked(records, ec);
+        }
+        bool deleteById(const std::string& id, std::error_code& ec) {
+            return check(ec) && repo_->deleteLocked(id, ec);
+        }
+        bool deleteAll(std::error_code& ec) { return check(ec) && repo_->deleteAllLocked(ec); }
+        bool compact(std::error_code& ec) { return check(ec) && repo_->compactLocked(ec); }
+
+        std::unique_ptr<T> findById(const std::string& id, std::error_code& ec) const {
+            return check(ec) ? repo_->readById(id, ec) : nullptr;
+        }
+        bool existsById(const std::string& id) const {
+            return repo_ && repo_->findIdxByIdCached(id).has_value();
+        }
+        size_t count() const noexcept { return repo_ ? repo_->liveCount_ : 0; }
+
+        /// @brief Visit every live record in slot order
+        /// @param fn Callable taking `const RecordView<T>&`; may return bool (false stops)
+        template <typename Fn> void forEach(Fn&& fn) const {
+            if (repo_)
+                repo_->scanLive(std::forward<Fn>(fn));
+        }
+
+        /// @brief Make the session's writes durable and release the lock
+        /// @param ec Error code set if the flush failed
+        /// @return true on success (also for an invalid session)
+        bool commit(std::error_code& ec) {
+            ec.clear();
+            if (!repo_)
+                return true;
+            const bool ok = std::exchange(repo_, nullptr)->endWriteSession(ec);
+            lock_.release();
+            return ok;
+        }
+
+      private:
+        friend class UniformFixedRepositoryImpl;
+        WriteSession(UniformFixedRepositoryImpl* repo, WriteLock lock)
+            : repo_(repo), lock_(std::move(lock)) {}
+
+        bool check(std::error_code& ec) const {
+            ec.clear();
+            if (!repo_)
+                ec = std::make_error_code(std::errc::invalid_argument);
+            return repo_ != nullptr;
         }
+
+        UniformFixedRepositoryImpl* repo_ = nullptr;
+        WriteLock lock_;
+    };
+
+    /// @brief Open a read session (takes the shared lock and validates the cache once)
+    /// @param ec Error code set on failure
+    /// @return Session; check valid() or ec
+    ReadSession readSession(std::error_code& ec) {
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
+            return {};
+        return ReadSession(this, std::move(lock));
+    }
+
+    /// @brief Open a write session (takes the exclusive lock and validates the cache once)
+    /// @param ec Error code set on failure
+    /// @return Session; check valid() or ec
+    WriteSession writeSession(std::error_code& ec) {
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return {};
+        return startWriteSession(std::move(lock), ec);
+    }
+
+    /// @brief Visit every live record through a zero-copy view
+    /// @details The views are only valid inside the callback.
+    /// @param fn Callable taking `const RecordView<T>&`; may return bool (false stops)
+    /// @param ec Error code set on failure
+    /// @return true on success
+    template <typename Fn> bool forEach(Fn&& fn, std::error_code& ec) {
+        FDFILE_STATS_TIMER(stats_, FindAll);
+        ReadSession session = readSession(ec);
+        if (ec)
+            return false;
+        ScanHint hint(*this);
+        session.forEach(std::forward<Fn>(fn));
         return true;
     }
 
-    std::vector<std::unique_ptr<T>> findAll(std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
+    /// @brief forEach() on several threads at once, for analytic scans of large files
+    /// @details The slots are split into one contiguous range per thread; each thread visits
+    ///          its range in slot order while the shared lock is held. fn is called
+    ///          concurrently and must be thread-safe; returning false stops all threads soon
+    ///          after (records already being visited still complete).
+    /// @param fn Callable taking `const RecordView<T>&`; may return bool (false stops)
+    /// @param ec Error code set on failure
+    /// @param threads Threads to use (0: one per core); ranges are at least
+    ///        FixedRepositoryOptions::scanMinRecordsPerThread slots
+    /// @return true on success
+    template <typename Fn>
+    bool parallelForEach(Fn&& fn, std::error_code& ec, size_t threads = 0) {
+        FDFILE_STATS_TIMER(stats_, FindAll);
+        ReadSession session = readSession(ec);
         if (ec)
-            return {};
+            return false;
+        ScanHint hint(*this);
+        const size_t cnt = slotCount();
+        const size_t chunks =
+            detail::scanChunkCount(cnt, threads, options_.scanMinRecordsPerThread);
+        std::atomic<bool> stop{false};
+        detail::runParallel(chunks, [&](size_t c) {
+            scanRange(detail::chunkBegin(cnt, chunks, c), detail::chunkBegin(cnt, chunks, c + 1),
+                      [&](const RecordView<T>& view) {
+                          if (stop.load(std::memory_order_relaxed))
+                              return false;
+                          if constexpr (std::is_same_v<
+                                            std::invoke_result_t<Fn&, const RecordView<T>&>,
+                                            bool>) {
+                              if (!fn(view)) {
+                                  stop.store(true, std::memory_order_relaxed);
+                                  return false;
+                              }
+                          } else {
+                              fn(view);
+                          }
+                          return true;
+                      });
+        });
+        return true;
+    }
+
+    // =========================================================================
+    // RecordRepository Interface Implementation
+    // =========================================================================
+
+    bool save(const T& record, std::error_code& ec) override {
+        FDFILE_STATS_TIMER(stats_, Save);
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return false;
+
+        // Check for external modifications
+        if (!checkAndRefreshCache(ec))
+            return false;
+        return saveLocked(record, ec);
+    }
 
+    /// @brief Save multiple records as a single batch
+    /// @details Takes the exclusive lock once, grows the file once for all inserts, maps it
+    ///          once, serializes every record in place and syncs once.
+    ///          Duplicate IDs within the batch resolve to a single slot (last one wins),
+    ///          matching the result of calling save() sequentially.
+    ///          The ID cache is only updated after the whole batch has been written.
+    bool saveAll(const std::vector<const T*>& records, std::error_code& ec) override {
         ec.clear();
-        std::vector<std::unique_ptr<T>> res;
+        if (records.empty())
+            return true;
+
+        FDFILE_STATS_TIMER(stats_, SaveAll);
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return false;
 
+        // Check for external modifications
         if (!checkAndRefreshCache(ec))
-            return res;
+            return false;
+        return saveAllLocked(records, ec);
+    }
 
-        if (!remapFile(ec))
+    std::vector<std::unique_ptr<T>> findAll(std::error_code& ec) override {
+        FDFILE_STATS_TIMER(stats_, FindAll);
+        std::vector<std::unique_ptr<T>> res;
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
             return res;
 
+        ScanHint hint(*this);
         size_t cnt = slotCount();
+        res.reserve(liveCount_);
 
+        const size_t chunks = scanChunks(cnt);
+        if (chunks > 1) {
+            findAllParallel(cnt, chunks, res, ec);
+            return res;
+        }
         for (size_t i = 0; i < cnt; ++i) {
-            auto rec = std::make_unique<T>();
             const char* buf = static_cast<const char*>(mmap_.data()) + i * recordSize_;
+            if (!isLiveSlot(buf))
+                continue;
+            auto rec = std::make_unique<T>();
             if (rec->deserialize(buf, ec)) {
                 res.push_back(std::move(rec));
             } else {
@@ -174,176 +571,1111 @@ template <typename T> class UniformFixedRepositoryImpl : public RecordRepository
     }
 
     std::unique_ptr<T> findById(const std::string& id, std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
-        if (ec)
+        FDFILE_STATS_TIMER(stats_, FindById);
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
             return nullptr;
+        return readById(id, ec);
+    }
 
-        ec.clear();
+    bool deleteById(const std::string& id, std::error_code& ec) override {
+        FDFILE_STATS_TIMER(stats_, Delete);
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return false;
 
         if (!checkAndRefreshCache(ec))
-            return nullptr;
+            return false;
+        return deleteLocked(id, ec);
+    }
 
-        // O(1) cache lookup
-        auto idxOpt = findIdxByIdCached(id);
-        if (!idxOpt) {
-            return nullptr;
-        }
+    /// @brief Reclaim tombstoned slots
+    /// @details Moves live records down over free slots in runs, truncates the file and
+    ///          remaps cached indices without deserializing any record.
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool compact(std::error_code& ec) {
+        FDFILE_STATS_TIMER(stats_, Compact);
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return false;
 
-        if (!remapFile(ec))
-            return nullptr;
+        if (!checkAndRefreshCache(ec))
+            return false;
 
-        size_t idx = *idxOpt;
-        const char* buf = static_cast<const char*>(mmap_.data()) + idx * recordSize_;
+        return compactLocked(ec);
+    }
 
-        T temp;
-        if (temp.deserialize(buf, ec)) {
-            return std::make_unique<T>(temp);
-        }
-        return nullptr;
+    /// @brief Ticket of the most recent write (0 if nothing was written)
+    /// @details Pass to waitDurable() to wait until that write is on stable storage.
+    uint64_t lastWriteTicket() const {
+        if (flusher_)
+            return flusher_->lastTicket();
+        std::shared_lock<std::shared_mutex> shared;
+        if (gate_)
+            shared = gate_->lockShared();
+        return writeSeq_;
     }
 
-    bool deleteById(const std::string& id, std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-        if (ec)
-            return false;
+    /// @brief Block until the write identified by ticket is durable
+    /// @details Strict writes are durable on return. Async writes are flushed by this call.
+    ///          GroupCommit waits for the flusher thread (and wakes it early).
+    /// @param ticket Ticket from lastWriteTicket()
+    /// @param ec Error code set if the flush failed
+    /// @return true once durable
+    bool waitDurable(uint64_t ticket, std::error_code& ec) {
+        ec.clear();
+        if (flusher_)
+            return flusher_->waitDurable(ticket, ec);
+        std::unique_lock<std::shared_mutex> exclusive;
+        if (gate_)
+            exclusive = gate_->lockExclusive();
+        if (durableSeq_ >= ticket)
+            return true;
+        return flushData(ec);
+    }
 
-        if (!checkAndRefreshCache(ec))
-            return false;
+    /// @brief Make every write performed so far durable
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool flush(std::error_code& ec) {
+        ec.clear();
+        if (flusher_)
+            return flusher_->waitDurable(flusher_->lastTicket(), ec);
+        std::unique_lock<std::shared_mutex> exclusive;
+        if (gate_)
+            exclusive = gate_->lockExclusive();
+        return flushData(ec);
+    }
 
-        auto idxOpt = findIdxByIdCached(id);
-        if (!idxOpt)
-            return true; // not found
+    /// @brief Completion callback of saveAsync()/deleteAsync()
+    using AsyncCallback = std::function<void(const std::error_code&)>;
+
+    /// @brief Queue save() of a copy of record on the background writer
+    /// @details The result is what save() would have returned, available once the batch
+    ///          holding the write is committed (durable for Durability::Strict). Operations
+    ///          are applied in submission order. Without asyncWrites the record is saved
+    ///          before this returns.
+    /// @param record Record to save (copied)
+    /// @return Future of the error code (empty on success)
+    std::future<std::error_code> saveAsync(const T& record) {
+        auto promise = std::make_shared<std::promise<std::error_code>>();
+        std::future<std::error_code> result = promise->get_future();
+        saveAsync(record, [promise](const std::error_code& ec) { promise->set_value(ec); });
+        return result;
+    }
 
-        size_t idx = *idxOpt;
-        size_t cnt = slotCount();
+    /// @brief saveAsync() reporting to a callback
+    /// @param record Record to save (copied)
+    /// @param done Called with the result on the writer thread (on the caller's thread
+    ///        without asyncWrites). Must not wait for later asynchronous writes.
+    void saveAsync(const T& record, AsyncCallback done) {
+        auto copy = std::make_shared<T>(record);
+        submitAsync([copy](WriteSession& s, std::error_code& ec) { return s.save(*copy, ec); },
+                    std::move(done));
+    }
 
-        // Simple Shift (O(N) data move)
-        char* base = static_cast<char*>(mmap_.data());
-        char* dst = base + idx * recordSize_;
-        char* src = dst + recordSize_;
-        size_t moveBytes = (cnt - 1 - idx) * recordSize_;
-        if (moveBytes > 0) {
-            std::memmove(dst, src, moveBytes);
-        }
+    /// @brief Queue deleteById() on the background writer (see saveAsync())
+    /// @param id ID of the record to remove
+    /// @return Future of the error code (empty on success, including a missing ID)
+    std::future<std::error_code> deleteAsync(const std::string& id) {
+        auto promise = std::make_shared<std::promise<std::error_code>>();
+        std::future<std::error_code> result = promise->get_future();
+        deleteAsync(id, [promise](const std::error_code& ec) { promise->set_value(ec); });
+        return result;
+    }
 
-        size_t newSize = (cnt - 1) * recordSize_;
-        mmap_.reset();
-        if (::ftruncate(fd_.get(), newSize) != 0) {
-            ec = std::error_code(errno, std::generic_category());
-            return false;
-        }
+    /// @brief deleteAsync() reporting to a callback (see saveAsync())
+    void deleteAsync(const std::string& id, AsyncCallback done) {
+        submitAsync([id](WriteSession& s, std::error_code& ec) { return s.deleteById(id, ec); },
+                    std::move(done));
+    }
 
-        // Rebuild entire cache since indices shifted
-        rebuildCache(ec);
-        return true;
+    /// @brief Block until every asynchronous write submitted so far has completed
+    void drainAsync() {
+        if (AsyncQueue* queue = async_.current())
+            queue->drain();
     }
 
-    bool deleteAll(std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-        if (ec)
-            return false;
+    /// @brief Snapshot of the operation latencies and cache counters
+    /// @details Empty (enabled == false) unless built with FDFILE_ENABLE_STATS.
+    RepositoryStats stats() const {
+#if defined(FDFILE_ENABLE_STATS)
+        return stats_.snapshot();
+#else
+        return RepositoryStats();
+#endif
+    }
 
-        mmap_.reset();
-        if (::ftruncate(fd_.get(), 0) != 0) {
-            ec = std::error_code(errno, std::generic_category());
-            return false;
-        }
+    /// @brief Zero the statistics
+    void resetStats() {
+#if defined(FDFILE_ENABLE_STATS)
+        stats_.reset();
+#endif
+    }
 
-        // Clear cache
-        idCache_.clear();
-        updateFileStats();
-        return true;
+    /// @brief Install a hook called with every timed operation (see StatsHook)
+    /// @details Set it before the repository is shared between threads. Ignored unless built
+    ///          with FDFILE_ENABLE_STATS.
+    void setStatsHook(StatsHook hook) {
+#if defined(FDFILE_ENABLE_STATS)
+        stats_.setHook(std::move(hook));
+#else
+        (void)hook;
+#endif
     }
 
-    size_t count(std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
-        if (ec)
-            return 0;
+    /// @brief Whether the persistent ID index is pinned in memory (MappingOptions::lockIndex)
+    /// @details false without persistentIndex, or when mlock failed (e.g. RLIMIT_MEMLOCK).
+    bool indexPinned() const {
+        std::shared_lock<std::shared_mutex> shared;
+        if (gate_)
+            shared = gate_->lockShared();
+        return sidecar_ && sidecar_->pinned();
+    }
 
-        if (!checkAndRefreshCache(ec))
-            return 0;
+    bool deleteAll(std::error_code& ec) override {
+        WriteLock lock;
+        if (!lockForWrite(lock, ec))
+            return false;
+        return deleteAllLocked(ec);
+    }
 
-        if (!remapFile(ec))
+    size_t count(std::error_code& ec) override {
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
             return 0;
-        return slotCount();
+
+        return liveCount_;
     }
 
     bool existsById(const std::string& id, std::error_code& ec) override {
-        detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
-        if (ec)
-            return false;
-
-        if (!checkAndRefreshCache(ec))
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
             return false;
 
         return findIdxByIdCached(id).has_value();
     }
 
-  private:
-    /// @brief Detect file mtime/size changes and refresh cache
-    bool checkAndRefreshCache(std::error_code& ec) {
-        struct stat st{};
-        if (::fstat(fd_.get(), &st) < 0) {
-            ec = std::error_code(errno, std::generic_category());
-            return false;
-        }
-
-        // Detect external modifications
-        if (st.st_mtime != lastMtime_ || static_cast<size_t>(st.st_size) != lastSize_) {
-            // File size not divisible by record size means corrupt
-            if (st.st_size > 0 && (static_cast<size_t>(st.st_size) % recordSize_) != 0) {
-                ec = std::make_error_code(std::errc::invalid_argument);
-                return false;
-            }
+    // =========================================================================
+    // Secondary Index Queries (FixedRepositoryOptions::fieldIndexes)
+    // =========================================================================
 
-            if (!remapFile(ec))
-                return false;
+    /// @brief Records whose string field equals value, in slot order
+    /// @details Only the matching records are deserialized. Use ReadSession::findByField()
+    ///          for views instead of copies.
+    /// @param field Field key with a FieldIndexKind::Hash index
+    /// @param value Value to match (compared without zero padding)
+    /// @param ec Error code set on failure (invalid_argument if the field has no such index)
+    std::vector<std::unique_ptr<T>> findByField(std::string_view field, std::string_view value,
+                                                std::error_code& ec) {
+        return findIndexed([&](std::vector<size_t>& slots, std::error_code& qec) {
+            return fieldSlots(field, value, slots, qec);
+        }, ec);
+    }
 
-            rebuildCache(ec);
-            if (ec)
-                return false;
+    /// @brief Records whose numeric field equals value, in slot order
+    /// @param field Field key with a Hash or Ordered index
+    std::vector<std::unique_ptr<T>> findByField(std::string_view field, int64_t value,
+                                                std::error_code& ec) {
+        return findIndexed([&](std::vector<size_t>& slots, std::error_code& qec) {
+            return fieldSlots(field, value, slots, qec);
+        }, ec);
+    }
 
-            lastMtime_ = st.st_mtime;
-            lastSize_ = st.st_size;
-        }
-        return true;
+    /// @brief Records whose numeric field lies in [lo, hi], ordered by value (then slot)
+    /// @param field Field key with a FieldIndexKind::Ordered index
+    std::vector<std::unique_ptr<T>> findInRange(std::string_view field, int64_t lo, int64_t hi,
+                                                std::error_code& ec) {
+        return findIndexed([&](std::vector<size_t>& slots, std::error_code& qec) {
+            return rangeSlots(field, lo, hi, slots, qec);
+        }, ec);
     }
 
-    /// @brief Rebuild entire cache
-    void rebuildCache(std::error_code& ec) {
-        idCache_.clear();
+  private:
+    using AsyncQueue = detail::AsyncWriteQueue<WriteSession>;
+
+    /// @brief Writer queue bound to this object (nullptr without asyncWrites)
+    AsyncQueue* asyncQueue() {
+        return async_.get([this](std::error_code& oec) { return writeSession(oec); });
+    }
+
+    /// @brief Queue op, or run it in a session of its own without asyncWrites
+    void submitAsync(typename AsyncQueue::Apply op, AsyncCallback done) {
+        if (AsyncQueue* queue = asyncQueue()) {
+            queue->submit(std::move(op), std::move(done));
+            return;
+        }
+        std::error_code ec;
+        WriteSession session = writeSession(ec);
+        if (!ec)
+            op(session, ec);
+        std::error_code cec;
+        if (!session.commit(cec) && !ec)
+            ec = cec;
+        if (done)
+            done(ec);
+    }
+
+    /// @brief save() body (caller holds the exclusive lock on a current cache)
+    bool saveLocked(const T& record, std::error_code& ec) {
+        ec.clear();
+        if (record.recordSize() != recordSize_) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+
+        auto idxOpt = findIdxByIdCached(record.getId());
+
+        beginIndexWrite();
+        if (idxOpt) {
+            // Update (mapping is current after checkAndRefreshCache)
+            char* dst = mmap_.data() + (*idxOpt * recordSize_);
+            fieldIndexRemove(*idxOpt);
+            record.serialize(dst);
+            fieldIndexAdd(*idxOpt);
+            updateFileStats();
+            return commitSlots(*idxOpt, 1, ec);
+        }
+
+        if (!reserveIndex(1, ec))
+            return false;
+        ensureFreeSlots();
+        if (freeSlots_.empty()) {
+            // Grow by one chunk; slots past the new record become free slots
+            const size_t oldCount = slotCount();
+            const size_t newCount = oldCount + std::max<size_t>(options_.growChunkRecords, 1);
+            if (!growFile(oldCount, newCount, ec))
+                return false;
+            for (size_t i = oldCount; i < newCount; ++i)
+                pushFreeSlot(i);
+        }
+
+        // Insert into the lowest free slot
+        size_t idx = freeSlots_.front();
+        char* dst = mmap_.data() + (idx * recordSize_);
+        if (dst[typeOffset_] == FIXED_TOMBSTONE_MARK)
+            --tombstones_;
+        record.serialize(dst);
+        popFreeSlot();
+
+        // Update cache
+        indexPut(record.getId(), idx);
+        fieldIndexAdd(idx);
+        ++liveCount_;
+        updateFileStats();
+
+        return commitSlots(idx, 1, ec);
+    }
+
+    /// @brief saveAll() body (caller holds the exclusive lock on a current cache)
+    bool saveAllLocked(const std::vector<const T*>& records, std::error_code& ec) {
+        ec.clear();
+        if (records.empty())
+            return true;
+
+        for (const auto* r : records) {
+            if (!r || r->recordSize() != recordSize_) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+        }
+
+        beginIndexWrite();
+        ensureFreeSlots();
+
+        // 1. Split batch into updates (existing slots) and inserts (free or new slots)
+        const size_t oldCount = lastSize_ / recordSize_;
+        size_t newCount = oldCount;
+        std::vector<size_t> reused; // Free slots taken, lowest first (returned on failure)
+        std::unordered_map<std::string, size_t> staged; // Insert ID -> new slot
+        std::vector<std::pair<size_t, const T*>> writes;
+        std::vector<size_t> updated; // Existing slots to re-index (field indexes only)
+        writes.reserve(records.size());
+
+        for (const auto* r : records) {
+            std::string id = r->getId();
+            if (auto idxOpt = findIdxByIdCached(id)) {
+                writes.emplace_back(*idxOpt, r);
+                if (!fieldIndexes_.empty())
+                    updated.push_back(*idxOpt);
+                continue;
+            }
+            auto it = staged.find(id);
+            if (it != staged.end()) {
+                writes.emplace_back(it->second, r);
+                continue;
+            }
+            size_t slot = newCount;
+            if (freeSlots_.empty())
+                ++newCount;
+            else
+                reused.push_back(slot = popFreeSlot());
+            staged.emplace(std::move(id), slot);
+            writes.emplace_back(slot, r);
+        }
+        auto returnReused = [&] {
+            for (size_t slot : reused)
+                pushFreeSlot(slot);
+        };
+
+        if (!reserveIndex(staged.size(), ec)) {
+            returnReused();
+            return false;
+        }
+
+        // 2. Grow file once (rounded up to a whole chunk) and map once
+        size_t capacity = oldCount;
+        if (newCount != oldCount) {
+            capacity = oldCount + std::max(newCount - oldCount, options_.growChunkRecords);
+            if (!growFile(oldCount, capacity, ec)) {
+                returnReused();
+                return false;
+            }
+        }
+
+        // 3. Serialize every record in place
+        char* base = mmap_.data();
+        size_t reusedTombstones = 0;
+        for (size_t slot : reused) {
+            if (base[slot * recordSize_ + typeOffset_] == FIXED_TOMBSTONE_MARK)
+                ++reusedTombstones;
+        }
+        std::sort(updated.begin(), updated.end());
+        updated.erase(std::unique(updated.begin(), updated.end()), updated.end());
+        for (size_t slot : updated)
+            fieldIndexRemove(slot);
+        for (const auto& w : writes) {
+            if (!w.second->serialize(base + w.first * recordSize_)) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                rollbackGrow(oldCount, capacity);
+                returnReused();
+                rebuildFieldIndexes(); // Updates before the failure are in the file
+                return false;
+            }
+        }
+
+        // 4. Commit cache once the batch is fully serialized (like save(), before the sync:
+        //    the mapping already holds every record, whether or not the sync succeeds)
+        tombstones_ -= reusedTombstones;
+        for (size_t i = newCount; i < capacity; ++i)
+            pushFreeSlot(i);
+        for (auto& s : staged) {
+            indexPut(s.first, s.second);
+            fieldIndexAdd(s.second);
+        }
+        for (size_t slot : updated)
+            fieldIndexAdd(slot);
+        liveCount_ += staged.size();
+        updateFileStats();
+
+        // 5. Single sync covering every written slot
+        size_t lo = writes.front().first, hi = lo;
+        for (const auto& w : writes) {
+            lo = std::min(lo, w.first);
+            hi = std::max(hi, w.first);
+        }
+        return commitSlots(lo, hi - lo + 1, ec);
+    }
+
+    /// @brief Copy of the record with the given ID (caller holds a lock on a current cache)
+    std::unique_ptr<T> readById(const std::string& id, std::error_code& ec) const {
+        // O(1) cache lookup
+        auto idxOpt = findIdxByIdCached(id);
+        if (!idxOpt) {
+            return nullptr;
+        }
+
+        size_t idx = *idxOpt;
+        const char* buf = static_cast<const char*>(mmap_.data()) + idx * recordSize_;
+
+        // Deserialize straight into the returned object (no temporary copy)
+        auto rec = std::make_unique<T>();
+        if (rec->deserialize(buf, ec)) {
+            return rec;
+        }
+        return nullptr;
+    }
+
+    /// @brief deleteById() body (caller holds the exclusive lock on a current cache)
+    bool deleteLocked(const std::string& id, std::error_code& ec) {
+        ec.clear();
+        auto idxOpt = findIdxByIdCached(id);
+        if (!idxOpt)
+            return true; // not found
+
+        size_t idx = *idxOpt;
+        char* base = static_cast<char*>(mmap_.data());
+
+        // Drop the index entry while the slot still holds the ID (sidecar matches on it)
+        beginIndexWrite();
+        indexErase(id);
+        fieldIndexRemove(idx);
+        --liveCount_;
+        noteLayoutChange();
+
+        if (options_.deleteMode == DeleteMode::Tombstone) {
+            // O(1): mark slot free, other cache entries stay valid
+            char* slot = base + idx * recordSize_;
+            slot[typeOffset_] = FIXED_TOMBSTONE_MARK;
+            if (!commitSlots(idx, 1, ec))
+                return false;
+            if (freeSlotsKnown_)
+                pushFreeSlot(idx);
+            ++tombstones_;
+            updateFileStats();
+
+            if (options_.compactThreshold > 0.0 &&
+                static_cast<double>(tombstones_) >=
+                    options_.compactThreshold * static_cast<double>(slotCount())) {
+                return compactLocked(ec);
+            }
+            return true;
+        }
+
+        size_t cnt = slotCount();
+
+        // Simple Shift (O(N) data move)
+        char* dst = base + idx * recordSize_;
+        char* src = dst + recordSize_;
+        size_t moveBytes = (cnt - 1 - idx) * recordSize_;
+        if (moveBytes > 0) {
+            std::memmove(dst, src, moveBytes);
+            if (!commitSlots(idx, cnt - 1 - idx, ec))
+                return false;
+        }
+
+        size_t newSize = (cnt - 1) * recordSize_;
+        mmap_.reset();
+        if (::ftruncate(fd_.get(), newSize) != 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (!remapFile(ec))
+            return false;
+
+        // Shift cached indices instead of re-parsing every record
+        indexShiftAbove(idx);
+        for (auto& f : freeSlots_) {
+            if (f > idx)
+                --f;
+        }
+        rebuildFieldIndexes();
+        updateFileStats();
+        return true;
+    }
+
+    /// @brief deleteAll() body (caller holds the exclusive lock)
+    bool deleteAllLocked(std::error_code& ec) {
+        ec.clear();
+        mmap_.reset();
+        if (::ftruncate(fd_.get(), 0) != 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+
+        // Clear cache
+        beginIndexWrite();
+        noteLayoutChange();
+        if (!resetIndex(0, ec))
+            return false;
+        freeSlots_.clear();
+        freeSlotsKnown_ = true;
+        tombstones_ = 0;
+        liveCount_ = 0;
+        clearFieldIndexes();
+        updateFileStats();
+        if (flusher_)
+            flusher_->noteWrite();
+        else
+            ++writeSeq_;
+        return true;
+    }
+
+    /// @brief flush() without a flusher thread (caller holds the exclusive side of gate_)
+    bool flushData(std::error_code& ec) {
+        FDFILE_STATS_TIMER(stats_, Sync);
+        if (mmap_ && !mmap_.sync()) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (!detail::syncFileData(fd_.get(), ec))
+            return false;
+        durableSeq_ = writeSeq_;
+        return true;
+    }
+
+    /// @brief Validate the cache under a freshly taken write lock and open a session on it
+    WriteSession startWriteSession(WriteLock lock, std::error_code& ec) {
+        if (!checkAndRefreshCache(ec))
+            return {};
+        inWriteSession_ = true;
+        return WriteSession(this, std::move(lock));
+    }
+
+    /// @brief Exchange a read session's locks for a write session
+    WriteSession upgradeLock(ReadLock& from, std::error_code& ec) {
+        WriteLock lock;
+        from.shared.unlock(); // Other reader threads have to leave before gate_ is exclusive
+        if (gate_)
+            lock.exclusive = from.exclusive ? std::move(from.exclusive) : gate_->lockExclusive();
+        if (from.file.locked()) {
+            // This thread holds the process's only shared lock: convert it in place
+            if (!from.file.convert(detail::FileLockGuard::Mode::Exclusive, ec))
+                return {};
+            lock.file = std::move(from.file);
+        } else if (!lockFile(lock.file, detail::FileLockGuard::Mode::Exclusive, ec)) {
+            return {};
+        }
+        lock.owner = this;
+        return startWriteSession(std::move(lock), ec);
+    }
+
+    /// @brief Flush what the ending write session deferred (it still holds its locks)
+    bool endWriteSession(std::error_code& ec) {
+        inWriteSession_ = false;
+        if (!sessionUnsynced_)
+            return true;
+        sessionUnsynced_ = false;
+        return flushData(ec);
+    }
+
+    /// @brief Detect file mtime/size changes and refresh cache
+    bool checkAndRefreshCache(std::error_code& ec) {
+        // Loaded before the check: a cooperating write after this point changes it again
+        std::optional<uint64_t> gen;
+        std::optional<uint64_t> layout;
+        bool foreign = false;
+        if (control_) {
+            gen = control_->generation();
+            layout = control_->layoutGeneration();
+            if (gen == knownGen_ && options_.controlFile) {
+                FDFILE_STATS_COUNT(stats_, CacheHits);
+                return true; // No cooperating process wrote since the last check
+            }
+            foreign = foreignWrite(*gen);
+        }
+
+        struct stat st{};
+        if (::fstat(fd_.get(), &st) < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+
+        // A write by another process need not change size or mtime (a filled preallocated
+        // slot, or any store to a page that is still dirty), so its generation decides
+        if (!foreign && !fileChanged(st)) {
+            FDFILE_STATS_COUNT(stats_, CacheHits);
+        } else {
+            // File size not divisible by record size means corrupt
+            if (st.st_size > 0 && (static_cast<size_t>(st.st_size) % recordSize_) != 0) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+
+            const size_t oldCount = lastSize_ / recordSize_;
+            if (!remapFile(ec))
+                return false;
+
+            if (foreign && layout == knownLayout_ && canIndexTail(oldCount)) {
+                // No record left its slot: index the filled free slots and the appended ones
+                FDFILE_STATS_COUNT(stats_, TailLoads);
+                if (!indexTail(oldCount, ec))
+                    return false;
+            } else {
+                // Another indexed process may have kept the sidecar current
+                if (sidecar_ && !sidecar_->refresh(ec))
+                    return false;
+                if (!loadIndex(st, ec))
+                    return false;
+                knownLayout_ = layout;
+            }
+
+            lastMtimeNs_ = detail::statMtimeNs(st);
+            lastSize_ = st.st_size;
+        }
+        knownGen_ = gen;
+        return true;
+    }
+
+    /// @brief Bump the layout generation for a write that removes records from their slots
+    /// @details Call under the exclusive lock. Our own cache follows the change, so it stays
+    ///          current for the new value if it was current for the old one.
+    void noteLayoutChange() noexcept {
+        if (!control_)
+            return;
+        const uint64_t layout = control_->bumpLayout();
+        if (knownLayout_ && *knownLayout_ + 1 == layout)
+            knownLayout_ = layout;
+    }
+
+    /// @brief Whether another process wrote since the cache was last checked
+    /// @param gen Current control file generation
+    bool foreignWrite(uint64_t gen) const { return gen != knownGen_ && gen != ownGen_; }
+
+    /// @brief Bump the control file generation for a write this instance made
+    /// @details Called while the exclusive lock is still held. If the cache was current just
+    ///          before, the new generation is recorded as our own, so the next check only has
+    ///          to confirm size and mtime instead of rebuilding.
+    void announceWrite() noexcept {
+        if (!control_)
+            return;
+        const uint64_t gen = control_->bump();
+        if (knownGen_ && *knownGen_ + 1 == gen)
+            ownGen_ = gen;
+    }
+
+    /// @brief Whether change detection needs the control file generation
+    /// @details Inserts into preallocated slots, tombstone deletes and the reuse of tombstoned
+    ///          slots keep the file size, and the mtime alone does not reliably reveal them to
+    ///          other processes. Without a per-write msync(MS_SYNC) (Async, GroupCommit) even
+    ///          an in-place update leaves the mtime alone once its page is dirty.
+    bool sharesGeneration() const {
+        return options_.controlFile || options_.growChunkRecords > 1 ||
+               options_.deleteMode == DeleteMode::Tombstone ||
+               options_.durability != Durability::Strict;
+    }
+
+    /// @brief Whether the file differs from the state the cache was built for
+    bool fileChanged(const struct stat& st) const {
+        // Detect external modifications; the ns mtime also catches same-second rewrites.
+        // A sidecar left dirty by a failed write is stale.
+        if (detail::statMtimeNs(st) != lastMtimeNs_ || static_cast<size_t>(st.st_size) != lastSize_)
+            return true;
+        return sidecar_ && !sidecar_->matches(st);
+    }
+
+    /// @brief Take the locks for a read and make the cache current
+    /// @details With threadSafe, readers share gate_ while the cache is current. A reader that
+    ///          finds it stale retries under the exclusive side, which may refresh it.
+    bool lockForRead(ReadLock& lock, std::error_code& ec) {
+        ec.clear();
+        if (gate_) {
+            if (lock.shared.lock(*gate_, fd_.get(), ec) && cacheIsCurrent()) {
+                FDFILE_STATS_COUNT(stats_, CacheHits);
+                return true;
+            }
+            lock.shared.unlock();
+            if (ec)
+                return false;
+            lock.exclusive = gate_->lockExclusive();
+        }
+        if (!lockFile(lock.file, detail::FileLockGuard::Mode::Shared, ec))
+            return false;
+        return checkAndRefreshCache(ec);
+    }
+
+    /// @brief Take the fcntl lock on fd_ (timed as StatOp::LockWait)
+    bool lockFile(detail::FileLockGuard& guard, detail::FileLockGuard::Mode mode,
+                  std::error_code& ec) {
+        FDFILE_STATS_TIMER(stats_, LockWait);
+        return guard.lock(fd_.get(), mode, ec);
+    }
+
+    /// @brief Whether checkAndRefreshCache() would find nothing to do (no state is touched)
+    bool cacheIsCurrent() const {
+        if (control_) {
+            const uint64_t gen = control_->generation();
+            if (gen == knownGen_ && options_.controlFile)
+                return true;
+            if (foreignWrite(gen))
+                return false;
+        }
+        struct stat st{};
+        return ::fstat(fd_.get(), &st) == 0 && !fileChanged(st);
+    }
+
+    /// @brief Take the locks for a write (the caller refreshes the cache)
+    bool lockForWrite(WriteLock& lock, std::error_code& ec) {
+        if (gate_)
+            lock.exclusive = gate_->lockExclusive();
+        if (!lockFile(lock.file, detail::FileLockGuard::Mode::Exclusive, ec))
+            return false;
+        lock.owner = this;
+        return true;
+    }
+
+    /// @brief Whether the cache can be refreshed by indexTail() instead of a full rebuild
+    /// @details The caller has established through the layout generation that no record left
+    ///          its slot. Field values may still have changed in place and the sidecar is kept
+    ///          by whichever process wrote, so both need the full path.
+    bool canIndexTail(size_t oldCount) const {
+        return !sidecar_ && fieldIndexes_.empty() && freeSlotsKnown_ &&
+               slotCount() >= oldCount;
+    }
+
+    /// @brief Index the records other processes put into free slots or appended after `from`
+    /// @details Every slot that was live at the last index still holds the same record, so only
+    ///          the known free slots and the slots past the old end need to be looked at.
+    bool indexTail(size_t from, std::error_code& ec) {
+        const size_t cnt = slotCount();
+        if (!reserveIndex(freeSlots_.size() + (cnt - from), ec))
+            return false;
+        std::vector<size_t> stillFree;
+        size_t tombstones = 0;
+        T temp;
+        auto visit = [&](size_t i) {
+            const char* buf = mmap_.data() + i * recordSize_;
+            if (!isLiveSlot(buf)) {
+                if (buf[typeOffset_] == FIXED_TOMBSTONE_MARK)
+                    ++tombstones;
+                stillFree.push_back(i);
+                return true;
+            }
+            if (!temp.deserialize(buf, ec))
+                return false;
+            indexPut(temp.getId(), i);
+            ++liveCount_;
+            return true;
+        };
+
+        bool ok = true;
+        for (auto it = freeSlots_.begin(); ok && it != freeSlots_.end(); ++it)
+            ok = visit(*it);
+        for (size_t i = from; ok && i < cnt; ++i)
+            ok = visit(i);
+        if (!ok) {
+            // Same outcome as a failed full rebuild; retried in full on next access
+            index().clear();
+            freeSlots_.clear();
+            liveCount_ = 0;
+            knownLayout_.reset();
+            return false;
+        }
+        std::make_heap(stillFree.begin(), stillFree.end(), std::greater<size_t>());
+        freeSlots_.swap(stillFree);
+        tombstones_ = tombstones;
+        ec.clear();
+        return true;
+    }
+
+    /// @brief Populate the ID index and the field indexes for the current mapping
+    bool loadIndex(const struct stat& st, std::error_code& ec) {
+        FDFILE_STATS_COUNT(stats_, Reloads);
+        if (!loadIdIndex(st, ec)) {
+            clearFieldIndexes();
+            return false;
+        }
+        rebuildFieldIndexes();
+        return true;
+    }
+
+    /// @brief Populate the ID index for the current mapping
+    /// @details Adopts the sidecar when it describes `st`, otherwise rebuilds.
+    bool loadIdIndex(const struct stat& st, std::error_code& ec) {
+        if (!sidecar_) {
+            rebuildCache(ec);
+            return !ec;
+        }
+        if (sidecar_->matches(st)) {
+            adoptSidecar();
+            return true;
+        }
+        return rebuildSidecar(ec);
+    }
+
+    /// @brief Rebuild entire cache
+    void rebuildCache(std::error_code& ec) {
+        ScanHint hint(*this);
+        freeSlots_.clear();
+        tombstones_ = 0;
+        liveCount_ = 0;
 
         size_t cnt = slotCount();
+        if (!resetIndex(cnt, ec))
+            return;
+        const size_t chunks = scanChunks(cnt);
+        if (chunks > 1) {
+            rebuildParallel(cnt, chunks, ec);
+            return;
+        }
         T temp;
 
         for (size_t i = 0; i < cnt; ++i) {
             const char* buf = static_cast<const char*>(mmap_.data()) + i * recordSize_;
+            if (!isLiveSlot(buf)) {
+                if (buf[typeOffset_] == FIXED_TOMBSTONE_MARK)
+                    ++tombstones_;
+                freeSlots_.push_back(i);
+                continue;
+            }
             if (temp.deserialize(buf, ec)) {
-                idCache_[temp.getId()] = i;
+                indexPut(temp.getId(), i);
+                ++liveCount_;
             } else {
                 // On deserialize failure, return error
-                idCache_.clear();
+                index().clear();
+                freeSlots_.clear();
+                liveCount_ = 0;
+                knownLayout_.reset();
                 return;
             }
         }
+        // Ascending order is already a min-heap (see pushFreeSlot())
+        freeSlotsKnown_ = true;
         ec.clear();
     }
 
-    /// @brief O(1) ID lookup via cache
-    std::optional<size_t> findIdxByIdCached(const std::string& id) {
-        auto it = idCache_.find(id);
-        if (it != idCache_.end()) {
-            return it->second;
+    /// @brief What one range of a parallel rebuild found
+    struct SlotScan {
+        std::vector<std::pair<uint64_t, size_t>> live; ///< keyHash() and slot of each record
+        std::vector<size_t> free;                      ///< Ascending
+        size_t tombstones = 0;
+        std::error_code ec; ///< Deserialization failure (the range stops there)
+    };
+
+    /// @brief Number of ranges a full scan of cnt slots is split into (1: serial)
+    size_t scanChunks(size_t cnt) const {
+        return detail::scanChunkCount(cnt, options_.scanThreads, options_.scanMinRecordsPerThread);
+    }
+
+    /// @brief Deserialize slots [from, to) and collect their index entries
+    /// @details Only reads the mapping, so ranges can be scanned concurrently.
+    void scanSlots(size_t from, size_t to, SlotScan& out) const {
+        T temp;
+        for (size_t i = from; i < to; ++i) {
+            const char* buf = mmap_.data() + i * recordSize_;
+            if (!isLiveSlot(buf)) {
+                if (buf[typeOffset_] == FIXED_TOMBSTONE_MARK)
+                    ++out.tombstones;
+                out.free.push_back(i);
+                continue;
+            }
+            if (!temp.deserialize(buf, out.ec))
+                return;
+            out.live.emplace_back(keyHash(indexKey(temp.getId())), i);
+        }
+        out.ec.clear();
+    }
+
+    /// @brief rebuildCache() body for chunks > 1 (index already reset)
+    /// @details The ranges are scanned concurrently and merged into the index in slot order,
+    ///          so a duplicate ID ends up at the same slot as with a serial scan.
+    void rebuildParallel(size_t cnt, size_t chunks, std::error_code& ec) {
+        std::vector<SlotScan> parts(chunks);
+        detail::runParallel(chunks, [&](size_t c) {
+            scanSlots(detail::chunkBegin(cnt, chunks, c), detail::chunkBegin(cnt, chunks, c + 1),
+                      parts[c]);
+        });
+        for (auto& part : parts) {
+            if (part.ec) {
+                ec = part.ec;
+                index().clear();
+                knownLayout_.reset();
+                return;
+            }
+        }
+        for (auto& part : parts) {
+            for (const auto& [hash, slot] : part.live)
+                indexPutHashed(hash, viewAt(slot).id(), slot);
+            liveCount_ += part.live.size();
+            tombstones_ += part.tombstones;
+            freeSlots_.insert(freeSlots_.end(), part.free.begin(), part.free.end());
+        }
+        // Ascending order is already a min-heap (see pushFreeSlot())
+        freeSlotsKnown_ = true;
+        ec.clear();
+    }
+
+    /// @brief findAll() body for chunks > 1
+    /// @details Each range is deserialized into its own vector; the vectors are concatenated
+    ///          in slot order. On a failure the records before it are returned with ec set,
+    ///          as in the serial loop.
+    void findAllParallel(size_t cnt, size_t chunks, std::vector<std::unique_ptr<T>>& res,
+                         std::error_code& ec) const {
+        std::vector<std::vector<std::unique_ptr<T>>> parts(chunks);
+        std::vector<std::error_code> errors(chunks);
+        detail::runParallel(chunks, [&](size_t c) {
+            const size_t end = detail::chunkBegin(cnt, chunks, c + 1);
+            for (size_t i = detail::chunkBegin(cnt, chunks, c); i < end; ++i) {
+                const char* buf = mmap_.data() + i * recordSize_;
+                if (!isLiveSlot(buf))
+                    continue;
+                auto rec = std::make_unique<T>();
+                if (!rec->deserialize(buf, errors[c]))
+                    return;
+                parts[c].push_back(std::move(rec));
+            }
+        });
+        for (size_t c = 0; c < chunks; ++c) {
+            std::move(parts[c].begin(), parts[c].end(), std::back_inserter(res));
+            if (errors[c]) {
+                ec = errors[c];
+                return;
+            }
         }
-        return std::nullopt;
     }
 
-    /// @brief Update file mtime/size
+    /// @brief Rebuild the sidecar from the data file
+    /// @details Readers only hold the shared data lock, so the rebuild is serialized through
+    ///          an exclusive lock on the sidecar itself. A sidecar that another process rebuilt
+    ///          in the meantime is adopted as is.
+    bool rebuildSidecar(std::error_code& ec) {
+        detail::FileLockGuard idxLock(sidecar_->fd(), detail::FileLockGuard::Mode::Exclusive,
+                                      ec);
+        if (ec)
+            return false;
+        if (!sidecar_->refresh(ec))
+            return false;
+
+        struct stat st{};
+        if (::fstat(fd_.get(), &st) < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (sidecar_->matches(st)) {
+            adoptSidecar();
+            return true;
+        }
+
+        sidecar_->beginWrite();
+        rebuildCache(ec);
+        if (ec)
+            return false; // Left dirty: retried on next access
+        sidecar_->commit(st, liveCount_, tombstones_);
+        return true;
+    }
+
+    /// @brief Take the counts from a sidecar that matches the data file (no scan)
+    /// @details The free-slot list is rebuilt lazily by ensureFreeSlots() on the first insert.
+    void adoptSidecar() {
+        liveCount_ = static_cast<size_t>(sidecar_->count());
+        tombstones_ = static_cast<size_t>(sidecar_->tombstones());
+        freeSlots_.clear();
+        freeSlotsKnown_ = (liveCount_ == slotCount());
+    }
+
+    /// @brief Make a slot available for reuse
+    /// @details freeSlots_ is a min-heap, so a slot freed by a delete is reused only after every
+    ///          lower free slot, the same order a rebuild after reopening gives.
+    void pushFreeSlot(size_t slot) {
+        freeSlots_.push_back(slot);
+        std::push_heap(freeSlots_.begin(), freeSlots_.end(), std::greater<size_t>());
+    }
+
+    /// @brief Take the lowest free slot (freeSlots_ must not be empty)
+    size_t popFreeSlot() {
+        std::pop_heap(freeSlots_.begin(), freeSlots_.end(), std::greater<size_t>());
+        const size_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+
+    /// @brief Collect free slots if they were not loaded yet (type byte scan only)
+    void ensureFreeSlots() {
+        if (freeSlotsKnown_)
+            return;
+        freeSlots_.clear();
+        // Ascending order is already a min-heap (see pushFreeSlot())
+        for (size_t i = 0; i < slotCount(); ++i) {
+            if (!isLiveSlot(mmap_.data() + i * recordSize_))
+                freeSlots_.push_back(i);
+        }
+        freeSlotsKnown_ = true;
+    }
+
+    /// @brief Hash index in use: the sidecar's mapped table or the in-memory one
+    detail::SlotHashTable& index() { return sidecar_ ? sidecar_->table() : idTable_; }
+    const detail::SlotHashTable& index() const {
+        return sidecar_ ? sidecar_->table() : idTable_;
+    }
+
+    /// @brief Hash of an index key
+    static uint64_t keyHash(std::string_view key) { return detail::hashId(key.data(), key.size()); }
+
+    /// @brief O(1) ID lookup via the hash index
+    /// @details Buckets hold no keys: a hash hit is confirmed by comparing the ID bytes of the
+    ///          mapped slot, which also rejects slots deleted by another process.
+    std::optional<size_t> findIdxByIdCached(const std::string& id) const {
+        const std::string_view key = indexKey(id);
+        return index().find(keyHash(key), [&](size_t slot) { return slotHasId(slot, key); });
+    }
+
+    /// @brief ID as stored in a slot (serialize() truncates to the ID field length)
+    std::string_view indexKey(const std::string& id) const {
+        return std::string_view(id).substr(0, layout_.idLength());
+    }
+
+    /// @brief Whether slot holds a live record with the given (truncated) ID
+    bool slotHasId(size_t slot, std::string_view key) const {
+        return slot < slotCount() && isLiveSlot(mmap_.data() + slot * recordSize_) &&
+               viewAt(slot).id() == key;
+    }
+
+    /// @brief Point `id` at `slot` (the record must already be written there)
+    /// @note Call reserveIndex() first so the table never fills up.
+    void indexPut(const std::string& id, size_t slot) {
+        const std::string_view key = indexKey(id);
+        indexPutHashed(keyHash(key), key, slot);
+    }
+
+    /// @brief indexPut() with the key and its hash already computed
+    void indexPutHashed(uint64_t h, std::string_view key, size_t slot) {
+        auto& table = index();
+        if (!table.update(h, slot, [&](size_t s) { return slotHasId(s, key); }))
+            table.insert(h, slot);
+    }
+
+    /// @brief Remove `id` from the index (its slot must still hold the record)
+    void indexErase(const std::string& id) {
+        const std::string_view key = indexKey(id);
+        index().erase(keyHash(key), [&](size_t s) { return slotHasId(s, key); });
+    }
+
+    /// @brief Shift every indexed slot above idx down by one
+    void indexShiftAbove(size_t idx) {
+        index().remapSlots([idx](size_t s) { return s > idx ? s - 1 : s; });
+    }
+
+    /// @brief Renumber indexed slots after the sorted `holes` were removed
+    void indexRemoveHoles(const std::vector<size_t>& holes) {
+        // New index = old index - number of holes below it
+        index().remapSlots([&holes](size_t s) {
+            return s - static_cast<size_t>(std::lower_bound(holes.begin(), holes.end(), s) -
+                                           holes.begin());
+        });
+    }
+
+    /// @brief Make room for `extra` more entries
+    bool reserveIndex(size_t extra, std::error_code& ec) {
+        if (sidecar_)
+            return sidecar_->reserve(liveCount_, extra, ec);
+        const size_t want = detail::SlotHashTable::capacityFor(liveCount_ + extra);
+        if (want <= idTable_.capacity())
+            return true;
+
+        std::vector<detail::SlotBucket> grown(want, detail::SlotBucket{0, 0});
+        detail::SlotHashTable next;
+        next.attach(grown.data(), grown.size());
+        idTable_.forEach([&](uint64_t h, size_t slot) { next.insert(h, slot); });
+        idBuckets_.swap(grown);
+        idTable_ = next;
+        return true;
+    }
+
+    /// @brief Drop every entry and size the index for `expected` entries
+    bool resetIndex(size_t expected, std::error_code& ec) {
+        if (sidecar_)
+            return sidecar_->reset(expected, ec);
+        idBuckets_.assign(detail::SlotHashTable::capacityFor(expected), detail::SlotBucket{0, 0});
+        idTable_.attach(idBuckets_.data(), idBuckets_.size());
+        return true;
+    }
+
+    /// @brief Mark the sidecar as being modified (committed by updateFileStats())
+    void beginIndexWrite() {
+        if (sidecar_)
+            sidecar_->beginWrite();
+    }
+
+    /// @brief Update file mtime/size (and commit the sidecar for that state)
     void updateFileStats() {
         struct stat st{};
         if (::fstat(fd_.get(), &st) == 0) {
-            lastMtime_ = st.st_mtime;
+            lastMtimeNs_ = detail::statMtimeNs(st);
             lastSize_ = st.st_size;
+            if (sidecar_)
+                sidecar_->commit(st, liveCount_, tombstones_);
         }
     }
 
@@ -354,36 +1686,398 @@ template <typename T> class UniformFixedRepositoryImpl : public RecordRepository
             ec = std::error_code(errno, std::generic_category());
             return false;
         }
-        if (st.st_size == 0) {
+        return mapSize(static_cast<size_t>(st.st_size), ec);
+    }
+
+    /// @brief Map exactly `size` bytes, reusing the current mapping if it already matches
+    bool mapSize(size_t size, std::error_code& ec) {
+        ec.clear();
+        if (size == 0) {
             mmap_.reset();
             return true;
         }
-        void* ptr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_.get(), 0);
+        if (mmap_ && mmap_.size() == size)
+            return true;
+        FDFILE_STATS_COUNT(stats_, Remaps);
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        // Grow/shrink in place when possible instead of a full munmap + mmap
+        if (mmap_) {
+            const size_t oldSize = mmap_.size();
+            void* ptr = ::mremap(mmap_.get(), oldSize, size, MREMAP_MAYMOVE);
+            if (ptr != MAP_FAILED) {
+                (void)mmap_.release();
+                mmap_.reset(ptr, size);
+                adviseMapping(oldSize);
+                return true;
+            }
+        }
+#endif
+        void* ptr = detail::MmapGuard::mapShared(fd_.get(), size, options_.mapping.populate);
         if (ptr == MAP_FAILED) {
             ec = std::error_code(errno, std::generic_category());
             return false;
         }
-        mmap_.reset(ptr, st.st_size);
+        mmap_.reset(ptr, size);
+        adviseMapping(size);
         return true;
     }
 
+    static detail::MmapGuard::Advice adviceFor(AccessPattern pattern) {
+        switch (pattern) {
+        case AccessPattern::Sequential:
+            return detail::MmapGuard::Advice::Sequential;
+        case AccessPattern::Random:
+            return detail::MmapGuard::Advice::Random;
+        default:
+            return detail::MmapGuard::Advice::Normal;
+        }
+    }
+
+    /// @brief Apply FixedRepositoryOptions::mapping to a new or resized mapping
+    /// @param populated Bytes at the start of the mapping already prefaulted
+    void adviseMapping(size_t populated) const {
+        const MappingOptions& m = options_.mapping;
+        if (m.pattern != AccessPattern::Normal)
+            (void)mmap_.advise(adviceFor(m.pattern));
+        if (m.hugePages)
+            (void)mmap_.advise(detail::MmapGuard::Advice::HugePages);
+        if (m.populate && populated < mmap_.size())
+            (void)mmap_.advise(detail::MmapGuard::Advice::WillNeed, populated);
+    }
+
+    /// @brief Advises the mapping as sequential for the lifetime of a full scan (scanHints)
+    class ScanHint {
+      public:
+        explicit ScanHint(const UniformFixedRepositoryImpl& repo)
+            : repo_(repo.options_.mapping.scanHints ? &repo : nullptr) {
+            if (repo_) {
+                (void)repo_->mmap_.advise(detail::MmapGuard::Advice::Sequential);
+                (void)repo_->mmap_.advise(detail::MmapGuard::Advice::WillNeed);
+            }
+        }
+        ~ScanHint() {
+            // The scan may have remapped the file: restore the pattern on the current mapping
+            if (repo_)
+                (void)repo_->mmap_.advise(adviceFor(repo_->options_.mapping.pattern));
+        }
+        ScanHint(const ScanHint&) = delete;
+        ScanHint& operator=(const ScanHint&) = delete;
+
+      private:
+        const UniformFixedRepositoryImpl* repo_;
+    };
+
+    /// @brief Extend the file from oldCount to newCount slots and map the new size
+    /// @details New slots are zero-filled, which marks them empty (free).
+    ///          Blocks are reserved with posix_fallocate where available.
+    bool growFile(size_t oldCount, size_t newCount, std::error_code& ec) {
+        const size_t newSize = newCount * recordSize_;
+        int rc = -1;
+#if defined(__linux__)
+        const size_t oldSize = oldCount * recordSize_;
+        rc = ::posix_fallocate(fd_.get(), static_cast<off_t>(oldSize),
+                               static_cast<off_t>(newSize - oldSize));
+#else
+        (void)oldCount;
+#endif
+        if (rc != 0 && ::ftruncate(fd_.get(), static_cast<off_t>(newSize)) != 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (!mapSize(newSize, ec)) {
+            (void)::ftruncate(fd_.get(), static_cast<off_t>(oldCount * recordSize_));
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Make slots [first, first + n) durable according to options_.durability
+    /// @details Strict flushes the pages synchronously. Async and GroupCommit only schedule
+    ///          write-back (MS_ASYNC); GroupCommit additionally queues the write for the
+    ///          flusher thread.
+    bool commitSlots(size_t first, size_t n, std::error_code& ec) {
+        // A write session flushes its Strict writes once, in commit()
+        const bool strict = options_.durability == Durability::Strict && !inWriteSession_;
+        sessionUnsynced_ |= inWriteSession_ && options_.durability == Durability::Strict;
+        if (!syncSlots(first, n, strict)) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (flusher_)
+            flusher_->noteWrite();
+        else
+            ++writeSeq_;
+        if (strict)
+            durableSeq_ = writeSeq_;
+        return true;
+    }
+
+    /// @brief msync() the pages of slots [first, first + n); only Strict syncs are timed
+    bool syncSlots(size_t first, size_t n, bool strict) {
+        if (!strict)
+            return mmap_.syncRange(first * recordSize_, n * recordSize_, true);
+        FDFILE_STATS_TIMER(stats_, Sync);
+        return mmap_.syncRange(first * recordSize_, n * recordSize_, false);
+    }
+
+    /// @brief Check whether a slot holds a live record (not tombstoned or empty)
+    /// @details Preallocated slots are zero-filled, so an empty type field means free.
+    bool isLiveSlot(const char* slot) const {
+        const char c = slot[typeOffset_];
+        return c != FIXED_TOMBSTONE_MARK && c != '\0';
+    }
+
+    /// @brief Compact free slots away (caller holds exclusive lock)
+    bool compactLocked(std::error_code& ec) {
+        ec.clear();
+        ensureFreeSlots();
+        if (freeSlots_.empty())
+            return true;
+        ScanHint hint(*this);
+        beginIndexWrite();
+        noteLayoutChange();
+
+        std::vector<size_t> holes(freeSlots_);
+        std::sort(holes.begin(), holes.end());
+
+        // Move each run of live slots between holes down in one memmove
+        const size_t cnt = slotCount();
+        char* base = mmap_.data();
+        size_t w = holes.front();
+        for (size_t k = 0; k < holes.size(); ++k) {
+            size_t runStart = holes[k] + 1;
+            size_t runEnd = (k + 1 < holes.size()) ? holes[k + 1] : cnt;
+            if (runEnd > runStart) {
+                std::memmove(base + w * recordSize_, base + runStart * recordSize_,
+                             (runEnd - runStart) * recordSize_);
+                w += runEnd - runStart;
+            }
+        }
+
+        indexRemoveHoles(holes);
+
+        if (!commitSlots(holes.front(), cnt - holes.front(), ec))
+            return false;
+        mmap_.reset();
+        if (::ftruncate(fd_.get(), (cnt - holes.size()) * recordSize_) != 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        freeSlots_.clear();
+        tombstones_ = 0;
+        if (!remapFile(ec))
+            return false;
+        rebuildFieldIndexes();
+        updateFileStats();
+        return true;
+    }
+
+    /// @brief Undo a file growth performed by a failed batch (best effort)
+    void rollbackGrow(size_t oldCount, size_t newCount) {
+        if (newCount == oldCount)
+            return;
+        mmap_.reset();
+        (void)::ftruncate(fd_.get(), oldCount * recordSize_);
+        std::error_code ignore;
+        (void)remapFile(ignore);
+    }
+
+    /// @brief Call fn(index, value) for every field index with the value stored in slot
+    template <typename Fn> void visitFieldValues(size_t slot, Fn&& fn) {
+        const RecordView<T> view = viewAt(slot);
+        for (auto& fi : fieldIndexes_) {
+            if (!fi.numeric()) {
+                fn(fi, view.str(fi.field()));
+                continue;
+            }
+            std::error_code vec;
+            const int64_t value = view.num(fi.field(), vec);
+            if (!vec) // A number that does not parse is not indexed
+                fn(fi, value);
+        }
+    }
+
+    /// @brief Index the record written to slot in every field index
+    void fieldIndexAdd(size_t slot) {
+        if (!fieldIndexes_.empty())
+            visitFieldValues(slot, [slot](auto& fi, auto value) { fi.add(value, slot); });
+    }
+
+    /// @brief Drop slot from every field index (the slot must still hold the record)
+    void fieldIndexRemove(size_t slot) {
+        if (!fieldIndexes_.empty())
+            visitFieldValues(slot, [slot](auto& fi, auto value) { fi.remove(value, slot); });
+    }
+
+    void clearFieldIndexes() {
+        for (auto& fi : fieldIndexes_)
+            fi.clear();
+    }
+
+    /// @brief Rebuild the field indexes from the mapped slots (views only, no deserialize)
+    void rebuildFieldIndexes() {
+        if (fieldIndexes_.empty())
+            return;
+        ScanHint hint(*this);
+        clearFieldIndexes();
+        const size_t cnt = slotCount();
+        for (size_t i = 0; i < cnt; ++i) {
+            if (isLiveSlot(mmap_.data() + i * recordSize_))
+                fieldIndexAdd(i);
+        }
+    }
+
+    /// @brief Field index answering a lookup on field (a hash index is preferred)
+    /// @return nullptr if the field has no index of that type (and kind, for ranges)
+    const detail::FieldIndex* fieldIndexFor(std::string_view field, bool numeric,
+                                            bool ordered) const {
+        const size_t idx = layout_.fieldIndex(field);
+        const detail::FieldIndex* found = nullptr;
+        for (const auto& fi : fieldIndexes_) {
+            if (fi.field() != idx || fi.numeric() != numeric || (ordered && !fi.ordered()))
+                continue;
+            if (!fi.ordered())
+                return &fi;
+            found = &fi;
+        }
+        return found;
+    }
+
+    /// @brief Slots whose field equals value (caller holds a lock on a current cache)
+    template <typename V>
+    bool fieldSlots(std::string_view field, V value, std::vector<size_t>& out,
+                    std::error_code& ec) const {
+        ec.clear();
+        const detail::FieldIndex* fi = fieldIndexFor(field, std::is_same_v<V, int64_t>, false);
+        if (!fi) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        out = fi->equal(value);
+        return true;
+    }
+
+    /// @brief Slots whose numeric field lies in [lo, hi] (caller holds a lock)
+    bool rangeSlots(std::string_view field, int64_t lo, int64_t hi, std::vector<size_t>& out,
+                    std::error_code& ec) const {
+        ec.clear();
+        const detail::FieldIndex* fi = fieldIndexFor(field, true, true);
+        if (!fi) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        out = fi->range(lo, hi);
+        return true;
+    }
+
+    /// @brief Views of the live slots among `slots`
+    std::vector<RecordView<T>> viewsOf(const std::vector<size_t>& slots) const {
+        std::vector<RecordView<T>> views;
+        views.reserve(slots.size());
+        const size_t cnt = slotCount();
+        for (size_t slot : slots) {
+            if (slot < cnt && isLiveSlot(mmap_.data() + slot * recordSize_))
+                views.push_back(viewAt(slot));
+        }
+        return views;
+    }
+
+    /// @brief Deserialize the records a field index query selects (takes the shared lock)
+    template <typename Query>
+    std::vector<std::unique_ptr<T>> findIndexed(Query&& slotsOf, std::error_code& ec) {
+        std::vector<std::unique_ptr<T>> res;
+        ReadLock lock;
+        if (!lockForRead(lock, ec))
+            return res;
+        std::vector<size_t> slots;
+        if (!slotsOf(slots, ec))
+            return res;
+        for (const auto& view : viewsOf(slots)) {
+            auto rec = view.toRecord(ec);
+            if (!rec)
+                return res;
+            res.push_back(std::move(rec));
+        }
+        return res;
+    }
+
+    /// @brief View of slot idx (mapping must be current)
+    RecordView<T> viewAt(size_t idx) const {
+        return RecordView<T>(mmap_.data() + idx * recordSize_, &layout_);
+    }
+
+    /// @brief Call fn for every live slot; stops early if fn returns false
+    template <typename Fn> void scanLive(Fn&& fn) const {
+        scanRange(0, slotCount(), std::forward<Fn>(fn));
+    }
+
+    /// @brief scanLive() over slots [from, to)
+    template <typename Fn> void scanRange(size_t from, size_t to, Fn&& fn) const {
+        for (size_t i = from; i < to; ++i) {
+            const char* buf = mmap_.data() + i * recordSize_;
+            if (!isLiveSlot(buf))
+                continue;
+            RecordView<T> view(buf, &layout_);
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const RecordView<T>&>, bool>) {
+                if (!fn(view))
+                    return;
+            } else {
+                fn(view);
+            }
+        }
+    }
+
     size_t slotCount() const {
         if (!mmap_)
             return 0;
         return mmap_.size() / recordSize_;
     }
 
+    // Declared first so a moved writer drains into the old state before it is replaced
+    detail::AsyncWriter<WriteSession> async_; ///< Background writer (asyncWrites)
     std::string path_;
+    std::unique_ptr<detail::ThreadGate> gate_; ///< threadSafe or asyncWrites
+    std::unique_ptr<detail::IdIndexFile> sidecar_; ///< Persistent ID index (persistentIndex)
+    std::unique_ptr<detail::ControlFile> control_; ///< Shared write generation (controlFile)
+    // Declared before fd_ so a move-assigned flusher finishes with the old fd still open
+    std::unique_ptr<detail::GroupCommitFlusher> flusher_;
     detail::UniqueFd fd_;
     detail::MmapGuard mmap_;
+    T layout_; ///< Layout prototype shared by all RecordViews
     size_t recordSize_ = 0;
-
-    // ID cache (O(1) lookup)
-    std::unordered_map<std::string, size_t> idCache_;
+    size_t typeOffset_ = 0;
+    FixedRepositoryOptions options_;
+
+    // In-memory ID index (unused when sidecar_ is set): hash + slot only, ~16 bytes per bucket
+    std::vector<detail::SlotBucket> idBuckets_;
+    detail::SlotHashTable idTable_; ///< Views idBuckets_ (heap buffer survives moves)
+
+    std::vector<detail::FieldIndex> fieldIndexes_; ///< One per FixedRepositoryOptions::fieldIndexes
+
+    // Tombstoned and preallocated slots available for reuse: a min-heap, so inserts always fill
+    // the lowest free slot, however the list was built
+    std::vector<size_t> freeSlots_;
+    bool freeSlotsKnown_ = true; ///< false after adopting a sidecar until ensureFreeSlots()
+    size_t tombstones_ = 0;      ///< Free slots that were deleted (as opposed to preallocated)
+    size_t liveCount_ = 0;       ///< Live records
+
+    // Write tickets for Strict/Async (GroupCommit tickets come from flusher_)
+    uint64_t writeSeq_ = 0;
+    uint64_t durableSeq_ = 0;
+    bool inWriteSession_ = false;  ///< A WriteSession holds the exclusive lock
+    bool sessionUnsynced_ = false; ///< Strict writes of the session still to be flushed
+
+#if defined(FDFILE_ENABLE_STATS)
+    detail::StatsRecorder stats_;
+#endif
 
     // For external modification detection
-    time_t lastMtime_ = 0;
+    int64_t lastMtimeNs_ = 0;
     size_t lastSize_ = 0;
+    std::optional<uint64_t> knownGen_; ///< control_ generation the cache was last checked at
+    std::optional<uint64_t> ownGen_;   ///< Generation produced by our own last write (see announceWrite)
+    std::optional<uint64_t> knownLayout_; ///< Layout generation the index reflects (see indexTail)
 };
 
 } // namespace FdFile
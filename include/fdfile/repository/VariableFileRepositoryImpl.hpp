@@ -3,16 +3,50 @@
 /// @brief Variable-length record repository implementation (formerly FdTextFile)
 
 #include "../record/VariableRecordBase.hpp"
+#include "../util/AsyncWriteQueue.hpp"
+#include "../util/BinaryCodec.hpp"
+#include "../util/ControlFile.hpp"
+#include "../util/FileLockGuard.hpp"
+#include "../util/GroupCommitFlusher.hpp"
+#include "../util/LruCache.hpp"
+#include "../util/ThreadGate.hpp"
 #include "../util/UniqueFd.hpp"
+#include "../util/WriteBatch.hpp"
 
 #include "RecordRepository.hpp"
+#include "RepositoryOptions.hpp"
+#include "RepositoryStats.hpp"
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
 #include <unordered_map>
 
 namespace FdFile {
 
 /// @brief Variable-length record repository implementation
-/// @details Manages variable-length records in JSON-like text format.
+/// @details Manages variable-length records in JSON-like text format, or in the binary
+///          format of util/BinaryCodec.hpp with VariableRepositoryOptions::format.
 ///          Supports caching with automatic detection of external file modifications.
+///          When the file only grew (appends by this or another process), just the new
+///          lines are parsed; rewrites and truncations reload the whole file.
+///          With VariableRepositoryOptions::logStructured, updates and deletes are appended
+///          too and compact() rewrites the live records to a temp file renamed over the
+///          original. Every instance follows the rename on its next access.
+///          With VariableRepositoryOptions::lazyLoad only the ID → file location index stays
+///          resident and records are decoded on demand.
+///          With VariableRepositoryOptions::threadSafe one instance may serve several threads.
+///          With VariableRepositoryOptions::controlFile, reads that find the shared write
+///          generation unchanged are served from the cache without any system call.
+///          Built with FDFILE_ENABLE_STATS, stats() reports operation latencies and cache
+///          counters.
+///          With VariableRepositoryOptions::asyncWrites, saveAsync()/deleteAsync() are applied
+///          in batches by a background writer. Moving such an instance first applies every
+///          write queued on it.
 class VariableFileRepositoryImpl : public RecordRepository<VariableRecordBase> {
   public:
     /// @brief Constructor
@@ -22,7 +56,19 @@ class VariableFileRepositoryImpl : public RecordRepository<VariableRecordBase> {
     VariableFileRepositoryImpl(const std::string& path,
                                std::vector<std::unique_ptr<VariableRecordBase>> prototypes,
                                std::error_code& ec);
-    ~VariableFileRepositoryImpl() override = default;
+
+    /// @brief Constructor with options
+    /// @param path File path for the repository
+    /// @param prototypes Prototype instances for each record type
+    /// @param options Repository tuning options
+    /// @param ec Error code set on failure
+    VariableFileRepositoryImpl(const std::string& path,
+                               std::vector<std::unique_ptr<VariableRecordBase>> prototypes,
+                               const VariableRepositoryOptions& options, std::error_code& ec);
+
+    /// @brief Destructor (applies queued asynchronous writes and stops the group-commit
+    ///        flusher before the fd closes)
+    ~VariableFileRepositoryImpl() override;
 
     // 복사 방지
     VariableFileRepositoryImpl(const VariableFileRepositoryImpl&) = delete;
@@ -43,10 +89,301 @@ class VariableFileRepositoryImpl : public RecordRepository<VariableRecordBase> {
     size_t count(std::error_code& ec) override;
     bool existsById(const std::string& id, std::error_code& ec) override;
 
+    /// @brief Immutable record shared with the cache
+    /// @details Writes and reloads replace cache entries instead of modifying them, so a
+    ///          snapshot never changes and stays valid after the repository moves on.
+    using Snapshot = std::shared_ptr<const VariableRecordBase>;
+
+    /// @brief All records as shared snapshots (no per-record copy)
+    /// @param ec Error code set on failure
+    /// @return Snapshots in file order
+    std::vector<Snapshot> findAllShared(std::error_code& ec);
+
+    /// @brief Record by ID as a shared snapshot
+    /// @param id Record ID
+    /// @param ec Error code set on failure
+    /// @return Snapshot, or nullptr if absent
+    Snapshot findByIdShared(const std::string& id, std::error_code& ec);
+
+    /// @brief Visit every record under the shared file lock without copying
+    /// @param visitor Called in file order; return false to stop. Must not call back into
+    ///        this repository.
+    /// @param ec Error code set on failure
+    /// @return true unless the file could not be read (stopping early is not a failure)
+    bool forEach(const std::function<bool(const VariableRecordBase&)>& visitor,
+                 std::error_code& ec);
+
+    /// @brief forEach() on several threads at once, for analytic scans of large files
+    /// @details The slots are split into one contiguous range per thread; each thread visits
+    ///          its range in file order while the shared lock is held. With lazyLoad each
+    ///          thread reads and decodes its own records (text format; binary files are
+    ///          visited on the calling thread) without touching the record cache.
+    /// @param visitor Called concurrently, so it must be thread-safe; return false to stop
+    ///        all threads soon after. Must not call back into this repository.
+    /// @param ec Error code set on failure
+    /// @param threads Threads to use (0: one per core)
+    /// @return true unless a record could not be read
+    bool parallelForEach(const std::function<bool(const VariableRecordBase&)>& visitor,
+                         std::error_code& ec, size_t threads = 0);
+
+    using RecordRepository<VariableRecordBase>::findAllByType;
+
+    /// @brief Copies of the records whose typeName() is `typeName`
+    /// @details Walks the per-type slot list built while loading, so records of other types
+    ///          are neither copied nor, with lazyLoad, read back from the file.
+    /// @param typeName Registered prototype type name (unknown names yield no records)
+    /// @param ec Error code set on failure
+    /// @return Records in file order
+    std::vector<std::unique_ptr<VariableRecordBase>> findAllByType(const std::string& typeName,
+                                                                   std::error_code& ec);
+
+    /// @brief findAllByType() as shared snapshots
+    std::vector<Snapshot> findAllSharedByType(const std::string& typeName, std::error_code& ec);
+
+    /// @brief Number of live records of one type (no record is decoded)
+    /// @param typeName Registered prototype type name
+    /// @param ec Error code set on failure
+    size_t countByType(const std::string& typeName, std::error_code& ec);
+
   private:
+    /// @brief Locks held by a read: the file lock, plus one side of gate_ with threadSafe
+    struct ReadLock {
+        std::unique_lock<std::shared_mutex> exclusive;
+        std::shared_lock<std::shared_mutex> memory; ///< Shared side without the file lock
+        detail::SharedGateLock shared; ///< Also stands for the shared file lock
+        detail::FileLockGuard file;
+    };
+
+  public:
+    class WriteSession;
+
+    /// @brief Read scope: locks and validates the cache once for any number of reads
+    /// @details The session sees the file as it was when it was opened. Like every read it
+    ///          may be served without the file lock while the controlFile generation is
+    ///          unchanged.
+    /// @note Do not call this repository's methods while a session is alive (with threadSafe
+    ///       a write blocks forever in the same thread). Use upgrade() to write.
+    class ReadSession {
+      public:
+        ReadSession() = default;
+        ReadSession(ReadSession&& other) noexcept;
+        ReadSession& operator=(ReadSession&& other) noexcept;
+
+        /// @brief Whether the session holds the lock (false if readSession() failed)
+        bool valid() const noexcept { return repo_ != nullptr; }
+
+        std::unique_ptr<VariableRecordBase> findById(const std::string& id, std::error_code& ec);
+        Snapshot findByIdShared(const std::string& id, std::error_code& ec);
+        bool existsById(const std::string& id) const;
+        size_t count() const;
+        /// @brief Visit every record in file order; return false from visitor to stop
+        bool forEach(const std::function<bool(const VariableRecordBase&)>& visitor,
+                     std::error_code& ec);
+
+        /// @brief Trade the shared lock for the exclusive one
+        /// @details A file lock this thread holds alone is converted in place, so no other
+        ///          process writes in between; otherwise (threadSafe, or a read served
+        ///          without the file lock) it is taken anew. Either way the cache is
+        ///          validated again. This session is released, also on failure.
+        /// @param ec Error code set on failure (EDEADLK if another process upgrades too)
+        /// @return Write session; check valid() or ec
+        WriteSession upgrade(std::error_code& ec);
+
+      private:
+        friend class VariableFileRepositoryImpl;
+
+        VariableFileRepositoryImpl* repo_ = nullptr;
+        ReadLock lock_;
+    };
+
+    /// @brief Exclusive scope grouping several reads and writes
+    /// @details Locks and validates the cache once; operations inside skip the per-call lock
+    ///          and, until the session writes, the stat() of the file. Other processes do not
+    ///          see appended records before the session ends, and Strict writes are made
+    ///          durable together by commit(). A rewrite (update or delete without
+    ///          logStructured, compact(), deleteAll()) publishes the new file immediately.
+    ///          There is no rollback: writes that completed stay written.
+    class WriteSession {
+      public:
+        WriteSession() = default;
+        WriteSession(WriteSession&& other) noexcept;
+        WriteSession& operator=(WriteSession&& other) noexcept;
+        /// @brief Commits (errors are ignored; call commit() to see them)
+        ~WriteSession();
+
+        /// @brief Whether the session holds the lock (false after commit() or a failed open)
+        bool valid() const noexcept { return repo_ != nullptr; }
+
+        bool save(const VariableRecordBase& record, std::error_code& ec);
+        bool saveAll(const std::vector<const VariableRecordBase*>& records, std::error_code& ec);
+        bool deleteById(const std::string& id, std::error_code& ec);
+        bool deleteAll(std::error_code& ec);
+        bool compact(std::error_code& ec);
+
+        std::unique_ptr<VariableRecordBase> findById(const std::string& id, std::error_code& ec);
+        Snapshot findByIdShared(const std::string& id, std::error_code& ec);
+        bool existsById(const std::string& id, std::error_code& ec);
+        size_t count(std::error_code& ec);
+        /// @brief Visit every record in file order; return false from visitor to stop
+        bool forEach(const std::function<bool(const VariableRecordBase&)>& visitor,
+                     std::error_code& ec);
+
+        /// @brief Make the session's writes durable and release the lock
+        /// @param ec Error code set if the flush failed
+        /// @return true on success (also for an invalid session)
+        bool commit(std::error_code& ec);
+
+      private:
+        friend class VariableFileRepositoryImpl;
+        /// @brief Refresh the cache after the session's own writes (no-op until it writes)
+        bool ready(std::error_code& ec);
+
+        VariableFileRepositoryImpl* repo_ = nullptr;
+        std::unique_lock<std::shared_mutex> exclusive_; ///< gate_ side (threadSafe)
+    };
+
+    /// @brief Open a read session (takes the shared lock and validates the cache once)
+    /// @param ec Error code set on failure
+    /// @return Session; check valid() or ec
+    ReadSession readSession(std::error_code& ec);
+
+    /// @brief Open a write session (takes the exclusive lock and validates the cache once)
+    /// @param ec Error code set on failure
+    /// @return Session; check valid() or ec
+    WriteSession writeSession(std::error_code& ec);
+
+    /// @brief Ticket of the most recent write (0 if nothing was written)
+    uint64_t lastWriteTicket() const;
+
+    /// @brief Block until the write identified by ticket is durable
+    /// @param ticket Ticket from lastWriteTicket()
+    /// @param ec Error code set if the flush failed
+    /// @return true once durable
+    bool waitDurable(uint64_t ticket, std::error_code& ec);
+
+    /// @brief Make every write performed so far durable
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool flush(std::error_code& ec);
+
+    /// @brief Completion callback of saveAsync()/deleteAsync()
+    using AsyncCallback = std::function<void(const std::error_code&)>;
+
+    /// @brief Queue save() of a copy of record on the background writer
+    /// @details The result is what save() would have returned, available once the batch
+    ///          holding the write is committed (durable for Durability::Strict). Operations
+    ///          are applied in submission order. Without asyncWrites the record is saved
+    ///          before this returns.
+    /// @param record Record to save (copied with cloneVariable())
+    /// @return Future of the error code (empty on success)
+    std::future<std::error_code> saveAsync(const VariableRecordBase& record);
+
+    /// @brief saveAsync() reporting to a callback
+    /// @param record Record to save (copied with cloneVariable())
+    /// @param done Called with the result on the writer thread (on the caller's thread
+    ///        without asyncWrites). Must not wait for later asynchronous writes.
+    void saveAsync(const VariableRecordBase& record, AsyncCallback done);
+
+    /// @brief Queue deleteById() on the background writer (see saveAsync())
+    /// @param id ID of the record to remove
+    /// @return Future of the error code (empty on success, including a missing ID)
+    std::future<std::error_code> deleteAsync(const std::string& id);
+
+    /// @brief deleteAsync() reporting to a callback (see saveAsync())
+    void deleteAsync(const std::string& id, AsyncCallback done);
+
+    /// @brief Block until every asynchronous write submitted so far has completed
+    void drainAsync();
+
+    /// @brief Rewrite the file with only the live records
+    /// @details Writes `<path>.tmp`, syncs it and renames it over the file, so readers see
+    ///          either the old or the new file. Superseded versions and tombstones are dropped.
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool compact(std::error_code& ec);
+
+    /// @brief Counters of the lazyLoad record cache
+    VariableCacheStats cacheStats() const;
+
+    /// @brief Snapshot of the operation latencies and cache counters
+    /// @details Empty (enabled == false) unless built with FDFILE_ENABLE_STATS.
+    RepositoryStats stats() const;
+
+    /// @brief Zero the statistics
+    void resetStats();
+
+    /// @brief Install a hook called with every timed operation (see StatsHook)
+    /// @details Set it before the repository is shared between threads. Ignored unless built
+    ///          with FDFILE_ENABLE_STATS.
+    void setStatsHook(StatsHook hook);
+
+  private:
+    using AsyncQueue = detail::AsyncWriteQueue<WriteSession>;
+
+    /// @brief Writer queue bound to this object (nullptr without asyncWrites)
+    AsyncQueue* asyncQueue();
+
+    /// @brief Queue op, or run it in a session of its own without asyncWrites
+    void submitAsync(AsyncQueue::Apply op, AsyncCallback done);
+
+    /// @brief Take the locks for a read and make the cache current
+    /// @param lockFile Take the shared file lock even without threadSafe
+    bool lockForRead(ReadLock& lock, bool lockFile, std::error_code& ec);
+    /// @brief Exclusive side of gate_ for a write (empty without threadSafe)
+    std::unique_lock<std::shared_mutex> lockThreadsExclusive();
+    /// @brief Whether checkAndRefreshCache() would find nothing to do (no state is touched)
+    bool cacheIsCurrent() const;
+    /// @brief Whether no cooperating process wrote since the cache was checked (one load)
+    bool generationCurrent() const {
+        return control_ && cacheValid_ && control_->generation() == knownGen_;
+    }
+
+    /// @brief save() without the thread gate
+    bool saveRecord(const VariableRecordBase& record, std::error_code& ec);
+    /// @brief deleteById() without the thread gate
+    bool deleteRecord(const std::string& id, std::error_code& ec);
+    /// @brief deleteAll() without the thread gate
+    bool clearFile(std::error_code& ec);
+    /// @brief compact() without the thread gate
+    bool compactFile(std::error_code& ec);
+    /// @brief Exclusive file lock for one write step (already held inside a WriteSession)
+    bool lockForWriteStep(detail::FileLockGuard& lock, std::error_code& ec);
+    /// @brief Take (or convert `held` to) the session's exclusive lock and validate the cache
+    /// @param held Shared file lock of an upgrading ReadSession, or nullptr
+    bool beginWriteSession(detail::FileLockGuard* held, std::error_code& ec);
+    /// @brief Flush what the ending write session deferred and release its file lock
+    bool endWriteSession(std::error_code& ec);
+    /// @brief Live record with the given ID (caller holds a lock on a current cache)
+    Snapshot lookup(const std::string& id, std::error_code& ec);
+    /// @brief forEach() body (caller holds a lock on a current cache)
+    bool visit(const std::function<bool(const VariableRecordBase&)>& visitor,
+               std::error_code& ec);
     bool appendRecord(const VariableRecordBase& record, std::error_code& ec);
-    bool rewriteAll(const std::vector<std::unique_ptr<VariableRecordBase>>& records,
-                    std::error_code& ec);
+    /// @brief Append one entry (record or tombstone) in the file's format
+    bool appendEntry(std::string_view type, const util::KvViews& kv, std::error_code& ec);
+    /// @brief compact() if the dead-line fraction reached options_.compactThreshold
+    bool maybeCompact(std::error_code& ec);
+    /// @brief Replace the file with the batched records via `<path>.tmp` + rename
+    /// @details Readers see either the old or the new file, never a partial one.
+    bool replaceFile(std::string_view header, const detail::WriteBatch& batch,
+                     std::error_code& ec);
+    /// @brief Start a rewrite: empty rewriteBatch_ and the rewrite dictionary
+    void beginRewrite();
+    /// @brief Append the encoded `record` to rewriteBatch_
+    void batchRecord(const VariableRecordBase& record);
+    /// @brief replaceFile() with the batched records (plus the binary header)
+    bool finishRewrite(std::error_code& ec);
+    /// @brief Lock fd_, following a rename of the path by another instance
+    bool lockCurrentFile(detail::FileLockGuard& lock, detail::FileLockGuard::Mode mode,
+                         std::error_code& ec);
+    /// @brief Point fd_ (same descriptor number) at the file now at path_
+    bool reopenFile(std::error_code& ec);
+    /// @brief Remember the device/inode fd_ refers to
+    void noteFileIdentity();
+    /// @brief Replace the file with the live records (caller holds the exclusive lock)
+    /// @param pos Slot to substitute with `replacement` (nullptr drops it), or NO_SLOT
+    /// @param replacement Record written at `pos`, or appended when pos is NO_SLOT
+    bool rewriteLive(size_t pos, const VariableRecordBase* replacement, std::error_code& ec);
     bool sync(std::error_code& ec);
 
     /// @brief Detect file mtime/size changes and refresh cache
@@ -55,18 +392,147 @@ class VariableFileRepositoryImpl : public RecordRepository<VariableRecordBase> {
     void updateFileStats();
     /// @brief Load all records to cache
     bool loadAllToCache(std::error_code& ec);
+    /// @brief Parse complete lines from byte offset `from` to EOF into the cache
+    bool loadFromOffset(size_t from, std::error_code& ec);
+    /// @brief pread() fallback for loadFromOffset() when the file cannot be mapped
+    bool readLinesFrom(size_t from, size_t& consumed, std::error_code& ec);
+    /// @brief Cache every complete line (or binary frame) in [data, data + len)
+    /// @param fileOffset File offset of data[0]
+    /// @return Bytes up to and including the last complete line or frame
+    size_t cacheLines(const char* data, size_t len, uint64_t fileOffset, std::error_code& ec);
+    /// @brief Binary-format cacheLines()
+    size_t cacheFrames(const char* data, size_t len, uint64_t fileOffset, std::error_code& ec);
+    /// @brief Parse one line and append the record to the cache
+    /// @details The body of a line whose type has no prototype is not parsed.
+    void cacheLine(std::string_view line, uint64_t offset, std::error_code& ec);
+    /// @brief Apply the record or tombstone parsed into lineKv_, stored at [offset, +length)
+    /// @param typeId typeIdOf() the entry's type (never NO_TYPE)
+    void cacheEntry(uint32_t typeId, uint64_t offset, size_t length, std::error_code& ec);
+    /// @brief Index one entry: `rec` (its ID is `id`), or a tombstone for `id` if rec is
+    ///        nullptr and typeId is TOMBSTONE_TYPE
+    void indexEntry(uint32_t typeId, uint64_t offset, size_t length, std::string id,
+                    std::unique_ptr<VariableRecordBase> rec);
+
+    /// @brief One entry parsed by a scan thread, indexed later by indexEntry()
+    struct ParsedEntry {
+        uint32_t typeId;
+        uint64_t offset;
+        size_t length;
+        std::string id;
+        std::unique_ptr<VariableRecordBase> rec; ///< nullptr for tombstones and with lazyLoad
+    };
+    /// @brief Entries of one scan range, in file order
+    struct ParsedRange {
+        std::vector<ParsedEntry> entries;
+        std::error_code ec; ///< State after the range's last line, as with cacheLine()
+    };
+    /// @brief cacheLines() for text split into `chunks` ranges parsed concurrently
+    size_t cacheLinesParallel(const char* data, size_t len, uint64_t fileOffset, size_t chunks,
+                              std::error_code& ec);
+    /// @brief Parse the complete lines of [data, data + len) without touching the cache
+    void parseRange(const char* data, size_t len, uint64_t fileOffset, ParsedRange& out) const;
+    /// @brief Record of prototype typeId, filled from lineKv_ (nullptr if unknown)
+    std::unique_ptr<VariableRecordBase> materialize(uint32_t typeId, std::error_code& ec);
+    /// @brief materialize() from the fields in kv
+    std::unique_ptr<VariableRecordBase> materialize(uint32_t typeId, const util::KvViews& kv,
+                                                    std::error_code& ec) const;
+    /// @brief Index of type in prototypes_, TOMBSTONE_TYPE or NO_TYPE
+    uint32_t typeIdOf(std::string_view type) const;
+    /// @brief Slots that hold (or held, if since deleted) a record of prototype typeId
+    const std::vector<size_t>& slotsOfType(uint32_t typeId);
+    /// @brief Hash of the bytes around the start and end of [0, end)
+    uint64_t prefixFingerprint(size_t end) const;
     /// @brief Invalidate cache
     void invalidateCache();
+    /// @brief Whether a live record has the given ID
+    bool hasId(const std::string& id) const { return idIndex_.count(id) != 0; }
+    /// @brief Number of record slots (live and deleted) in file order
+    size_t slotCount() const { return options_.lazyLoad ? locs_.size() : cache_.size(); }
+    /// @brief Record in slot i (nullptr for a deleted slot, or if decoding failed)
+    /// @param remember Add a record decoded in lazyLoad mode to recordCache_
+    Snapshot recordAt(size_t i, bool remember, std::error_code& ec);
+    /// @brief pread() and decode the entry at loc (lazyLoad)
+    Snapshot decodeAt(uint64_t offset, uint32_t length, std::error_code& ec);
+    /// @brief decodeAt() of a text line with caller-owned scratch (safe to run concurrently)
+    Snapshot decodeTextAt(uint64_t offset, uint32_t length, std::string& scratch,
+                          util::KvViews& kv, std::error_code& ec) const;
+    /// @brief pread() exactly length bytes at offset into scratch
+    bool readEntry(uint64_t offset, uint32_t length, std::string& scratch,
+                   std::error_code& ec) const;
 
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+    static constexpr uint32_t NO_TYPE = static_cast<uint32_t>(-1);
+    static constexpr uint32_t TOMBSTONE_TYPE = NO_TYPE - 1;
+
+    // Declared first so a moved writer drains into the old state before it is replaced
+    detail::AsyncWriter<WriteSession> async_; ///< Background writer (asyncWrites)
     std::string path_;
+    VariableRepositoryOptions options_;
+    std::unique_ptr<detail::ThreadGate> gate_; ///< threadSafe or asyncWrites
+    std::unique_ptr<detail::ControlFile> control_; ///< Shared write generation (controlFile)
+    std::optional<uint64_t> knownGen_; ///< control_ generation the cache was last checked at
+    // Declared before fd_ so a move-assigned flusher finishes with the old fd still open
+    std::unique_ptr<detail::GroupCommitFlusher> flusher_;
     detail::UniqueFd fd_;
-    std::unordered_map<std::string, std::unique_ptr<VariableRecordBase>> prototypes_;
+    std::vector<std::unique_ptr<VariableRecordBase>> prototypes_; ///< By type id
+    std::unordered_map<std::string, uint32_t> typeIds_;              ///< typeName() → type id
 
     // Cache members
-    std::vector<std::unique_ptr<VariableRecordBase>> cache_;
+    std::vector<Snapshot> cache_;
+    // cache_ slots of deleted records are null; idIndex_ only holds live records
+    std::unordered_map<std::string, size_t> idIndex_; ///< ID → slot (last wins)
+
+    /// @brief Slots of one prototype type, in file order
+    struct TypeSlots {
+        std::vector<size_t> slots; ///< Includes slots deleted since (they read as nullptr)
+        size_t live = 0;
+    };
+    std::vector<TypeSlots> typeSlots_; ///< By type id
+    std::vector<uint32_t> slotTypes_;  ///< Type id of each slot's current version
+    bool typeSlotsStale_ = false;      ///< A slot changed type; slotsOfType() rebuilds the lists
+
+    /// @brief File location of the current version of a slot (lazyLoad replaces cache_)
+    struct EntryLoc {
+        uint64_t offset = 0;
+        uint32_t length = 0; ///< 0: deleted
+    };
+    std::vector<EntryLoc> locs_;
+    detail::LruCache<uint64_t, Snapshot> recordCache_; ///< Keyed by file offset
+    std::string readScratch_;
+    size_t logLines_ = 0; ///< Record and tombstone lines behind cache_
     bool cacheValid_ = false;
-    time_t lastMtime_ = 0;
+    int64_t lastMtimeNs_ = 0;
     size_t lastSize_ = 0;
+    dev_t fileDev_ = 0; ///< Identity of the file fd_ refers to (changes on compact())
+    ino_t fileIno_ = 0;
+
+    // Rewrite scratch, reused across rewriteAll()/compact() calls
+    detail::WriteBatch rewriteBatch_;
+    detail::BinaryEncoder rewriteEncoder_; ///< Fresh dictionary per rewrite (file header)
+    std::string rewriteHeader_;
+    util::KvViews kvScratch_;
+    std::string appendScratch_;
+
+    /// @brief Dictionary of the file as loaded (binary format); also encodes appends
+    detail::BinaryEncoder binary_;
+
+    util::KvViews lineKv_; ///< Parse scratch for cacheLine(), reused across lines
+    size_t indexedBytes_ = 0;       ///< Bytes covered by cache_ (ends after a '\n')
+    uint64_t indexedFingerprint_ = 0; ///< prefixFingerprint(indexedBytes_) when loaded
+
+    // Write tickets for Strict/Async (GroupCommit tickets come from flusher_)
+    uint64_t writeSeq_ = 0;
+    uint64_t durableSeq_ = 0;
+
+#if defined(FDFILE_ENABLE_STATS)
+    detail::StatsRecorder stats_;
+#endif
+
+    // WriteSession state
+    detail::FileLockGuard sessionLock_; ///< Exclusive lock held for the session
+    bool inWriteSession_ = false;
+    bool sessionFresh_ = false;    ///< Cache validated and not written since (skip the stat)
+    bool sessionUnsynced_ = false; ///< Strict writes of the session still to be fsynced
 };
 
 } // namespace FdFile
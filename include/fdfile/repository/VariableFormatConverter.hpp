@@ -0,0 +1,34 @@
+#pragma once
+/// @file VariableFormatConverter.hpp
+/// @brief Conversion of variable-length record files between the text and binary formats
+
+#include "RepositoryOptions.hpp"
+
+#include <string>
+#include <system_error>
+
+namespace FdFile {
+
+/// @brief Result counters of convertVariableFile()
+struct VariableConvertStats {
+    size_t entries = 0; ///< Records and tombstones written
+    size_t skipped = 0; ///< Unparsable lines or frames with a bad checksum
+};
+
+/// @brief Convert a variable-length record file to `to`
+/// @details Works on the key/value level, so no record prototypes are needed: every entry,
+///          including superseded versions and tombstones, is carried over in file order. The
+///          source format is detected from its first bytes (an empty file is empty in both).
+///          The output is written to `<dst>.tmp`, synced and renamed over dst. Take the
+///          repository out of use (or hold off writers) while converting.
+/// @param src Source file
+/// @param dst Destination file (may not be src)
+/// @param to Output format
+/// @param ec Error code set on failure (`std::errc::invalid_argument` if src and dst are the
+///        same path)
+/// @param stats Optional counters
+/// @return true on success
+bool convertVariableFile(const std::string& src, const std::string& dst, VariableFormat to,
+                         std::error_code& ec, VariableConvertStats* stats = nullptr);
+
+} // namespace FdFile
@@ -0,0 +1,239 @@
+#pragma once
+/// @file AsyncWriteQueue.hpp
+/// @brief Background writer that applies queued repository writes in batches (internal)
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Asynchronous write pipeline of a repository
+/// @tparam Session Write session type of the repository (see WriteSession)
+///
+/// submit() queues an operation and returns at once. A worker thread takes everything queued
+/// so far, opens one write session for the batch, applies the operations in submission order
+/// and commits, so a batch costs one lock acquisition and one flush however many records
+/// it holds. Each operation's completion callback then receives its own result, or the commit
+/// error if the batch could not be made durable.
+///
+/// @note This class is for internal library use. Callbacks run on the worker thread and must
+///       not wait for later submissions of the same queue.
+template <typename Session> class AsyncWriteQueue {
+  public:
+    /// @brief Operation applied inside the batch's session
+    using Apply = std::function<bool(Session&, std::error_code&)>;
+    /// @brief Completion callback
+    using Done = std::function<void(const std::error_code&)>;
+    /// @brief Opens the session of a batch
+    using Open = std::function<Session(std::error_code&)>;
+
+    /// @brief Start the worker thread
+    /// @param open Called on the worker thread for every batch
+    /// @param maxBatch Operations applied per session at most (0: no limit)
+    explicit AsyncWriteQueue(Open open, size_t maxBatch = 0)
+        : open_(std::move(open)), maxBatch_(maxBatch), thread_([this] { run(); }) {}
+
+    /// @brief Apply everything still queued and stop the thread
+    ~AsyncWriteQueue() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    // Copy/move prohibited (thread captures this)
+    AsyncWriteQueue(const AsyncWriteQueue&) = delete;
+    AsyncWriteQueue& operator=(const AsyncWriteQueue&) = delete;
+
+    /// @brief Queue an operation
+    /// @param apply Operation (runs on the worker thread)
+    /// @param done Called with the outcome once the operation's batch is committed
+    void submit(Apply apply, Done done) {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            queue_.push_back(Task{std::move(apply), std::move(done)});
+            ++submitted_;
+        }
+        cv_.notify_one();
+    }
+
+    /// @brief Block until every operation submitted before the call has completed
+    void drain() {
+        std::unique_lock<std::mutex> lk(mu_);
+        const uint64_t target = submitted_;
+        while (completed_ < target)
+            doneCv_.wait_for(lk, std::chrono::milliseconds(100));
+    }
+
+    /// @brief Operations submitted but not completed yet
+    size_t pending() const {
+        std::lock_guard<std::mutex> lk(mu_);
+        return static_cast<size_t>(submitted_ - completed_);
+    }
+
+  private:
+    struct Task {
+        Apply apply;
+        Done done;
+    };
+
+    void run() {
+        std::vector<Task> batch;
+        std::vector<std::error_code> results;
+        std::unique_lock<std::mutex> lk(mu_);
+        while (true) {
+            while (!(stop_ || !queue_.empty()))
+                cv_.wait_for(lk, std::chrono::seconds(1));
+            if (queue_.empty())
+                break; // Stopped and drained
+
+            // Take everything queued (up to maxBatch_) in one go
+            const size_t n = maxBatch_ == 0 ? queue_.size() : std::min(queue_.size(), maxBatch_);
+            batch.clear();
+            for (size_t i = 0; i < n; ++i) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+            lk.unlock();
+
+            applyBatch(batch, results);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (batch[i].done)
+                    batch[i].done(results[i]);
+            }
+            batch.clear(); // Release captured records before waking drain()
+
+            lk.lock();
+            completed_ += n;
+            doneCv_.notify_all();
+        }
+    }
+
+    void applyBatch(std::vector<Task>& batch, std::vector<std::error_code>& results) {
+        results.assign(batch.size(), std::error_code());
+        std::error_code ec;
+        Session session = open_(ec);
+        if (ec) {
+            for (auto& r : results)
+                r = ec;
+            return;
+        }
+        for (size_t i = 0; i < batch.size(); ++i)
+            batch[i].apply(session, results[i]);
+        if (!session.commit(ec)) {
+            // Nothing in the batch is known to be durable
+            for (auto& r : results) {
+                if (!r)
+                    r = ec;
+            }
+        }
+    }
+
+    Open open_;
+    size_t maxBatch_;
+
+    mutable std::mutex mu_;
+    std::condition_variable cv_;     ///< Wakes the worker
+    std::condition_variable doneCv_; ///< Wakes drain() after each batch
+    std::deque<Task> queue_;
+    uint64_t submitted_ = 0;
+    uint64_t completed_ = 0;
+    bool stop_ = false;
+
+    std::thread thread_; ///< Declared last: started after all state is initialized
+};
+
+/// @brief Movable holder of a repository's AsyncWriteQueue
+/// @tparam Session Write session type of the repository
+///
+/// The queue's open callback points at the repository, so the queue cannot follow the
+/// repository through a move. Moving the holder drains and stops the source's queue instead,
+/// and the moved-to holder starts a queue bound to its new owner on the next get(). A
+/// repository declares the holder as its first member: members are moved in declaration
+/// order, so the source's batches still run against intact state.
+///
+/// @note This class is for internal library use. get() may be called from several threads;
+///       moves and stop() must not overlap any other call.
+template <typename Session> class AsyncWriter {
+  public:
+    using Queue = AsyncWriteQueue<Session>;
+
+    AsyncWriter() = default;
+
+    /// @brief Stop the queue (applying everything still queued)
+    ~AsyncWriter() { stop(); }
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    /// @brief Take over the configuration; the source's queue is drained and stopped
+    AsyncWriter(AsyncWriter&& other) noexcept
+        : enabled_(other.enabled_), maxBatch_(other.maxBatch_) {
+        other.stop();
+    }
+
+    /// @brief Drain and stop both queues, then take over the configuration
+    AsyncWriter& operator=(AsyncWriter&& other) noexcept {
+        if (this != &other) {
+            stop();
+            other.stop();
+            enabled_ = other.enabled_;
+            maxBatch_ = other.maxBatch_;
+        }
+        return *this;
+    }
+
+    /// @brief Turn the writer on (see AsyncWriteQueue::AsyncWriteQueue())
+    void enable(size_t maxBatch) {
+        enabled_ = true;
+        maxBatch_ = maxBatch;
+    }
+
+    /// @brief Running queue, started with `open` if needed; nullptr while disabled
+    template <typename Open> Queue* get(Open&& open) {
+        if (!enabled_)
+            return nullptr;
+        std::lock_guard<std::mutex> lk(mu_);
+        if (!queue_)
+            queue_ = std::make_unique<Queue>(std::forward<Open>(open), maxBatch_);
+        return queue_.get();
+    }
+
+    /// @brief Running queue, or nullptr if none has been started since the last stop
+    Queue* current() {
+        std::lock_guard<std::mutex> lk(mu_);
+        return queue_.get();
+    }
+
+    /// @brief Apply everything queued and stop the worker thread
+    void stop() noexcept {
+        std::unique_ptr<Queue> queue;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            queue = std::move(queue_);
+        }
+        queue.reset(); // Joins the worker outside mu_
+    }
+
+  private:
+    std::mutex mu_; ///< Guards starting queue_ from several threads
+    std::unique_ptr<Queue> queue_;
+    bool enabled_ = false;
+    size_t maxBatch_ = 0;
+};
+
+} // namespace detail
+} // namespace FdFile
@@ -0,0 +1,318 @@
+#pragma once
+/// @file BinaryCodec.hpp
+/// @brief Length-prefixed binary encoding of variable-length records (internal)
+///
+/// File layout (VariableFormat::Binary):
+///
+///     magic (8 bytes) frame frame ...
+///     frame   = varint(payload length) payload crc32c(payload) (4 bytes, little endian)
+///     payload = kind (1 byte) body
+///
+/// A Dictionary body is `varint(first id) varint(count) {varint(len) bytes}*` and assigns the
+/// next ids to type names and keys. A Record body is
+/// `varint(type id) varint(field count) {varint(key id) tag value}*`, where the tag says
+/// whether the value is a string, a numeric token or a zigzag varint integer. Symbols are
+/// always defined before the first record that uses them, so frames can be appended.
+
+#include "Crc32c.hpp"
+#include "textFormatUtil.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief First bytes of a binary variable-length file (the last byte is the format version)
+/// @details 0x89 cannot start a text line, so the format is recognizable from the first byte.
+inline constexpr char BINARY_MAGIC[] = "\x89"
+                                       "FDVB\r\n\x01";
+constexpr size_t BINARY_MAGIC_LEN = sizeof(BINARY_MAGIC) - 1;
+
+/// @brief Largest payload accepted by readBinaryFrame()
+constexpr uint64_t BINARY_MAX_PAYLOAD = 1u << 30;
+
+/// @brief Payload kinds
+enum class BinaryFrameKind : unsigned char { Dictionary = 1, Record = 2 };
+
+/// @brief Field value tags of a Record payload
+enum class BinaryValueTag : unsigned char {
+    Number = 0, ///< Numeric token stored as text (not a canonical int64)
+    String = 1, ///< Raw string bytes (no escaping)
+    Int = 2     ///< Canonical int64 numeric token as a zigzag varint
+};
+
+/// @brief Whether the file content starting with [data, data + len) is in the binary format
+/// @details A prefix of the magic (a header still being written) counts as binary.
+inline bool isBinaryVariableData(const char* data, size_t len) noexcept {
+    const size_t n = len < BINARY_MAGIC_LEN ? len : BINARY_MAGIC_LEN;
+    return n > 0 && std::memcmp(data, BINARY_MAGIC, n) == 0;
+}
+
+/// @brief Append v as an LEB128 varint (1-10 bytes)
+inline void appendVarint(std::string& out, uint64_t v) {
+    char buf[10];
+    size_t n = 0;
+    while (v >= 0x80) {
+        buf[n++] = static_cast<char>((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = static_cast<char>(v);
+    out.append(buf, n);
+}
+
+/// @brief Read a varint at p
+/// @return false if the input ends inside the varint or it is longer than 10 bytes
+inline bool readVarint(const char*& p, const char* end, uint64_t& v) noexcept {
+    v = 0;
+    for (unsigned shift = 0; shift < 70 && p < end; shift += 7) {
+        const auto b = static_cast<unsigned char>(*p++);
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Map signed to unsigned so small magnitudes get short varints
+inline uint64_t zigzagEncode(int64_t v) noexcept {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) noexcept {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+/// @brief Per-file symbol table of type names and keys
+/// @details Symbols are stored in a deque, so views returned by symbol() stay valid until
+///          clear().
+class BinaryDictionary {
+  public:
+    size_t size() const noexcept { return symbols_.size(); }
+
+    /// @brief Symbol with the given id (id < size())
+    std::string_view symbol(size_t id) const noexcept { return symbols_[id]; }
+
+    /// @brief Id of s, adding it if it is new
+    uint32_t intern(std::string_view s) {
+        auto it = ids_.find(s);
+        if (it != ids_.end())
+            return it->second;
+        return add(s);
+    }
+
+    /// @brief Append a symbol (the next id), even if it already exists
+    uint32_t add(std::string_view s) {
+        const auto id = static_cast<uint32_t>(symbols_.size());
+        symbols_.emplace_back(s);
+        ids_.emplace(symbols_.back(), id); // Keeps the first id of a duplicate
+        return id;
+    }
+
+    void clear() noexcept {
+        symbols_.clear();
+        ids_.clear();
+    }
+
+  private:
+    std::deque<std::string> symbols_;
+    std::unordered_map<std::string_view, uint32_t> ids_; ///< Views into symbols_
+};
+
+/// @brief Append a frame holding payload
+inline void appendBinaryFrame(std::string& out, std::string_view payload) {
+    appendVarint(out, payload.size());
+    out.append(payload.data(), payload.size());
+    const uint32_t crc = crc32c(payload.data(), payload.size());
+    const char le[4] = {static_cast<char>(crc), static_cast<char>(crc >> 8),
+                        static_cast<char>(crc >> 16), static_cast<char>(crc >> 24)};
+    out.append(le, 4);
+}
+
+/// @brief Encoder that keeps a dictionary and reusable payload buffers
+/// @note This class is for internal library use.
+class BinaryEncoder {
+  public:
+    BinaryDictionary& dictionary() noexcept { return dict_; }
+
+    /// @brief Append the frame of one record
+    /// @param defineSymbols Precede it with a Dictionary frame for the symbols it introduces.
+    ///        When false, the new symbols must be written later through appendDictionary()
+    ///        ahead of the record (e.g. as a file header).
+    void appendRecord(std::string& out, std::string_view type, const util::KvViews& kv,
+                      bool defineSymbols = true) {
+        const size_t known = dict_.size();
+        record_.clear();
+        record_.push_back(static_cast<char>(BinaryFrameKind::Record));
+        appendVarint(record_, dict_.intern(type));
+        appendVarint(record_, kv.size());
+        for (const auto& e : kv) {
+            appendVarint(record_, dict_.intern(e.key));
+            int64_t n;
+            if (e.isString) {
+                record_.push_back(static_cast<char>(BinaryValueTag::String));
+            } else if (isCanonicalInt(e.value, n)) {
+                record_.push_back(static_cast<char>(BinaryValueTag::Int));
+                appendVarint(record_, zigzagEncode(n));
+                continue;
+            } else {
+                record_.push_back(static_cast<char>(BinaryValueTag::Number));
+            }
+            appendVarint(record_, e.value.size());
+            record_.append(e.value.data(), e.value.size());
+        }
+
+        if (defineSymbols && dict_.size() > known)
+            appendDictionary(out, known);
+        appendBinaryFrame(out, record_);
+    }
+
+    /// @brief Append a Dictionary frame defining the symbols with ids [first, size())
+    void appendDictionary(std::string& out, size_t first = 0) {
+        symbols_.clear();
+        symbols_.push_back(static_cast<char>(BinaryFrameKind::Dictionary));
+        appendVarint(symbols_, first);
+        appendVarint(symbols_, dict_.size() - first);
+        for (size_t i = first; i < dict_.size(); ++i) {
+            const std::string_view s = dict_.symbol(i);
+            appendVarint(symbols_, s.size());
+            symbols_.append(s.data(), s.size());
+        }
+        appendBinaryFrame(out, symbols_);
+    }
+
+    /// @brief Forget the dictionary (keeps buffer capacity)
+    void clear() noexcept { dict_.clear(); }
+
+  private:
+    /// @brief Whether v is exactly what std::to_chars prints for some int64
+    static bool isCanonicalInt(std::string_view v, int64_t& n) noexcept {
+        if (v.empty() || v.size() > 20)
+            return false;
+        auto r = std::from_chars(v.data(), v.data() + v.size(), n);
+        if (r.ec != std::errc() || r.ptr != v.data() + v.size())
+            return false;
+        char buf[20];
+        auto w = std::to_chars(buf, buf + sizeof(buf), n);
+        return static_cast<size_t>(w.ptr - buf) == v.size() &&
+               std::memcmp(buf, v.data(), v.size()) == 0;
+    }
+
+    BinaryDictionary dict_;
+    std::string record_;
+    std::string symbols_;
+};
+
+/// @brief Result of readBinaryFrame()
+enum class BinaryFrameStatus {
+    Ok,          ///< Payload returned, p advanced past the frame
+    Incomplete,  ///< The input ends inside the frame; p unchanged
+    BadChecksum, ///< Checksum mismatch; p advanced past the frame
+    Malformed    ///< Impossible length; the rest of the input cannot be framed
+};
+
+/// @brief Read the frame starting at p
+inline BinaryFrameStatus readBinaryFrame(const char*& p, const char* end,
+                                         std::string_view& payload) noexcept {
+    const char* q = p;
+    uint64_t len;
+    if (!readVarint(q, end, len))
+        return q == end ? BinaryFrameStatus::Incomplete : BinaryFrameStatus::Malformed;
+    if (len == 0 || len > BINARY_MAX_PAYLOAD)
+        return BinaryFrameStatus::Malformed;
+    if (static_cast<uint64_t>(end - q) < len + 4)
+        return BinaryFrameStatus::Incomplete;
+
+    payload = std::string_view(q, static_cast<size_t>(len));
+    const auto* c = reinterpret_cast<const unsigned char*>(q + len);
+    const uint32_t stored = static_cast<uint32_t>(c[0]) | static_cast<uint32_t>(c[1]) << 8 |
+                            static_cast<uint32_t>(c[2]) << 16 | static_cast<uint32_t>(c[3]) << 24;
+    p = q + len + 4;
+    return crc32c(payload.data(), payload.size()) == stored ? BinaryFrameStatus::Ok
+                                                            : BinaryFrameStatus::BadChecksum;
+}
+
+/// @brief What decodeBinaryPayload() found
+enum class BinaryPayloadKind { Record, Dictionary, Invalid };
+
+/// @brief Decode a frame payload
+/// @details Dictionary payloads are applied to dict. For a Record, `type`, keys and string
+///          values view dict and the payload (no copy); integers are formatted into `out`'s
+///          own storage.
+inline BinaryPayloadKind decodeBinaryPayload(std::string_view payload, BinaryDictionary& dict,
+                                             std::string_view& type, util::KvViews& out) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    if (p == end)
+        return BinaryPayloadKind::Invalid;
+    const auto kind = static_cast<BinaryFrameKind>(*p++);
+    uint64_t a, b;
+
+    if (kind == BinaryFrameKind::Dictionary) {
+        // Frames defining ids the reader already has (or skipping some) are ignored
+        if (!readVarint(p, end, a) || !readVarint(p, end, b) || a != dict.size())
+            return BinaryPayloadKind::Invalid;
+        for (uint64_t i = 0; i < b; ++i) {
+            uint64_t len;
+            if (!readVarint(p, end, len) || static_cast<uint64_t>(end - p) < len)
+                return BinaryPayloadKind::Invalid;
+            dict.add(std::string_view(p, static_cast<size_t>(len)));
+            p += len;
+        }
+        return BinaryPayloadKind::Dictionary;
+    }
+    if (kind != BinaryFrameKind::Record)
+        return BinaryPayloadKind::Invalid;
+
+    out.clear();
+    if (!readVarint(p, end, a) || a >= dict.size() || !readVarint(p, end, b))
+        return BinaryPayloadKind::Invalid;
+    type = dict.symbol(static_cast<size_t>(a));
+    for (uint64_t i = 0; i < b; ++i) {
+        uint64_t key, v;
+        if (!readVarint(p, end, key) || key >= dict.size() || p == end)
+            return BinaryPayloadKind::Invalid;
+        const auto tag = static_cast<BinaryValueTag>(*p++);
+        if (!readVarint(p, end, v))
+            return BinaryPayloadKind::Invalid;
+        const std::string_view k = dict.symbol(static_cast<size_t>(key));
+
+        if (tag == BinaryValueTag::Int) {
+            std::string& s = out.scratch();
+            char buf[20];
+            auto w = std::to_chars(buf, buf + sizeof(buf), zigzagDecode(v));
+            s.assign(buf, w.ptr);
+            out.add(k, false, s);
+            continue;
+        }
+        if ((tag != BinaryValueTag::String && tag != BinaryValueTag::Number) ||
+            static_cast<uint64_t>(end - p) < v)
+            return BinaryPayloadKind::Invalid;
+        out.add(k, tag == BinaryValueTag::String, std::string_view(p, static_cast<size_t>(v)));
+        p += v;
+    }
+    return p == end ? BinaryPayloadKind::Record : BinaryPayloadKind::Invalid;
+}
+
+/// @brief Type name of a record payload without decoding its fields
+/// @return false for dictionary or invalid payloads
+inline bool peekBinaryRecordType(std::string_view payload, const BinaryDictionary& dict,
+                                 std::string_view& type) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    uint64_t a;
+    if (p == end || static_cast<BinaryFrameKind>(*p++) != BinaryFrameKind::Record ||
+        !readVarint(p, end, a) || a >= dict.size())
+        return false;
+    type = dict.symbol(static_cast<size_t>(a));
+    return true;
+}
+
+} // namespace detail
+} // namespace FdFile
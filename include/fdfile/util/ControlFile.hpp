@@ -0,0 +1,135 @@
+#pragma once
+/// @file ControlFile.hpp
+/// @brief Memory-mapped write generation shared by cooperating processes (internal)
+
+#include "FileLockGuard.hpp"
+#include "MmapGuard.hpp"
+#include "UniqueFd.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Control file (`<data path>.ctl`) holding the data file's write generation
+///
+/// Every process that writes the data file with the option enabled bumps the generation under
+/// the data file's exclusive lock. A reader that remembers the generation its cache was built
+/// at can then confirm with one atomic load of shared memory that no cooperating process has
+/// written since, instead of calling stat().
+///
+/// A second counter, the layout generation, is bumped only by writes that remove a record
+/// from its slot (deletes, compaction). While it is unchanged, records written by others can
+/// only have been appended or put into slots that were free, so a reader may index just
+/// those.
+///
+/// @note This class is for internal library use. The file only holds a counter and may be
+///       deleted while no process has it open.
+class ControlFile {
+  public:
+    /// @brief On-disk layout (64 bytes)
+    struct Header {
+        char magic[8];       ///< "FDCTL01\0"
+        uint32_t version;    ///< Format version
+        uint32_t reserved0;
+        uint64_t generation; ///< Accessed only through atomic operations
+        uint64_t layout;     ///< Layout generation (atomic; zero in files from before it)
+        char reserved[32];
+    };
+    static_assert(sizeof(Header) == 64, "ControlFile header must stay 64 bytes");
+
+    static constexpr uint32_t VERSION = 1;
+
+    ControlFile() = default;
+
+    /// @brief Open or create the control file and map its header
+    /// @param path Control file path
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool open(const std::string& path, std::error_code& ec) {
+        ec.clear();
+        int flags = O_CREAT | O_RDWR;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+        fd_.reset(::open(path.c_str(), flags, 0644));
+        if (!fd_) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+
+        // Serialize initialization with other processes opening the same file
+        FileLockGuard lock(fd_.get(), FileLockGuard::Mode::Exclusive, ec);
+        if (ec)
+            return false;
+        struct stat st{};
+        if (::fstat(fd_.get(), &st) < 0 ||
+            (static_cast<size_t>(st.st_size) < sizeof(Header) &&
+             ::ftruncate(fd_.get(), sizeof(Header)) < 0)) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        void* ptr =
+            ::mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd_.get(), 0);
+        if (ptr == MAP_FAILED) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        map_.reset(ptr, sizeof(Header));
+
+        Header& h = header();
+        if (std::memcmp(h.magic, MAGIC, sizeof(h.magic)) != 0 || h.version != VERSION) {
+            // New or foreign content. Any value works as long as it changes on every write.
+            h.version = VERSION;
+            std::memcpy(h.magic, MAGIC, sizeof(h.magic));
+            bump();
+        }
+        return true;
+    }
+
+    /// @brief Whether open() succeeded
+    explicit operator bool() const noexcept { return static_cast<bool>(map_); }
+
+    /// @brief Current generation (acquire load, no system call)
+    uint64_t generation() const noexcept {
+        return __atomic_load_n(&header().generation, __ATOMIC_ACQUIRE);
+    }
+
+    /// @brief Announce a write (call while holding the data file's exclusive lock)
+    /// @return The new generation
+    uint64_t bump() noexcept {
+        return __atomic_add_fetch(&header().generation, 1, __ATOMIC_ACQ_REL);
+    }
+
+    /// @brief Current layout generation (acquire load, no system call)
+    uint64_t layoutGeneration() const noexcept {
+        return __atomic_load_n(&header().layout, __ATOMIC_ACQUIRE);
+    }
+
+    /// @brief Announce that a record left its slot (call under the data file's exclusive lock)
+    /// @return The new layout generation
+    uint64_t bumpLayout() noexcept {
+        return __atomic_add_fetch(&header().layout, 1, __ATOMIC_ACQ_REL);
+    }
+
+  private:
+    static constexpr char MAGIC[8] = {'F', 'D', 'C', 'T', 'L', '0', '1', '\0'};
+
+    Header& header() noexcept { return *static_cast<Header*>(map_.get()); }
+    const Header& header() const noexcept { return *static_cast<const Header*>(map_.get()); }
+
+    UniqueFd fd_;
+    MmapGuard map_;
+};
+
+} // namespace detail
+} // namespace FdFile
@@ -0,0 +1,132 @@
+#pragma once
+/// @file Crc32c.hpp
+/// @brief CRC-32C (Castagnoli) checksum with hardware acceleration where available (internal)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(FDFILE_NO_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define FDFILE_CRC32C_X86 1
+#elif !defined(FDFILE_NO_SIMD) && defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define FDFILE_CRC32C_ARM 1
+#endif
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Reflected CRC-32C polynomial
+constexpr uint32_t CRC32C_POLY = 0x82F63B78u;
+
+/// @brief Slice-by-8 lookup tables (table[k][b]: CRC of byte b followed by k zero bytes)
+using Crc32cTables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Crc32cTables makeCrc32cTables() {
+    Crc32cTables t{};
+    for (uint32_t b = 0; b < 256; ++b) {
+        uint32_t c = b;
+        for (int i = 0; i < 8; ++i)
+            c = (c >> 1) ^ ((c & 1u) ? CRC32C_POLY : 0u);
+        t[0][b] = c;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t b = 0; b < 256; ++b)
+            t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xFFu];
+    }
+    return t;
+}
+
+inline constexpr Crc32cTables CRC32C_TABLES = makeCrc32cTables();
+
+/// @brief Portable slice-by-8 kernel
+/// @param crc Running checksum (already inverted, see crc32c())
+inline uint32_t crc32cScalar(uint32_t crc, const char* p, size_t len) noexcept {
+    const auto* s = reinterpret_cast<const unsigned char*>(p);
+    const auto& t = CRC32C_TABLES;
+    while (len >= 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, s, 4);
+        std::memcpy(&hi, s + 4, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        lo = __builtin_bswap32(lo);
+        hi = __builtin_bswap32(hi);
+#endif
+        lo ^= crc;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^
+              t[4][lo >> 24] ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^
+              t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        s += 8;
+        len -= 8;
+    }
+    while (len-- > 0)
+        crc = (crc >> 8) ^ t[0][(crc ^ *s++) & 0xFF];
+    return crc;
+}
+
+#if defined(FDFILE_CRC32C_X86)
+
+/// @brief SSE4.2 `crc32` instruction kernel (8 bytes per step)
+__attribute__((target("sse4.2"))) inline uint32_t crc32cSse42(uint32_t crc, const char* p,
+                                                               size_t len) noexcept {
+    uint64_t c = crc;
+    while (len >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+        p += 8;
+        len -= 8;
+    }
+    uint32_t c32 = static_cast<uint32_t>(c);
+    while (len-- > 0)
+        c32 = _mm_crc32_u8(c32, static_cast<unsigned char>(*p++));
+    return c32;
+}
+
+#elif defined(FDFILE_CRC32C_ARM)
+
+/// @brief ARMv8 CRC extension kernel (8 bytes per step)
+inline uint32_t crc32cArm(uint32_t crc, const char* p, size_t len) noexcept {
+    while (len >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+        p += 8;
+        len -= 8;
+    }
+    while (len-- > 0)
+        crc = __crc32cb(crc, static_cast<uint8_t>(*p++));
+    return crc;
+}
+
+#endif
+
+/// @brief Kernel signature (running, inverted checksum in and out)
+using Crc32cKernel = uint32_t (*)(uint32_t, const char*, size_t) noexcept;
+
+/// @brief Best CRC-32C kernel for this CPU
+inline Crc32cKernel selectCrc32cKernel() noexcept {
+#if defined(FDFILE_CRC32C_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2"))
+        return &crc32cSse42;
+    return &crc32cScalar;
+#elif defined(FDFILE_CRC32C_ARM)
+    return &crc32cArm;
+#else
+    return &crc32cScalar;
+#endif
+}
+
+/// @brief CRC-32C of [data, data + len)
+/// @param seed Checksum of the preceding bytes, to checksum data in pieces (0 to start)
+/// @return Checksum (crc32c("123456789") == 0xE3069283)
+inline uint32_t crc32c(const char* data, size_t len, uint32_t seed = 0) noexcept {
+    static const Crc32cKernel kernel = selectCrc32cKernel();
+    return ~kernel(~seed, data, len);
+}
+
+} // namespace detail
+} // namespace FdFile
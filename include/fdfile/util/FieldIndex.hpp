@@ -0,0 +1,131 @@
+#pragma once
+/// @file FieldIndex.hpp
+/// @brief Secondary field value → slot index of a fixed-length repository (internal)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief In-memory index from the value of one record field to the slots holding it
+///
+/// A hash index maps string or numeric values to their slots; an ordered index keeps
+/// (value, slot) pairs of a numeric field sorted for range lookups. The index stores slot
+/// numbers only: the repository reads the records through views of its mapping.
+///
+/// @note This class is for internal library use.
+class FieldIndex {
+  public:
+    /// @param field Field index in the record layout
+    /// @param numeric Whether the field is an FD_NUM field
+    /// @param ordered Ordered (range) index instead of a hash index; numeric fields only
+    FieldIndex(size_t field, bool numeric, bool ordered)
+        : field_(field), numeric_(numeric), ordered_(ordered) {}
+
+    size_t field() const noexcept { return field_; }
+    bool numeric() const noexcept { return numeric_; }
+    bool ordered() const noexcept { return ordered_; }
+
+    void add(std::string_view value, size_t slot) { strings_[std::string(value)].push_back(slot); }
+
+    void add(int64_t value, size_t slot) {
+        if (ordered_)
+            sorted_.emplace(value, slot);
+        else
+            numbers_[value].push_back(slot);
+    }
+
+    void remove(std::string_view value, size_t slot) {
+        auto it = strings_.find(std::string(value));
+        if (it != strings_.end() && eraseSlot(it->second, slot))
+            strings_.erase(it);
+    }
+
+    void remove(int64_t value, size_t slot) {
+        if (ordered_) {
+            sorted_.erase({value, slot});
+            return;
+        }
+        auto it = numbers_.find(value);
+        if (it != numbers_.end() && eraseSlot(it->second, slot))
+            numbers_.erase(it);
+    }
+
+    void clear() {
+        strings_.clear();
+        numbers_.clear();
+        sorted_.clear();
+    }
+
+    /// @brief Slots holding a string value, ascending
+    std::vector<size_t> equal(std::string_view value) const {
+        auto it = strings_.find(std::string(value));
+        return it == strings_.end() ? std::vector<size_t>() : sortedCopy(it->second);
+    }
+
+    /// @brief Slots holding a numeric value, ascending
+    std::vector<size_t> equal(int64_t value) const {
+        if (ordered_)
+            return range(value, value);
+        auto it = numbers_.find(value);
+        return it == numbers_.end() ? std::vector<size_t>() : sortedCopy(it->second);
+    }
+
+    /// @brief Slots whose value lies in [lo, hi], by value and then by slot (ordered only)
+    std::vector<size_t> range(int64_t lo, int64_t hi) const {
+        std::vector<size_t> out;
+        if (lo > hi)
+            return out;
+        for (auto it = sorted_.lower_bound({lo, 0}); it != sorted_.end() && it->first <= hi; ++it)
+            out.push_back(it->second);
+        return out;
+    }
+
+    /// @brief Number of indexed slots
+    size_t size() const noexcept {
+        if (ordered_)
+            return sorted_.size();
+        size_t n = 0;
+        for (const auto& e : strings_)
+            n += e.second.size();
+        for (const auto& e : numbers_)
+            n += e.second.size();
+        return n;
+    }
+
+  private:
+    /// @brief Remove slot from a value's list (order is not kept)
+    /// @return true if the list became empty
+    static bool eraseSlot(std::vector<size_t>& slots, size_t slot) {
+        auto it = std::find(slots.begin(), slots.end(), slot);
+        if (it != slots.end()) {
+            *it = slots.back();
+            slots.pop_back();
+        }
+        return slots.empty();
+    }
+
+    static std::vector<size_t> sortedCopy(const std::vector<size_t>& slots) {
+        std::vector<size_t> out(slots);
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    size_t field_;
+    bool numeric_;
+    bool ordered_;
+    std::unordered_map<std::string, std::vector<size_t>> strings_; ///< Hash, string field
+    std::unordered_map<int64_t, std::vector<size_t>> numbers_;     ///< Hash, numeric field
+    std::set<std::pair<int64_t, size_t>> sorted_;                  ///< Ordered
+};
+
+} // namespace detail
+} // namespace FdFile
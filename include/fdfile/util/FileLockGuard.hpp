@@ -36,6 +36,21 @@ class FileLockGuard {
         Exclusive ///< Exclusive lock (write, only one process can acquire)
     };
 
+    /// @brief Who holds the lock
+    enum class Owner {
+        Process, ///< Classic fcntl lock, shared by every descriptor of the process
+        OpenFile ///< Lock of the open file description (F_OFD_SETLKW) where available
+    };
+
+    /// @brief Whether Owner::OpenFile locks are separate from process locks on this platform
+    /// @details Without them Owner::OpenFile falls back to a process lock: two descriptors of
+    ///          one process then never conflict, and closing either releases both.
+#ifdef F_OFD_SETLKW
+    static constexpr bool openFileLocks = true;
+#else
+    static constexpr bool openFileLocks = false;
+#endif
+
     /// @brief Default constructor. Creates without acquiring lock
     FileLockGuard() = default;
 
@@ -53,7 +68,8 @@ class FileLockGuard {
     FileLockGuard& operator=(const FileLockGuard&) = delete;
 
     /// @brief Move constructor
-    FileLockGuard(FileLockGuard&& other) noexcept : fd_(other.fd_), locked_(other.locked_) {
+    FileLockGuard(FileLockGuard&& other) noexcept
+        : fd_(other.fd_), locked_(other.locked_), owner_(other.owner_) {
         other.fd_ = -1;
         other.locked_ = false;
     }
@@ -64,6 +80,7 @@ class FileLockGuard {
             unlockIgnore();
             fd_ = other.fd_;
             locked_ = other.locked_;
+            owner_ = other.owner_;
             other.fd_ = -1;
             other.locked_ = false;
         }
@@ -74,14 +91,16 @@ class FileLockGuard {
     /// @param fd File descriptor to lock
     /// @param mode Lock mode
     /// @param ec Error code
+    /// @param owner Owner::OpenFile makes descriptors of one process exclude each other
     /// @return true on success
     /// @note Releases existing lock first if held
-    bool lock(int fd, Mode mode, std::error_code& ec) {
+    bool lock(int fd, Mode mode, std::error_code& ec, Owner owner = Owner::Process) {
         ec.clear();
         // 동일 객체에서 잠금 대상을 바꾸는 경우를 허용하기 위해 기존 잠금부터 정리한다.
         // 잠금 중첩 상태를 남기지 않도록 RAII 객체의 상태를 항상 단일 잠금으로 유지한다.
         unlockIgnore();
         fd_ = fd;
+        owner_ = owner;
 
         if (fd_ < 0) {
             ec = std::make_error_code(std::errc::bad_file_descriptor);
@@ -95,7 +114,7 @@ class FileLockGuard {
         fl.l_whence = SEEK_SET;
         fl.l_start = 0;
         fl.l_len = 0; // 0 = entire file
-        if (::fcntl(fd_, F_SETLKW, &fl) < 0) {
+        if (::fcntl(fd_, waitCommand(), &fl) < 0) {
             ec = std::error_code(errno, std::generic_category());
             fd_ = -1;
             locked_ = false;
@@ -106,6 +125,30 @@ class FileLockGuard {
         return true;
     }
 
+    /// @brief Change the mode of the held lock without releasing it
+    /// @param mode New lock mode
+    /// @param ec Error code (set on failure; the lock keeps its old mode)
+    /// @return true on success
+    /// @note fcntl replaces the lock in place, so no other process can take the file in
+    ///       between. When two processes upgrade at once, one of them fails with EDEADLK.
+    bool convert(Mode mode, std::error_code& ec) {
+        ec.clear();
+        if (!locked_ || fd_ < 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        struct flock fl{};
+        fl.l_type = (mode == Mode::Shared) ? F_RDLCK : F_WRLCK;
+        fl.l_whence = SEEK_SET;
+        fl.l_start = 0;
+        fl.l_len = 0;
+        if (::fcntl(fd_, waitCommand(), &fl) < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        return true;
+    }
+
     /// @brief Release lock (ignores errors)
     void unlockIgnore() noexcept {
         if (!locked_ || fd_ < 0)
@@ -117,7 +160,11 @@ class FileLockGuard {
         fl.l_whence = SEEK_SET;
         fl.l_start = 0;
         fl.l_len = 0;
+#ifdef F_OFD_SETLK
+        ::fcntl(fd_, owner_ == Owner::OpenFile ? F_OFD_SETLK : F_SETLK, &fl);
+#else
         ::fcntl(fd_, F_SETLK, &fl);
+#endif
         locked_ = false;
         fd_ = -1;
     }
@@ -127,8 +174,18 @@ class FileLockGuard {
     bool locked() const noexcept { return locked_; }
 
   private:
+    /// @brief Blocking fcntl command for owner_ (OFD locks need l_pid == 0, as set by flock{})
+    int waitCommand() const noexcept {
+#ifdef F_OFD_SETLKW
+        if (owner_ == Owner::OpenFile)
+            return F_OFD_SETLKW;
+#endif
+        return F_SETLKW;
+    }
+
     int fd_ = -1;
     bool locked_ = false;
+    Owner owner_ = Owner::Process;
 };
 
 } // namespace detail
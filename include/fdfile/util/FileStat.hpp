@@ -0,0 +1,23 @@
+#pragma once
+/// @file FileStat.hpp
+/// @brief stat() helpers shared by the repositories (internal)
+
+#include <sys/stat.h>
+
+#include <cstdint>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Modification time of a stat result in nanoseconds
+inline int64_t statMtimeNs(const struct stat& st) noexcept {
+#if defined(__APPLE__)
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL +
+           st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+}
+
+} // namespace detail
+} // namespace FdFile
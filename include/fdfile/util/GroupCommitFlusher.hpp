@@ -0,0 +1,168 @@
+#pragma once
+/// @file GroupCommitFlusher.hpp
+/// @brief Background flusher that coalesces many writes into one fdatasync (internal)
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Flush file data (and the metadata needed to read it back) to stable storage
+/// @param fd File descriptor
+/// @param ec Error code set on failure
+/// @return true on success
+inline bool syncFileData(int fd, std::error_code& ec) {
+#if defined(__APPLE__)
+    int rc = ::fsync(fd);
+#else
+    int rc = ::fdatasync(fd);
+#endif
+    if (rc < 0) {
+        ec = std::error_code(errno, std::generic_category());
+        return false;
+    }
+    return true;
+}
+
+/// @brief Group-commit flusher
+///
+/// Writers call noteWrite() after each write and get a ticket back. A background thread
+/// issues one fdatasync for every batch of pending writes, either after `interval` or as
+/// soon as `maxPending` writes are queued. waitDurable() blocks until a ticket is on disk.
+///
+/// @note Works on the file descriptor only, so it stays valid when the owning repository
+///       is moved. On Linux, fdatasync also writes back pages dirtied through MAP_SHARED
+///       mappings of the same file.
+class GroupCommitFlusher {
+  public:
+    /// @brief Start the flusher thread
+    /// @param fd File descriptor to flush (not owned)
+    /// @param interval Maximum delay between a write and its flush
+    /// @param maxPending Pending write count that triggers an early flush
+    GroupCommitFlusher(int fd, std::chrono::milliseconds interval, size_t maxPending)
+        : fd_(fd), interval_(interval), maxPending_(maxPending == 0 ? 1 : maxPending),
+          thread_([this] { run(); }) {}
+
+    /// @brief Flush outstanding writes and stop the thread
+    ~GroupCommitFlusher() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    // Copy/move prohibited (thread captures this)
+    GroupCommitFlusher(const GroupCommitFlusher&) = delete;
+    GroupCommitFlusher& operator=(const GroupCommitFlusher&) = delete;
+
+    /// @brief Register a completed write
+    /// @return Ticket to pass to waitDurable()
+    uint64_t noteWrite() {
+        uint64_t ticket;
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            ticket = ++issued_;
+            // Only wake the thread when it is idle (first pending write) or the batch is full
+            const uint64_t pending = issued_ - durable_;
+            wake = (pending == 1 || pending >= maxPending_);
+        }
+        if (wake)
+            cv_.notify_one();
+        return ticket;
+    }
+
+    /// @brief Most recently issued ticket (0 if nothing written yet)
+    uint64_t lastTicket() const {
+        std::lock_guard<std::mutex> lk(mu_);
+        return issued_;
+    }
+
+    /// @brief Block until the given ticket is durable
+    /// @param ticket Ticket returned by noteWrite()
+    /// @param ec Error code set if the covering flush failed
+    /// @return true once durable
+    bool waitDurable(uint64_t ticket, std::error_code& ec) {
+        ec.clear();
+        std::unique_lock<std::mutex> lk(mu_);
+        if (durable_ >= ticket)
+            return true;
+
+        const uint64_t errorsBefore = errorCount_;
+        ++waiters_;
+        cv_.notify_one();
+        while (!(durable_ >= ticket || errorCount_ != errorsBefore || stop_))
+            doneCv_.wait_for(lk, interval_);
+        --waiters_;
+
+        if (durable_ >= ticket)
+            return true;
+        ec = lastError_ ? lastError_ : std::make_error_code(std::errc::io_error);
+        return false;
+    }
+
+  private:
+    void run() {
+        std::unique_lock<std::mutex> lk(mu_);
+        while (true) {
+            // Sleep until there is something to flush
+            while (!(stop_ || issued_ != durable_))
+                cv_.wait_for(lk, std::chrono::seconds(1));
+            if (issued_ == durable_ && stop_)
+                break;
+
+            // Coalesce: wait for the interval unless enough writes piled up or someone waits
+            cv_.wait_for(lk, interval_, [&] {
+                return stop_ || waiters_ > 0 || issued_ - durable_ >= maxPending_;
+            });
+
+            const uint64_t target = issued_;
+            lk.unlock();
+            std::error_code ec;
+            bool ok = syncFileData(fd_, ec);
+            lk.lock();
+
+            if (ok) {
+                if (target > durable_)
+                    durable_ = target;
+            } else {
+                lastError_ = ec;
+                ++errorCount_;
+            }
+            doneCv_.notify_all();
+
+            // Give up on shutdown if the device keeps failing
+            if (stop_ && (!ok || issued_ == durable_))
+                break;
+        }
+    }
+
+    int fd_;
+    std::chrono::milliseconds interval_;
+    size_t maxPending_;
+
+    mutable std::mutex mu_;
+    std::condition_variable cv_;     ///< Wakes the flusher thread
+    std::condition_variable doneCv_; ///< Wakes waiters after each flush
+    uint64_t issued_ = 0;            ///< Last ticket handed out
+    uint64_t durable_ = 0;           ///< Last ticket known to be on disk
+    uint64_t errorCount_ = 0;
+    std::error_code lastError_;
+    size_t waiters_ = 0;
+    bool stop_ = false;
+
+    std::thread thread_; ///< Declared last: started after all state is initialized
+};
+
+} // namespace detail
+} // namespace FdFile
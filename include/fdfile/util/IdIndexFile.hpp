@@ -0,0 +1,260 @@
+#pragma once
+/// @file IdIndexFile.hpp
+/// @brief Memory-mapped sidecar ID index for fixed-length repositories (internal)
+
+#include "FileLockGuard.hpp"
+#include "FileStat.hpp"
+#include "MmapGuard.hpp"
+#include "SlotHashTable.hpp"
+#include "UniqueFd.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Sidecar ID index file (`<data path>.idx`)
+///
+/// Layout: a fixed 128-byte header followed by SlotHashTable buckets. The header records
+/// the data file's size, mtime and inode as of the last indexed write, plus live/tombstone
+/// counts, so a repository can trust the index at open time without scanning the data file.
+///
+/// Writers (holding the data file's exclusive lock) call beginWrite() before touching the
+/// data file and commit() afterwards. A crash in between leaves the dirty flag set, which
+/// makes the index stale.
+///
+/// @note The index is a cache: it is never the only copy of any information and is rebuilt
+///       from the data file whenever matches() fails.
+class IdIndexFile {
+  public:
+    /// @brief On-disk header (little-endian host layout, 128 bytes)
+    struct Header {
+        char magic[8];         ///< "FDIDX01\0"
+        uint32_t version;      ///< Format version
+        uint32_t dirty;        ///< Non-zero while a write is in progress
+        uint64_t recordSize;   ///< Record size of the data file
+        uint64_t dataSize;     ///< Data file size at last commit
+        int64_t dataMtimeNs;   ///< Data file mtime at last commit
+        uint64_t dataIno;      ///< Data file inode at last commit
+        uint64_t generation;   ///< Incremented on every commit
+        uint64_t capacity;     ///< Bucket count (power of two)
+        uint64_t count;        ///< Live records
+        uint64_t tombstones;   ///< Tombstoned slots
+        uint64_t checksum;     ///< hashId() over all preceding header bytes
+        char reserved[40];
+    };
+    static_assert(sizeof(Header) == 128, "IdIndexFile header must stay 128 bytes");
+
+    static constexpr uint32_t VERSION = 1;
+
+    IdIndexFile() = default;
+
+    /// @brief Keep every mapping of the sidecar pinned in memory (mlock); call before open()
+    /// @details Best effort: see pinned() for whether the current mapping is pinned.
+    void setPinned(bool pin) noexcept { pin_ = pin; }
+
+    /// @brief Whether the current mapping is pinned (setPinned() and mlock succeeded)
+    bool pinned() const noexcept { return map_.locked(); }
+
+    /// @brief Open or create the sidecar file and map it
+    /// @param path Sidecar path
+    /// @param recordSize Record size of the data file (mismatch makes the index stale)
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool open(const std::string& path, uint64_t recordSize, std::error_code& ec) {
+        ec.clear();
+        recordSize_ = recordSize;
+        int flags = O_CREAT | O_RDWR;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+        fd_.reset(::open(path.c_str(), flags, 0644));
+        if (!fd_) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        // Serialize initialization with processes rebuilding the same sidecar
+        FileLockGuard lock(fd_.get(), FileLockGuard::Mode::Exclusive, ec);
+        if (ec)
+            return false;
+        return refresh(ec);
+    }
+
+    /// @brief Re-map after another process resized the file
+    bool refresh(std::error_code& ec) {
+        ec.clear();
+        struct stat st{};
+        if (::fstat(fd_.get(), &st) < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            // New or truncated sidecar: start with an empty, stale index
+            return resize(SlotHashTable::capacityFor(0), ec);
+        }
+        if (!mapBytes(static_cast<size_t>(st.st_size), ec))
+            return false;
+        attachTable();
+        return true;
+    }
+
+    /// @brief Whether the index is complete and describes the given data file state
+    bool matches(const struct stat& dataSt) const noexcept {
+        if (!map_)
+            return false;
+        const Header& h = header();
+        return std::memcmp(h.magic, MAGIC, sizeof(h.magic)) == 0 && h.version == VERSION &&
+               h.dirty == 0 && h.checksum == headerChecksum(h) && h.recordSize == recordSize_ &&
+               h.dataSize == static_cast<uint64_t>(dataSt.st_size) &&
+               h.dataMtimeNs == statMtimeNs(dataSt) &&
+               h.dataIno == static_cast<uint64_t>(dataSt.st_ino) && tableFits(h.capacity);
+    }
+
+    /// @brief Make room for `extra` more entries, rehashing into a larger table if needed
+    bool reserve(size_t live, size_t extra, std::error_code& ec) {
+        const size_t want = SlotHashTable::capacityFor(live + extra);
+        if (want <= table_.capacity())
+            return true;
+
+        std::vector<SlotBucket> entries;
+        entries.reserve(live);
+        table_.forEach([&](uint64_t h, size_t slot) { entries.push_back(SlotBucket{h, slot}); });
+        if (!resize(want, ec))
+            return false;
+        for (const auto& e : entries)
+            table_.insert(e.hash, static_cast<size_t>(e.slot));
+        return true;
+    }
+
+    /// @brief Drop every entry and size the table for `expected` entries
+    bool reset(size_t expected, std::error_code& ec) {
+        const size_t want = SlotHashTable::capacityFor(expected);
+        if (want != table_.capacity())
+            return resize(want, ec);
+        table_.clear();
+        return true;
+    }
+
+    /// @brief Mark the index as being modified
+    void beginWrite() noexcept {
+        if (map_)
+            header().dirty = 1;
+    }
+
+    /// @brief Record the data file state the index now describes and clear the dirty flag
+    void commit(const struct stat& dataSt, uint64_t count, uint64_t tombstones) noexcept {
+        if (!map_)
+            return;
+        Header& h = header();
+        std::memcpy(h.magic, MAGIC, sizeof(h.magic));
+        h.version = VERSION;
+        h.recordSize = recordSize_;
+        h.dataSize = static_cast<uint64_t>(dataSt.st_size);
+        h.dataMtimeNs = statMtimeNs(dataSt);
+        h.dataIno = static_cast<uint64_t>(dataSt.st_ino);
+        h.generation += 1;
+        h.capacity = table_.capacity();
+        h.count = count;
+        h.tombstones = tombstones;
+        h.dirty = 0;
+        // Written last: a torn header fails the checksum and is treated as stale
+        h.checksum = headerChecksum(h);
+        // Schedule write-back; the index is rebuilt if it is ever found stale
+        (void)map_.sync(true);
+    }
+
+    /// @brief Sidecar file descriptor (lock it exclusively to rebuild under a shared data lock)
+    int fd() const noexcept { return fd_.get(); }
+
+    /// @brief Bucket table
+    SlotHashTable& table() noexcept { return table_; }
+    const SlotHashTable& table() const noexcept { return table_; }
+
+    /// @brief Live record count at last commit
+    uint64_t count() const noexcept { return header().count; }
+
+    /// @brief Tombstone count at last commit
+    uint64_t tombstones() const noexcept { return header().tombstones; }
+
+    /// @brief Commit counter (changes whenever any process commits)
+    uint64_t generation() const noexcept { return header().generation; }
+
+  private:
+    static constexpr char MAGIC[8] = {'F', 'D', 'I', 'D', 'X', '0', '1', '\0'};
+
+    static uint64_t headerChecksum(const Header& h) noexcept {
+        return hashId(reinterpret_cast<const char*>(&h), offsetof(Header, checksum));
+    }
+
+    Header& header() noexcept { return *reinterpret_cast<Header*>(map_.data()); }
+    const Header& header() const noexcept { return *reinterpret_cast<const Header*>(map_.data()); }
+
+    bool tableFits(uint64_t capacity) const noexcept {
+        return capacity != 0 && (capacity & (capacity - 1)) == 0 &&
+               sizeof(Header) + capacity * sizeof(SlotBucket) <= map_.size();
+    }
+
+    void attachTable() noexcept {
+        const uint64_t cap = header().capacity;
+        if (tableFits(cap)) {
+            table_.attach(reinterpret_cast<SlotBucket*>(map_.data() + sizeof(Header)),
+                          static_cast<size_t>(cap));
+        } else {
+            table_.attach(nullptr, 0);
+        }
+    }
+
+    /// @brief Resize to an empty table of `capacity` buckets (header left dirty)
+    bool resize(size_t capacity, std::error_code& ec) {
+        const size_t bytes = sizeof(Header) + capacity * sizeof(SlotBucket);
+        map_.reset();
+        // Shrink to the header first so every bucket comes back zero-filled (empty)
+        if (::ftruncate(fd_.get(), sizeof(Header)) != 0 ||
+            ::ftruncate(fd_.get(), static_cast<off_t>(bytes)) != 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (!mapBytes(bytes, ec))
+            return false;
+        Header& h = header();
+        h.dirty = 1;
+        h.capacity = capacity;
+        attachTable();
+        return true;
+    }
+
+    bool mapBytes(size_t bytes, std::error_code& ec) {
+        if (map_ && map_.size() == bytes)
+            return true;
+        map_.reset();
+        void* ptr = MmapGuard::mapShared(fd_.get(), bytes);
+        if (ptr == MAP_FAILED) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        map_.reset(ptr, bytes);
+        if (pin_)
+            (void)map_.lock(); // A failed pin only costs page faults
+        return true;
+    }
+
+    UniqueFd fd_;
+    MmapGuard map_;
+    SlotHashTable table_;
+    uint64_t recordSize_ = 0;
+    bool pin_ = false;
+};
+
+} // namespace detail
+} // namespace FdFile
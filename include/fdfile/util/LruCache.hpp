@@ -0,0 +1,101 @@
+#pragma once
+/// @file LruCache.hpp
+/// @brief Least-recently-used cache with a byte budget (internal)
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Hit/miss/eviction counters of an LruCache
+struct LruStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/// @brief LRU map whose entries carry a caller-supplied byte cost
+///
+/// put() evicts least recently used entries until the total cost fits the budget. An entry
+/// costing more than the whole budget is not stored. A budget of 0 disables the cache.
+///
+/// @note This class is for internal library use.
+template <typename Key, typename Value> class LruCache {
+  public:
+    explicit LruCache(size_t budgetBytes = 0) : budget_(budgetBytes) {}
+
+    /// @brief Look up key and mark it most recently used
+    /// @return Pointer to the value (valid until the next put/erase/clear), or nullptr
+    const Value* get(const Key& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->value;
+    }
+
+    /// @brief Insert or replace key
+    void put(const Key& key, Value value, size_t cost) {
+        erase(key);
+        if (cost > budget_)
+            return;
+        while (used_ + cost > budget_)
+            evictOne();
+        order_.push_front(Node{key, std::move(value), cost});
+        index_.emplace(key, order_.begin());
+        used_ += cost;
+    }
+
+    /// @brief Remove key if present (not counted as an eviction)
+    void erase(const Key& key) {
+        auto it = index_.find(key);
+        if (it == index_.end())
+            return;
+        used_ -= it->second->cost;
+        order_.erase(it->second);
+        index_.erase(it);
+    }
+
+    /// @brief Remove every entry (counters are kept)
+    void clear() {
+        order_.clear();
+        index_.clear();
+        used_ = 0;
+    }
+
+    size_t size() const noexcept { return index_.size(); }
+    size_t usedBytes() const noexcept { return used_; }
+    size_t budgetBytes() const noexcept { return budget_; }
+    const LruStats& stats() const noexcept { return stats_; }
+
+  private:
+    struct Node {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+
+    void evictOne() {
+        const Node& victim = order_.back();
+        used_ -= victim.cost;
+        index_.erase(victim.key);
+        order_.pop_back();
+        ++stats_.evictions;
+    }
+
+    size_t budget_;
+    size_t used_ = 0;
+    std::list<Node> order_; ///< Most recently used first
+    std::unordered_map<Key, typename std::list<Node>::iterator> index_;
+    LruStats stats_;
+};
+
+} // namespace detail
+} // namespace FdFile
@@ -12,8 +12,11 @@
 /// @file MmapGuard.hpp
 /// @brief RAII wrapper for mmap (internal implementation)
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <sys/mman.h>
+#include <unistd.h>
 
 namespace FdFile {
 namespace detail {
@@ -23,8 +26,34 @@ namespace detail {
 /// Automatically unmaps memory region on destruction.
 class MmapGuard {
   public:
+    /// @brief Kernel hint for how a mapped range will be used (madvise)
+    enum class Advice {
+        Normal,     ///< Default readahead
+        Sequential, ///< Read ahead aggressively; pages may be dropped soon after use
+        Random,     ///< No readahead
+        WillNeed,   ///< Start reading the range in now
+        HugePages   ///< Back the range with transparent huge pages where supported
+    };
+
     MmapGuard() = default;
 
+    /// @brief Map `size` bytes of fd read/write, shared with other processes
+    /// @param populate Prefault every page (MAP_POPULATE; WillNeed advice where missing)
+    /// @return Mapped pointer, or MAP_FAILED with errno set
+    static void* mapShared(int fd, size_t size, bool populate = false) noexcept {
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if (populate)
+            flags |= MAP_POPULATE;
+#endif
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+#if !defined(MAP_POPULATE) && defined(MADV_WILLNEED)
+        if (populate && ptr != MAP_FAILED)
+            (void)::madvise(ptr, size, MADV_WILLNEED);
+#endif
+        return ptr;
+    }
+
     /// @brief Constructor with mapped memory
     /// @param ptr Mapped memory pointer
     /// @param size Size of mapped region
@@ -44,9 +73,11 @@ class MmapGuard {
     MmapGuard& operator=(const MmapGuard&) = delete;
 
     // Move allowed
-    MmapGuard(MmapGuard&& other) noexcept : ptr_(other.ptr_), size_(other.size_) {
+    MmapGuard(MmapGuard&& other) noexcept
+        : ptr_(other.ptr_), size_(other.size_), locked_(other.locked_) {
         other.ptr_ = nullptr;
         other.size_ = 0;
+        other.locked_ = false;
     }
 
     MmapGuard& operator=(MmapGuard&& other) noexcept {
@@ -56,8 +87,10 @@ class MmapGuard {
             reset();
             ptr_ = other.ptr_;
             size_ = other.size_;
+            locked_ = other.locked_;
             other.ptr_ = nullptr;
             other.size_ = 0;
+            other.locked_ = false;
         }
         return *this;
     }
@@ -82,12 +115,23 @@ class MmapGuard {
         if (ptr_) {
             // munmap은 커널 자원을 반환하는 핵심 호출이므로,
             // reset을 여러 번 호출해도 안전하도록 null-check 후 정리한다.
-            ::munmap(ptr_, size_);
+            ::munmap(ptr_, size_); // Also drops an mlock() pin
             ptr_ = nullptr;
             size_ = 0;
+            locked_ = false;
         }
     }
 
+    /// @brief Releases ownership without unmapping
+    /// @return Previously owned pointer (caller becomes responsible for munmap)
+    void* release() noexcept {
+        void* tmp = ptr_;
+        ptr_ = nullptr;
+        size_ = 0;
+        locked_ = false;
+        return tmp;
+    }
+
     /// @brief Replaces with new mapping
     /// @param ptr New mapped memory pointer
     /// @param size New region size
@@ -111,9 +155,83 @@ class MmapGuard {
         return ::msync(ptr_, size_, flags) == 0;
     }
 
+    /// @brief Syncs only the pages covering [offset, offset + length)
+    /// @param offset Byte offset into the mapping (rounded down to a page boundary)
+    /// @param length Number of bytes (clamped to the mapping size)
+    /// @param async If true, use MS_ASYNC; otherwise MS_SYNC
+    /// @return true on success
+    bool syncRange(size_t offset, size_t length, bool async = false) noexcept {
+        if (!ptr_ || offset >= size_)
+            return false;
+        // msync는 페이지 경계 주소만 허용하므로 시작 오프셋을 페이지 단위로 내림한다.
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t start = offset - (offset % page);
+        const size_t end = std::min(size_, offset + length);
+        int flags = async ? MS_ASYNC : MS_SYNC;
+        return ::msync(static_cast<char*>(ptr_) + start, end - start, flags) == 0;
+    }
+
+    /// @brief Hint to the kernel how [offset, offset + length) will be accessed
+    /// @details Best effort: false means the hint is unsupported or was rejected, which never
+    ///          affects the contents of the mapping.
+    /// @param offset Byte offset into the mapping (rounded down to a page boundary)
+    /// @param length Number of bytes (clamped to the mapping size)
+    /// @return true if the kernel accepted the hint
+    bool advise(Advice advice, size_t offset = 0, size_t length = SIZE_MAX) const noexcept {
+        const int native = nativeAdvice(advice);
+        if (!ptr_ || offset >= size_ || native < 0)
+            return false;
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t start = offset - (offset % page);
+        const size_t end = offset + std::min(length, size_ - offset);
+        return ::madvise(static_cast<char*>(ptr_) + start, end - start, native) == 0;
+    }
+
+    /// @brief Pin the mapped pages in memory (mlock)
+    /// @return true on success; fails with errno set, e.g. beyond RLIMIT_MEMLOCK
+    bool lock() noexcept {
+        if (!ptr_)
+            return false;
+        if (!locked_)
+            locked_ = ::mlock(ptr_, size_) == 0;
+        return locked_;
+    }
+
+    /// @brief Undo lock()
+    void unlock() noexcept {
+        if (locked_)
+            (void)::munlock(ptr_, size_);
+        locked_ = false;
+    }
+
+    /// @brief Whether lock() pinned the current mapping
+    bool locked() const noexcept { return locked_; }
+
   private:
+    /// @return MADV_* value of advice, or -1 if this platform has none
+    static int nativeAdvice(Advice advice) noexcept {
+        switch (advice) {
+        case Advice::Normal:
+            return MADV_NORMAL;
+        case Advice::Sequential:
+            return MADV_SEQUENTIAL;
+        case Advice::Random:
+            return MADV_RANDOM;
+        case Advice::WillNeed:
+            return MADV_WILLNEED;
+        case Advice::HugePages:
+#ifdef MADV_HUGEPAGE
+            return MADV_HUGEPAGE;
+#else
+            return -1;
+#endif
+        }
+        return -1;
+    }
+
     void* ptr_ = nullptr;
     size_t size_ = 0;
+    bool locked_ = false; ///< Pinned by lock()
 };
 
 } // namespace detail
@@ -0,0 +1,146 @@
+/**
+ * @file fdFileLib/util/NumericCodec.hpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 POSIX file descriptor 기반 저장소/레코드 처리 흐름의 핵심 구성요소를 담고 있습니다.
+ * - 구현의 기본 원칙은 예외 남용을 피하고 std::error_code 중심으로 실패 원인을 호출자에게 전달하는 것입니다.
+ * - 직렬화/역직렬화 규약(필드 길이, 문자열 escape, 레코드 경계)은 파일 포맷 호환성과 직접 연결되므로 수정 시 매우 주의해야 합니다.
+ * - 동시 접근 시에는 lock 획득 순서, 캐시 무효화 시점, 파일 stat 갱신 타이밍이 데이터 무결성을 좌우하므로 흐름을 깨지 않도록 유지해야 합니다.
+ * - 내부 헬퍼를 변경할 때는 단건/다건 저장, 조회, 삭제, 외부 수정 감지 경로까지 함께 점검해야 회귀를 방지할 수 있습니다.
+ */
+#pragma once
+/// @file NumericCodec.hpp
+/// @brief Fixed-width signed int64 encoder/decoder for FD_NUM fields (internal implementation)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Encoded width: sign + 19 zero-padded digits (e.g. "+0000000000000000025")
+constexpr size_t FIXED_INT64_LEN = 20;
+
+/// @brief "00".."99" lookup table for two-digits-at-a-time formatting
+inline constexpr char DIGIT_PAIRS[201] = "00010203040506070809"
+                                         "10111213141516171819"
+                                         "20212223242526272829"
+                                         "30313233343536373839"
+                                         "40414243444546474849"
+                                         "50515253545556575859"
+                                         "60616263646566676869"
+                                         "70717273747576777879"
+                                         "80818283848586878889"
+                                         "90919293949596979899";
+
+/// @brief Encode a value in the fixed 20-byte format
+/// @details Writes exactly FIXED_INT64_LEN bytes (no terminating NUL).
+/// @param value Value to encode
+/// @param[out] out Destination (at least FIXED_INT64_LEN bytes)
+inline void encodeFixedInt64(int64_t value, char* out) noexcept {
+    out[0] = (value >= 0) ? '+' : '-';
+    // INT64_MIN 절대값은 unsigned 경유로 계산해 overflow를 피한다.
+    uint64_t q = (value >= 0) ? static_cast<uint64_t>(value) : 0 - static_cast<uint64_t>(value);
+
+    // 뒤에서부터 두 자리씩 18자리를 채우고, 남은 최상위 한 자리(최대 9)를 기록한다.
+    char* p = out + FIXED_INT64_LEN;
+    for (int i = 0; i < 9; ++i) {
+        p -= 2;
+        std::memcpy(p, DIGIT_PAIRS + (q % 100) * 2, 2);
+        q /= 100;
+    }
+    out[1] = static_cast<char>('0' + q);
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/// @brief Validate and convert 8 ASCII digits at once (SWAR, little-endian)
+/// @return true if all 8 bytes are '0'..'9'
+inline bool parseEightDigits(const char* p, uint64_t& out) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    // 모든 바이트의 상위 니블이 3이고, +6 해도 3이면 '0'..'9' 범위다.
+    if ((v & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+        ((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL)
+        return false;
+    v -= 0x3030303030303030ULL;
+    v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v * 10000 + (v >> 32)) & 0x00000000FFFFFFFFULL;
+    out = v;
+    return true;
+}
+#endif
+
+/// @brief Decode a fixed-format signed value
+/// @details Accepts a sign followed by up to `len - 1` digits; digits may be followed by NUL
+///          padding. The canonical 20-byte form takes a branch-light SWAR path.
+/// @param in Source bytes (not required to be NUL-terminated)
+/// @param len Field width in bytes
+/// @param[out] out Decoded value (untouched on failure)
+/// @param ec invalid_argument for bad sign/digits, result_out_of_range if outside int64
+/// @return true on success
+inline bool decodeFixedInt64(const char* in, size_t len, int64_t& out,
+                             std::error_code& ec) noexcept {
+    const char sign = (len > 0) ? in[0] : '\0';
+    if (sign != '+' && sign != '-') {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    uint64_t absVal = 0;
+    bool parsed = false;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (len == FIXED_INT64_LEN) {
+        uint64_t hi, mid;
+        const unsigned d0 = static_cast<unsigned char>(in[17]) - '0';
+        const unsigned d1 = static_cast<unsigned char>(in[18]) - '0';
+        const unsigned d2 = static_cast<unsigned char>(in[19]) - '0';
+        if (parseEightDigits(in + 1, hi) && parseEightDigits(in + 9, mid) && d0 <= 9 && d1 <= 9 &&
+            d2 <= 9) {
+            // 19자리 최대값(9999...)도 uint64 범위 안이므로 곱셈 overflow가 없다.
+            absVal = hi * 100000000000ULL + mid * 1000ULL + d0 * 100 + d1 * 10 + d2;
+            parsed = true;
+        }
+    }
+#endif
+    if (!parsed) {
+        // 일반 경로: 자리수가 짧거나 NUL 패딩이 있는 입력
+        size_t i = 1;
+        for (; i < len && in[i] != '\0'; ++i) {
+            const unsigned d = static_cast<unsigned char>(in[i]) - '0';
+            if (d > 9) {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            if (absVal > (UINT64_MAX - d) / 10) {
+                ec = std::make_error_code(std::errc::result_out_of_range);
+                return false;
+            }
+            absVal = absVal * 10 + d;
+        }
+        if (i == 1) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+    }
+
+    if (sign == '-') {
+        if (absVal > static_cast<uint64_t>(INT64_MAX) + 1) {
+            ec = std::make_error_code(std::errc::result_out_of_range);
+            return false;
+        }
+        out = static_cast<int64_t>(0 - absVal);
+    } else {
+        if (absVal > static_cast<uint64_t>(INT64_MAX)) {
+            ec = std::make_error_code(std::errc::result_out_of_range);
+            return false;
+        }
+        out = static_cast<int64_t>(absVal);
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace FdFile
@@ -0,0 +1,90 @@
+#pragma once
+/// @file ParallelScan.hpp
+/// @brief Splitting full-file scans across threads (internal)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Number of chunks a scan of n items is split into
+/// @param n Items to scan (slots or bytes)
+/// @param threads Requested threads (0: one per core, 1: serial)
+/// @param minPerChunk Fewest items worth a thread of their own
+/// @return Between 1 and the thread count; 1 means scan on the calling thread only
+inline size_t scanChunkCount(size_t n, size_t threads, size_t minPerChunk) {
+    if (threads == 0)
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t bySize = n / std::max<size_t>(1, minPerChunk);
+    return std::max<size_t>(1, std::min(threads, bySize));
+}
+
+/// @brief First item of chunk c when n items are split evenly into `chunks`
+inline size_t chunkBegin(size_t n, size_t chunks, size_t c) {
+    return n / chunks * c + n % chunks * c / chunks;
+}
+
+/// @brief Run fn(0) .. fn(tasks - 1) concurrently and wait for all of them
+/// @details Task 0 runs on the calling thread. A task whose thread cannot be started runs
+///          on the calling thread as well, so every task runs exactly once. If tasks throw,
+///          the exception of the lowest one is rethrown once all of them have finished.
+template <typename Fn> void runParallel(size_t tasks, Fn&& fn) {
+    std::vector<std::exception_ptr> errors(tasks);
+    auto task = [&fn, &errors](size_t t) {
+        try {
+            fn(t);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    std::vector<size_t> unstarted;
+    workers.reserve(tasks > 0 ? tasks - 1 : 0);
+    for (size_t t = 1; t < tasks; ++t) {
+        try {
+            workers.emplace_back(task, t);
+        } catch (const std::system_error&) {
+            unstarted.push_back(t);
+        }
+    }
+    if (tasks > 0)
+        task(0);
+    for (size_t t : unstarted)
+        task(t);
+    for (auto& w : workers)
+        w.join();
+    for (const auto& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+/// @brief Split [0, len) of text into about `parts` ranges that start after a '\n'
+/// @param data Text whose last byte is '\n'
+/// @return Ascending range boundaries: 0, ..., len (fewer ranges for long lines)
+inline std::vector<size_t> splitAtNewlines(const char* data, size_t len, size_t parts) {
+    std::vector<size_t> bounds{0};
+    for (size_t c = 1; c < parts; ++c) {
+        const size_t from = std::max(chunkBegin(len, parts, c), bounds.back());
+        if (from >= len)
+            break;
+        const void* nl = std::memchr(data + from, '\n', len - from);
+        if (!nl)
+            break;
+        const size_t next = static_cast<size_t>(static_cast<const char*>(nl) - data) + 1;
+        if (next >= len)
+            break;
+        bounds.push_back(next);
+    }
+    bounds.push_back(len);
+    return bounds;
+}
+
+} // namespace detail
+} // namespace FdFile
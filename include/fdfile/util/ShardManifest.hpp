@@ -0,0 +1,292 @@
+#pragma once
+/// @file ShardManifest.hpp
+/// @brief Shard layout file of a ShardedRepository (internal)
+
+#include "FileLockGuard.hpp"
+#include "GroupCommitFlusher.hpp"
+#include "UniqueFd.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Manifest (`<path>.manifest`) naming the shard set in use
+///
+/// The file is a few lines of text:
+/// @code
+/// FDSHARD 1
+/// generation 3
+/// shards 8
+/// @endcode
+/// Shard i of generation g lives at `<path>.<g>.<i>`. The content is written once when the
+/// file is created and afterwards only replaced as a whole (temporary file + rename), so a
+/// process that locks the manifest and finds the path still naming its open file knows its
+/// layout is current without reading the file again.
+///
+/// Every repository operation holds a shared lock on the manifest and resharding holds an
+/// exclusive one, so a reshard waits for in-flight operations and blocks new ones until the
+/// new layout is in place. The lock belongs to the open file description (see
+/// FileLockGuard::Owner::OpenFile), so instances in one process exclude each other as
+/// processes do, and one instance releasing or closing its descriptor leaves the others'
+/// locks alone. Where such locks are missing, a process-wide reader/writer lock per manifest
+/// path orders the instances of a process instead.
+///
+/// @note This class is for internal library use.
+class ShardManifest {
+  public:
+    /// @brief Shard layout
+    struct Layout {
+        uint64_t generation = 0; ///< Bumped by every reshard (part of the shard file names)
+        size_t shards = 0;       ///< Number of shards (at least 1)
+    };
+
+    /// @brief Lock held for one repository operation or reshard
+    class Guard {
+      public:
+        /// @brief Whether the manifest is locked
+        bool locked() const noexcept { return file_.locked(); }
+
+      private:
+        friend class ShardManifest;
+
+        // Declared first so it is released after the file lock
+        std::shared_lock<std::shared_mutex> sharedGate_;
+        std::unique_lock<std::shared_mutex> exclusiveGate_;
+        FileLockGuard file_;
+    };
+
+    static constexpr uint32_t VERSION = 1;
+
+    ShardManifest() = default;
+
+    /// @brief Open the manifest, creating it with `defaultShards` shards if it does not exist
+    /// @param path Manifest path
+    /// @param defaultShards Shard count of a new manifest (ignored for an existing one)
+    /// @param ec Error code set on failure (invalid_argument for a malformed manifest)
+    /// @return true on success
+    bool open(const std::string& path, size_t defaultShards, std::error_code& ec) {
+        ec.clear();
+        path_ = path;
+        if (defaultShards == 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        if (!FileLockGuard::openFileLocks)
+            gate_ = processGate(path_);
+        if (!openFile(ec))
+            return false;
+
+        // Creation is serialized with other processes opening the same path
+        Guard guard;
+        if (!lock(guard, FileLockGuard::Mode::Exclusive, ec))
+            return false;
+        struct stat st{};
+        if (::fstat(fd_.get(), &st) < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (st.st_size == 0) {
+            layout_ = Layout{0, defaultShards};
+            const std::string text = format(layout_);
+            if (::pwrite(fd_.get(), text.data(), text.size(), 0) !=
+                    static_cast<ssize_t>(text.size()) ||
+                !syncFileData(fd_.get(), ec)) {
+                if (!ec)
+                    ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+            return true;
+        }
+        return readLayout(ec);
+    }
+
+    /// @brief Lock the manifest, following a replacement by another process
+    /// @details On return layout() describes the shard set current under the lock.
+    /// @param guard Guard that receives the lock
+    /// @param mode Shared for repository operations, Exclusive for resharding
+    /// @param ec Error code set on failure
+    /// @return true on success
+    bool lock(Guard& guard, FileLockGuard::Mode mode, std::error_code& ec) {
+        if (gate_) {
+            if (mode == FileLockGuard::Mode::Shared)
+                guard.sharedGate_ = std::shared_lock<std::shared_mutex>(*gate_);
+            else
+                guard.exclusiveGate_ = std::unique_lock<std::shared_mutex>(*gate_);
+        }
+        bool reopened = false;
+        while (true) {
+            if (!guard.file_.lock(fd_.get(), mode, ec, FileLockGuard::Owner::OpenFile))
+                return false;
+            struct stat onPath{}, held{};
+            if (::stat(path_.c_str(), &onPath) < 0 || ::fstat(fd_.get(), &held) < 0 ||
+                (onPath.st_dev == held.st_dev && onPath.st_ino == held.st_ino))
+                return !reopened || readLayout(ec);
+            guard.file_.unlockIgnore();
+            if (!openFile(ec))
+                return false;
+            reopened = true;
+        }
+    }
+
+    /// @brief Replace the manifest with `next` (caller holds the exclusive lock)
+    /// @details Writes `<path>.tmp`, syncs it and renames it over the manifest. Processes
+    ///          blocked on the old file notice the rename once they get the lock.
+    bool replace(const Layout& next, std::error_code& ec) {
+        const std::string tmpPath = path_ + ".tmp";
+        int flags = O_CREAT | O_TRUNC | O_WRONLY;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+        UniqueFd tmp(::open(tmpPath.c_str(), flags, 0644));
+        if (!tmp) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        const std::string text = format(next);
+        if (::write(tmp.get(), text.data(), text.size()) != static_cast<ssize_t>(text.size()) ||
+            !syncFileData(tmp.get(), ec) || ::rename(tmpPath.c_str(), path_.c_str()) < 0) {
+            if (!ec)
+                ec = std::error_code(errno, std::generic_category());
+            ::unlink(tmpPath.c_str());
+            return false;
+        }
+        tmp.reset();
+
+        // Persist the rename itself (best effort)
+        const std::filesystem::path dir = std::filesystem::path(path_).parent_path();
+        UniqueFd dirFd(::open(dir.empty() ? "." : dir.c_str(), O_RDONLY));
+        if (dirFd)
+            (void)::fsync(dirFd.get());
+        layout_ = next;
+        return true;
+    }
+
+    /// @brief Layout read at the last open() or lock()
+    const Layout& layout() const noexcept { return layout_; }
+
+    /// @brief Manifest text of a layout
+    static std::string format(const Layout& layout) {
+        return "FDSHARD " + std::to_string(VERSION) + "\ngeneration " +
+               std::to_string(layout.generation) + "\nshards " + std::to_string(layout.shards) +
+               "\n";
+    }
+
+    /// @brief Parse manifest text
+    /// @return false if the text is not a version-1 manifest with at least one shard
+    static bool parse(std::string_view text, Layout& out) {
+        Layout parsed;
+        bool header = false, haveGen = false, haveShards = false;
+        while (!text.empty()) {
+            const size_t nl = text.find('\n');
+            const std::string_view line = text.substr(0, nl);
+            text = nl == std::string_view::npos ? std::string_view() : text.substr(nl + 1);
+            if (line.empty())
+                continue;
+            const size_t sp = line.find(' ');
+            if (sp == std::string_view::npos)
+                return false;
+            const std::string_view key = line.substr(0, sp);
+            uint64_t value = 0;
+            if (!parseNumber(line.substr(sp + 1), value))
+                return false;
+            if (!header) {
+                if (key != "FDSHARD" || value != VERSION)
+                    return false;
+                header = true;
+            } else if (key == "generation") {
+                parsed.generation = value;
+                haveGen = true;
+            } else if (key == "shards") {
+                parsed.shards = static_cast<size_t>(value);
+                haveShards = true;
+            } // Unknown keys are left for later versions
+        }
+        if (!header || !haveGen || !haveShards || parsed.shards == 0)
+            return false;
+        out = parsed;
+        return true;
+    }
+
+  private:
+    /// @brief Reader/writer lock shared by every instance of this process on a manifest path
+    static std::shared_ptr<std::shared_mutex> processGate(const std::string& path) {
+        static std::mutex registryMutex;
+        static std::map<std::string, std::weak_ptr<std::shared_mutex>> registry;
+        std::error_code fec;
+        // Absolute first: a relative path whose file does not exist yet stays relative
+        std::string key =
+            std::filesystem::weakly_canonical(std::filesystem::absolute(path, fec), fec).string();
+        if (fec)
+            key = path;
+        std::lock_guard<std::mutex> hold(registryMutex);
+        auto& slot = registry[key];
+        auto gate = slot.lock();
+        if (!gate) {
+            gate = std::make_shared<std::shared_mutex>();
+            slot = gate;
+        }
+        return gate;
+    }
+
+    static bool parseNumber(std::string_view s, uint64_t& out) {
+        if (s.empty() || s.size() > 19)
+            return false;
+        uint64_t v = 0;
+        for (char c : s) {
+            if (c < '0' || c > '9')
+                return false;
+            v = v * 10 + static_cast<uint64_t>(c - '0');
+        }
+        out = v;
+        return true;
+    }
+
+    bool openFile(std::error_code& ec) {
+        int flags = O_CREAT | O_RDWR;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+        fd_.reset(::open(path_.c_str(), flags, 0644));
+        if (!fd_) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        return true;
+    }
+
+    bool readLayout(std::error_code& ec) {
+        char buf[512];
+        const ssize_t n = ::pread(fd_.get(), buf, sizeof(buf), 0);
+        if (n < 0) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (!parse(std::string_view(buf, static_cast<size_t>(n)), layout_)) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        return true;
+    }
+
+    std::string path_;
+    UniqueFd fd_;
+    Layout layout_;
+    std::shared_ptr<std::shared_mutex> gate_; ///< Only without open file description locks
+};
+
+} // namespace detail
+} // namespace FdFile
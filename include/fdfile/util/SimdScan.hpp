@@ -0,0 +1,154 @@
+#pragma once
+/// @file SimdScan.hpp
+/// @brief Vectorized search for the special characters of the text format (internal)
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(FDFILE_NO_SIMD) && defined(__x86_64__) && defined(__SSE2__) &&                     \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FDFILE_SIMD_X86 1
+#elif !defined(FDFILE_NO_SIMD) && (defined(__aarch64__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define FDFILE_SIMD_NEON 1
+#endif
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Character set searched by findScanChar()
+enum class ScanSet {
+    QuoteOrBackslash, ///< `"` and `\` (end of a quoted string body, or an escape)
+    NeedsEscape       ///< `"`, `\`, newline and tab (characters escapeString() rewrites)
+};
+
+/// @brief Whether c belongs to set S
+template <ScanSet S> inline bool isScanChar(char c) noexcept {
+    if (c == '"' || c == '\\')
+        return true;
+    if constexpr (S == ScanSet::NeedsEscape)
+        return c == '\n' || c == '\t';
+    return false;
+}
+
+/// @brief Portable byte-at-a-time kernel
+/// @return First character of set S in [p, end), or end
+template <ScanSet S>
+inline const char* findScanCharScalar(const char* p, const char* end) noexcept {
+    while (p < end && !isScanChar<S>(*p))
+        ++p;
+    return p;
+}
+
+#if defined(FDFILE_SIMD_X86)
+
+/// @brief SSE2 kernel (16 bytes per step; baseline on x86-64)
+template <ScanSet S> inline const char* findScanCharSse2(const char* p, const char* end) noexcept {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i slash = _mm_set1_epi8('\\');
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i tab = _mm_set1_epi8('\t');
+    while (end - p >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash));
+        if constexpr (S == ScanSet::NeedsEscape)
+            m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, tab)));
+        const int mask = _mm_movemask_epi8(m);
+        if (mask != 0)
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        p += 16;
+    }
+    return findScanCharScalar<S>(p, end);
+}
+
+/// @brief AVX2 kernel (32 bytes per step; selected at runtime when the CPU supports it)
+template <ScanSet S>
+__attribute__((target("avx2"))) inline const char* findScanCharAvx2(const char* p,
+                                                                   const char* end) noexcept {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i slash = _mm256_set1_epi8('\\');
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    while (end - p >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, slash));
+        if constexpr (S == ScanSet::NeedsEscape)
+            m = _mm256_or_si256(
+                m, _mm256_or_si256(_mm256_cmpeq_epi8(v, nl), _mm256_cmpeq_epi8(v, tab)));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(m));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findScanCharSse2<S>(p, end);
+}
+
+#elif defined(FDFILE_SIMD_NEON)
+
+/// @brief NEON kernel (16 bytes per step)
+template <ScanSet S> inline const char* findScanCharNeon(const char* p, const char* end) noexcept {
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t slash = vdupq_n_u8('\\');
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    const uint8x16_t tab = vdupq_n_u8('\t');
+    while (end - p >= 16) {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t m = vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, slash));
+        if constexpr (S == ScanSet::NeedsEscape)
+            m = vorrq_u8(m, vorrq_u8(vceqq_u8(v, nl), vceqq_u8(v, tab)));
+        // Narrow each byte mask to 4 bits so the 16 lanes fit in one 64-bit word
+        const uint64_t bits =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+        if (bits != 0)
+            return p + (__builtin_ctzll(bits) >> 2);
+        p += 16;
+    }
+    return findScanCharScalar<S>(p, end);
+}
+
+#endif
+
+/// @brief Kernel signature
+using ScanKernel = const char* (*)(const char*, const char*) noexcept;
+
+/// @brief Best kernel for set S on this CPU
+template <ScanSet S> inline ScanKernel selectScanKernel() noexcept {
+#if defined(FDFILE_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &findScanCharAvx2<S>;
+    return &findScanCharSse2<S>;
+#elif defined(FDFILE_SIMD_NEON)
+    return &findScanCharNeon<S>;
+#else
+    return &findScanCharScalar<S>;
+#endif
+}
+
+/// @brief Name of the kernel findScanChar() dispatches to ("avx2", "sse2", "neon" or "scalar")
+inline const char* activeScanKernelName() noexcept {
+#if defined(FDFILE_SIMD_X86)
+    return selectScanKernel<ScanSet::QuoteOrBackslash>() ==
+                   &findScanCharAvx2<ScanSet::QuoteOrBackslash>
+               ? "avx2"
+               : "sse2";
+#elif defined(FDFILE_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/// @brief First character of set S in [p, end), or end
+/// @details Short spans are scanned inline; longer ones go to the vector kernel picked once
+///          per process.
+template <ScanSet S> inline const char* findScanChar(const char* p, const char* end) noexcept {
+    if (end - p < 16)
+        return findScanCharScalar<S>(p, end);
+    static const ScanKernel kernel = selectScanKernel<S>();
+    return kernel(p, end);
+}
+
+} // namespace detail
+} // namespace FdFile
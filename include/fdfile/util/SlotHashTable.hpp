@@ -0,0 +1,163 @@
+#pragma once
+/// @file SlotHashTable.hpp
+/// @brief Open-addressing hash → slot table over caller-provided storage (internal)
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief 64-bit hash of an ID (FNV-1a with a murmur3 finalizer)
+/// @details The value is persisted in sidecar index files, so it must stay stable.
+inline uint64_t hashId(const char* data, size_t len) noexcept {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 0x100000001b3ULL;
+    }
+    // FNV 하위 비트는 분산이 약하므로 마스크 기반 버킷 선택 전에 한 번 섞는다.
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/// @brief One table entry (16 bytes)
+struct SlotBucket {
+    uint64_t hash; ///< hashId() of the record ID
+    uint64_t slot; ///< Record slot + 1 (0 = empty bucket)
+};
+
+/// @brief Linear-probing table mapping ID hashes to record slots
+///
+/// Stores no keys: a hash match is confirmed by the caller's `match(slot)` predicate, which
+/// compares the ID bytes stored in the record itself. Deletion uses backward shifting, so
+/// there are no tombstone buckets.
+///
+/// @note The table does not own its storage. Capacity must be a power of two and the caller
+///       keeps the load factor below one (see capacityFor()).
+class SlotHashTable {
+  public:
+    /// @brief Smallest power-of-two capacity keeping `entries` at or below 75% load
+    /// @details 16-byte buckets at 37.5-75% load cost 21-43 bytes per entry.
+    static size_t capacityFor(size_t entries) noexcept {
+        size_t cap = 16;
+        while (cap * 3 < entries * 4)
+            cap <<= 1;
+        return cap;
+    }
+
+    /// @brief Use `buckets[0, capacity)` as table storage
+    void attach(SlotBucket* buckets, size_t capacity) noexcept {
+        buckets_ = buckets;
+        capacity_ = capacity;
+    }
+
+    /// @brief Number of buckets
+    size_t capacity() const noexcept { return capacity_; }
+
+    /// @brief Find the slot of an ID
+    /// @param hash hashId() of the ID
+    /// @param match Predicate confirming that a candidate slot holds the ID
+    template <typename Match>
+    std::optional<size_t> find(uint64_t hash, Match&& match) const {
+        if (capacity_ == 0)
+            return std::nullopt;
+        const size_t mask = capacity_ - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const SlotBucket& b = buckets_[i];
+            if (b.slot == 0)
+                return std::nullopt;
+            if (b.hash == hash && match(static_cast<size_t>(b.slot - 1)))
+                return static_cast<size_t>(b.slot - 1);
+        }
+    }
+
+    /// @brief Insert an entry (the ID must not already be present)
+    void insert(uint64_t hash, size_t slot) noexcept {
+        const size_t mask = capacity_ - 1;
+        size_t i = hash & mask;
+        while (buckets_[i].slot != 0)
+            i = (i + 1) & mask;
+        buckets_[i].hash = hash;
+        buckets_[i].slot = static_cast<uint64_t>(slot) + 1;
+    }
+
+    /// @brief Change the slot of an existing entry
+    /// @return false if the ID was not found
+    template <typename Match> bool update(uint64_t hash, size_t newSlot, Match&& match) {
+        const size_t idx = bucketOf(hash, match);
+        if (idx == capacity_)
+            return false;
+        buckets_[idx].slot = static_cast<uint64_t>(newSlot) + 1;
+        return true;
+    }
+
+    /// @brief Remove an entry
+    /// @return false if the ID was not found
+    template <typename Match> bool erase(uint64_t hash, Match&& match) {
+        size_t i = bucketOf(hash, match);
+        if (i == capacity_)
+            return false;
+
+        // Backward-shift deletion: pull later entries of the probe chain into the hole
+        const size_t mask = capacity_ - 1;
+        for (size_t j = (i + 1) & mask; buckets_[j].slot != 0; j = (j + 1) & mask) {
+            const size_t home = buckets_[j].hash & mask;
+            // Entry j may move to i only if its home bucket is not within (i, j]
+            const bool homeInRange = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+            if (!homeInRange) {
+                buckets_[i] = buckets_[j];
+                i = j;
+            }
+        }
+        buckets_[i] = SlotBucket{0, 0};
+        return true;
+    }
+
+    /// @brief Visit every stored slot; `fn(size_t slot)` returns the (possibly new) slot
+    template <typename Fn> void remapSlots(Fn&& fn) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (buckets_[i].slot != 0)
+                buckets_[i].slot = static_cast<uint64_t>(fn(buckets_[i].slot - 1)) + 1;
+        }
+    }
+
+    /// @brief Visit every entry as `fn(uint64_t hash, size_t slot)`
+    template <typename Fn> void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (buckets_[i].slot != 0)
+                fn(buckets_[i].hash, static_cast<size_t>(buckets_[i].slot - 1));
+        }
+    }
+
+    /// @brief Remove every entry
+    void clear() noexcept {
+        for (size_t i = 0; i < capacity_; ++i)
+            buckets_[i] = SlotBucket{0, 0};
+    }
+
+  private:
+    template <typename Match> size_t bucketOf(uint64_t hash, Match& match) const {
+        if (capacity_ == 0)
+            return capacity_;
+        const size_t mask = capacity_ - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const SlotBucket& b = buckets_[i];
+            if (b.slot == 0)
+                return capacity_;
+            if (b.hash == hash && match(static_cast<size_t>(b.slot - 1)))
+                return i;
+        }
+    }
+
+    SlotBucket* buckets_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+} // namespace detail
+} // namespace FdFile
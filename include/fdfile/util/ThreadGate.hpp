@@ -0,0 +1,112 @@
+#pragma once
+/// @file ThreadGate.hpp
+/// @brief In-process reader/writer gate layered under the fcntl file lock (internal)
+
+#include "FileLockGuard.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Reader/writer lock for a repository instance shared between threads
+///
+/// fcntl locks belong to the process: a second thread's lock request is a no-op and the first
+/// unlock releases the lock for every thread. The gate orders the threads itself and keeps a
+/// single shared file lock for all concurrent reader threads (see SharedGateLock), taken by
+/// the first and released by the last. A thread holding the exclusive side is alone in the
+/// process, so it takes and releases the file lock with a plain FileLockGuard.
+///
+/// @note This class is for internal library use.
+class ThreadGate {
+  public:
+    /// @brief Exclusive side: writers, and readers that have to refresh the cache
+    std::unique_lock<std::shared_mutex> lockExclusive() {
+        return std::unique_lock<std::shared_mutex>(mutex_);
+    }
+
+    /// @brief Shared side without the file lock, for purely in-memory state
+    std::shared_lock<std::shared_mutex> lockShared() {
+        return std::shared_lock<std::shared_mutex>(mutex_);
+    }
+
+    /// @brief Serializes state that readers still mutate under the shared side (e.g. an LRU)
+    std::mutex& readerStateMutex() noexcept { return readerMu_; }
+
+  private:
+    friend class SharedGateLock;
+
+    std::shared_mutex mutex_;
+    std::mutex fileMu_;      ///< Guards fileReaders_ and fileLock_
+    size_t fileReaders_ = 0; ///< SharedGateLocks currently relying on fileLock_
+    FileLockGuard fileLock_; ///< Shared fcntl lock of the process's reader threads
+    std::mutex readerMu_;
+};
+
+/// @brief Shared side of a ThreadGate plus the process's shared fcntl lock on a file
+/// @note This class is for internal library use.
+class SharedGateLock {
+  public:
+    SharedGateLock() = default;
+    ~SharedGateLock() { unlock(); }
+
+    SharedGateLock(const SharedGateLock&) = delete;
+    SharedGateLock& operator=(const SharedGateLock&) = delete;
+
+    SharedGateLock(SharedGateLock&& other) noexcept : gate_(other.gate_) { other.gate_ = nullptr; }
+    SharedGateLock& operator=(SharedGateLock&& other) noexcept {
+        if (this != &other) {
+            unlock();
+            gate_ = other.gate_;
+            other.gate_ = nullptr;
+        }
+        return *this;
+    }
+
+    /// @brief Enter the shared side and make sure the process holds a shared lock on fd
+    /// @param gate Gate of the repository
+    /// @param fd File to lock (the same file for every reader of the gate)
+    /// @param ec Error code set if the file lock failed
+    /// @return true on success
+    bool lock(ThreadGate& gate, int fd, std::error_code& ec) {
+        unlock();
+        ec.clear();
+        gate.mutex_.lock_shared();
+        {
+            std::lock_guard<std::mutex> guard(gate.fileMu_);
+            if (gate.fileReaders_ == 0 &&
+                !gate.fileLock_.lock(fd, FileLockGuard::Mode::Shared, ec)) {
+                gate.mutex_.unlock_shared();
+                return false;
+            }
+            ++gate.fileReaders_;
+        }
+        gate_ = &gate;
+        return true;
+    }
+
+    /// @brief Leave the shared side (the last reader releases the file lock)
+    void unlock() noexcept {
+        if (!gate_)
+            return;
+        {
+            std::lock_guard<std::mutex> guard(gate_->fileMu_);
+            if (--gate_->fileReaders_ == 0)
+                gate_->fileLock_.unlockIgnore();
+        }
+        gate_->mutex_.unlock_shared();
+        gate_ = nullptr;
+    }
+
+    /// @brief Whether the shared side is held
+    bool locked() const noexcept { return gate_ != nullptr; }
+
+  private:
+    ThreadGate* gate_ = nullptr;
+};
+
+} // namespace detail
+} // namespace FdFile
@@ -0,0 +1,113 @@
+#pragma once
+/// @file WriteBatch.hpp
+/// @brief Reusable chunked output buffer flushed with writev (internal)
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace FdFile {
+namespace detail {
+
+/// @brief Output buffer made of large chunks, written with as few writev() calls as possible
+///
+/// Callers append text to buffer(); once the current chunk reaches `chunkBytes` a new one is
+/// started, so appending never moves bytes that were already serialized. clear() keeps the
+/// first few chunks allocated for the next batch.
+///
+/// @note This class is for internal library use.
+class WriteBatch {
+  public:
+    /// @param chunkBytes Size at which a new chunk is started
+    /// @param retainedChunks Chunks whose storage survives clear()
+    explicit WriteBatch(size_t chunkBytes = 256 * 1024, size_t retainedChunks = 4)
+        : chunkBytes_(chunkBytes == 0 ? 1 : chunkBytes), retainedChunks_(retainedChunks) {}
+
+    /// @brief Chunk to append the next piece of output to
+    std::string& buffer() {
+        if (used_ == 0 || chunks_[used_ - 1].size() >= chunkBytes_) {
+            if (used_ == chunks_.size())
+                chunks_.emplace_back();
+            chunks_[used_].reserve(chunkBytes_ + chunkBytes_ / 4);
+            ++used_;
+        }
+        return chunks_[used_ - 1];
+    }
+
+    /// @brief Total bytes buffered
+    size_t size() const {
+        size_t n = 0;
+        for (size_t i = 0; i < used_; ++i)
+            n += chunks_[i].size();
+        return n;
+    }
+
+    /// @brief Drop the buffered bytes, keeping up to `retainedChunks` allocations
+    void clear() {
+        for (size_t i = 0; i < used_; ++i)
+            chunks_[i].clear();
+        if (chunks_.size() > retainedChunks_)
+            chunks_.resize(retainedChunks_);
+        used_ = 0;
+    }
+
+    /// @brief Write every buffered byte to fd at its current offset
+    /// @param fd Destination file descriptor
+    /// @param ec Error code set on failure
+    /// @return true when everything was written
+    bool writeTo(int fd, std::error_code& ec) const {
+#ifdef IOV_MAX
+        const size_t maxIov = IOV_MAX;
+#else
+        const size_t maxIov = 16;
+#endif
+        std::vector<struct iovec> iov;
+        iov.reserve(std::min(used_, maxIov));
+
+        size_t chunk = 0, offset = 0; // First byte not yet written
+        while (chunk < used_) {
+            iov.clear();
+            for (size_t i = chunk; i < used_ && iov.size() < maxIov; ++i) {
+                const size_t skip = (i == chunk) ? offset : 0;
+                if (chunks_[i].size() > skip)
+                    iov.push_back({const_cast<char*>(chunks_[i].data()) + skip,
+                                   chunks_[i].size() - skip});
+            }
+            if (iov.empty())
+                break;
+
+            ssize_t n = ::writev(fd, iov.data(), static_cast<int>(iov.size()));
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+
+            // Advance past the bytes written (short writes resume mid-chunk)
+            size_t left = static_cast<size_t>(n);
+            while (chunk < used_ && left >= chunks_[chunk].size() - offset) {
+                left -= chunks_[chunk].size() - offset;
+                ++chunk;
+                offset = 0;
+            }
+            offset += left;
+        }
+        return true;
+    }
+
+  private:
+    std::vector<std::string> chunks_;
+    size_t used_ = 0; ///< Chunks holding data in this batch
+    size_t chunkBytes_;
+    size_t retainedChunks_;
+};
+
+} // namespace detail
+} // namespace FdFile
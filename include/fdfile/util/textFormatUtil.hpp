@@ -2,9 +2,15 @@
 /// @file textFormatUtil.hpp
 /// @brief Text format utilities for JSON-like parsing and formatting
 
+#include "SimdScan.hpp"
+
 #include <cctype>
+#include <charconv>
+#include <cstring>
+#include <deque>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <unordered_map>
 #include <vector>
@@ -12,96 +18,209 @@
 namespace FdFile::util {
 
 /// @brief Strict long integer parsing with range check
+/// @details Accepts leading whitespace and an optional sign, like std::stoll, but rejects any
+///          trailing characters. Works on a view, so no temporary string is built.
 /// @param s String to parse
 /// @param out Output value
 /// @param ec Error code set on failure
 /// @return true on success
-inline bool parseLongStrict(const std::string& s, long& out, std::error_code& ec) {
+inline bool parseLongStrict(std::string_view s, long& out, std::error_code& ec) {
     ec.clear();
-    try {
-        size_t pos = 0;
-        long long v = std::stoll(s, &pos, 10);
-        if (pos != s.size())
-            throw 1;
-
-        if (v < (long long)std::numeric_limits<long>::min() ||
-            v > (long long)std::numeric_limits<long>::max()) {
-            ec = std::make_error_code(std::errc::result_out_of_range);
-            return false;
-        }
-        out = (long)v;
-        return true;
-    } catch (...) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (p < end && std::isspace((unsigned char)*p))
+        ++p;
+    if (p < end && *p == '+' && (p + 1 == end || p[1] != '-'))
+        ++p;
+
+    long long v = 0;
+    auto res = std::from_chars(p, end, v, 10);
+    if (res.ec != std::errc() || res.ptr != end || p == end) {
+        // Values outside long long are malformed input, as with std::stoll
         ec = std::make_error_code(std::errc::invalid_argument);
         return false;
     }
+    if (v < (long long)std::numeric_limits<long>::min() ||
+        v > (long long)std::numeric_limits<long>::max()) {
+        ec = std::make_error_code(std::errc::result_out_of_range);
+        return false;
+    }
+    out = (long)v;
+    return true;
+}
+
+/// @brief Whether c is whitespace in the C locale (without the locale lookup of std::isspace)
+inline bool isAsciiSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r'); // \t \n \v \f \r
 }
 
 /// @brief Skip whitespace characters
 inline void skipWs(const char*& p, const char* end) {
-    while (p < end && std::isspace((unsigned char)*p))
+    while (p < end && isAsciiSpace(*p))
         ++p;
 }
 
-/// @brief Parse identifier (alphanumeric + underscore)
+/// @brief Flat list of key/value views produced by parseLineView() and consumed by
+///        VariableRecordBase::fromKvView()/toKvView()
+/// @details Entries point into the parsed line, into record members, or into strings owned by
+///          the list (store()/scratch()), which stay valid until clear(). clear() keeps every
+///          allocation, so a list reused across lines stops allocating once warmed up.
+///          Lookups are linear, which beats hashing for the handful of fields a record has.
+class KvViews {
+  public:
+    /// @brief One field
+    struct Entry {
+        std::string_view key;
+        bool isString; ///< true: quoted string, false: integer token
+        std::string_view value;
+    };
+
+    /// @brief Remove all entries (keeps capacity)
+    void clear() noexcept {
+        entries_.clear();
+        usedStore_ = 0;
+    }
+
+    /// @brief Append a field (the viewed bytes must outlive the use of the list)
+    void add(std::string_view key, bool isString, std::string_view value) {
+        entries_.push_back(Entry{key, isString, value});
+    }
+
+    /// @brief Copy `s` into storage owned by the list
+    /// @return View of the copy, valid until clear()
+    std::string_view store(std::string_view s) {
+        std::string& buf = scratch();
+        buf.assign(s.data(), s.size());
+        return buf;
+    }
+
+    /// @brief Empty owned string to build a value in; stays valid (and in place) until clear()
+    std::string& scratch() {
+        if (usedStore_ == store_.size())
+            store_.emplace_back(); // deque: existing strings never move
+        std::string& buf = store_[usedStore_++];
+        buf.clear();
+        return buf;
+    }
+
+    /// @brief First entry with the given key, or nullptr
+    const Entry* find(std::string_view key) const noexcept {
+        for (const auto& e : entries_) {
+            if (e.key == key)
+                return &e;
+        }
+        return nullptr;
+    }
+
+    size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+    const Entry& operator[](size_t i) const noexcept { return entries_[i]; }
+    std::vector<Entry>::const_iterator begin() const noexcept { return entries_.begin(); }
+    std::vector<Entry>::const_iterator end() const noexcept { return entries_.end(); }
+
+  private:
+    std::vector<Entry> entries_;
+    std::deque<std::string> store_;
+    size_t usedStore_ = 0; ///< Strings of store_ handed out since the last clear()
+};
+
+/// @brief Parse identifier as a view into the input
 /// @param p Input pointer (updated on success)
 /// @param end End of input
-/// @param out Output string
+/// @param out Output view
 /// @return true on success
-inline bool parseIdent(const char*& p, const char* end, std::string& out) {
+inline bool parseIdentView(const char*& p, const char* end, std::string_view& out) {
     skipWs(p, end);
     if (p >= end || !(std::isalpha((unsigned char)*p) || *p == '_'))
         return false;
     const char* s = p++;
     while (p < end && (std::isalnum((unsigned char)*p) || *p == '_'))
         ++p;
-    out.assign(s, p);
+    out = std::string_view(s, static_cast<size_t>(p - s));
     return true;
 }
 
-/// @brief Parse quoted string with escape sequences
+namespace detail {
+
+/// @brief Find the closing quote of a string body starting at p
+/// @param p Input pointer, just after the opening quote (left on the closing quote)
+/// @param hasEscape Set when the body contains a backslash
+/// @return false if the string is unterminated
+inline bool scanQuotedBody(const char*& p, const char* end, bool& hasEscape) {
+    hasEscape = false;
+    while ((p = FdFile::detail::findScanChar<FdFile::detail::ScanSet::QuoteOrBackslash>(p, end)) <
+           end) {
+        if (*p == '"')
+            return true;
+        hasEscape = true;
+        p += 2; // Skip the escaped character
+    }
+    return false;
+}
+
+/// @brief Append the unescaped form of [s, e) to out
+/// @return false on an unknown escape sequence
+inline bool decodeEscapes(const char* s, const char* e, std::string& out) {
+    out.reserve(out.size() + static_cast<size_t>(e - s));
+    while (s < e) {
+        // Bulk-copy the clean span up to the next backslash
+        const char* bs = static_cast<const char*>(std::memchr(s, '\\', static_cast<size_t>(e - s)));
+        if (!bs) {
+            out.append(s, e);
+            break;
+        }
+        out.append(s, bs);
+        s = bs + 1;
+        char esc = *s++; // scanQuotedBody guarantees a following byte
+        if (esc == '"' || esc == '\\')
+            out.push_back(esc);
+        else if (esc == 'n')
+            out.push_back('\n');
+        else if (esc == 't')
+            out.push_back('\t');
+        else
+            return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/// @brief Parse quoted string as a view
+/// @details The view points into the input unless the string contains escapes; only then is
+///          it decoded into storage owned by `kv` (KvViews::scratch()).
 /// @param p Input pointer (updated on success)
 /// @param end End of input
-/// @param out Output string
+/// @param out Output view
+/// @param kv Owner of decoded strings
 /// @return true on success
-inline bool parseQuotedString(const char*& p, const char* end, std::string& out) {
+inline bool parseQuotedView(const char*& p, const char* end, std::string_view& out, KvViews& kv) {
     skipWs(p, end);
     if (p >= end || *p != '"')
         return false;
-    ++p;
+    const char* s = ++p;
+    bool hasEscape = false;
+    if (!detail::scanQuotedBody(p, end, hasEscape))
+        return false;
+    const char* e = p++;
 
-    std::string s;
-    while (p < end) {
-        char c = *p++;
-        if (c == '"') {
-            out = std::move(s);
-            return true;
-        }
-        if (c == '\\') {
-            if (p >= end)
-                return false;
-            char e = *p++;
-            if (e == '"' || e == '\\')
-                s.push_back(e);
-            else if (e == 'n')
-                s.push_back('\n');
-            else if (e == 't')
-                s.push_back('\t');
-            else
-                return false;
-        } else {
-            s.push_back(c);
-        }
+    if (!hasEscape) {
+        out = std::string_view(s, static_cast<size_t>(e - s));
+        return true;
     }
-    return false;
+    std::string& buf = kv.scratch();
+    if (!detail::decodeEscapes(s, e, buf))
+        return false;
+    out = buf;
+    return true;
 }
 
-/// @brief Parse integer token (optionally signed)
+/// @brief Parse integer token (optionally signed) as a view
 /// @param p Input pointer (updated on success)
 /// @param end End of input
-/// @param out Output string
+/// @param out Output view
 /// @return true on success
-inline bool parseIntToken(const char*& p, const char* end, std::string& out) {
+inline bool parseIntTokenView(const char*& p, const char* end, std::string_view& out) {
     skipWs(p, end);
     const char* s = p;
     if (p < end && (*p == '-' || *p == '+'))
@@ -111,46 +230,90 @@ inline bool parseIntToken(const char*& p, const char* end, std::string& out) {
         ++p;
     if (p == digits)
         return false;
-    out.assign(s, p);
+    out = std::string_view(s, static_cast<size_t>(p - s));
+    return true;
+}
+
+/// @brief Parse identifier (alphanumeric + underscore)
+/// @param p Input pointer (updated on success)
+/// @param end End of input
+/// @param out Output string
+/// @return true on success
+inline bool parseIdent(const char*& p, const char* end, std::string& out) {
+    std::string_view v;
+    if (!parseIdentView(p, end, v))
+        return false;
+    out.assign(v.data(), v.size());
+    return true;
+}
+
+/// @brief Parse quoted string with escape sequences
+/// @param p Input pointer (updated on success)
+/// @param end End of input
+/// @param out Output string
+/// @return true on success
+inline bool parseQuotedString(const char*& p, const char* end, std::string& out) {
+    skipWs(p, end);
+    if (p >= end || *p != '"')
+        return false;
+    const char* s = ++p;
+    bool hasEscape = false;
+    if (!detail::scanQuotedBody(p, end, hasEscape))
+        return false;
+    const char* e = p++;
+
+    std::string decoded;
+    if (!detail::decodeEscapes(s, e, decoded))
+        return false;
+    out = std::move(decoded);
+    return true;
+}
+
+/// @brief Parse integer token (optionally signed)
+/// @param p Input pointer (updated on success)
+/// @param end End of input
+/// @param out Output string
+/// @return true on success
+inline bool parseIntToken(const char*& p, const char* end, std::string& out) {
+    std::string_view v;
+    if (!parseIntTokenView(p, end, v))
+        return false;
+    out.assign(v.data(), v.size());
     return true;
 }
 
 /// @brief Escape string for JSON output
 /// @param in Input string
 /// @return Escaped string
-inline std::string escapeString(const std::string& in) {
-    std::string o;
-    o.reserve(in.size() + 4);
-    for (char c : in) {
-        if (c == '"' || c == '\\') {
-            o.push_back('\\');
-            o.push_back(c);
-        } else if (c == '\n')
-            o += "\\n";
-        else if (c == '\t')
-            o += "\\t";
-        else
-            o.push_back(c);
-    }
-    return o;
+inline std::string escapeString(std::string_view in);
+
+/// @brief Type name of a line without parsing its body
+/// @param line Input line
+/// @param type Output view into `line`
+/// @return false if the line does not start with an identifier
+inline bool peekLineType(std::string_view line, std::string_view& type) {
+    const char* p = line.data();
+    return parseIdentView(p, p + line.size(), type);
 }
 
-/// @brief Parse a single line (excluding newline): Type { "k": "v", "id": 123 }
+/// @brief Parse a single line (excluding newline) without copying: Type { "k": "v", "id": 123 }
+/// @details `type` and the keys/values in `kv` view `line` (or strings owned by `kv` for values
+///          with escapes), so both must outlive their use. `kv` is cleared first; reusing one
+///          list across lines avoids per-line allocations.
 /// @param line Input line
 /// @param type Output type name
-/// @param kv Output key-value map
+/// @param kv Output fields, in line order
 /// @param ec Error code set on failure
 /// @return true on success
-inline bool parseLine(const std::string& line, std::string& type,
-                      std::unordered_map<std::string, std::pair<bool, std::string>>& kv,
-                      std::error_code& ec) {
+inline bool parseLineView(std::string_view line, std::string_view& type, KvViews& kv,
+                          std::error_code& ec) {
     ec.clear();
     kv.clear();
 
     const char* p = line.data();
     const char* end = p + line.size();
 
-    if (!parseIdent(p, end, type)) {
+    if (!parseIdentView(p, end, type)) {
         ec = std::make_error_code(std::errc::invalid_argument);
         return false;
     }
@@ -174,8 +337,8 @@ inline bool parseLine(const std::string& line, std::string& type,
     }
 
     while (true) {
-        std::string key;
-        if (!parseQuotedString(p, end, key)) {
+        std::string_view key;
+        if (!parseQuotedView(p, end, key, kv)) {
             ec = std::make_error_code(std::errc::invalid_argument);
             return false;
         }
@@ -189,28 +352,28 @@ inline bool parseLine(const std::string& line, std::string& type,
 
         skipWs(p, end);
         bool isStr = false;
-        std::string val;
+        std::string_view val;
 
         if (p < end && *p == '"') {
             isStr = true;
-            if (!parseQuotedString(p, end, val)) {
+            if (!parseQuotedView(p, end, val, kv)) {
                 ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
         } else {
             isStr = false;
-            if (!parseIntToken(p, end, val)) {
+            if (!parseIntTokenView(p, end, val)) {
                 ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
         }
 
         // Duplicate key is treated as format error
-        if (kv.find(key) != kv.end()) {
+        if (kv.find(key) != nullptr) {
             ec = std::make_error_code(std::errc::invalid_argument);
             return false;
         }
-        kv.emplace(std::move(key), std::make_pair(isStr, std::move(val)));
+        kv.add(key, isStr, val);
 
         skipWs(p, end);
         if (p >= end) {
@@ -239,15 +402,62 @@ inline bool parseLine(const std::string& line, std::string& type,
     return true;
 }
 
-/// @brief Format fields into a JSON-like line
+/// @brief Parse a single line (excluding newline): Type { "k": "v", "id": 123 }
+/// @details Map-based compatibility wrapper around parseLineView().
+/// @param line Input line
+/// @param type Output type name
+/// @param kv Output key-value map
+/// @param ec Error code set on failure
+/// @return true on success
+inline bool parseLine(std::string_view line, std::string& type,
+                      std::unordered_map<std::string, std::pair<bool, std::string>>& kv,
+                      std::error_code& ec) {
+    kv.clear();
+    KvViews views;
+    std::string_view typeView;
+    if (!parseLineView(line, typeView, views, ec))
+        return false;
+    type.assign(typeView.data(), typeView.size());
+    kv.reserve(views.size());
+    for (const auto& e : views)
+        kv.emplace(std::string(e.key), std::make_pair(e.isString, std::string(e.value)));
+    return true;
+}
+
+/// @brief Append `in` to `out` with JSON escaping
+/// @param out Destination string
+/// @param in Input string
+inline void appendEscaped(std::string& out, std::string_view in) {
+    const char* p = in.data();
+    const char* end = p + in.size();
+    while (true) {
+        // Bulk-copy the clean span up to the next character that needs escaping
+        const char* q = FdFile::detail::findScanChar<FdFile::detail::ScanSet::NeedsEscape>(p, end);
+        out.append(p, q);
+        if (q == end)
+            return;
+        const char c = *q;
+        out.push_back('\\');
+        out.push_back(c == '\n' ? 'n' : c == '\t' ? 't' : c);
+        p = q + 1;
+    }
+}
+
+inline std::string escapeString(std::string_view in) {
+    std::string o;
+    o.reserve(in.size() + 4);
+    appendEscaped(o, in);
+    return o;
+}
+
+/// @brief Append one formatted JSON-like line (with trailing newline) to `out`
+/// @details Lets callers serialize many records into one reusable buffer.
+/// @param out Destination string
 /// @param type Type name
 /// @param fields Field key-value pairs
-/// @return Formatted line string
-inline std::string
-formatLine(const char* type,
-           const std::vector<std::pair<std::string, std::pair<bool, std::string>>>& fields) {
-
-    std::string out;
+inline void appendFormattedLine(
+    std::string& out, const char* type,
+    const std::vector<std::pair<std::string, std::pair<bool, std::string>>>& fields) {
     out += type;
     out += " { ";
     for (size_t i = 0; i < fields.size(); ++i) {
@@ -256,11 +466,11 @@ formatLine(const char* type,
         const auto& v = fields[i].second.second;
 
         out += '"';
-        out += escapeString(k);
+        appendEscaped(out, k);
         out += "\": ";
         if (isStr) {
             out += '"';
-            out += escapeString(v);
+            appendEscaped(out, v);
             out += '"';
         } else {
             out += v;
@@ -270,6 +480,43 @@ formatLine(const char* type,
             out += ", ";
     }
     out += " }\n"; // Add newline for proper line-by-line parsing
+}
+
+/// @brief Append one formatted line built from a KvViews list to `out`
+/// @param out Destination string
+/// @param type Type name
+/// @param fields Fields, written in list order
+inline void appendFormattedLine(std::string& out, std::string_view type, const KvViews& fields) {
+    out += type;
+    out += " { ";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const auto& f = fields[i];
+        out += '"';
+        appendEscaped(out, f.key);
+        out += "\": ";
+        if (f.isString) {
+            out += '"';
+            appendEscaped(out, f.value);
+            out += '"';
+        } else {
+            out += f.value;
+        }
+
+        if (i + 1 < fields.size())
+            out += ", ";
+    }
+    out += " }\n";
+}
+
+/// @brief Format fields into a JSON-like line
+/// @param type Type name
+/// @param fields Field key-value pairs
+/// @return Formatted line string
+inline std::string
+formatLine(const char* type,
+           const std::vector<std::pair<std::string, std::pair<bool, std::string>>>& fields) {
+    std::string out;
+    appendFormattedLine(out, type, fields);
     return out;
 }
 
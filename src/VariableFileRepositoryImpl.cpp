@@ -1,12 +1,21 @@
 #include <fdfile/repository/VariableFileRepositoryImpl.hpp>
 #include <fdfile/util/FileLockGuard.hpp>
+#include <fdfile/util/FileStat.hpp>
+#include <fdfile/util/MmapGuard.hpp>
+#include <fdfile/util/ParallelScan.hpp>
+#include <fdfile/util/SlotHashTable.hpp>
 #include <fdfile/util/textFormatUtil.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fcntl.h>
 #include <filesystem>
-#include <sstream>
+#include <functional>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <utility>
 
 namespace FdFile {
 
@@ -15,17 +24,25 @@ namespace fs = std::filesystem;
 VariableFileRepositoryImpl::VariableFileRepositoryImpl(
     const std::string& path, std::vector<std::unique_ptr<VariableRecordBase>> prototypes,
     std::error_code& ec)
-    : path_(path) {
+    : VariableFileRepositoryImpl(path, std::move(prototypes), VariableRepositoryOptions{}, ec) {}
+
+VariableFileRepositoryImpl::VariableFileRepositoryImpl(
+    const std::string& path, std::vector<std::unique_ptr<VariableRecordBase>> prototypes,
+    const VariableRepositoryOptions& options, std::error_code& ec)
+    : path_(path), options_(options),
+      recordCache_(options.lazyLoad ? options.recordCacheBytes : 0) {
     ec.clear();
+    if (options_.threadSafe || options_.asyncWrites)
+        gate_ = std::make_unique<detail::ThreadGate>();
 
     for (auto& p : prototypes) {
         if (!p)
             continue;
         std::string t = p->typeName();
-        if (prototypes_.find(t) == prototypes_.end()) {
-            prototypes_[t] = std::move(p);
-        }
+        if (typeIds_.emplace(t, static_cast<uint32_t>(prototypes_.size())).second)
+            prototypes_.push_back(std::move(p));
     }
+    typeSlots_.resize(prototypes_.size());
 
     // Create directory if needed
     fs::path p(path_);
@@ -51,50 +68,84 @@ VariableFileRepositoryImpl::VariableFileRepositoryImpl(
         return;
     }
 
+    if (options_.controlFile) {
+        control_ = std::make_unique<detail::ControlFile>();
+        if (!control_->open(path_ + ".ctl", ec))
+            return;
+    }
+
+    // An existing file must already be in the requested format
+    char head[detail::BINARY_MAGIC_LEN];
+    const ssize_t headLen = ::pread(fd_.get(), head, sizeof(head), 0);
+    if (headLen > 0 && detail::isBinaryVariableData(head, static_cast<size_t>(headLen)) !=
+                           (options_.format == VariableFormat::Binary)) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return;
+    }
+
     // Save initial file stat (for external modification detection)
+    noteFileIdentity();
     updateFileStats();
+
+    if (options_.durability == Durability::GroupCommit) {
+        flusher_ = std::make_unique<detail::GroupCommitFlusher>(
+            fd_.get(), options_.groupCommit.interval, options_.groupCommit.maxPendingWrites);
+    }
+    if (options_.asyncWrites) {
+        async_.enable(options_.asyncMaxBatch);
+        asyncQueue();
+    }
+}
+
+VariableFileRepositoryImpl::~VariableFileRepositoryImpl() {
+    async_.stop();
+    flusher_.reset();
 }
 
 bool VariableFileRepositoryImpl::save(const VariableRecordBase& record, std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, Save);
+    auto exclusive = lockThreadsExclusive();
+    return saveRecord(record, ec);
+}
+
+bool VariableFileRepositoryImpl::saveRecord(const VariableRecordBase& record,
+                                            std::error_code& ec) {
     // Check cache refresh
     if (!checkAndRefreshCache(ec))
         return false;
 
-    if (existsById(record.id(), ec)) {
-        // Update
-        auto all = findAll(ec);
-        if (ec)
+    if (options_.logStructured) {
+        // Insert and update are both an append; the loader keeps the last version
+        if (!appendRecord(record, ec))
             return false;
+        return maybeCompact(ec);
+    }
 
-        // Replace
-        bool replaced = false;
-        for (auto& r : all) {
-            if (r->id() == record.id()) {
-                auto cloned = record.clone();
-                if (auto* v = dynamic_cast<VariableRecordBase*>(cloned.get())) {
-                    (void)cloned.release();
-                    r.reset(v);
-                    replaced = true;
-                }
-                break;
-            }
-        }
-        if (replaced) {
-            invalidateCache();
-            return rewriteAll(all, ec);
-        }
-        return false;
-    } else {
-        // Insert
-        invalidateCache();
+    const std::string id = record.id();
+    if (!hasId(id)) {
+        // Insert (cache stays valid; the appended line is parsed on next access)
         return appendRecord(record, ec);
     }
+
+    // Update: rewrite the cached snapshots with this record substituted, under one lock so
+    // no other writer's change is lost in between
+    detail::FileLockGuard lock;
+    if (!lockForWriteStep(lock, ec))
+        return false;
+    if (!checkAndRefreshCache(ec))
+        return false;
+
+    // Appended at the end if another writer deleted it meanwhile
+    auto pos = idIndex_.find(id);
+    return rewriteLive(pos == idIndex_.end() ? NO_SLOT : pos->second, &record, ec);
 }
 
 bool VariableFileRepositoryImpl::saveAll(const std::vector<const VariableRecordBase*>& records,
                                          std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, SaveAll);
+    auto exclusive = lockThreadsExclusive();
     for (const auto* r : records) {
-        if (!save(*r, ec))
+        if (!saveRecord(*r, ec))
             return false;
     }
     return true;
@@ -102,6 +153,7 @@ bool VariableFileRepositoryImpl::saveAll(const std::vector<const VariableRecordB
 
 std::vector<std::unique_ptr<VariableRecordBase>>
 VariableFileRepositoryImpl::findAll(std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, FindAll);
     ec.clear();
     std::vector<std::unique_ptr<VariableRecordBase>> result;
 
@@ -110,154 +162,810 @@ VariableFileRepositoryImpl::findAll(std::error_code& ec) {
         return result;
     }
 
-    detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
-    if (ec)
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
         return result;
 
-    // Check cache refresh
-    if (!checkAndRefreshCache(ec))
+    // Return copies from cache
+    result.reserve(idIndex_.size());
+    for (size_t i = 0; i < slotCount(); ++i) {
+        std::error_code rec;
+        Snapshot r = recordAt(i, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return {};
+        }
+        if (!r)
+            continue; // Deleted by a later tombstone line
+        if (auto cloned = r->cloneVariable())
+            result.push_back(std::move(cloned));
+    }
+    return result;
+}
+
+std::vector<VariableFileRepositoryImpl::Snapshot>
+VariableFileRepositoryImpl::findAllShared(std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, FindAll);
+    ec.clear();
+    std::vector<Snapshot> result;
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
         return result;
 
-    // Return copies from cache
-    for (const auto& r : cache_) {
-        auto cloned = r->clone();
-        if (auto* v = dynamic_cast<VariableRecordBase*>(cloned.get())) {
-            (void)cloned.release();
-            result.push_back(std::unique_ptr<VariableRecordBase>(v));
+    result.reserve(idIndex_.size());
+    for (size_t i = 0; i < slotCount(); ++i) {
+        std::error_code rec;
+        Snapshot r = recordAt(i, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return {};
         }
+        if (r)
+            result.push_back(std::move(r));
     }
     return result;
 }
 
-std::unique_ptr<VariableRecordBase> VariableFileRepositoryImpl::findById(const std::string& id,
-                                                                         std::error_code& ec) {
-    detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Shared, ec);
-    if (ec)
+VariableFileRepositoryImpl::Snapshot
+VariableFileRepositoryImpl::findByIdShared(const std::string& id, std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, FindById);
+    ec.clear();
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
         return nullptr;
 
-    // Check cache refresh
-    if (!checkAndRefreshCache(ec))
-        return nullptr;
+    return lookup(id, ec);
+}
+
+bool VariableFileRepositoryImpl::forEach(
+    const std::function<bool(const VariableRecordBase&)>& visitor, std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, FindAll);
+    ec.clear();
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
+        return false;
+    return visit(visitor, ec);
+}
 
-    for (const auto& r : cache_) {
-        if (r->id() == id) {
-            auto cloned = r->clone();
-            if (auto* v = dynamic_cast<VariableRecordBase*>(cloned.get())) {
-                (void)cloned.release();
-                return std::unique_ptr<VariableRecordBase>(v);
+bool VariableFileRepositoryImpl::parallelForEach(
+    const std::function<bool(const VariableRecordBase&)>& visitor, std::error_code& ec,
+    size_t threads) {
+    FDFILE_STATS_TIMER(stats_, FindAll);
+    ec.clear();
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
+        return false;
+    if (options_.lazyLoad && options_.format == VariableFormat::Binary)
+        return visit(visitor, ec); // Decoding may extend the shared dictionary
+
+    const size_t cnt = slotCount();
+    const size_t chunks = detail::scanChunkCount(cnt, threads, 1);
+    std::vector<std::error_code> errors(chunks);
+    std::atomic<bool> stop{false};
+    detail::runParallel(chunks, [&](size_t c) {
+        std::string scratch;
+        util::KvViews kv;
+        const size_t end = detail::chunkBegin(cnt, chunks, c + 1);
+        for (size_t i = detail::chunkBegin(cnt, chunks, c); i < end; ++i) {
+            if (stop.load(std::memory_order_relaxed))
+                return;
+            Snapshot r;
+            if (options_.lazyLoad) {
+                if (locs_[i].length == 0)
+                    continue;
+                r = decodeTextAt(locs_[i].offset, locs_[i].length, scratch, kv, errors[c]);
+                if (errors[c]) {
+                    stop.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                r = cache_[i];
+            }
+            if (r && !visitor(*r)) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
             }
         }
+    });
+    for (const auto& e : errors) {
+        if (e) {
+            ec = e;
+            return false;
+        }
     }
-    return nullptr;
+    return true;
+}
+
+std::unique_ptr<VariableRecordBase> VariableFileRepositoryImpl::findById(const std::string& id,
+                                                                         std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, FindById);
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
+        return nullptr;
+
+    Snapshot r = lookup(id, ec);
+    return r ? r->cloneVariable() : nullptr;
 }
 
 bool VariableFileRepositoryImpl::deleteById(const std::string& id, std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, Delete);
+    auto exclusive = lockThreadsExclusive();
+    return deleteRecord(id, ec);
+}
+
+bool VariableFileRepositoryImpl::deleteRecord(const std::string& id, std::error_code& ec) {
     // Check cache refresh
     if (!checkAndRefreshCache(ec))
         return false;
 
-    auto all = findAll(ec);
-    if (ec)
+    if (options_.logStructured) {
+        if (!hasId(id))
+            return true; // Not found acts as success
+        kvScratch_.clear();
+        kvScratch_.add("id", true, id);
+        if (!appendEntry(VARIABLE_TOMBSTONE_TYPE, kvScratch_, ec))
+            return false;
+        return maybeCompact(ec);
+    }
+
+    if (!hasId(id))
+        return true; // Not found acts as success
+
+    detail::FileLockGuard lock;
+    if (!lockForWriteStep(lock, ec))
+        return false;
+    if (!checkAndRefreshCache(ec))
         return false;
 
-    std::vector<std::unique_ptr<VariableRecordBase>> kept;
-    bool found = false;
-    for (auto& r : all) {
-        if (r->id() == id) {
-            found = true;
-            continue;
+    auto pos = idIndex_.find(id);
+    if (pos == idIndex_.end())
+        return true; // Deleted by another writer meanwhile
+    return rewriteLive(pos->second, nullptr, ec);
+}
+
+bool VariableFileRepositoryImpl::deleteAll(std::error_code& ec) {
+    auto exclusive = lockThreadsExclusive();
+    return clearFile(ec);
+}
+
+bool VariableFileRepositoryImpl::clearFile(std::error_code& ec) {
+    ec.clear();
+    detail::FileLockGuard lock;
+    if (!lockForWriteStep(lock, ec))
+        return false;
+    // Rename an empty file over the data instead of truncating it, so other instances
+    // that are scanning a mapping of the old file never fault
+    beginRewrite();
+    return finishRewrite(ec);
+}
+
+std::vector<std::unique_ptr<VariableRecordBase>>
+VariableFileRepositoryImpl::findAllByType(const std::string& typeName, std::error_code& ec) {
+    ec.clear();
+    std::vector<std::unique_ptr<VariableRecordBase>> result;
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
+        return result;
+
+    const uint32_t t = typeIdOf(typeName);
+    if (t >= prototypes_.size())
+        return result;
+    result.reserve(typeSlots_[t].live);
+    for (size_t slot : slotsOfType(t)) {
+        std::error_code rec;
+        Snapshot r = recordAt(slot, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return {};
         }
-        kept.push_back(std::move(r));
+        if (!r)
+            continue;
+        if (auto cloned = r->cloneVariable())
+            result.push_back(std::move(cloned));
     }
+    return result;
+}
 
-    if (found) {
-        invalidateCache();
-        return rewriteAll(kept, ec);
+std::vector<VariableFileRepositoryImpl::Snapshot>
+VariableFileRepositoryImpl::findAllSharedByType(const std::string& typeName, std::error_code& ec) {
+    ec.clear();
+    std::vector<Snapshot> result;
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/true, ec))
+        return result;
+
+    const uint32_t t = typeIdOf(typeName);
+    if (t >= prototypes_.size())
+        return result;
+    result.reserve(typeSlots_[t].live);
+    for (size_t slot : slotsOfType(t)) {
+        std::error_code rec;
+        Snapshot r = recordAt(slot, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return {};
+        }
+        if (r)
+            result.push_back(std::move(r));
     }
-    return true; // Not found acts as success
+    return result;
 }
 
-bool VariableFileRepositoryImpl::deleteAll(std::error_code& ec) {
-    detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-    if (ec)
-        return false;
-    if (::ftruncate(fd_.get(), 0) < 0) {
-        ec = std::error_code(errno, std::generic_category());
-        return false;
-    }
-    invalidateCache();
-    return sync(ec);
+size_t VariableFileRepositoryImpl::countByType(const std::string& typeName, std::error_code& ec) {
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/false, ec))
+        return 0;
+    const uint32_t t = typeIdOf(typeName);
+    return t < prototypes_.size() ? typeSlots_[t].live : 0;
 }
 
 size_t VariableFileRepositoryImpl::count(std::error_code& ec) {
-    // Check cache refresh
-    if (!checkAndRefreshCache(ec))
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/false, ec))
         return 0;
-    return cache_.size();
+    return idIndex_.size();
 }
 
 bool VariableFileRepositoryImpl::existsById(const std::string& id, std::error_code& ec) {
-    // Check cache refresh
+    ReadLock lock;
+    if (!lockForRead(lock, /*lockFile=*/false, ec))
+        return false;
+
+    return hasId(id);
+}
+
+bool VariableFileRepositoryImpl::compact(std::error_code& ec) {
+    FDFILE_STATS_TIMER(stats_, Compact);
+    auto exclusive = lockThreadsExclusive();
+    return compactFile(ec);
+}
+
+bool VariableFileRepositoryImpl::compactFile(std::error_code& ec) {
+    detail::FileLockGuard lock;
+    if (!lockForWriteStep(lock, ec))
+        return false;
     if (!checkAndRefreshCache(ec))
         return false;
+    return rewriteLive(NO_SLOT, nullptr, ec);
+}
 
-    for (const auto& r : cache_) {
-        if (r->id() == id)
-            return true;
+VariableFileRepositoryImpl::Snapshot VariableFileRepositoryImpl::lookup(const std::string& id,
+                                                                        std::error_code& ec) {
+    auto it = idIndex_.find(id);
+    return it == idIndex_.end() ? nullptr : recordAt(it->second, /*remember=*/true, ec);
+}
+
+bool VariableFileRepositoryImpl::visit(
+    const std::function<bool(const VariableRecordBase&)>& visitor, std::error_code& ec) {
+    for (size_t i = 0; i < slotCount(); ++i) {
+        std::error_code rec;
+        Snapshot r = recordAt(i, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return false;
+        }
+        if (r && !visitor(*r))
+            break;
     }
-    return false;
+    return true;
 }
 
-bool VariableFileRepositoryImpl::appendRecord(const VariableRecordBase& record,
-                                              std::error_code& ec) {
-    detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-    if (ec)
+VariableFileRepositoryImpl::ReadSession
+VariableFileRepositoryImpl::readSession(std::error_code& ec) {
+    ReadSession session;
+    if (!lockForRead(session.lock_, /*lockFile=*/true, ec))
+        return {};
+    session.repo_ = this;
+    return session;
+}
+
+VariableFileRepositoryImpl::WriteSession
+VariableFileRepositoryImpl::writeSession(std::error_code& ec) {
+    ec.clear();
+    WriteSession session;
+    session.exclusive_ = lockThreadsExclusive();
+    if (!beginWriteSession(nullptr, ec))
+        return {};
+    session.repo_ = this;
+    return session;
+}
+
+bool VariableFileRepositoryImpl::lockForWriteStep(detail::FileLockGuard& lock,
+                                                  std::error_code& ec) {
+    if (inWriteSession_)
+        return true; // Nested guards would release the session's lock (fcntl is per process)
+    return lockCurrentFile(lock, detail::FileLockGuard::Mode::Exclusive, ec);
+}
+
+bool VariableFileRepositoryImpl::beginWriteSession(detail::FileLockGuard* held,
+                                                   std::error_code& ec) {
+    if (held && held->locked()) {
+        // The path cannot have been renamed while we held the shared lock
+        if (!held->convert(detail::FileLockGuard::Mode::Exclusive, ec))
+            return false;
+        sessionLock_ = std::move(*held);
+    } else if (!lockCurrentFile(sessionLock_, detail::FileLockGuard::Mode::Exclusive, ec)) {
+        return false;
+    }
+    inWriteSession_ = true;
+    sessionFresh_ = false;
+    if (!checkAndRefreshCache(ec)) {
+        std::error_code ignore;
+        endWriteSession(ignore);
         return false;
+    }
+    return true;
+}
 
-    if (::lseek(fd_.get(), 0, SEEK_END) < 0) {
-        ec = std::error_code(errno, std::generic_category());
+bool VariableFileRepositoryImpl::endWriteSession(std::error_code& ec) {
+    bool ok = true;
+    if (sessionUnsynced_) {
+        FDFILE_STATS_TIMER(stats_, Sync);
+        ok = detail::syncFileData(fd_.get(), ec);
+        if (ok)
+            durableSeq_ = writeSeq_;
+        sessionUnsynced_ = false;
+    }
+    inWriteSession_ = false;
+    sessionFresh_ = false;
+    sessionLock_.unlockIgnore();
+    return ok;
+}
+
+VariableFileRepositoryImpl::ReadSession::ReadSession(ReadSession&& other) noexcept
+    : repo_(std::exchange(other.repo_, nullptr)), lock_(std::move(other.lock_)) {}
+
+VariableFileRepositoryImpl::ReadSession&
+VariableFileRepositoryImpl::ReadSession::operator=(ReadSession&& other) noexcept {
+    if (this != &other) {
+        repo_ = std::exchange(other.repo_, nullptr);
+        lock_ = std::move(other.lock_);
+    }
+    return *this;
+}
+
+std::unique_ptr<VariableRecordBase>
+VariableFileRepositoryImpl::ReadSession::findById(const std::string& id, std::error_code& ec) {
+    Snapshot r = findByIdShared(id, ec);
+    return r ? r->cloneVariable() : nullptr;
+}
+
+VariableFileRepositoryImpl::Snapshot
+VariableFileRepositoryImpl::ReadSession::findByIdShared(const std::string& id,
+                                                        std::error_code& ec) {
+    ec.clear();
+    return repo_ ? repo_->lookup(id, ec) : nullptr;
+}
+
+bool VariableFileRepositoryImpl::ReadSession::existsById(const std::string& id) const {
+    return repo_ && repo_->hasId(id);
+}
+
+size_t VariableFileRepositoryImpl::ReadSession::count() const {
+    return repo_ ? repo_->idIndex_.size() : 0;
+}
+
+bool VariableFileRepositoryImpl::ReadSession::forEach(
+    const std::function<bool(const VariableRecordBase&)>& visitor, std::error_code& ec) {
+    ec.clear();
+    return repo_ && repo_->visit(visitor, ec);
+}
+
+VariableFileRepositoryImpl::WriteSession
+VariableFileRepositoryImpl::ReadSession::upgrade(std::error_code& ec) {
+    ec.clear();
+    if (!repo_) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return {};
+    }
+    VariableFileRepositoryImpl* repo = std::exchange(repo_, nullptr);
+    ReadLock lock = std::move(lock_);
+
+    // Other reader threads have to leave before the gate can be held exclusively
+    lock.memory = std::shared_lock<std::shared_mutex>();
+    lock.shared.unlock();
+    WriteSession session;
+    session.exclusive_ =
+        lock.exclusive ? std::move(lock.exclusive) : repo->lockThreadsExclusive();
+    if (!repo->beginWriteSession(&lock.file, ec))
+        return {};
+    session.repo_ = repo;
+    return session;
+}
+
+VariableFileRepositoryImpl::WriteSession::WriteSession(WriteSession&& other) noexcept
+    : repo_(std::exchange(other.repo_, nullptr)), exclusive_(std::move(other.exclusive_)) {}
+
+VariableFileRepositoryImpl::WriteSession&
+VariableFileRepositoryImpl::WriteSession::operator=(WriteSession&& other) noexcept {
+    if (this != &other) {
+        std::error_code ignore;
+        commit(ignore);
+        repo_ = std::exchange(other.repo_, nullptr);
+        exclusive_ = std::move(other.exclusive_);
+    }
+    return *this;
+}
+
+VariableFileRepositoryImpl::WriteSession::~WriteSession() {
+    std::error_code ignore;
+    commit(ignore);
+}
+
+bool VariableFileRepositoryImpl::WriteSession::ready(std::error_code& ec) {
+    ec.clear();
+    if (!repo_) {
+        ec = std::make_error_code(std::errc::invalid_argument);
         return false;
     }
+    return repo_->checkAndRefreshCache(ec);
+}
 
-    std::vector<std::pair<std::string, std::pair<bool, std::string>>> out;
-    record.toKv(out);
-    std::string line = util::formatLine(record.typeName(), out);
+bool VariableFileRepositoryImpl::WriteSession::save(const VariableRecordBase& record,
+                                                    std::error_code& ec) {
+    return ready(ec) && repo_->saveRecord(record, ec);
+}
 
-    if (::write(fd_.get(), line.data(), line.size()) < 0) {
+bool VariableFileRepositoryImpl::WriteSession::saveAll(
+    const std::vector<const VariableRecordBase*>& records, std::error_code& ec) {
+    if (!ready(ec))
+        return false;
+    for (const auto* r : records) {
+        if (!repo_->saveRecord(*r, ec))
+            return false;
+    }
+    return true;
+}
+
+bool VariableFileRepositoryImpl::WriteSession::deleteById(const std::string& id,
+                                                          std::error_code& ec) {
+    return ready(ec) && repo_->deleteRecord(id, ec);
+}
+
+bool VariableFileRepositoryImpl::WriteSession::deleteAll(std::error_code& ec) {
+    return ready(ec) && repo_->clearFile(ec);
+}
+
+bool VariableFileRepositoryImpl::WriteSession::compact(std::error_code& ec) {
+    return ready(ec) && repo_->compactFile(ec);
+}
+
+std::unique_ptr<VariableRecordBase>
+VariableFileRepositoryImpl::WriteSession::findById(const std::string& id, std::error_code& ec) {
+    Snapshot r = findByIdShared(id, ec);
+    return r ? r->cloneVariable() : nullptr;
+}
+
+VariableFileRepositoryImpl::Snapshot
+VariableFileRepositoryImpl::WriteSession::findByIdShared(const std::string& id,
+                                                         std::error_code& ec) {
+    return ready(ec) ? repo_->lookup(id, ec) : nullptr;
+}
+
+bool VariableFileRepositoryImpl::WriteSession::existsById(const std::string& id,
+                                                          std::error_code& ec) {
+    return ready(ec) && repo_->hasId(id);
+}
+
+size_t VariableFileRepositoryImpl::WriteSession::count(std::error_code& ec) {
+    return ready(ec) ? repo_->idIndex_.size() : 0;
+}
+
+bool VariableFileRepositoryImpl::WriteSession::forEach(
+    const std::function<bool(const VariableRecordBase&)>& visitor, std::error_code& ec) {
+    return ready(ec) && repo_->visit(visitor, ec);
+}
+
+bool VariableFileRepositoryImpl::WriteSession::commit(std::error_code& ec) {
+    ec.clear();
+    if (!repo_)
+        return true;
+    const bool ok = std::exchange(repo_, nullptr)->endWriteSession(ec);
+    if (exclusive_.owns_lock())
+        exclusive_.unlock();
+    return ok;
+}
+
+VariableCacheStats VariableFileRepositoryImpl::cacheStats() const {
+    std::shared_lock<std::shared_mutex> shared;
+    std::unique_lock<std::mutex> state;
+    if (gate_) {
+        shared = gate_->lockShared();
+        state = std::unique_lock<std::mutex>(gate_->readerStateMutex());
+    }
+    VariableCacheStats s;
+    const detail::LruStats& lru = recordCache_.stats();
+    s.hits = lru.hits;
+    s.misses = lru.misses;
+    s.evictions = lru.evictions;
+    s.cachedRecords = recordCache_.size();
+    s.cachedBytes = recordCache_.usedBytes();
+    s.indexedRecords = idIndex_.size();
+    return s;
+}
+
+void VariableFileRepositoryImpl::beginRewrite() {
+    rewriteBatch_.clear();
+    rewriteEncoder_.clear();
+}
+
+void VariableFileRepositoryImpl::batchRecord(const VariableRecordBase& record) {
+    record.toKvView(kvScratch_);
+    if (options_.format == VariableFormat::Binary)
+        rewriteEncoder_.appendRecord(rewriteBatch_.buffer(), record.typeName(), kvScratch_,
+                                     /*defineSymbols=*/false);
+    else
+        util::appendFormattedLine(rewriteBatch_.buffer(), record.typeName(), kvScratch_);
+}
+
+bool VariableFileRepositoryImpl::finishRewrite(std::error_code& ec) {
+    // Binary files start with the magic and one dictionary covering every record
+    rewriteHeader_.clear();
+    if (options_.format == VariableFormat::Binary && rewriteBatch_.size() > 0) {
+        rewriteHeader_.append(detail::BINARY_MAGIC, detail::BINARY_MAGIC_LEN);
+        rewriteEncoder_.appendDictionary(rewriteHeader_);
+    }
+    const bool ok = replaceFile(rewriteHeader_, rewriteBatch_, ec);
+    rewriteBatch_.clear(); // Release all but the retained chunks
+    return ok;
+}
+
+bool VariableFileRepositoryImpl::maybeCompact(std::error_code& ec) {
+    if (options_.compactThreshold <= 0.0)
+        return true;
+    // Picks up the line just appended
+    if (!checkAndRefreshCache(ec))
+        return false;
+    const size_t dead = logLines_ - idIndex_.size();
+    if (dead == 0 ||
+        static_cast<double>(dead) < options_.compactThreshold * static_cast<double>(logLines_))
+        return true;
+    return compactFile(ec);
+}
+
+bool VariableFileRepositoryImpl::replaceFile(std::string_view header,
+                                             const detail::WriteBatch& batch,
+                                             std::error_code& ec) {
+    const std::string tmpPath = path_ + ".tmp";
+    int flags = O_CREAT | O_TRUNC | O_WRONLY;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    detail::UniqueFd tmp(::open(tmpPath.c_str(), flags, 0644));
+    if (!tmp) {
         ec = std::error_code(errno, std::generic_category());
         return false;
     }
+
+    // Keep the original permissions
+    struct stat st{};
+    if (::fstat(fd_.get(), &st) == 0)
+        (void)::fchmod(tmp.get(), st.st_mode & 07777);
+
+    for (size_t off = 0; off < header.size();) {
+        ssize_t n = ::write(tmp.get(), header.data() + off, header.size() - off);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            ec = std::error_code(errno, std::generic_category());
+            ::unlink(tmpPath.c_str());
+            return false;
+        }
+        off += static_cast<size_t>(n);
+    }
+    if (!batch.writeTo(tmp.get(), ec)) {
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+
+    // The new file must be complete on disk before it becomes visible under path_
+    if (!detail::syncFileData(tmp.get(), ec) || ::rename(tmpPath.c_str(), path_.c_str()) < 0) {
+        if (!ec)
+            ec = std::error_code(errno, std::generic_category());
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    tmp.reset();
+
+    // Persist the rename itself (best effort)
+    fs::path dir = fs::path(path_).parent_path();
+    detail::UniqueFd dirFd(::open(dir.empty() ? "." : dir.c_str(), O_RDONLY));
+    if (dirFd)
+        (void)::fsync(dirFd.get());
+
+    if (!reopenFile(ec))
+        return false;
+    // Closing the old file dropped the session's lock; hold the new file from here on
+    if (inWriteSession_ &&
+        !lockCurrentFile(sessionLock_, detail::FileLockGuard::Mode::Exclusive, ec))
+        return false;
     return sync(ec);
 }
 
-bool VariableFileRepositoryImpl::rewriteAll(
-    const std::vector<std::unique_ptr<VariableRecordBase>>& records, std::error_code& ec) {
-    detail::FileLockGuard lock(fd_.get(), detail::FileLockGuard::Mode::Exclusive, ec);
-    if (ec)
+bool VariableFileRepositoryImpl::lockForRead(ReadLock& lock, bool lockFile, std::error_code& ec) {
+    ec.clear();
+    if (gate_ && control_) {
+        lock.memory = gate_->lockShared();
+        if (generationCurrent()) {
+            FDFILE_STATS_COUNT(stats_, CacheHits);
+            return true;
+        }
+        lock.memory.unlock();
+    } else if (generationCurrent()) {
+        FDFILE_STATS_COUNT(stats_, CacheHits);
+        return true; // Served from memory: no file lock, no stat
+    }
+    if (gate_) {
+        // Readers share the gate while the cache is current; otherwise retry alone, which
+        // may refresh it
+        if (lock.shared.lock(*gate_, fd_.get(), ec) && cacheIsCurrent()) {
+            FDFILE_STATS_COUNT(stats_, CacheHits);
+            return true;
+        }
+        lock.shared.unlock();
+        if (ec)
+            return false;
+        lock.exclusive = gate_->lockExclusive();
+    }
+    if (lockFile && !lockCurrentFile(lock.file, detail::FileLockGuard::Mode::Shared, ec))
+        return false;
+    return checkAndRefreshCache(ec);
+}
+
+std::unique_lock<std::shared_mutex> VariableFileRepositoryImpl::lockThreadsExclusive() {
+    return gate_ ? gate_->lockExclusive() : std::unique_lock<std::shared_mutex>();
+}
+
+bool VariableFileRepositoryImpl::cacheIsCurrent() const {
+    if (control_)
+        return generationCurrent();
+    struct stat st{};
+    if (!cacheValid_ || ::stat(path_.c_str(), &st) < 0)
         return false;
+    const size_t size = static_cast<size_t>(st.st_size);
+    return st.st_dev == fileDev_ && st.st_ino == fileIno_ &&
+           detail::statMtimeNs(st) == lastMtimeNs_ && size == lastSize_ && size == indexedBytes_;
+}
 
-    if (::ftruncate(fd_.get(), 0) < 0) {
+bool VariableFileRepositoryImpl::lockCurrentFile(detail::FileLockGuard& lock,
+                                                 detail::FileLockGuard::Mode mode,
+                                                 std::error_code& ec) {
+    while (true) {
+        bool locked;
+        {
+            FDFILE_STATS_TIMER(stats_, LockWait);
+            locked = lock.lock(fd_.get(), mode, ec);
+        }
+        if (!locked)
+            return false;
+        // Another instance may have renamed a compacted file over path_ while we waited
+        struct stat st{};
+        if (::stat(path_.c_str(), &st) < 0 || (st.st_dev == fileDev_ && st.st_ino == fileIno_))
+            return true;
+        lock.unlockIgnore();
+        if (!reopenFile(ec))
+            return false;
+    }
+}
+
+bool VariableFileRepositoryImpl::reopenFile(std::error_code& ec) {
+    int flags = O_CREAT | O_RDWR;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    detail::UniqueFd fresh(::open(path_.c_str(), flags, 0644));
+    if (!fresh) {
         ec = std::error_code(errno, std::generic_category());
         return false;
     }
-    if (::lseek(fd_.get(), 0, SEEK_SET) < 0) {
+    // Keep the descriptor number: the group-commit flusher holds it
+#if defined(__linux__)
+    int rc = ::dup3(fresh.get(), fd_.get(), O_CLOEXEC);
+#else
+    int rc = ::dup2(fresh.get(), fd_.get());
+    if (rc >= 0)
+        (void)::fcntl(fd_.get(), F_SETFD, FD_CLOEXEC);
+#endif
+    if (rc < 0) {
         ec = std::error_code(errno, std::generic_category());
         return false;
     }
+    noteFileIdentity();
+    invalidateCache();
+    updateFileStats();
+    return true;
+}
 
-    for (const auto& r : records) {
-        std::vector<std::pair<std::string, std::pair<bool, std::string>>> out;
-        r->toKv(out);
-        std::string line = util::formatLine(r->typeName(), out);
-        if (::write(fd_.get(), line.data(), line.size()) < 0) {
-            ec = std::error_code(errno, std::generic_category());
+void VariableFileRepositoryImpl::noteFileIdentity() {
+    struct stat st{};
+    if (::fstat(fd_.get(), &st) == 0) {
+        fileDev_ = st.st_dev;
+        fileIno_ = st.st_ino;
+    }
+}
+
+bool VariableFileRepositoryImpl::appendRecord(const VariableRecordBase& record,
+                                              std::error_code& ec) {
+    record.toKvView(kvScratch_);
+    return appendEntry(record.typeName(), kvScratch_, ec);
+}
+
+bool VariableFileRepositoryImpl::appendEntry(std::string_view type, const util::KvViews& kv,
+                                             std::error_code& ec) {
+    detail::FileLockGuard lock;
+    if (!lockForWriteStep(lock, ec))
+        return false;
+
+    appendScratch_.clear();
+    if (options_.format == VariableFormat::Binary) {
+        // Symbol ids continue the dictionary of every frame already in the file
+        if (!checkAndRefreshCache(ec))
             return false;
+        if (lastSize_ > indexedBytes_) {
+            // Incomplete frame left by a writer that died mid-append (the lock is ours)
+            if (::ftruncate(fd_.get(), static_cast<off_t>(indexedBytes_)) < 0) {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
         }
+        if (indexedBytes_ == 0)
+            appendScratch_.append(detail::BINARY_MAGIC, detail::BINARY_MAGIC_LEN);
+        binary_.appendRecord(appendScratch_, type, kv);
+    } else {
+        util::appendFormattedLine(appendScratch_, type, kv);
+    }
+
+    if (::lseek(fd_.get(), 0, SEEK_END) < 0 ||
+        ::write(fd_.get(), appendScratch_.data(), appendScratch_.size()) < 0) {
+        ec = std::error_code(errno, std::generic_category());
+        invalidateCache(); // The dictionary may hold symbols that never reached the file
+        if (control_)
+            control_->bump(); // Part of the entry may have reached the file
+        return false;
     }
     return sync(ec);
 }
 
+bool VariableFileRepositoryImpl::rewriteLive(size_t pos, const VariableRecordBase* replacement,
+                                             std::error_code& ec) {
+    // Serialize into reusable chunks, then writev them to a new file renamed over path_.
+    // In lazyLoad mode each record is decoded, batched and released in turn.
+    beginRewrite();
+    for (size_t i = 0; i < slotCount(); ++i) {
+        if (i == pos) {
+            if (replacement)
+                batchRecord(*replacement);
+            continue;
+        }
+        std::error_code rec;
+        Snapshot r = recordAt(i, /*remember=*/false, rec);
+        if (rec) {
+            ec = rec;
+            return false;
+        }
+        if (r)
+            batchRecord(*r);
+    }
+    if (pos == NO_SLOT && replacement)
+        batchRecord(*replacement);
+    return finishRewrite(ec);
+}
+
 bool VariableFileRepositoryImpl::checkAndRefreshCache(std::error_code& ec) {
+    if (sessionFresh_ && cacheValid_) {
+        FDFILE_STATS_COUNT(stats_, CacheHits);
+        return true; // The session's lock keeps other writers out
+    }
+    // Loaded before the check: a cooperating write after this point changes it again
+    std::optional<uint64_t> gen;
+    if (control_) {
+        gen = control_->generation();
+        if (cacheValid_ && gen == knownGen_) {
+            FDFILE_STATS_COUNT(stats_, CacheHits);
+            return true;
+        }
+    }
+
     struct stat st{};
     // Use stat on path - more reliable for detecting external changes than fstat
     if (::stat(path_.c_str(), &st) < 0) {
@@ -265,11 +973,21 @@ bool VariableFileRepositoryImpl::checkAndRefreshCache(std::error_code& ec) {
         return false;
     }
 
+    // Another instance compacted the file: switch to the new one
+    if (st.st_dev != fileDev_ || st.st_ino != fileIno_) {
+        if (!reopenFile(ec))
+            return false;
+    }
+
     // Detect external modifications (mtime or size change)
-    if (st.st_mtime != lastMtime_ || static_cast<size_t>(st.st_size) != lastSize_) {
-        invalidateCache();
-        lastMtime_ = st.st_mtime;
-        lastSize_ = st.st_size;
+    const size_t size = static_cast<size_t>(st.st_size);
+    if (detail::statMtimeNs(st) != lastMtimeNs_ || size != lastSize_) {
+        // Keep the cache only if the file grew and the indexed prefix looks untouched
+        if (cacheValid_ &&
+            !(size > indexedBytes_ && prefixFingerprint(indexedBytes_) == indexedFingerprint_))
+            invalidateCache();
+        lastMtimeNs_ = detail::statMtimeNs(st);
+        lastSize_ = size;
     }
 
     // Load cache if invalid
@@ -277,7 +995,17 @@ bool VariableFileRepositoryImpl::checkAndRefreshCache(std::error_code& ec) {
         if (!loadAllToCache(ec)) {
             return false;
         }
+    } else if (indexedBytes_ < size) {
+        // Appended lines (ours or another process's)
+        FDFILE_STATS_COUNT(stats_, TailLoads);
+        if (!loadFromOffset(indexedBytes_, ec))
+            return false;
+    } else {
+        FDFILE_STATS_COUNT(stats_, CacheHits);
     }
+    if (indexedBytes_ == size)
+        knownGen_ = gen; // An incomplete tail keeps the next read on this path
+    sessionFresh_ = inWriteSession_;
     return true;
 }
 
@@ -285,78 +1013,564 @@ void VariableFileRepositoryImpl::updateFileStats() {
     struct stat st{};
     // Use stat on path for consistency with checkAndRefreshCache
     if (::stat(path_.c_str(), &st) == 0) {
-        lastMtime_ = st.st_mtime;
+        lastMtimeNs_ = detail::statMtimeNs(st);
         lastSize_ = st.st_size;
     }
 }
 
 bool VariableFileRepositoryImpl::loadAllToCache(std::error_code& ec) {
-    cache_.clear();
-
-    // When external process appends to file, seek to end first to refresh kernel's file size
-    (void)::lseek(fd_.get(), 0, SEEK_END);
+    FDFILE_STATS_COUNT(stats_, Reloads);
+    invalidateCache();
+    if (!loadFromOffset(0, ec))
+        return false;
+    cacheValid_ = true;
+    return true;
+}
 
-    if (::lseek(fd_.get(), 0, SEEK_SET) < 0) {
+bool VariableFileRepositoryImpl::loadFromOffset(size_t from, std::error_code& ec) {
+    struct stat st{};
+    if (::fstat(fd_.get(), &st) < 0) {
         ec = std::error_code(errno, std::generic_category());
         return false;
     }
 
-    char buf[4096];
-    std::string leftover;
-    ssize_t n;
+    // An incomplete last line is left for a later refresh
+    size_t consumed = from;
+    const size_t size = static_cast<size_t>(st.st_size);
+    if (options_.format == VariableFormat::Binary && from == 0 && size > 0) {
+        char head[detail::BINARY_MAGIC_LEN];
+        if (size < sizeof(head))
+            return true; // Header still being written
+        if (::pread(fd_.get(), head, sizeof(head), 0) != static_cast<ssize_t>(sizeof(head)) ||
+            std::memcmp(head, detail::BINARY_MAGIC, sizeof(head)) != 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+        from = consumed = sizeof(head);
+    }
+    if (size > from) {
+        // Map [from, size) and parse lines in place. Library writers only append or rename,
+        // never shrink the file in place, so the mapping stays backed while we scan it.
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t base = from - from % page;
+        const size_t mapLen = size - base;
+        detail::MmapGuard map(
+            ::mmap(nullptr, mapLen, PROT_READ, MAP_SHARED, fd_.get(), static_cast<off_t>(base)),
+            mapLen);
+        if (map) {
+#ifdef MADV_SEQUENTIAL
+            (void)::madvise(map.get(), map.size(), MADV_SEQUENTIAL);
+#endif
+            consumed += cacheLines(static_cast<const char*>(map.get()) + (from - base), size - from,
+                                   from, ec);
+        } else if (!readLinesFrom(from, consumed, ec)) {
+            return false;
+        }
+    }
 
-    while ((n = ::read(fd_.get(), buf, sizeof(buf))) > 0) {
-        std::string chunk = leftover + std::string(buf, n);
-        std::istringstream iss(chunk);
-        std::string line;
+    indexedBytes_ = consumed;
+    indexedFingerprint_ = prefixFingerprint(consumed);
+    return true;
+}
 
-        while (std::getline(iss, line)) {
-            if (line.empty())
+bool VariableFileRepositoryImpl::readLinesFrom(size_t from, size_t& consumed,
+                                               std::error_code& ec) {
+    std::vector<char> buf(1 << 20);
+    size_t have = 0; // Bytes of an incomplete line carried to the next read
+    off_t pos = static_cast<off_t>(from);
+    while (true) {
+        if (have == buf.size())
+            buf.resize(buf.size() * 2); // Line longer than the buffer
+        ssize_t n = ::pread(fd_.get(), buf.data() + have, buf.size() - have, pos);
+        if (n < 0) {
+            if (errno == EINTR)
                 continue;
-            // If last line is incomplete, save to leftover
-            if (iss.eof() && chunk.back() != '\n') {
-                leftover = line;
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        if (n == 0)
+            return true;
+        pos += n;
+        have += static_cast<size_t>(n);
+
+        const size_t used = cacheLines(buf.data(), have, consumed, ec);
+        consumed += used;
+        std::memmove(buf.data(), buf.data() + used, have - used);
+        have -= used;
+    }
+}
+
+size_t VariableFileRepositoryImpl::cacheLines(const char* data, size_t len, uint64_t fileOffset,
+                                              std::error_code& ec) {
+    if (options_.format == VariableFormat::Binary)
+        return cacheFrames(data, len, fileOffset, ec);
+    const size_t chunks =
+        detail::scanChunkCount(len, options_.scanThreads, options_.scanMinBytesPerThread);
+    if (chunks > 1)
+        return cacheLinesParallel(data, len, fileOffset, chunks, ec);
+    size_t start = 0;
+    while (const char* nl =
+               static_cast<const char*>(std::memchr(data + start, '\n', len - start))) {
+        const size_t lineLen = static_cast<size_t>(nl - (data + start));
+        if (lineLen > 0)
+            cacheLine(std::string_view(data + start, lineLen), fileOffset + start, ec);
+        start += lineLen + 1;
+    }
+    return start;
+}
+
+size_t VariableFileRepositoryImpl::cacheLinesParallel(const char* data, size_t len,
+                                                      uint64_t fileOffset, size_t chunks,
+                                                      std::error_code& ec) {
+    // Only complete lines are parsed: the ranges end after the last '\n'
+    const size_t lastNl = std::string_view(data, len).rfind('\n');
+    if (lastNl == std::string_view::npos)
+        return 0;
+    const size_t used = lastNl + 1;
+    const std::vector<size_t> bounds = detail::splitAtNewlines(data, used, chunks);
+
+    // Parse concurrently, then index in file order so later versions still replace earlier
+    std::vector<ParsedRange> parts(bounds.size() - 1);
+    detail::runParallel(parts.size(), [&](size_t c) {
+        parseRange(data + bounds[c], bounds[c + 1] - bounds[c], fileOffset + bounds[c],
+                   parts[c]);
+    });
+    for (auto& part : parts) {
+        for (auto& e : part.entries)
+            indexEntry(e.typeId, e.offset, e.length, std::move(e.id), std::move(e.rec));
+    }
+    ec = parts.back().ec;
+    return used;
+}
+
+void VariableFileRepositoryImpl::parseRange(const char* data, size_t len, uint64_t fileOffset,
+                                            ParsedRange& out) const {
+    util::KvViews kv;
+    size_t start = 0;
+    while (const char* nl =
+               static_cast<const char*>(std::memchr(data + start, '\n', len - start))) {
+        const size_t lineLen = static_cast<size_t>(nl - (data + start));
+        const std::string_view line(data + start, lineLen);
+        const uint64_t offset = fileOffset + start;
+        start += lineLen + 1;
+
+        // Same filtering as cacheLine()
+        std::string_view type;
+        if (lineLen == 0 || !util::peekLineType(line, type))
+            continue;
+        const uint32_t t = typeIdOf(type);
+        if (t == NO_TYPE || !util::parseLineView(line, type, kv, out.ec))
+            continue;
+        if (t == TOMBSTONE_TYPE) {
+            if (const auto* idField = kv.find("id"))
+                out.entries.push_back(
+                    ParsedEntry{t, offset, lineLen, std::string(idField->value), nullptr});
+            continue;
+        }
+        std::unique_ptr<VariableRecordBase> rec = materialize(t, kv, out.ec);
+        if (!rec)
+            continue;
+        std::string id = rec->id();
+        if (options_.lazyLoad)
+            rec.reset(); // Only the location is kept
+        out.entries.push_back(ParsedEntry{t, offset, lineLen, std::move(id), std::move(rec)});
+    }
+}
+
+size_t VariableFileRepositoryImpl::cacheFrames(const char* data, size_t len, uint64_t fileOffset,
+                                               std::error_code& ec) {
+    const char* p = data;
+    const char* end = data + len;
+    while (p < end) {
+        const char* frame = p;
+        std::string_view payload, type;
+        switch (detail::readBinaryFrame(p, end, payload)) {
+        case detail::BinaryFrameStatus::Ok:
+            // Records of types without a prototype are skipped before their fields are decoded
+            if (detail::peekBinaryRecordType(payload, binary_.dictionary(), type) &&
+                typeIdOf(type) == NO_TYPE)
                 break;
-            } else {
-                // Parse line
-                std::string type;
-                std::unordered_map<std::string, std::pair<bool, std::string>> kv;
-                if (util::parseLine(line, type, kv, ec)) {
-                    auto it = prototypes_.find(type);
-                    if (it != prototypes_.end()) {
-                        auto clo = it->second->clone();
-                        if (auto* v = dynamic_cast<VariableRecordBase*>(clo.get())) {
-                            (void)clo.release();
-                            if (v->fromKv(kv, ec)) {
-                                cache_.push_back(std::unique_ptr<VariableRecordBase>(v));
-                            } else {
-                                delete v;
-                            }
-                        }
-                    }
-                }
-                leftover.clear();
-            }
+            if (detail::decodeBinaryPayload(payload, binary_.dictionary(), type, lineKv_) ==
+                detail::BinaryPayloadKind::Record)
+                cacheEntry(typeIdOf(type), fileOffset + static_cast<uint64_t>(frame - data),
+                           static_cast<size_t>(p - frame), ec);
+            break;
+        case detail::BinaryFrameStatus::BadChecksum:
+            break; // Skipped like an unparsable text line
+        case detail::BinaryFrameStatus::Incomplete:
+            return static_cast<size_t>(frame - data);
+        case detail::BinaryFrameStatus::Malformed:
+            return len; // Nothing after a bad length can be framed
         }
     }
+    return len;
+}
 
-    cacheValid_ = true;
+void VariableFileRepositoryImpl::cacheLine(std::string_view line, uint64_t offset,
+                                           std::error_code& ec) {
+    // Unparsable lines and unknown types are skipped; the body of an unknown type is never
+    // parsed
+    std::string_view type;
+    if (!util::peekLineType(line, type))
+        return;
+    const uint32_t t = typeIdOf(type);
+    if (t != NO_TYPE && util::parseLineView(line, type, lineKv_, ec))
+        cacheEntry(t, offset, line.size(), ec);
+}
+
+void VariableFileRepositoryImpl::cacheEntry(uint32_t typeId, uint64_t offset, size_t length,
+                                            std::error_code& ec) {
+    if (typeId == TOMBSTONE_TYPE) {
+        if (const auto* idField = lineKv_.find("id"))
+            indexEntry(typeId, offset, length, std::string(idField->value), nullptr);
+        return;
+    }
+    std::unique_ptr<VariableRecordBase> rec = materialize(typeId, ec);
+    if (!rec)
+        return;
+    // id() is computed once per record here instead of on every lookup
+    std::string id = rec->id();
+    indexEntry(typeId, offset, length, std::move(id), std::move(rec));
+}
+
+void VariableFileRepositoryImpl::indexEntry(uint32_t typeId, uint64_t offset, size_t length,
+                                            std::string id,
+                                            std::unique_ptr<VariableRecordBase> rec) {
+    if (typeId == TOMBSTONE_TYPE) {
+        ++logLines_;
+        auto pos = idIndex_.find(id);
+        if (pos != idIndex_.end()) {
+            if (options_.lazyLoad)
+                locs_[pos->second] = EntryLoc{};
+            else
+                cache_[pos->second].reset();
+            --typeSlots_[slotTypes_[pos->second]].live;
+            idIndex_.erase(pos);
+        }
+        return;
+    }
+
+    ++logLines_;
+    // A later line for the same ID replaces the earlier version's slot; snapshots handed out
+    // earlier keep the old object.
+    auto pos = idIndex_.try_emplace(std::move(id), slotTypes_.size());
+    const size_t slot = pos.first->second;
+    if (pos.second) {
+        slotTypes_.push_back(typeId);
+        typeSlots_[typeId].slots.push_back(slot);
+    } else {
+        --typeSlots_[slotTypes_[slot]].live;
+        if (slotTypes_[slot] != typeId) {
+            slotTypes_[slot] = typeId;
+            typeSlotsStale_ = true;
+        }
+    }
+    ++typeSlots_[typeId].live;
+
+    if (options_.lazyLoad) {
+        // Only the location stays resident; rec is dropped here
+        const EntryLoc loc{offset, static_cast<uint32_t>(length)};
+        if (pos.second)
+            locs_.push_back(loc);
+        else
+            locs_[slot] = loc;
+        return;
+    }
+    if (pos.second)
+        cache_.push_back(Snapshot(std::move(rec)));
+    else
+        cache_[slot] = Snapshot(std::move(rec));
+}
+
+std::unique_ptr<VariableRecordBase> VariableFileRepositoryImpl::materialize(uint32_t typeId,
+                                                                            std::error_code& ec) {
+    return materialize(typeId, lineKv_, ec);
+}
+
+std::unique_ptr<VariableRecordBase>
+VariableFileRepositoryImpl::materialize(uint32_t typeId, const util::KvViews& kv,
+                                        std::error_code& ec) const {
+    if (typeId >= prototypes_.size())
+        return nullptr;
+    std::unique_ptr<VariableRecordBase> rec = prototypes_[typeId]->cloneVariable();
+    if (!rec || !rec->fromKvView(kv, ec))
+        return nullptr;
+    return rec;
+}
+
+uint32_t VariableFileRepositoryImpl::typeIdOf(std::string_view type) const {
+    if (type == VARIABLE_TOMBSTONE_TYPE)
+        return TOMBSTONE_TYPE;
+    auto it = typeIds_.find(std::string(type));
+    return it == typeIds_.end() ? NO_TYPE : it->second;
+}
+
+const std::vector<size_t>& VariableFileRepositoryImpl::slotsOfType(uint32_t typeId) {
+    std::unique_lock<std::mutex> state;
+    if (gate_)
+        state = std::unique_lock<std::mutex>(gate_->readerStateMutex());
+    if (typeSlotsStale_) {
+        // Rare: an ID was saved again as a different type. Regroup from slotTypes_.
+        for (auto& ts : typeSlots_)
+            ts.slots.clear();
+        for (size_t slot = 0; slot < slotTypes_.size(); ++slot)
+            typeSlots_[slotTypes_[slot]].slots.push_back(slot);
+        typeSlotsStale_ = false;
+    }
+    return typeSlots_[typeId].slots;
+}
+
+VariableFileRepositoryImpl::Snapshot VariableFileRepositoryImpl::recordAt(size_t i, bool remember,
+                                                                          std::error_code& ec) {
+    if (!options_.lazyLoad)
+        return cache_[i];
+
+    // Readers sharing the gate take turns on the LRU and the decode scratch
+    std::unique_lock<std::mutex> state;
+    if (gate_)
+        state = std::unique_lock<std::mutex>(gate_->readerStateMutex());
+    const EntryLoc loc = locs_[i];
+    if (loc.length == 0)
+        return nullptr;
+    if (const Snapshot* hit = recordCache_.get(loc.offset))
+        return *hit;
+    Snapshot r = decodeAt(loc.offset, loc.length, ec);
+    // Approximate resident cost: encoded size plus object and bookkeeping overhead
+    constexpr size_t ENTRY_OVERHEAD = 128;
+    if (r && remember)
+        recordCache_.put(loc.offset, r, loc.length + ENTRY_OVERHEAD);
+    return r;
+}
+
+VariableFileRepositoryImpl::Snapshot
+VariableFileRepositoryImpl::decodeAt(uint64_t offset, uint32_t length, std::error_code& ec) {
+    if (!readEntry(offset, length, readScratch_, ec))
+        return nullptr;
+
+    // The entry was parsed once while indexing, so a failure here means the file changed
+    std::string_view type;
+    if (options_.format == VariableFormat::Binary) {
+        const char* p = readScratch_.data();
+        std::string_view payload;
+        if (detail::readBinaryFrame(p, p + length, payload) != detail::BinaryFrameStatus::Ok ||
+            detail::decodeBinaryPayload(payload, binary_.dictionary(), type, lineKv_) !=
+                detail::BinaryPayloadKind::Record)
+            return nullptr;
+    } else if (!util::parseLineView(readScratch_, type, lineKv_, ec)) {
+        return nullptr;
+    }
+    return Snapshot(materialize(typeIdOf(type), ec));
+}
+
+VariableFileRepositoryImpl::Snapshot
+VariableFileRepositoryImpl::decodeTextAt(uint64_t offset, uint32_t length, std::string& scratch,
+                                         util::KvViews& kv, std::error_code& ec) const {
+    if (!readEntry(offset, length, scratch, ec))
+        return nullptr;
+    std::string_view type;
+    if (!util::parseLineView(scratch, type, kv, ec))
+        return nullptr;
+    return Snapshot(materialize(typeIdOf(type), kv, ec));
+}
+
+bool VariableFileRepositoryImpl::readEntry(uint64_t offset, uint32_t length, std::string& scratch,
+                                           std::error_code& ec) const {
+    scratch.resize(length);
+    for (size_t got = 0; got < length;) {
+        ssize_t n =
+            ::pread(fd_.get(), &scratch[got], length - got, static_cast<off_t>(offset + got));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            ec = n < 0 ? std::error_code(errno, std::generic_category())
+                       : std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        got += static_cast<size_t>(n);
+    }
     return true;
 }
 
+uint64_t VariableFileRepositoryImpl::prefixFingerprint(size_t end) const {
+    // First and last 64 bytes of the prefix: catches rewrites, which shift or truncate
+    // content, without reading the file
+    constexpr size_t WINDOW = 64;
+    char buf[2 * WINDOW];
+    size_t headLen = std::min(end, WINDOW);
+    size_t tailLen = std::min(end, WINDOW);
+    if (::pread(fd_.get(), buf, headLen, 0) != static_cast<ssize_t>(headLen) ||
+        ::pread(fd_.get(), buf + headLen, tailLen, static_cast<off_t>(end - tailLen)) !=
+            static_cast<ssize_t>(tailLen))
+        return 0;
+    return detail::hashId(buf, headLen + tailLen) ^ end;
+}
+
 void VariableFileRepositoryImpl::invalidateCache() {
     cache_.clear();
+    locs_.clear();
+    recordCache_.clear();
+    idIndex_.clear();
+    slotTypes_.clear();
+    for (auto& ts : typeSlots_)
+        ts = TypeSlots{};
+    typeSlotsStale_ = false;
+    binary_.clear();
+    logLines_ = 0;
     cacheValid_ = false;
+    sessionFresh_ = false;
+    indexedBytes_ = 0;
 }
 
 bool VariableFileRepositoryImpl::sync(std::error_code& ec) {
-    if (::fsync(fd_.get()) < 0) {
-        ec = std::error_code(errno, std::generic_category());
-        return false;
+    // Every write ends here under the exclusive lock: announce it to cooperating processes
+    if (control_)
+        control_->bump();
+    sessionFresh_ = false; // Our own entry still has to be indexed
+    switch (options_.durability) {
+    case Durability::Strict:
+        if (inWriteSession_) {
+            // The session's commit() fsyncs once for all of its writes
+            sessionUnsynced_ = true;
+            ++writeSeq_;
+            break;
+        }
+        {
+            FDFILE_STATS_TIMER(stats_, Sync);
+            if (::fsync(fd_.get()) < 0) {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+        }
+        durableSeq_ = ++writeSeq_;
+        break;
+    case Durability::Async:
+        // Leave write-back to the kernel; flush() forces it
+        ++writeSeq_;
+        break;
+    case Durability::GroupCommit:
+        flusher_->noteWrite();
+        break;
     }
     // Update file stats after sync
     updateFileStats();
     return true;
 }
 
+uint64_t VariableFileRepositoryImpl::lastWriteTicket() const {
+    if (flusher_)
+        return flusher_->lastTicket();
+    std::shared_lock<std::shared_mutex> shared;
+    if (gate_)
+        shared = gate_->lockShared();
+    return writeSeq_;
+}
+
+bool VariableFileRepositoryImpl::waitDurable(uint64_t ticket, std::error_code& ec) {
+    ec.clear();
+    if (flusher_)
+        return flusher_->waitDurable(ticket, ec);
+    {
+        std::shared_lock<std::shared_mutex> shared;
+        if (gate_)
+            shared = gate_->lockShared();
+        if (durableSeq_ >= ticket)
+            return true;
+    }
+    return flush(ec);
+}
+
+std::future<std::error_code>
+VariableFileRepositoryImpl::saveAsync(const VariableRecordBase& record) {
+    auto promise = std::make_shared<std::promise<std::error_code>>();
+    std::future<std::error_code> result = promise->get_future();
+    saveAsync(record, [promise](const std::error_code& ec) { promise->set_value(ec); });
+    return result;
+}
+
+void VariableFileRepositoryImpl::saveAsync(const VariableRecordBase& record, AsyncCallback done) {
+    std::shared_ptr<VariableRecordBase> copy = record.cloneVariable();
+    if (!copy) {
+        if (done)
+            done(std::make_error_code(std::errc::invalid_argument));
+        return;
+    }
+    submitAsync([copy](WriteSession& s, std::error_code& ec) { return s.save(*copy, ec); },
+                std::move(done));
+}
+
+std::future<std::error_code> VariableFileRepositoryImpl::deleteAsync(const std::string& id) {
+    auto promise = std::make_shared<std::promise<std::error_code>>();
+    std::future<std::error_code> result = promise->get_future();
+    deleteAsync(id, [promise](const std::error_code& ec) { promise->set_value(ec); });
+    return result;
+}
+
+void VariableFileRepositoryImpl::deleteAsync(const std::string& id, AsyncCallback done) {
+    submitAsync([id](WriteSession& s, std::error_code& ec) { return s.deleteById(id, ec); },
+                std::move(done));
+}
+
+RepositoryStats VariableFileRepositoryImpl::stats() const {
+#if defined(FDFILE_ENABLE_STATS)
+    return stats_.snapshot();
+#else
+    return RepositoryStats();
+#endif
+}
+
+void VariableFileRepositoryImpl::resetStats() {
+#if defined(FDFILE_ENABLE_STATS)
+    stats_.reset();
+#endif
+}
+
+void VariableFileRepositoryImpl::setStatsHook(StatsHook hook) {
+#if defined(FDFILE_ENABLE_STATS)
+    stats_.setHook(std::move(hook));
+#else
+    (void)hook;
+#endif
+}
+
+void VariableFileRepositoryImpl::drainAsync() {
+    if (AsyncQueue* queue = async_.current())
+        queue->drain();
+}
+
+VariableFileRepositoryImpl::AsyncQueue* VariableFileRepositoryImpl::asyncQueue() {
+    return async_.get([this](std::error_code& oec) { return writeSession(oec); });
+}
+
+void VariableFileRepositoryImpl::submitAsync(AsyncQueue::Apply op, AsyncCallback done) {
+    if (AsyncQueue* queue = asyncQueue()) {
+        queue->submit(std::move(op), std::move(done));
+        return;
+    }
+    std::error_code ec;
+    WriteSession session = writeSession(ec);
+    if (!ec)
+        op(session, ec);
+    std::error_code cec;
+    if (!session.commit(cec) && !ec)
+        ec = cec;
+    if (done)
+        done(ec);
+}
+
+bool VariableFileRepositoryImpl::flush(std::error_code& ec) {
+    ec.clear();
+    if (flusher_)
+        return flusher_->waitDurable(flusher_->lastTicket(), ec);
+    auto exclusive = lockThreadsExclusive();
+    if (!fd_) {
+        ec = std::make_error_code(std::errc::bad_file_descriptor);
+        return false;
+    }
+    FDFILE_STATS_TIMER(stats_, Sync);
+    if (!detail::syncFileData(fd_.get(), ec))
+        return false;
+    durableSeq_ = writeSeq_;
+    return true;
+}
+
 } // namespace FdFile
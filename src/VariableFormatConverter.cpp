@@ -0,0 +1,140 @@
+#include <fdfile/repository/VariableFormatConverter.hpp>
+#include <fdfile/util/BinaryCodec.hpp>
+#include <fdfile/util/GroupCommitFlusher.hpp>
+#include <fdfile/util/MmapGuard.hpp>
+#include <fdfile/util/UniqueFd.hpp>
+#include <fdfile/util/WriteBatch.hpp>
+#include <fdfile/util/textFormatUtil.hpp>
+
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FdFile {
+
+namespace {
+
+/// @brief Re-encode every entry of [data, data + len) into out
+void convertEntries(const char* data, size_t len, VariableFormat to, detail::WriteBatch& out,
+                    VariableConvertStats& stats) {
+    detail::BinaryEncoder encoder;
+    detail::BinaryDictionary inDict;
+    util::KvViews kv;
+    std::error_code parseEc;
+    const bool binaryIn = detail::isBinaryVariableData(data, len);
+
+    auto emit = [&](std::string_view type) {
+        if (to == VariableFormat::Binary)
+            encoder.appendRecord(out.buffer(), type, kv);
+        else
+            util::appendFormattedLine(out.buffer(), type, kv);
+        ++stats.entries;
+    };
+
+    if (!binaryIn) {
+        // Like the repository loader, an unterminated last line is not an entry yet
+        size_t start = 0;
+        while (const char* nl =
+                   static_cast<const char*>(std::memchr(data + start, '\n', len - start))) {
+            const size_t lineLen = static_cast<size_t>(nl - (data + start));
+            std::string_view type;
+            if (lineLen > 0) {
+                if (util::parseLineView(std::string_view(data + start, lineLen), type, kv,
+                                        parseEc))
+                    emit(type);
+                else
+                    ++stats.skipped;
+            }
+            start += lineLen + 1;
+        }
+        if (start < len)
+            ++stats.skipped;
+        return;
+    }
+
+    const char* p = data + std::min(len, detail::BINARY_MAGIC_LEN);
+    const char* end = data + len;
+    while (p < end) {
+        std::string_view payload, type;
+        const auto status = detail::readBinaryFrame(p, end, payload);
+        if (status == detail::BinaryFrameStatus::Ok) {
+            const auto kind = detail::decodeBinaryPayload(payload, inDict, type, kv);
+            if (kind == detail::BinaryPayloadKind::Record)
+                emit(type);
+            else if (kind == detail::BinaryPayloadKind::Invalid)
+                ++stats.skipped;
+        } else {
+            ++stats.skipped;
+            if (status != detail::BinaryFrameStatus::BadChecksum)
+                break; // Torn or unframeable tail
+        }
+    }
+}
+
+} // namespace
+
+bool convertVariableFile(const std::string& src, const std::string& dst, VariableFormat to,
+                         std::error_code& ec, VariableConvertStats* stats) {
+    ec.clear();
+    VariableConvertStats local;
+    VariableConvertStats& st = stats ? *stats : local;
+    st = VariableConvertStats{};
+
+    std::error_code fec;
+    if (std::filesystem::equivalent(src, dst, fec)) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    int flags = O_RDONLY;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    detail::UniqueFd in(::open(src.c_str(), flags));
+    struct stat sst{};
+    if (!in || ::fstat(in.get(), &sst) < 0) {
+        ec = std::error_code(errno, std::generic_category());
+        return false;
+    }
+
+    detail::WriteBatch out;
+    const size_t size = static_cast<size_t>(sst.st_size);
+    if (size > 0) {
+        detail::MmapGuard map(::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, in.get(), 0), size);
+        if (!map) {
+            ec = std::error_code(errno, std::generic_category());
+            return false;
+        }
+#ifdef MADV_SEQUENTIAL
+        (void)::madvise(map.get(), map.size(), MADV_SEQUENTIAL);
+#endif
+        std::string& first = out.buffer();
+        if (to == VariableFormat::Binary)
+            first.append(detail::BINARY_MAGIC, detail::BINARY_MAGIC_LEN);
+        convertEntries(static_cast<const char*>(map.get()), size, to, out, st);
+    }
+
+    const std::string tmpPath = dst + ".tmp";
+    flags = O_CREAT | O_TRUNC | O_WRONLY;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    detail::UniqueFd tmp(::open(tmpPath.c_str(), flags, sst.st_mode & 07777));
+    if (!tmp) {
+        ec = std::error_code(errno, std::generic_category());
+        return false;
+    }
+    if (!out.writeTo(tmp.get(), ec) || !detail::syncFileData(tmp.get(), ec) ||
+        ::rename(tmpPath.c_str(), dst.c_str()) < 0) {
+        if (!ec)
+            ec = std::error_code(errno, std::generic_category());
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace FdFile
@@ -13,11 +13,21 @@
  * @brief Unit tests for Fixed-length record repositories (FixedA, FixedB)
  */
 
+#include <atomic>
+#include <cstdint>
+#include <fcntl.h>
+#include <filesystem>
+#include <future>
 #include <gtest/gtest.h>
 #include <memory>
+#include <set>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 #include "records/FixedA.hpp"
 #include "records/FixedB.hpp"
+#include <fdfile/repository/ShardedRepository.hpp>
 #include <fdfile/repository/UniformFixedRepositoryImpl.hpp>
 
 using namespace FdFile;
@@ -223,84 +233,2154 @@ TEST_F(FixedARepositoryTest, EdgeCaseMinInt64) {
     EXPECT_EQ(found->age, INT64_MIN);
 }
 
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 SaveAllBatchInsertAndUpdate 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, SaveAllBatchInsertAndUpdate) {
+    FixedA alice("alice", 25, "001");
+    ASSERT_TRUE(repo_->save(alice, ec_));
+
+    // Batch mixes an update of an existing record with new inserts
+    FixedA aliceV2("alice_v2", 26, "001");
+    FixedA bob("bob", 30, "002");
+    FixedA charlie("charlie", 35, "003");
+    std::vector<const FixedA*> batch = {&aliceV2, &bob, &charlie};
+    ASSERT_TRUE(repo_->saveAll(batch, ec_)) << ec_.message();
+
+    EXPECT_EQ(repo_->count(ec_), 3);
+    auto found = repo_->findById("001", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "alice_v2");
+    EXPECT_EQ(found->age, 26);
+
+    found = repo_->findById("003", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 35);
+
+    // Records written by the batch must be visible to a fresh repository instance
+    std::error_code ec2;
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec2);
+    ASSERT_FALSE(ec2);
+    EXPECT_EQ(reopened.count(ec2), 3);
+    EXPECT_TRUE(reopened.existsById("002", ec2));
+}
+
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 SaveAllDuplicateIdsLastWins 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, SaveAllDuplicateIdsLastWins) {
+    FixedA first("first", 1, "001");
+    FixedA second("second", 2, "001");
+    std::vector<const FixedA*> batch = {&first, &second};
+    ASSERT_TRUE(repo_->saveAll(batch, ec_));
+
+    // Same ID inside one batch occupies a single slot
+    EXPECT_EQ(repo_->count(ec_), 1);
+    auto found = repo_->findById("001", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "second");
+}
+
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 SaveAllRejectsNullRecord 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, SaveAllRejectsNullRecord) {
+    FixedA alice("alice", 25, "001");
+    std::vector<const FixedA*> batch = {&alice, nullptr};
+
+    EXPECT_FALSE(repo_->saveAll(batch, ec_));
+    EXPECT_EQ(ec_, std::make_error_code(std::errc::invalid_argument));
+
+    // Nothing from the rejected batch is written
+    EXPECT_EQ(repo_->count(ec_), 0);
+}
+
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 HashIndexGrowsAndDeletes 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, HashIndexGrowsAndDeletes) {
+    // Enough records to rehash the index several times
+    for (int i = 0; i < 500; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    for (int i = 0; i < 500; i += 7)
+        ASSERT_TRUE(repo_->deleteById(std::to_string(i), ec_));
+
+    EXPECT_EQ(repo_->count(ec_), 500u - 72u);
+    for (int i = 0; i < 500; ++i) {
+        auto rec = repo_->findById(std::to_string(i), ec_);
+        if (i % 7 == 0) {
+            EXPECT_EQ(rec, nullptr) << i;
+        } else {
+            ASSERT_NE(rec, nullptr) << i;
+            EXPECT_EQ(rec->age, i);
+        }
+    }
+}
+
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 IdLongerThanFieldMatchesStoredPrefix 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, IdLongerThanFieldMatchesStoredPrefix) {
+    // The ID field holds 10 bytes; lookups compare against what was stored
+    FixedA rec("long", 1, "0123456789-tail");
+    ASSERT_TRUE(repo_->save(rec, ec_));
+
+    EXPECT_TRUE(repo_->existsById("0123456789-tail", ec_));
+    EXPECT_TRUE(repo_->existsById("0123456789", ec_));
+    EXPECT_FALSE(repo_->existsById("012345678", ec_));
+}
+
+// =============================================================================
+// FixedB Repository Tests
+// =============================================================================
+
+class FixedBRepositoryTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_b.db";
+        ::remove(testFile_.c_str());
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedB>>(testFile_, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedB>> repo_;
+};
+
+// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 InsertMultipleRecords 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedBRepositoryTest, InsertMultipleRecords) {
+    FixedB laptop("Laptop", 1500000, "P001");
+    FixedB phone("Phone", 800000, "P002");
+    FixedB tablet("Tablet", 500000, "P003");
+
+    ASSERT_TRUE(repo_->save(laptop, ec_));
+    ASSERT_TRUE(repo_->save(phone, ec_));
+    ASSERT_TRUE(repo_->save(tablet, ec_));
+
+    EXPECT_EQ(repo_->count(ec_), 3);
+}
+
+// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 FindAll 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedBRepositoryTest, FindAll) {
+    FixedB laptop("Laptop", 1500000, "P001");
+    FixedB phone("Phone", 800000, "P002");
+    repo_->save(laptop, ec_);
+    repo_->save(phone, ec_);
+
+    auto all = repo_->findAll(ec_);
+    ASSERT_EQ(all.size(), 2);
+
+    // Verify content
+    bool foundLaptop = false, foundPhone = false;
+    for (const auto& rec : all) {
+        if (std::string(rec->title) == "Laptop")
+            foundLaptop = true;
+        if (std::string(rec->title) == "Phone")
+            foundPhone = true;
+    }
+    EXPECT_TRUE(foundLaptop);
+    EXPECT_TRUE(foundPhone);
+}
+
+// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 UpdateExistingRecord 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedBRepositoryTest, UpdateExistingRecord) {
+    FixedB phone("Phone", 800000, "P001");
+    repo_->save(phone, ec_);
+
+    // Update price (discount!)
+    FixedB discountedPhone("Phone", 750000, "P001");
+    ASSERT_TRUE(repo_->save(discountedPhone, ec_));
+
+    EXPECT_EQ(repo_->count(ec_), 1);
+
+    auto found = repo_->findById("P001", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->cost, 750000);
+}
+
+// =============================================================================
+// Record Layout Tests
+// =============================================================================
+
+// 시나리오 상세 설명: FixedRecordLayoutTest 그룹의 LayoutSharedAcrossInstances 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FixedRecordLayoutTest, LayoutSharedAcrossInstances) {
+    FixedA a;
+    FixedA b("bob", 3, "002");
+    FixedB c;
+
+    // Same type -> same layout storage; different type -> different layout
+    EXPECT_EQ(&a.fieldName(0), &b.fieldName(0));
+    EXPECT_NE(static_cast<const void*>(&a.fieldName(0)),
+              static_cast<const void*>(&c.fieldName(0)));
+    EXPECT_EQ(a.recordSize(), b.recordSize());
+    EXPECT_EQ(a.fieldName(0), "name");
+    EXPECT_EQ(a.fieldIndex("age"), 1u);
+    EXPECT_EQ(a.fieldIndex("missing"), a.fieldCount());
+}
+
+// 시나리오 상세 설명: FixedRecordLayoutTest 그룹의 SerializeWritesExactlyRecordSize 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FixedRecordLayoutTest, SerializeWritesExactlyRecordSize) {
+    FixedA rec("alice", INT64_MIN, "id1");
+    std::vector<char> buf(rec.recordSize() + 1, '@');
+    ASSERT_TRUE(rec.serialize(buf.data()));
+    EXPECT_EQ(buf.back(), '@'); // Guard byte untouched
+    EXPECT_EQ(buf[rec.recordSize() - 1], '}');
+
+    FixedA out;
+    std::error_code ec;
+    ASSERT_TRUE(out.deserialize(buf.data(), ec));
+    EXPECT_EQ(out.getId(), "id1");
+    EXPECT_STREQ(out.name, "alice");
+    EXPECT_EQ(out.age, INT64_MIN);
+}
+
+// 시나리오 상세 설명: FixedRecordLayoutTest 그룹의 DeserializeReportsMalformedNumber 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FixedRecordLayoutTest, DeserializeReportsMalformedNumber) {
+    FixedA rec("alice", 5, "id1");
+    std::vector<char> buf(rec.recordSize());
+    ASSERT_TRUE(rec.serialize(buf.data()));
+    buf[rec.fieldOffset(1) + 10] = 'x';
+
+    FixedA out;
+    std::error_code ec;
+    EXPECT_FALSE(out.deserialize(buf.data(), ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+}
+
+// =============================================================================
+// Tombstone Delete Mode Tests
+// =============================================================================
+
+class TombstoneDeleteTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_tombstone.db";
+        ::remove(testFile_.c_str());
+        options_.deleteMode = DeleteMode::Tombstone;
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, options_, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+
+        FixedA temp("test", 0, "000");
+        recordSize_ = temp.recordSize();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    size_t fileSize() const {
+        struct stat st{};
+        ::stat(testFile_.c_str(), &st);
+        return static_cast<size_t>(st.st_size);
+    }
+
+    void saveN(int n) {
+        for (int i = 0; i < n; ++i) {
+            FixedA rec("user", i, std::to_string(i).c_str());
+            ASSERT_TRUE(repo_->save(rec, ec_)) << ec_.message();
+        }
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    FixedRepositoryOptions options_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> repo_;
+    size_t recordSize_ = 0;
+};
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 DeleteKeepsFileSizeAndReusesSlot 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, DeleteKeepsFileSizeAndReusesSlot) {
+    saveN(3);
+    ASSERT_EQ(fileSize(), 3 * recordSize_);
+
+    ASSERT_TRUE(repo_->deleteById("1", ec_));
+    EXPECT_EQ(fileSize(), 3 * recordSize_); // No compaction on delete
+    EXPECT_EQ(repo_->count(ec_), 2);
+    EXPECT_FALSE(repo_->existsById("1", ec_));
+    EXPECT_EQ(repo_->findAll(ec_).size(), 2);
+
+    // Other records keep their slots
+    auto found = repo_->findById("2", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 2);
+
+    // Next insert fills the free slot instead of growing the file
+    FixedA rec("new", 99, "99");
+    ASSERT_TRUE(repo_->save(rec, ec_));
+    EXPECT_EQ(fileSize(), 3 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 3);
+    found = repo_->findById("99", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 99);
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 InsertsReuseLowestFreeSlot 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, InsertsReuseLowestFreeSlot) {
+    saveN(10);
+    for (const char* id : {"5", "2", "8"})
+        ASSERT_TRUE(repo_->deleteById(id, ec_));
+
+    // Lowest first, in whatever order the slots were freed (as after a reopen)
+    ASSERT_TRUE(repo_->save(FixedA("new", 100, "100"), ec_));
+    FixedA a("new", 101, "101"), b("new", 102, "102");
+    ASSERT_TRUE(repo_->saveAll({&a, &b}, ec_));
+
+    auto ages = [](const std::vector<std::unique_ptr<FixedA>>& recs) {
+        std::vector<int64_t> out;
+        for (const auto& r : recs)
+            out.push_back(r->age);
+        return out;
+    };
+    const std::vector<int64_t> expected = {0, 1, 100, 3, 4, 101, 6, 7, 102, 9};
+    EXPECT_EQ(ages(repo_->findAll(ec_)), expected);
+    EXPECT_EQ(fileSize(), 10 * recordSize_);
+
+    repo_.reset();
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(ages(reopened.findAll(ec_)), expected);
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 CompactReclaimsSpace 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, CompactReclaimsSpace) {
+    saveN(5);
+    ASSERT_TRUE(repo_->deleteById("0", ec_));
+    ASSERT_TRUE(repo_->deleteById("2", ec_));
+    ASSERT_TRUE(repo_->deleteById("3", ec_));
+
+    ASSERT_TRUE(repo_->compact(ec_)) << ec_.message();
+    EXPECT_EQ(fileSize(), 2 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 2);
+
+    auto found = repo_->findById("1", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 1);
+    found = repo_->findById("4", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 4);
+
+    // Cached indices must match a fresh rebuild
+    std::error_code ec2;
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec2);
+    ASSERT_FALSE(ec2);
+    found = reopened.findById("4", ec2);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 4);
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 ReopenSkipsTombstones 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, ReopenSkipsTombstones) {
+    saveN(3);
+    ASSERT_TRUE(repo_->deleteById("0", ec_));
+    repo_.reset();
+
+    // A default-mode repository must also understand tombstoned slots
+    std::error_code ec2;
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec2);
+    ASSERT_FALSE(ec2) << ec2.message();
+    EXPECT_EQ(reopened.count(ec2), 2);
+    EXPECT_EQ(reopened.findAll(ec2).size(), 2);
+    EXPECT_FALSE(reopened.existsById("0", ec2));
+
+    FixedA rec("new", 7, "7");
+    ASSERT_TRUE(reopened.save(rec, ec2));
+    EXPECT_EQ(fileSize(), 3 * recordSize_);
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 AutoCompactThreshold 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, AutoCompactThreshold) {
+    repo_.reset();
+    options_.compactThreshold = 0.5;
+    repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_);
+
+    saveN(4);
+    ASSERT_TRUE(repo_->deleteById("0", ec_));
+    EXPECT_EQ(fileSize(), 4 * recordSize_); // 1/4 free: below threshold
+
+    ASSERT_TRUE(repo_->deleteById("1", ec_));
+    EXPECT_EQ(fileSize(), 2 * recordSize_); // 2/4 free: compacted
+    EXPECT_EQ(repo_->count(ec_), 2);
+    EXPECT_TRUE(repo_->existsById("3", ec_));
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 ExternalSlotReuseThenGrowthIsSeen 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, ExternalSlotReuseThenGrowthIsSeen) {
+    saveN(3);
+    ASSERT_TRUE(repo_->deleteById("1", ec_));
+    ASSERT_EQ(repo_->count(ec_), 2u);
+
+    {
+        // Fills the tombstoned slot, then grows the file
+        UniformFixedRepositoryImpl<FixedA> other(testFile_, options_, ec_);
+        ASSERT_FALSE(ec_);
+        FixedA x("x", 10, "x");
+        FixedA y("y", 11, "y");
+        ASSERT_TRUE(other.save(x, ec_));
+        ASSERT_TRUE(other.save(y, ec_));
+    }
+
+    EXPECT_EQ(repo_->count(ec_), 4u);
+    EXPECT_TRUE(repo_->existsById("x", ec_));
+    EXPECT_TRUE(repo_->existsById("y", ec_));
+    EXPECT_FALSE(repo_->existsById("1", ec_));
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 ExternalDeleteReuseThenGrowthRebuilds 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, ExternalDeleteReuseThenGrowthRebuilds) {
+    saveN(3);
+    UniformFixedRepositoryImpl<FixedA> reader(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_EQ(reader.count(ec_), 3u);
+
+    // Middle delete, reuse of its slot, then growth: the first and last slots are unchanged
+    ASSERT_TRUE(repo_->deleteById("1", ec_));
+    ASSERT_TRUE(repo_->save(FixedA("d", 10, "d"), ec_));
+    ASSERT_TRUE(repo_->save(FixedA("e", 11, "e"), ec_));
+
+    EXPECT_EQ(reader.count(ec_), 4u);
+    EXPECT_FALSE(reader.existsById("1", ec_));
+    EXPECT_TRUE(reader.existsById("d", ec_));
+    EXPECT_TRUE(reader.existsById("e", ec_));
+}
+
+// 시나리오 상세 설명: TombstoneDeleteTest 그룹의 AsyncDeleteAndReuseSeenByOtherInstance 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(TombstoneDeleteTest, AsyncDeleteAndReuseSeenByOtherInstance) {
+    repo_.reset();
+    ::remove(testFile_.c_str());
+    options_.durability = Durability::Async;
+    UniformFixedRepositoryImpl<FixedA> a(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_TRUE(a.save(FixedA("a", 1, "a"), ec_));
+    ASSERT_TRUE(a.save(FixedA("b", 2, "b"), ec_));
+
+    UniformFixedRepositoryImpl<FixedA> b(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_EQ(b.count(ec_), 2u);
+
+    // Delete and reuse the slot without changing the file size
+    ASSERT_TRUE(a.deleteById("a", ec_));
+    ASSERT_TRUE(a.save(FixedA("c", 3, "c"), ec_));
+    EXPECT_EQ(fileSize(), 2 * recordSize_);
+    EXPECT_EQ(b.count(ec_), 2u);
+    EXPECT_FALSE(b.existsById("a", ec_));
+    EXPECT_TRUE(b.existsById("c", ec_));
+
+    ASSERT_TRUE(b.save(FixedA("d", 4, "d"), ec_));
+    EXPECT_EQ(a.count(ec_), 3u);
+    EXPECT_TRUE(a.existsById("c", ec_));
+    EXPECT_TRUE(a.existsById("d", ec_));
+}
+
+// 시나리오 상세 설명: FixedARepositoryTest 그룹의 DeleteMiddleKeepsIndicesValid 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedARepositoryTest, DeleteMiddleKeepsIndicesValid) {
+    FixedA alice("alice", 25, "001");
+    FixedA bob("bob", 30, "002");
+    FixedA charlie("charlie", 35, "003");
+    repo_->save(alice, ec_);
+    repo_->save(bob, ec_);
+    repo_->save(charlie, ec_);
+
+    ASSERT_TRUE(repo_->deleteById("002", ec_));
+
+    // Records after the deleted slot shifted down; cache must follow
+    auto found = repo_->findById("003", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "charlie");
+    found = repo_->findById("001", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "alice");
+}
+
+// =============================================================================
+// Chunked Growth Tests
+// =============================================================================
+
+class ChunkedGrowthTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_chunked.db";
+        ::remove(testFile_.c_str());
+        options_.growChunkRecords = 8;
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, options_, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+
+        FixedA temp("test", 0, "000");
+        recordSize_ = temp.recordSize();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    size_t fileSize() const {
+        struct stat st{};
+        ::stat(testFile_.c_str(), &st);
+        return static_cast<size_t>(st.st_size);
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    FixedRepositoryOptions options_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> repo_;
+    size_t recordSize_ = 0;
+};
+
+// 시나리오 상세 설명: ChunkedGrowthTest 그룹의 GrowsByWholeChunks 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ChunkedGrowthTest, GrowsByWholeChunks) {
+    FixedA first("first", 1, "1");
+    ASSERT_TRUE(repo_->save(first, ec_));
+    EXPECT_EQ(fileSize(), 8 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 1);
+
+    // Fill the first chunk: file must not grow
+    for (int i = 2; i <= 8; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    EXPECT_EQ(fileSize(), 8 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 8);
+
+    // The ninth record starts a second chunk
+    FixedA ninth("ninth", 9, "9");
+    ASSERT_TRUE(repo_->save(ninth, ec_));
+    EXPECT_EQ(fileSize(), 16 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 9);
+    EXPECT_EQ(repo_->findAll(ec_).size(), 9);
+}
+
+// 시나리오 상세 설명: ChunkedGrowthTest 그룹의 ReopenIgnoresPreallocatedSlots 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ChunkedGrowthTest, ReopenIgnoresPreallocatedSlots) {
+    FixedA alice("alice", 25, "001");
+    FixedA bob("bob", 30, "002");
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    ASSERT_TRUE(repo_->save(bob, ec_));
+    repo_.reset();
+
+    // A default repository treats zero-filled slots as empty and reuses them
+    std::error_code ec2;
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec2);
+    ASSERT_FALSE(ec2) << ec2.message();
+    EXPECT_EQ(reopened.count(ec2), 2);
+    EXPECT_EQ(reopened.findAll(ec2).size(), 2);
+
+    FixedA charlie("charlie", 35, "003");
+    ASSERT_TRUE(reopened.save(charlie, ec2));
+    EXPECT_EQ(fileSize(), 8 * recordSize_);
+    auto found = reopened.findById("003", ec2);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "charlie");
+}
+
+// 시나리오 상세 설명: ChunkedGrowthTest 그룹의 SaveAllRoundsUpToChunk 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ChunkedGrowthTest, SaveAllRoundsUpToChunk) {
+    std::vector<FixedA> recs;
+    for (int i = 0; i < 10; ++i)
+        recs.emplace_back("user", i, std::to_string(i).c_str());
+    std::vector<const FixedA*> batch;
+    for (const auto& r : recs)
+        batch.push_back(&r);
+
+    ASSERT_TRUE(repo_->saveAll(batch, ec_));
+    EXPECT_EQ(fileSize(), 10 * recordSize_); // Batch larger than a chunk grows exactly
+
+    FixedA extra("extra", 99, "99");
+    ASSERT_TRUE(repo_->save(extra, ec_));
+    EXPECT_EQ(fileSize(), 18 * recordSize_);
+    EXPECT_EQ(repo_->count(ec_), 11);
+}
+
+// 시나리오 상세 설명: ChunkedGrowthTest 그룹의 PreallocatedSlotInsertSeenByOtherInstance 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ChunkedGrowthTest, PreallocatedSlotInsertSeenByOtherInstance) {
+    repo_.reset();
+    ::remove(testFile_.c_str());
+    options_.growChunkRecords = 16;
+    options_.durability = Durability::Async;
+    UniformFixedRepositoryImpl<FixedA> a(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_TRUE(a.save(FixedA("x1", 1, "x1"), ec_));
+
+    UniformFixedRepositoryImpl<FixedA> b(testFile_, options_, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_EQ(b.count(ec_), 1u);
+
+    // Neither the size nor (without msync) the mtime changes
+    ASSERT_TRUE(a.save(FixedA("x2", 2, "x2"), ec_));
+    ASSERT_TRUE(b.save(FixedA("y", 3, "y"), ec_));
+    ASSERT_TRUE(a.flush(ec_));
+    ASSERT_TRUE(b.flush(ec_));
+    EXPECT_EQ(b.count(ec_), 3u);
+    EXPECT_EQ(fileSize(), 16 * recordSize_);
+
+    UniformFixedRepositoryImpl<FixedA> fresh(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(fresh.count(ec_), 3u);
+    EXPECT_TRUE(fresh.existsById("x2", ec_));
+    EXPECT_TRUE(fresh.existsById("y", ec_));
+}
+
+// =============================================================================
+// Zero-copy RecordView Tests
+// =============================================================================
+
+class RecordViewTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_view.db";
+        ::remove(testFile_.c_str());
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> repo_;
+};
+
+// 시나리오 상세 설명: RecordViewTest 그룹의 ForEachReadsFieldsInPlace 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(RecordViewTest, ForEachReadsFieldsInPlace) {
+    FixedA a("alice", 30, "001");
+    FixedA b("bob", -7, "002");
+    ASSERT_TRUE(repo_->save(a, ec_));
+    ASSERT_TRUE(repo_->save(b, ec_));
+
+    std::vector<std::string> ids;
+    int64_t ageSum = 0;
+    ASSERT_TRUE(repo_->forEach(
+        [&](const RecordView<FixedA>& v) {
+            EXPECT_EQ(v.typeName(), "FixedA");
+            EXPECT_EQ(v.fieldCount(), 2u);
+            ids.emplace_back(v.id());
+            std::error_code fec;
+            ageSum += v.num("age", fec);
+            EXPECT_FALSE(fec);
+        },
+        ec_));
+
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids[0], "001");
+    EXPECT_EQ(ids[1], "002");
+    EXPECT_EQ(ageSum, 23);
+}
+
+// 시나리오 상세 설명: RecordViewTest 그룹의 ForEachStopsEarlyAndSkipsDeleted 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(RecordViewTest, ForEachStopsEarlyAndSkipsDeleted) {
+    FixedRepositoryOptions opts;
+    opts.deleteMode = DeleteMode::Tombstone;
+    repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_);
+    for (int i = 0; i < 5; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_TRUE(repo_->deleteById("1", ec_));
+
+    std::vector<std::string> ids;
+    ASSERT_TRUE(repo_->forEach(
+        [&](const RecordView<FixedA>& v) {
+            ids.emplace_back(v.id());
+            return ids.size() < 3;
+        },
+        ec_));
+    EXPECT_EQ(ids, (std::vector<std::string>{"0", "2", "3"}));
+}
+
+// 시나리오 상세 설명: RecordViewTest 그룹의 ReadSessionFindByIdAndMaterialize 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(RecordViewTest, ReadSessionFindByIdAndMaterialize) {
+    FixedA a("carol", 41, "c1");
+    ASSERT_TRUE(repo_->save(a, ec_));
+
+    auto session = repo_->readSession(ec_);
+    ASSERT_FALSE(ec_);
+    ASSERT_TRUE(session.valid());
+    EXPECT_EQ(session.count(), 1u);
+    EXPECT_FALSE(session.findById("missing").has_value());
+
+    auto view = session.findById("c1");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->str("name"), "carol");
+    EXPECT_EQ(view->str(size_t{0}), "carol");
+    EXPECT_TRUE(view->str("nope").empty());
+
+    std::error_code fec;
+    EXPECT_EQ(view->num(size_t{0}, fec), 0); // string field is not numeric
+    EXPECT_TRUE(fec);
+
+    auto rec = view->toRecord(ec_);
+    ASSERT_NE(rec, nullptr);
+    EXPECT_EQ(rec->getId(), "c1");
+    EXPECT_EQ(rec->age, 41);
+    EXPECT_STREQ(rec->name, "carol");
+}
+
+// =============================================================================
+// Lock Session Tests
+// =============================================================================
+
+class FixedSessionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_session.db";
+        ::remove(testFile_.c_str());
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    void open(const FixedRepositoryOptions& opts = {}) {
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+    }
+
+    /// Lock type (F_UNLCK, F_RDLCK, F_WRLCK) another process finds on the file
+    int lockSeenByOtherProcess() {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int fd = ::open(testFile_.c_str(), O_RDONLY);
+            struct flock fl{};
+            fl.l_type = F_WRLCK;
+            fl.l_whence = SEEK_SET;
+            ::fcntl(fd, F_GETLK, &fl);
+            ::_exit(fl.l_type == F_RDLCK ? 1 : fl.l_type == F_WRLCK ? 2 : 0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        const int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        return code == 1 ? F_RDLCK : code == 2 ? F_WRLCK : code == 0 ? F_UNLCK : -1;
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> repo_;
+};
+
+// 시나리오 상세 설명: FixedSessionTest 그룹의 WriteSessionHoldsLockUntilCommit 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedSessionTest, WriteSessionHoldsLockUntilCommit) {
+    open();
+    {
+        auto session = repo_->writeSession(ec_);
+        ASSERT_TRUE(session.valid()) << ec_.message();
+        for (int i = 1; i <= 5; ++i) {
+            FixedA rec("user", i, std::to_string(i).c_str());
+            ASSERT_TRUE(session.save(rec, ec_)) << ec_.message();
+        }
+        ASSERT_TRUE(session.deleteById("3", ec_));
+        EXPECT_EQ(session.count(), 4u);
+        EXPECT_FALSE(session.existsById("3"));
+        auto four = session.findById("4", ec_);
+        ASSERT_NE(four, nullptr);
+        EXPECT_EQ(four->age, 4);
+        EXPECT_EQ(lockSeenByOtherProcess(), F_WRLCK) << "One exclusive lock for the whole group";
+
+        ASSERT_TRUE(session.commit(ec_)) << ec_.message();
+        EXPECT_FALSE(session.valid());
+        EXPECT_EQ(lockSeenByOtherProcess(), F_UNLCK);
+        EXPECT_FALSE(session.save(FixedA("late", 9, "9"), ec_));
+        EXPECT_EQ(ec_, std::errc::invalid_argument);
+    }
+
+    EXPECT_EQ(repo_->count(ec_), 4u);
+    UniformFixedRepositoryImpl<FixedA> other(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other.count(ec_), 4u);
+    EXPECT_FALSE(other.existsById("3", ec_));
+}
+
+// 시나리오 상세 설명: FixedSessionTest 그룹의 ReadSessionUpgradesInPlace 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedSessionTest, ReadSessionUpgradesInPlace) {
+    open();
+    FixedA a("alice", 25, "001");
+    ASSERT_TRUE(repo_->save(a, ec_));
+
+    auto read = repo_->readSession(ec_);
+    ASSERT_TRUE(read.valid());
+    EXPECT_EQ(lockSeenByOtherProcess(), F_RDLCK);
+    ASSERT_TRUE(read.existsById("001"));
+    EXPECT_FALSE(read.existsById("002"));
+
+    auto write = read.upgrade(ec_);
+    ASSERT_TRUE(write.valid()) << ec_.message();
+    EXPECT_FALSE(read.valid());
+    EXPECT_EQ(lockSeenByOtherProcess(), F_WRLCK);
+
+    FixedA b("bob", 30, "002");
+    ASSERT_TRUE(write.save(b, ec_));
+    EXPECT_EQ(write.count(), 2u);
+    ASSERT_TRUE(write.commit(ec_));
+
+    EXPECT_EQ(repo_->count(ec_), 2u);
+    EXPECT_FALSE(read.upgrade(ec_).valid());
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+}
+
+// 시나리오 상세 설명: FixedSessionTest 그룹의 ThreadSafeUpgradeAndGrowth 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedSessionTest, ThreadSafeUpgradeAndGrowth) {
+    FixedRepositoryOptions opts;
+    opts.threadSafe = true;
+    opts.deleteMode = DeleteMode::Tombstone;
+    opts.growChunkRecords = 4;
+    open(opts);
+
+    auto read = repo_->readSession(ec_);
+    ASSERT_TRUE(read.valid());
+    auto write = read.upgrade(ec_);
+    ASSERT_TRUE(write.valid()) << ec_.message();
+
+    std::vector<FixedA> recs;
+    for (int i = 0; i < 10; ++i)
+        recs.emplace_back("user", i, std::to_string(i).c_str());
+    std::vector<const FixedA*> ptrs;
+    for (const auto& r : recs)
+        ptrs.push_back(&r);
+    ASSERT_TRUE(write.saveAll(ptrs, ec_));
+    ASSERT_TRUE(write.deleteById("0", ec_));
+    ASSERT_TRUE(write.compact(ec_));
+
+    size_t seen = 0;
+    write.forEach([&](const RecordView<FixedA>&) { ++seen; });
+    EXPECT_EQ(seen, 9u);
+    write = {}; // Commits
+
+    EXPECT_EQ(repo_->count(ec_), 9u);
+    ASSERT_TRUE(repo_->waitDurable(repo_->lastWriteTicket(), ec_));
+}
+
+// =============================================================================
+// Async Write Tests
+// =============================================================================
+
+class FixedAsyncWriteTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_async.db";
+        ::remove(testFile_.c_str());
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    void open(const FixedRepositoryOptions& opts) {
+        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
+    }
+
+    static FixedRepositoryOptions asyncOptions() {
+        FixedRepositoryOptions opts;
+        opts.asyncWrites = true;
+        opts.deleteMode = DeleteMode::Tombstone;
+        opts.growChunkRecords = 16;
+        return opts;
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> repo_;
+};
+
+// 시나리오 상세 설명: FixedAsyncWriteTest 그룹의 FuturesCompleteInSubmissionOrder 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedAsyncWriteTest, FuturesCompleteInSubmissionOrder) {
+    open(asyncOptions());
+
+    std::vector<std::future<std::error_code>> results;
+    for (int i = 0; i < 100; ++i) {
+        // IDs repeat, so only submission order leaves age == i for the last version
+        FixedA rec("user", i, std::to_string(i % 10).c_str());
+        results.push_back(repo_->saveAsync(rec));
+    }
+    results.push_back(repo_->deleteAsync("3"));
+    results.push_back(repo_->deleteAsync("missing"));
+    for (auto& f : results)
+        EXPECT_FALSE(f.get());
+
+    EXPECT_EQ(repo_->count(ec_), 9u);
+    EXPECT_FALSE(repo_->existsById("3", ec_));
+    auto seven = repo_->findById("7", ec_);
+    ASSERT_NE(seven, nullptr);
+    EXPECT_EQ(seven->age, 97);
+
+    UniformFixedRepositoryImpl<FixedA> other(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other.count(ec_), 9u);
+}
+
+// 시나리오 상세 설명: FixedAsyncWriteTest 그룹의 CallbacksFromSeveralThreads 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedAsyncWriteTest, CallbacksFromSeveralThreads) {
+    open(asyncOptions());
+
+    std::atomic<int> ok{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([this, t, &ok] {
+            for (int i = 0; i < 50; ++i) {
+                FixedA rec("user", i, ("t" + std::to_string(t) + "_" + std::to_string(i)).c_str());
+                repo_->saveAsync(rec, [&ok](const std::error_code& ec) {
+                    if (!ec)
+                        ++ok;
+                });
+                std::error_code readEc;
+                repo_->count(readEc); // Reads interleave with the writer thread
+                EXPECT_FALSE(readEc);
+            }
+        });
+    }
+    for (auto& w : writers)
+        w.join();
+    repo_->drainAsync();
+
+    EXPECT_EQ(ok.load(), 200);
+    EXPECT_EQ(repo_->count(ec_), 200u);
+}
+
+// 시나리오 상세 설명: FixedAsyncWriteTest 그룹의 DestructorAppliesQueuedWrites 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedAsyncWriteTest, DestructorAppliesQueuedWrites) {
+    FixedRepositoryOptions opts = asyncOptions();
+    opts.durability = Durability::GroupCommit;
+    open(opts);
+    for (int i = 0; i < 50; ++i)
+        repo_->saveAsync(FixedA("user", i, std::to_string(i).c_str()), nullptr);
+    repo_.reset();
+
+    UniformFixedRepositoryImpl<FixedA> other(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other.count(ec_), 50u);
+}
+
+// 시나리오 상세 설명: FixedAsyncWriteTest 그룹의 MoveKeepsWriterBoundToNewObject 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedAsyncWriteTest, MoveKeepsWriterBoundToNewObject) {
+    open(asyncOptions());
+    for (int i = 0; i < 50; ++i)
+        repo_->saveAsync(FixedA("user", i, std::to_string(i).c_str()), nullptr);
+
+    // Writes queued before the move are applied to the moved-from object first
+    UniformFixedRepositoryImpl<FixedA> moved(std::move(*repo_));
+    for (int i = 50; i < 100; ++i)
+        moved.saveAsync(FixedA("user", i, std::to_string(i).c_str()), nullptr);
+    EXPECT_FALSE(moved.deleteAsync("7").get());
+    EXPECT_EQ(moved.count(ec_), 99u);
+
+    // Move assignment drains both writers
+    UniformFixedRepositoryImpl<FixedA> target(testFile_, asyncOptions(), ec_);
+    ASSERT_FALSE(ec_);
+    target.saveAsync(FixedA("late", 1, "late"), nullptr);
+    target = std::move(moved);
+    EXPECT_FALSE(target.saveAsync(FixedA("user", 100, "100")).get());
+    EXPECT_EQ(target.count(ec_), 101u);
+    EXPECT_TRUE(target.existsById("late", ec_));
+
+    repo_.reset();
+    UniformFixedRepositoryImpl<FixedA> other(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other.count(ec_), 101u);
+}
+
+// 시나리오 상세 설명: FixedAsyncWriteTest 그룹의 WithoutAsyncWritesRunsInline 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedAsyncWriteTest, WithoutAsyncWritesRunsInline) {
+    open(FixedRepositoryOptions{});
+    auto saved = repo_->saveAsync(FixedA("alice", 25, "001"));
+    ASSERT_EQ(saved.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(saved.get());
+    EXPECT_TRUE(repo_->existsById("001", ec_));
+
+    bool called = false;
+    repo_->deleteAsync("001", [&called](const std::error_code& ec) {
+        EXPECT_FALSE(ec);
+        called = true;
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(repo_->count(ec_), 0u);
+}
+
+// =============================================================================
+// Statistics Tests
+// =============================================================================
+
+// 시나리오 상세 설명: FixedStatsTest 그룹의 RecordsOperationsAndCacheEvents 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FixedStatsTest, RecordsOperationsAndCacheEvents) {
+    const std::string path = "./test_fixed_stats.db";
+    ::remove(path.c_str());
+    std::error_code ec;
+    FixedRepositoryOptions opts;
+    opts.controlFile = true; // Lets the other instance's append be indexed on its own
+    {
+        UniformFixedRepositoryImpl<FixedA> repo(path, opts, ec);
+        ASSERT_FALSE(ec);
+        size_t hooked = 0;
+        repo.setStatsHook([&hooked](StatOp, uint64_t) { ++hooked; });
+
+        for (int i = 0; i < 5; ++i)
+            ASSERT_TRUE(repo.save(FixedA("user", i, std::to_string(i).c_str()), ec));
+        ASSERT_NE(repo.findById("3", ec), nullptr);
+        ASSERT_TRUE(repo.deleteById("3", ec));
+
+        // Another instance appends: the next read indexes only the new slot
+        {
+            UniformFixedRepositoryImpl<FixedA> other(path, opts, ec);
+            ASSERT_TRUE(other.save(FixedA("other", 9, "9"), ec));
+        }
+        EXPECT_EQ(repo.findAll(ec).size(), 5u);
+
+        RepositoryStats s = repo.stats();
+#if defined(FDFILE_ENABLE_STATS)
+        EXPECT_TRUE(s.enabled);
+        EXPECT_EQ(s.op(StatOp::Save).count, 5u);
+        EXPECT_EQ(s.op(StatOp::FindById).count, 1u);
+        EXPECT_EQ(s.op(StatOp::Delete).count, 1u);
+        EXPECT_EQ(s.op(StatOp::FindAll).count, 1u);
+        EXPECT_EQ(s.op(StatOp::LockWait).count, 8u);
+        EXPECT_EQ(s.op(StatOp::Sync).count, 6u); // Strict: one msync per write
+        EXPECT_GE(s.counter(StatCounter::CacheHits), 6u);
+        EXPECT_EQ(s.counter(StatCounter::TailLoads), 1u);
+        EXPECT_EQ(s.counter(StatCounter::Reloads), 1u); // The initial load
+        EXPECT_GE(s.counter(StatCounter::Remaps), 1u);
+        EXPECT_GT(s.op(StatOp::Save).percentileNs(0.5), 0u);
+        EXPECT_EQ(hooked, 22u);
+
+        repo.resetStats();
+        EXPECT_EQ(repo.stats().op(StatOp::Save).count, 0u);
+#else
+        EXPECT_FALSE(s.enabled);
+        EXPECT_EQ(s.op(StatOp::Save).count, 0u);
+        EXPECT_EQ(hooked, 0u);
+#endif
+    }
+    ::remove(path.c_str());
+    ::remove((path + ".ctl").c_str());
+}
+
+// =============================================================================
+// Parallel Scan Tests
+// =============================================================================
+
+class FixedParallelScanTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_parallel_scan.db";
+        ::remove(testFile_.c_str());
+    }
+
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    static FixedRepositoryOptions parallelOptions() {
+        FixedRepositoryOptions opts;
+        opts.deleteMode = DeleteMode::Tombstone;
+        opts.scanThreads = 4;
+        opts.scanMinRecordsPerThread = 1;
+        return opts;
+    }
+
+    /// @brief 1000 records with age == ID, every 7th deleted (tombstoned)
+    void populate() {
+        FixedRepositoryOptions opts;
+        opts.deleteMode = DeleteMode::Tombstone;
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_);
+        std::vector<FixedA> recs;
+        for (int i = 0; i < 1000; ++i)
+            recs.emplace_back("user", i, std::to_string(i).c_str());
+        std::vector<const FixedA*> ptrs;
+        for (const auto& r : recs)
+            ptrs.push_back(&r);
+        ASSERT_TRUE(repo.saveAll(ptrs, ec_));
+        for (int i = 0; i < 1000; i += 7)
+            ASSERT_TRUE(repo.deleteById(std::to_string(i), ec_));
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: FixedParallelScanTest 그룹의 RebuildMatchesSerialScan 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedParallelScanTest, RebuildMatchesSerialScan) {
+    populate();
+
+    FixedRepositoryOptions serialOpts;
+    serialOpts.deleteMode = DeleteMode::Tombstone;
+    UniformFixedRepositoryImpl<FixedA> serial(testFile_, serialOpts, ec_);
+    ASSERT_FALSE(ec_);
+    UniformFixedRepositoryImpl<FixedA> parallel(testFile_, parallelOptions(), ec_);
+    ASSERT_FALSE(ec_);
+
+    EXPECT_EQ(parallel.count(ec_), serial.count(ec_));
+    EXPECT_EQ(parallel.count(ec_), 857u);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string id = std::to_string(i);
+        auto found = parallel.findById(id, ec_);
+        if (i % 7 == 0) {
+            EXPECT_EQ(found, nullptr) << id;
+        } else {
+            ASSERT_NE(found, nullptr) << id;
+            EXPECT_EQ(found->age, i);
+        }
+    }
+
+    // findAll keeps slot order
+    auto all = parallel.findAll(ec_);
+    ASSERT_FALSE(ec_);
+    auto expected = serial.findAll(ec_);
+    ASSERT_EQ(all.size(), expected.size());
+    for (size_t i = 0; i < all.size(); ++i)
+        EXPECT_EQ(all[i]->getId(), expected[i]->getId());
+
+    // The free-slot order is the serial one too: the first insert reuses slot 0
+    FixedA fresh("fresh", 1, "fresh");
+    ASSERT_TRUE(parallel.save(fresh, ec_));
+    auto first = parallel.findAll(ec_);
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(first.front()->getId(), "fresh");
+}
+
+// 시나리오 상세 설명: FixedParallelScanTest 그룹의 ParallelForEachVisitsEveryRecordOnce 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedParallelScanTest, ParallelForEachVisitsEveryRecordOnce) {
+    populate();
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, parallelOptions(), ec_);
+    ASSERT_FALSE(ec_);
+
+    std::vector<std::atomic<int>> seen(1000);
+    std::atomic<int64_t> ageSum{0};
+    ASSERT_TRUE(repo.parallelForEach(
+        [&](const RecordView<FixedA>& v) {
+            std::error_code fec;
+            const int64_t age = v.num("age", fec);
+            seen[static_cast<size_t>(age)].fetch_add(1);
+            ageSum.fetch_add(age);
+        },
+        ec_, 4));
+
+    int64_t expectedSum = 0;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(seen[i].load(), i % 7 == 0 ? 0 : 1) << i;
+        if (i % 7 != 0)
+            expectedSum += i;
+    }
+    EXPECT_EQ(ageSum.load(), expectedSum);
+
+    // Returning false stops every thread well before the end
+    std::atomic<int> visited{0};
+    ASSERT_TRUE(repo.parallelForEach(
+        [&](const RecordView<FixedA>&) { return visited.fetch_add(1) < 10; }, ec_, 4));
+    EXPECT_LT(visited.load(), 857);
+}
+
+// 시나리오 상세 설명: FixedParallelScanTest 그룹의 CorruptSlotFailsParallelRebuild 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedParallelScanTest, CorruptSlotFailsParallelRebuild) {
+    populate();
+    const size_t recordSize = FixedA().recordSize();
+
+    // Break the sign of the numeric field of slot 900 (in the last range)
+    {
+        int fd = ::open(testFile_.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        std::vector<char> buf(recordSize);
+        const off_t at = static_cast<off_t>(900 * recordSize);
+        ASSERT_EQ(::pread(fd, buf.data(), recordSize, at), static_cast<ssize_t>(recordSize));
+        for (auto& c : buf) {
+            if (c == '+') {
+                c = 'x';
+                break;
+            }
+        }
+        ASSERT_EQ(::pwrite(fd, buf.data(), recordSize, at), static_cast<ssize_t>(recordSize));
+        ::close(fd);
+    }
+
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, parallelOptions(), ec_);
+    EXPECT_TRUE(ec_) << "Parallel rebuild should report the corrupt slot";
+}
+
+// =============================================================================
+// Sharded Repository Tests
+// =============================================================================
+
+class FixedShardedRepositoryTest : public ::testing::Test {
+  protected:
+    using Sharded = ShardedRepository<FixedA, UniformFixedRepositoryImpl<FixedA>>;
+
+    void SetUp() override {
+        base_ = "test_fixed_sharded.db";
+        cleanup();
+    }
+
+    void TearDown() override { cleanup(); }
+
+    /// @brief Remove the manifest and every shard file
+    void cleanup() {
+        std::error_code fec;
+        for (std::filesystem::directory_iterator it(".", fec), end; !fec && it != end;
+             it.increment(fec)) {
+            if (it->path().filename().string().compare(0, base_.size(), base_) == 0)
+                std::filesystem::remove(it->path(), fec);
+        }
+    }
+
+    std::unique_ptr<Sharded> open(size_t shards) {
+        ShardedRepositoryOptions opts;
+        opts.shardCount = shards;
+        return std::make_unique<Sharded>(base_, nullptr, opts, ec_);
+    }
+
+    /// @brief Records with IDs 0 .. n-1 (age == ID)
+    static std::vector<FixedA> makeRecords(int n) {
+        std::vector<FixedA> recs;
+        for (int i = 0; i < n; ++i)
+            recs.emplace_back("user", i, std::to_string(i).c_str());
+        return recs;
+    }
+
+    static std::vector<const FixedA*> pointers(const std::vector<FixedA>& recs) {
+        std::vector<const FixedA*> ptrs;
+        for (const auto& r : recs)
+            ptrs.push_back(&r);
+        return ptrs;
+    }
+
+    /// @brief Every record is stored in exactly the shard its ID routes to
+    void expectRouted(Sharded& repo, int n) {
+        for (int i = 0; i < n; ++i) {
+            const std::string id = std::to_string(i);
+            for (size_t s = 0; s < repo.shardCount(); ++s)
+                EXPECT_EQ(repo.shard(s).existsById(id, ec_), s == repo.shardOf(id)) << id;
+        }
+    }
+
+    std::string base_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 RoutesByIdAndFansOut 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, RoutesByIdAndFansOut) {
+    auto repo = open(3);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo->shardCount(), 3u);
+    EXPECT_EQ(repo->generation(), 0u);
+
+    const auto recs = makeRecords(200);
+    ASSERT_TRUE(repo->saveAll(pointers(recs), ec_)) << ec_.message();
+    ASSERT_TRUE(repo->save(FixedA("late", 999, "999"), ec_));
+    EXPECT_EQ(repo->count(ec_), 201u);
+    expectRouted(*repo, 200);
+
+    // Every shard got a share
+    for (size_t s = 0; s < 3; ++s)
+        EXPECT_GT(repo->shard(s).count(ec_), 0u);
+
+    auto all = repo->findAll(ec_);
+    ASSERT_FALSE(ec_);
+    std::set<int64_t> ages;
+    for (const auto& r : all)
+        ages.insert(r->age);
+    EXPECT_EQ(ages.size(), 201u);
+
+    auto found = repo->findById("123", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 123);
+    EXPECT_TRUE(repo->existsById("999", ec_));
+
+    ASSERT_TRUE(repo->deleteById("123", ec_));
+    EXPECT_FALSE(repo->existsById("123", ec_));
+    EXPECT_EQ(repo->count(ec_), 200u);
+
+    ASSERT_TRUE(repo->deleteAll(ec_));
+    EXPECT_EQ(repo->count(ec_), 0u);
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 ReopenKeepsManifestLayout 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, ReopenKeepsManifestLayout) {
+    const auto recs = makeRecords(50);
+    {
+        auto repo = open(3);
+        ASSERT_FALSE(ec_) << ec_.message();
+        ASSERT_TRUE(repo->saveAll(pointers(recs), ec_));
+    }
+
+    // shardCount only applies to a new repository
+    auto repo = open(7);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo->shardCount(), 3u);
+    EXPECT_EQ(repo->count(ec_), 50u);
+    expectRouted(*repo, 50);
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 ReshardMovesRecordsAndRemovesOldFiles 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, ReshardMovesRecordsAndRemovesOldFiles) {
+    auto repo = open(2);
+    ASSERT_FALSE(ec_) << ec_.message();
+    const auto recs = makeRecords(300);
+    ASSERT_TRUE(repo->saveAll(pointers(recs), ec_));
+
+    ASSERT_TRUE(repo->reshard(5, ec_)) << ec_.message();
+    EXPECT_EQ(repo->shardCount(), 5u);
+    EXPECT_EQ(repo->generation(), 1u);
+    EXPECT_EQ(repo->count(ec_), 300u);
+    expectRouted(*repo, 300);
+    for (size_t s = 0; s < 2; ++s)
+        EXPECT_FALSE(std::filesystem::exists(Sharded::shardPath(base_, 0, s)));
+    for (size_t s = 0; s < 5; ++s)
+        EXPECT_TRUE(std::filesystem::exists(Sharded::shardPath(base_, 1, s)));
+
+    // Same count: nothing to do
+    ASSERT_TRUE(repo->reshard(5, ec_));
+    EXPECT_EQ(repo->generation(), 1u);
+
+    EXPECT_FALSE(repo->reshard(0, ec_));
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+    // Shrink back down, then reopen from the manifest
+    ASSERT_TRUE(repo->reshard(1, ec_)) << ec_.message();
+    repo.reset();
+    repo = open(4);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo->shardCount(), 1u);
+    EXPECT_EQ(repo->generation(), 2u);
+    auto found = repo->findById("299", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 299);
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 ReshardRemovesLeftoversOfInterruptedRun 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, ReshardRemovesLeftoversOfInterruptedRun) {
+    auto repo = open(2);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_TRUE(repo->save(FixedA("a", 1, "1"), ec_));
+
+    // A reshard that died before replacing the manifest left a stale record in generation 1
+    {
+        UniformFixedRepositoryImpl<FixedA> stale(Sharded::shardPath(base_, 1, 0), ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(stale.save(FixedA("stale", 7, "7"), ec_));
+    }
+
+    ASSERT_TRUE(repo->reshard(3, ec_)) << ec_.message();
+    EXPECT_EQ(repo->count(ec_), 1u);
+    EXPECT_FALSE(repo->existsById("7", ec_));
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 OtherProcessFollowsReshard 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, OtherProcessFollowsReshard) {
+    auto repo = open(2);
+    ASSERT_FALSE(ec_) << ec_.message();
+    const auto recs = makeRecords(100);
+    ASSERT_TRUE(repo->saveAll(pointers(recs), ec_));
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        std::error_code cec;
+        ShardedRepositoryOptions opts;
+        Sharded other(base_, nullptr, opts, cec);
+        bool ok = !cec && other.reshard(4, cec) && other.save(FixedA("child", 500, "500"), cec);
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // The next operation notices the new manifest and switches to its shard set
+    EXPECT_EQ(repo->count(ec_), 101u);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo->shardCount(), 4u);
+    EXPECT_EQ(repo->generation(), 1u);
+    EXPECT_TRUE(repo->existsById("500", ec_));
+    ASSERT_TRUE(repo->save(FixedA("parent", 501, "501"), ec_));
+    expectRouted(*repo, 100);
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 ReshardWaitsForInstanceOnOtherThread 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, ReshardWaitsForInstanceOnOtherThread) {
+    auto repo = open(2);
+    ASSERT_FALSE(ec_) << ec_.message();
+    const auto recs = makeRecords(2000);
+    ASSERT_TRUE(repo->saveAll(pointers(recs), ec_));
+
+    // One instance per thread: saves must land in a shard set the reshard has not copied yet
+    constexpr int kSaves = 400;
+    std::atomic<bool> saverOk{true};
+    std::thread saver([&] {
+        std::error_code sec;
+        auto other = open(2);
+        if (ec_) {
+            saverOk = false;
+            return;
+        }
+        for (int i = 0; i < kSaves; ++i) {
+            const std::string id = std::to_string(10000 + i);
+            if (!other->save(FixedA("saver", 10000 + i, id.c_str()), sec))
+                saverOk = false;
+        }
+    });
+    for (size_t shards : {5u, 3u, 7u, 4u}) {
+        std::error_code rec;
+        EXPECT_TRUE(repo->reshard(shards, rec)) << rec.message();
+    }
+    saver.join();
+    ASSERT_TRUE(saverOk.load());
+
+    EXPECT_EQ(repo->count(ec_), 2000u + kSaves);
+    for (int i = 0; i < kSaves; ++i)
+        EXPECT_TRUE(repo->existsById(std::to_string(10000 + i), ec_)) << i;
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 SaveAllRejectsNullRecord 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, SaveAllRejectsNullRecord) {
+    auto repo = open(3);
+    ASSERT_FALSE(ec_) << ec_.message();
+    FixedA alice("alice", 25, "001");
+    std::vector<const FixedA*> batch = {&alice, nullptr};
+
+    EXPECT_FALSE(repo->saveAll(batch, ec_));
+    EXPECT_EQ(ec_, std::make_error_code(std::errc::invalid_argument));
+    EXPECT_EQ(repo->count(ec_), 0u);
+}
+
+// 시나리오 상세 설명: FixedShardedRepositoryTest 그룹의 SerialFanOutMatchesParallel 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedShardedRepositoryTest, SerialFanOutMatchesParallel) {
+    const auto recs = makeRecords(120);
+    {
+        auto repo = open(4);
+        ASSERT_FALSE(ec_) << ec_.message();
+        ASSERT_TRUE(repo->saveAll(pointers(recs), ec_));
+    }
+
+    ShardedRepositoryOptions serial;
+    serial.parallelFanOut = false;
+    Sharded repo(base_, nullptr, serial, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo.count(ec_), 120u);
+    EXPECT_EQ(repo.findAll(ec_).size(), 120u);
+    auto parallel = open(4);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(parallel->findAll(ec_).size(), 120u);
+}
+
 // =============================================================================
-// FixedB Repository Tests
+// Secondary Index Tests
 // =============================================================================
 
-class FixedBRepositoryTest : public ::testing::Test {
+class FixedFieldIndexTest : public ::testing::Test {
   protected:
     void SetUp() override {
-        testFile_ = "./test_fixed_b.db";
+        testFile_ = "./test_fixed_field_index.db";
         ::remove(testFile_.c_str());
-        repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedB>>(testFile_, ec_);
-        ASSERT_FALSE(ec_) << "Repository init failed: " << ec_.message();
     }
 
     void TearDown() override {
-        repo_.reset();
         ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    /// @brief Hash index on name, ordered index on age
+    static FixedRepositoryOptions indexedOptions(DeleteMode mode = DeleteMode::Tombstone) {
+        FixedRepositoryOptions opts;
+        opts.deleteMode = mode;
+        opts.fieldIndexes = {{"name", FieldIndexKind::Hash}, {"age", FieldIndexKind::Ordered}};
+        return opts;
+    }
+
+    /// @brief IDs 0 .. n-1 with age == ID and name "group<ID % 5>"
+    static std::vector<FixedA> makeRecords(int n) {
+        std::vector<FixedA> recs;
+        for (int i = 0; i < n; ++i)
+            recs.emplace_back(("group" + std::to_string(i % 5)).c_str(), i,
+                              std::to_string(i).c_str());
+        return recs;
+    }
+
+    static std::vector<const FixedA*> pointers(const std::vector<FixedA>& recs) {
+        std::vector<const FixedA*> ptrs;
+        for (const auto& r : recs)
+            ptrs.push_back(&r);
+        return ptrs;
+    }
+
+    static std::vector<int64_t> ages(const std::vector<std::unique_ptr<FixedA>>& recs) {
+        std::vector<int64_t> out;
+        for (const auto& r : recs)
+            out.push_back(r->age);
+        return out;
     }
 
     std::string testFile_;
     std::error_code ec_;
-    std::unique_ptr<UniformFixedRepositoryImpl<FixedB>> repo_;
 };
 
-// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 InsertMultipleRecords 케이스 동작을 검증한다.
+// 시나리오 상세 설명: FixedFieldIndexTest 그룹의 EqualityAndRangeQueries 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
-TEST_F(FixedBRepositoryTest, InsertMultipleRecords) {
-    FixedB laptop("Laptop", 1500000, "P001");
-    FixedB phone("Phone", 800000, "P002");
-    FixedB tablet("Tablet", 500000, "P003");
+TEST_F(FixedFieldIndexTest, EqualityAndRangeQueries) {
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, indexedOptions(), ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    const auto recs = makeRecords(100);
+    ASSERT_TRUE(repo.saveAll(pointers(recs), ec_));
+
+    auto group3 = repo.findByField("name", "group3", ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_EQ(group3.size(), 20u);
+    for (size_t k = 0; k < group3.size(); ++k)
+        EXPECT_EQ(group3[k]->age, static_cast<int64_t>(3 + 5 * k)); // Slot order
+    EXPECT_TRUE(repo.findByField("name", "nobody", ec_).empty());
+    EXPECT_FALSE(ec_);
+
+    EXPECT_EQ(ages(repo.findInRange("age", 10, 14, ec_)),
+              (std::vector<int64_t>{10, 11, 12, 13, 14}));
+    EXPECT_EQ(ages(repo.findInRange("age", 95, 1000, ec_)),
+              (std::vector<int64_t>{95, 96, 97, 98, 99}));
+    EXPECT_TRUE(repo.findInRange("age", 200, 300, ec_).empty());
+    EXPECT_EQ(ages(repo.findByField("age", 42, ec_)), (std::vector<int64_t>{42}));
+
+    // Sessions hand out views of the mapped slots
+    auto session = repo.readSession(ec_);
+    ASSERT_TRUE(session.valid());
+    auto views = session.findInRange("age", 20, 29, ec_);
+    ASSERT_FALSE(ec_);
+    ASSERT_EQ(views.size(), 10u);
+    for (size_t k = 0; k < views.size(); ++k) {
+        std::error_code vec;
+        EXPECT_EQ(views[k].num("age", vec), static_cast<int64_t>(20 + k));
+        EXPECT_EQ(views[k].str("name"), "group" + std::to_string(k % 5));
+    }
+    auto named = session.findByField("name", "group0", ec_);
+    ASSERT_EQ(named.size(), 20u);
+    EXPECT_EQ(named.front().id(), "0");
+}
 
-    ASSERT_TRUE(repo_->save(laptop, ec_));
-    ASSERT_TRUE(repo_->save(phone, ec_));
-    ASSERT_TRUE(repo_->save(tablet, ec_));
+// 시나리오 상세 설명: FixedFieldIndexTest 그룹의 MaintainedByEveryWrite 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedFieldIndexTest, MaintainedByEveryWrite) {
+    for (DeleteMode mode : {DeleteMode::Tombstone, DeleteMode::Compact}) {
+        SCOPED_TRACE(mode == DeleteMode::Tombstone ? "tombstone" : "compact");
+        ::remove(testFile_.c_str());
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, indexedOptions(mode), ec_);
+        ASSERT_FALSE(ec_) << ec_.message();
+        const auto recs = makeRecords(20);
+        ASSERT_TRUE(repo.saveAll(pointers(recs), ec_));
+
+        // Update in place: the old value no longer matches
+        ASSERT_TRUE(repo.save(FixedA("moved", 500, "7"), ec_));
+        EXPECT_EQ(repo.findByField("name", "group2", ec_).size(), 3u);
+        EXPECT_EQ(ages(repo.findByField("name", "moved", ec_)), (std::vector<int64_t>{500}));
+        EXPECT_TRUE(repo.findByField("age", 7, ec_).empty());
+
+        // Batch with an update, an insert and a duplicate (last one wins)
+        FixedA u("group0", 1001, "3"), n1("fresh", 30, "30"), n2("fresh", 31, "30");
+        ASSERT_TRUE(repo.saveAll({&u, &n1, &n2}, ec_));
+        EXPECT_EQ(ages(repo.findByField("name", "fresh", ec_)), (std::vector<int64_t>{31}));
+        EXPECT_EQ(ages(repo.findInRange("age", 1000, 2000, ec_)), (std::vector<int64_t>{1001}));
+        EXPECT_EQ(repo.findByField("name", "group0", ec_).size(), 5u);
+
+        // Deletes (compact mode also renumbers the slots above)
+        ASSERT_TRUE(repo.deleteById("0", ec_));
+        ASSERT_TRUE(repo.deleteById("30", ec_));
+        EXPECT_TRUE(repo.findByField("name", "fresh", ec_).empty());
+        EXPECT_EQ(ages(repo.findInRange("age", 0, 6, ec_)),
+                  (std::vector<int64_t>{1, 2, 4, 5, 6}));
+        EXPECT_EQ(ages(repo.findByField("name", "group4", ec_)),
+                  (std::vector<int64_t>{4, 9, 14, 19}));
+
+        // Compaction moves records, then every slot is freed
+        ASSERT_TRUE(repo.compact(ec_));
+        EXPECT_EQ(ages(repo.findInRange("age", 17, 19, ec_)), (std::vector<int64_t>{17, 18, 19}));
+        ASSERT_TRUE(repo.deleteAll(ec_));
+        EXPECT_TRUE(repo.findInRange("age", INT64_MIN, INT64_MAX, ec_).empty());
+        EXPECT_TRUE(repo.findByField("name", "group1", ec_).empty());
+    }
+}
 
-    EXPECT_EQ(repo_->count(ec_), 3);
+// 시나리오 상세 설명: FixedFieldIndexTest 그룹의 RebuiltAfterReopenAndExternalWrites 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedFieldIndexTest, RebuiltAfterReopenAndExternalWrites) {
+    FixedRepositoryOptions plainOpts;
+    plainOpts.deleteMode = DeleteMode::Tombstone;
+    {
+        UniformFixedRepositoryImpl<FixedA> plain(testFile_, plainOpts, ec_);
+        ASSERT_FALSE(ec_);
+        const auto recs = makeRecords(10);
+        ASSERT_TRUE(plain.saveAll(pointers(recs), ec_));
+    }
+
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, indexedOptions(), ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_EQ(repo.findByField("name", "group1", ec_).size(), 2u);
+
+    // Another writer updates a record in place and appends one: the file only grew, but the
+    // field indexes must still see the update
+    {
+        UniformFixedRepositoryImpl<FixedA> other(testFile_, plainOpts, ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(other.save(FixedA("changed", 77, "5"), ec_));
+        ASSERT_TRUE(other.save(FixedA("group1", 78, "10"), ec_));
+    }
+    EXPECT_EQ(ages(repo.findByField("name", "changed", ec_)), (std::vector<int64_t>{77}));
+    EXPECT_EQ(ages(repo.findByField("name", "group0", ec_)), (std::vector<int64_t>{0}));
+    EXPECT_EQ(ages(repo.findByField("name", "group1", ec_)), (std::vector<int64_t>{1, 6, 78}));
+    EXPECT_EQ(ages(repo.findInRange("age", 70, 80, ec_)), (std::vector<int64_t>{77, 78}));
 }
 
-// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 FindAll 케이스 동작을 검증한다.
+// 시나리오 상세 설명: FixedFieldIndexTest 그룹의 RejectsUnindexedFields 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
-TEST_F(FixedBRepositoryTest, FindAll) {
-    FixedB laptop("Laptop", 1500000, "P001");
-    FixedB phone("Phone", 800000, "P002");
-    repo_->save(laptop, ec_);
-    repo_->save(phone, ec_);
+TEST_F(FixedFieldIndexTest, RejectsUnindexedFields) {
+    FixedRepositoryOptions bad;
+    bad.fieldIndexes = {{"missing", FieldIndexKind::Hash}};
+    UniformFixedRepositoryImpl<FixedA> unknown(testFile_, bad, ec_);
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+    bad.fieldIndexes = {{"name", FieldIndexKind::Ordered}}; // Ranges need a numeric field
+    UniformFixedRepositoryImpl<FixedA> orderedString(testFile_, bad, ec_);
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+    FixedRepositoryOptions opts;
+    opts.fieldIndexes = {{"age", FieldIndexKind::Hash}};
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_TRUE(repo.save(FixedA("a", 1, "1"), ec_));
+
+    EXPECT_EQ(repo.findByField("age", 1, ec_).size(), 1u);
+    EXPECT_FALSE(ec_);
+    repo.findInRange("age", 0, 5, ec_); // Hash index: no ranges
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+    repo.findByField("name", "a", ec_); // No index on name
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+    repo.findByField("age", "1", ec_); // String lookup on a numeric field
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+
+    UniformFixedRepositoryImpl<FixedA>::ReadSession closed;
+    EXPECT_TRUE(closed.findByField("age", 1, ec_).empty());
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+}
 
-    auto all = repo_->findAll(ec_);
-    ASSERT_EQ(all.size(), 2);
+// =============================================================================
+// Mapping Hint Tests
+// =============================================================================
 
-    // Verify content
-    bool foundLaptop = false, foundPhone = false;
-    for (const auto& rec : all) {
-        if (std::string(rec->title) == "Laptop")
-            foundLaptop = true;
-        if (std::string(rec->title) == "Phone")
-            foundPhone = true;
+class FixedMappingOptionsTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_mapping.db";
+        removeFiles();
+    }
+
+    void TearDown() override { removeFiles(); }
+
+    void removeFiles() {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".idx").c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    /// @brief Saves, grows, deletes and compacts, then checks every read path
+    void exercise(const FixedRepositoryOptions& opts) {
+        {
+            UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+            ASSERT_FALSE(ec_) << ec_.message();
+            std::vector<FixedA> recs;
+            for (int i = 0; i < 300; ++i)
+                recs.emplace_back("user", i, std::to_string(i).c_str());
+            std::vector<const FixedA*> ptrs;
+            for (const auto& r : recs)
+                ptrs.push_back(&r);
+            ASSERT_TRUE(repo.saveAll(ptrs, ec_)) << ec_.message();
+            for (int i = 0; i < 300; i += 3)
+                ASSERT_TRUE(repo.deleteById(std::to_string(i), ec_)) << ec_.message();
+            ASSERT_TRUE(repo.compact(ec_)) << ec_.message();
+            FixedA extra("extra", 1000, "1000");
+            ASSERT_TRUE(repo.save(extra, ec_)) << ec_.message(); // Remaps the grown file
+        }
+
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_) << ec_.message();
+        auto all = repo.findAll(ec_);
+        ASSERT_FALSE(ec_) << ec_.message();
+        ASSERT_EQ(all.size(), 201u);
+        EXPECT_EQ(all.front()->age, 1);
+        EXPECT_EQ(all.back()->age, 1000);
+
+        auto found = repo.findById("299", ec_);
+        ASSERT_TRUE(found);
+        EXPECT_EQ(found->age, 299);
+        EXPECT_FALSE(repo.findById("3", ec_));
+
+        int64_t sum = 0;
+        ASSERT_TRUE(repo.forEach(
+            [&](const RecordView<FixedA>& v) {
+                std::error_code vec;
+                sum += v.num("age", vec);
+            },
+            ec_));
+        std::atomic<int64_t> parallelSum{0};
+        ASSERT_TRUE(repo.parallelForEach(
+            [&](const RecordView<FixedA>& v) {
+                std::error_code vec;
+                parallelSum += v.num("age", vec);
+            },
+            ec_, 2));
+        int64_t expected = 1000;
+        for (int i = 0; i < 300; ++i)
+            expected += i % 3 != 0 ? i : 0;
+        EXPECT_EQ(sum, expected);
+        EXPECT_EQ(parallelSum.load(), expected);
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: FixedMappingOptionsTest 그룹의 HintsKeepResultsUnchanged 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedMappingOptionsTest, HintsKeepResultsUnchanged) {
+    for (AccessPattern pattern :
+         {AccessPattern::Normal, AccessPattern::Sequential, AccessPattern::Random}) {
+        for (bool all : {false, true}) {
+            SCOPED_TRACE(static_cast<int>(pattern) * 2 + all);
+            removeFiles();
+            FixedRepositoryOptions opts;
+            opts.deleteMode = DeleteMode::Tombstone;
+            opts.growChunkRecords = 64;
+            opts.scanThreads = 2;
+            opts.scanMinRecordsPerThread = 16;
+            opts.mapping.pattern = pattern;
+            opts.mapping.scanHints = all;
+            opts.mapping.populate = all;
+            opts.mapping.hugePages = all;
+            opts.mapping.lockIndex = all;
+            opts.persistentIndex = all;
+            exercise(opts);
+        }
     }
-    EXPECT_TRUE(foundLaptop);
-    EXPECT_TRUE(foundPhone);
 }
 
-// 시나리오 상세 설명: FixedBRepositoryTest 그룹의 UpdateExistingRecord 케이스 동작을 검증한다.
+// 시나리오 상세 설명: FixedMappingOptionsTest 그룹의 PinsPersistentIndex 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
-TEST_F(FixedBRepositoryTest, UpdateExistingRecord) {
-    FixedB phone("Phone", 800000, "P001");
-    repo_->save(phone, ec_);
+TEST_F(FixedMappingOptionsTest, PinsPersistentIndex) {
+    {
+        // Pinning is best effort: skip where this process may not lock a page
+        detail::MmapGuard probe(::mmap(nullptr, 4096, PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0),
+                                4096);
+        if (!probe.lock())
+            GTEST_SKIP() << "mlock not permitted (RLIMIT_MEMLOCK)";
+    }
 
-    // Update price (discount!)
-    FixedB discountedPhone("Phone", 750000, "P001");
-    ASSERT_TRUE(repo_->save(discountedPhone, ec_));
+    FixedRepositoryOptions opts;
+    opts.persistentIndex = true;
+    {
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_) << ec_.message();
+        EXPECT_FALSE(repo.indexPinned()); // Not requested
+    }
 
-    EXPECT_EQ(repo_->count(ec_), 1);
+    opts.mapping.lockIndex = true;
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_TRUE(repo.indexPinned());
 
-    auto found = repo_->findById("P001", ec_);
+    // The sidecar is remapped as it grows; each new mapping is pinned again
+    for (int i = 0; i < 2000; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo.save(rec, ec_)) << ec_.message();
+    }
+    EXPECT_TRUE(repo.indexPinned());
+    EXPECT_EQ(repo.count(ec_), 2000u);
+
+    // Without a sidecar there is nothing to pin
+    FixedRepositoryOptions memOnly;
+    memOnly.mapping.lockIndex = true;
+    UniformFixedRepositoryImpl<FixedA> plain(testFile_ + ".plain", memOnly, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    EXPECT_FALSE(plain.indexPinned());
+    ::remove((testFile_ + ".plain").c_str());
+}
+
+// =============================================================================
+// Durability Tests
+// =============================================================================
+
+class FixedDurabilityTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_durability.db";
+        ::remove(testFile_.c_str());
+    }
+
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: FixedDurabilityTest 그룹의 StrictWritesAreDurableImmediately 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedDurabilityTest, StrictWritesAreDurableImmediately) {
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(repo.lastWriteTicket(), 0u);
+
+    FixedA rec("strict", 1, "001");
+    ASSERT_TRUE(repo.save(rec, ec_));
+    uint64_t ticket = repo.lastWriteTicket();
+    EXPECT_EQ(ticket, 1u);
+    EXPECT_TRUE(repo.waitDurable(ticket, ec_));
+    EXPECT_FALSE(ec_);
+}
+
+// 시나리오 상세 설명: FixedDurabilityTest 그룹의 AsyncFlushPersistsData 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedDurabilityTest, AsyncFlushPersistsData) {
+    FixedRepositoryOptions opts;
+    opts.durability = Durability::Async;
+    {
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_);
+        for (int i = 0; i < 5; ++i) {
+            FixedA rec("async", i, std::to_string(i).c_str());
+            ASSERT_TRUE(repo.save(rec, ec_));
+        }
+        ASSERT_TRUE(repo.deleteById("3", ec_));
+        EXPECT_GT(repo.lastWriteTicket(), 5u);
+        EXPECT_TRUE(repo.flush(ec_)) << ec_.message();
+    }
+
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened.count(ec_), 4);
+}
+
+// 시나리오 상세 설명: FixedDurabilityTest 그룹의 AsyncUpdatesSeenByOtherInstance 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedDurabilityTest, AsyncUpdatesSeenByOtherInstance) {
+    FixedRepositoryOptions opts;
+    opts.durability = Durability::Async;
+    opts.fieldIndexes = {{"age", FieldIndexKind::Ordered}};
+    UniformFixedRepositoryImpl<FixedA> writer(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_TRUE(writer.save(FixedA("alice", 1, "001"), ec_));
+
+    UniformFixedRepositoryImpl<FixedA> reader(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    ASSERT_EQ(reader.findByField("age", int64_t{1}, ec_).size(), 1u);
+
+    // Same size, and the page is still dirty: only the generation shows the update
+    for (int64_t age = 2; age <= 4; ++age) {
+        ASSERT_TRUE(writer.save(FixedA("alice", age, "001"), ec_));
+        auto found = reader.findByField("age", age, ec_);
+        ASSERT_FALSE(ec_) << ec_.message();
+        EXPECT_EQ(found.size(), 1u) << age;
+        EXPECT_TRUE(reader.findByField("age", age - 1, ec_).empty()) << age;
+    }
+}
+
+// 시나리오 상세 설명: FixedDurabilityTest 그룹의 GroupCommitWaitDurable 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FixedDurabilityTest, GroupCommitWaitDurable) {
+    FixedRepositoryOptions opts;
+    opts.durability = Durability::GroupCommit;
+    opts.groupCommit.interval = std::chrono::milliseconds(1000);
+    opts.groupCommit.maxPendingWrites = 1000;
+    {
+        UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec_);
+        ASSERT_FALSE(ec_);
+        for (int i = 0; i < 20; ++i) {
+            FixedA rec("group", i, std::to_string(i).c_str());
+            ASSERT_TRUE(repo.save(rec, ec_));
+        }
+        uint64_t ticket = repo.lastWriteTicket();
+        EXPECT_EQ(ticket, 20u);
+
+        // waitDurable wakes the flusher early instead of waiting for the interval
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(repo.waitDurable(ticket, ec_)) << ec_.message();
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(900));
+
+        FixedA last("group", 99, "099");
+        ASSERT_TRUE(repo.save(last, ec_));
+        // Destructor flushes the pending write
+    }
+
+    UniformFixedRepositoryImpl<FixedA> reopened(testFile_, ec_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened.count(ec_), 21);
+}
+
+// =============================================================================
+// Persistent Index Tests
+// =============================================================================
+
+class PersistentIndexTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_fixed_sidecar.db";
+        indexFile_ = testFile_ + ".idx";
+        ::remove(testFile_.c_str());
+        ::remove(indexFile_.c_str());
+        options_.persistentIndex = true;
+    }
+
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove(indexFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
+
+    std::unique_ptr<UniformFixedRepositoryImpl<FixedA>> open() {
+        auto repo = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, options_, ec_);
+        EXPECT_FALSE(ec_) << ec_.message();
+        return repo;
+    }
+
+    std::string testFile_;
+    std::string indexFile_;
+    std::error_code ec_;
+    FixedRepositoryOptions options_;
+};
+
+// 시나리오 상세 설명: PersistentIndexTest 그룹의 ReopenAdoptsCurrentSidecar 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(PersistentIndexTest, ReopenAdoptsCurrentSidecar) {
+    {
+        auto repo = open();
+        for (int i = 0; i < 5; ++i) {
+            FixedA rec("user", i, std::to_string(i).c_str());
+            ASSERT_TRUE(repo->save(rec, ec_));
+        }
+    }
+    struct stat st{};
+    ASSERT_EQ(::stat(indexFile_.c_str(), &st), 0);
+
+    // Corrupt record 0 without changing size or mtime: only a full rebuild would notice
+    ASSERT_EQ(::stat(testFile_.c_str(), &st), 0);
+    FixedA probe;
+    int fd = ::open(testFile_.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pwrite(fd, "X", 1, static_cast<off_t>(probe.fieldOffset(1))), 1);
+    struct timespec times[2] = {st.st_atim, st.st_mtim};
+    ASSERT_EQ(::futimens(fd, times), 0);
+    ::close(fd);
+
+    auto repo = open();
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(repo->count(ec_), 5u);
+    auto found = repo->findById("3", ec_);
     ASSERT_NE(found, nullptr);
-    EXPECT_EQ(found->cost, 750000);
+    EXPECT_EQ(found->age, 3);
+}
+
+// 시나리오 상세 설명: PersistentIndexTest 그룹의 StaleSidecarIsRebuilt 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(PersistentIndexTest, StaleSidecarIsRebuilt) {
+    {
+        auto repo = open();
+        FixedA a("alice", 1, "1");
+        ASSERT_TRUE(repo->save(a, ec_));
+    }
+    {
+        // Writer that does not maintain the sidecar
+        UniformFixedRepositoryImpl<FixedA> plain(testFile_, ec_);
+        ASSERT_FALSE(ec_);
+        FixedA b("bob", 2, "2");
+        ASSERT_TRUE(plain.save(b, ec_));
+        ASSERT_TRUE(plain.deleteById("1", ec_));
+    }
+
+    auto repo = open();
+    EXPECT_EQ(repo->count(ec_), 1u);
+    EXPECT_FALSE(repo->existsById("1", ec_));
+    EXPECT_TRUE(repo->existsById("2", ec_));
+
+    // A torn sidecar (bad header) is rebuilt too
+    repo.reset();
+    int fd = ::open(indexFile_.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pwrite(fd, "garbage!", 8, 0), 8);
+    ::close(fd);
+    repo = open();
+    EXPECT_TRUE(repo->existsById("2", ec_));
+}
+
+// 시나리오 상세 설명: PersistentIndexTest 그룹의 DeletesKeepSidecarValid 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(PersistentIndexTest, DeletesKeepSidecarValid) {
+    for (DeleteMode mode : {DeleteMode::Compact, DeleteMode::Tombstone}) {
+        SetUp();
+        options_.deleteMode = mode;
+        options_.growChunkRecords = 4;
+        {
+            auto repo = open();
+            for (int i = 0; i < 40; ++i) {
+                FixedA rec("user", i, std::to_string(i).c_str());
+                ASSERT_TRUE(repo->save(rec, ec_));
+            }
+            for (int i = 0; i < 40; i += 3)
+                ASSERT_TRUE(repo->deleteById(std::to_string(i), ec_));
+        }
+        {
+            // Reopen from the sidecar, then insert into a reused slot and compact
+            auto repo = open();
+            EXPECT_EQ(repo->count(ec_), 26u);
+            FixedA extra("extra", 99, "extra");
+            ASSERT_TRUE(repo->save(extra, ec_));
+            ASSERT_TRUE(repo->compact(ec_));
+            EXPECT_EQ(repo->count(ec_), 27u);
+        }
+        auto repo = open();
+        for (int i = 0; i < 40; ++i) {
+            auto rec = repo->findById(std::to_string(i), ec_);
+            if (i % 3 == 0) {
+                EXPECT_EQ(rec, nullptr) << i;
+            } else {
+                ASSERT_NE(rec, nullptr) << i;
+                EXPECT_EQ(rec->age, i);
+            }
+        }
+        EXPECT_TRUE(repo->existsById("extra", ec_));
+        repo.reset();
+        TearDown();
+    }
+}
+
+// 시나리오 상세 설명: PersistentIndexTest 그룹의 WritesFromAnotherInstanceAreSeen 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(PersistentIndexTest, WritesFromAnotherInstanceAreSeen) {
+    auto reader = open();
+    auto writer = open();
+
+    FixedA a("alice", 1, "1");
+    ASSERT_TRUE(writer->save(a, ec_));
+    EXPECT_TRUE(reader->existsById("1", ec_));
+
+    FixedA b("bob", 2, "2");
+    ASSERT_TRUE(writer->save(b, ec_));
+    ASSERT_TRUE(writer->deleteById("1", ec_));
+    EXPECT_FALSE(reader->existsById("1", ec_));
+    auto found = reader->findById("2", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "bob");
+    EXPECT_EQ(reader->count(ec_), 1u);
 }
 
 // =============================================================================
@@ -319,6 +2399,7 @@ class ExternalModificationTest : public ::testing::Test {
     void TearDown() override {
         repo_.reset();
         ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
     }
 
     std::string testFile_;
@@ -544,6 +2625,172 @@ TEST_F(ExternalModificationTest, ExternalAppendMultipleRecords) {
     EXPECT_TRUE(repo_->existsById("003", ec_));
 }
 
+// 시나리오 상세 설명: ExternalModificationTest 그룹의 ExternalAppendIndexesOnlyNewSlots 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ExternalModificationTest, ExternalAppendIndexesOnlyNewSlots) {
+    repo_.reset();
+    ::remove(testFile_.c_str());
+    FixedRepositoryOptions opts;
+    opts.controlFile = true;
+    repo_ = std::make_unique<UniformFixedRepositoryImpl<FixedA>>(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    for (int i = 1; i <= 5; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_EQ(repo_->count(ec_), 5u);
+
+    // Corrupt a middle record behind the repositories' backs, then append through a
+    // cooperating instance. Only a full rebuild would parse the corrupt slot.
+    UniformFixedRepositoryImpl<FixedA> other(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    FixedA extra("extra", 6, "6");
+    {
+        int fd = ::open(testFile_.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(::pwrite(fd, "X", 1,
+                           static_cast<off_t>(2 * extra.recordSize() + extra.fieldOffset(1))),
+                  1);
+        ::close(fd);
+    }
+    ASSERT_TRUE(other.save(extra, ec_)) << ec_.message();
+
+    EXPECT_EQ(repo_->count(ec_), 6u);
+    EXPECT_FALSE(ec_);
+    auto found = repo_->findById("6", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 6);
+}
+
+// 시나리오 상세 설명: ExternalModificationTest 그룹의 UnannouncedAppendRebuilds 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ExternalModificationTest, UnannouncedAppendRebuilds) {
+    for (int i = 1; i <= 5; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_EQ(repo_->count(ec_), 5u);
+
+    // Without a control file nothing proves that the growth was a pure append, so the
+    // corrupt middle slot is parsed and reported
+    FixedA extra("extra", 6, "6");
+    const size_t recordSize = extra.recordSize();
+    std::vector<char> buf(recordSize);
+    extra.serialize(buf.data());
+    {
+        int fd = ::open(testFile_.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(::pwrite(fd, "X", 1, static_cast<off_t>(2 * recordSize + extra.fieldOffset(1))),
+                  1);
+        ASSERT_EQ(::pwrite(fd, buf.data(), recordSize, static_cast<off_t>(5 * recordSize)),
+                  static_cast<ssize_t>(recordSize));
+        ::close(fd);
+    }
+
+    repo_->count(ec_);
+    EXPECT_TRUE(ec_);
+}
+
+// 시나리오 상세 설명: ExternalModificationTest 그룹의 ExternalRewriteThenGrowthRebuilds 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ExternalModificationTest, ExternalRewriteThenGrowthRebuilds) {
+    for (int i = 1; i <= 3; ++i) {
+        FixedA rec("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_EQ(repo_->count(ec_), 3u);
+
+    {
+        // Compact-mode delete shifts the prefix; the two saves then grow the file
+        UniformFixedRepositoryImpl<FixedA> other(testFile_, ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(other.deleteById("1", ec_));
+        FixedA d("dave", 4, "4");
+        FixedA e("erin", 5, "5");
+        ASSERT_TRUE(other.save(d, ec_));
+        ASSERT_TRUE(other.save(e, ec_));
+    }
+
+    EXPECT_EQ(repo_->count(ec_), 4u);
+    EXPECT_FALSE(repo_->existsById("1", ec_));
+    for (int i = 2; i <= 5; ++i) {
+        auto rec = repo_->findById(std::to_string(i), ec_);
+        ASSERT_NE(rec, nullptr) << i;
+        EXPECT_EQ(rec->age, i);
+    }
+}
+
+// 시나리오 상세 설명: ExternalModificationTest 그룹의 DetectsSameSizeInPlaceEdit 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ExternalModificationTest, DetectsSameSizeInPlaceEdit) {
+    FixedA alice("alice", 25, "001");
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    ASSERT_EQ(repo_->findById("001", ec_)->age, 25);
+
+    // Same size, and usually within the same second as the save
+    usleep(10000);
+    {
+        FixedA older("alice", 26, "001");
+        std::vector<char> buf(older.recordSize());
+        older.serialize(buf.data());
+        int fd = ::open(testFile_.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(::pwrite(fd, buf.data(), buf.size(), 0), static_cast<ssize_t>(buf.size()));
+        ::close(fd);
+    }
+
+    auto found = repo_->findById("001", ec_);
+    ASSERT_FALSE(ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 26) << "Nanosecond mtime must reveal the rewrite";
+}
+
+// 시나리오 상세 설명: ExternalModificationTest 그룹의 ControlFileSharesWriteGeneration 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ExternalModificationTest, ControlFileSharesWriteGeneration) {
+    repo_.reset();
+    ::remove(testFile_.c_str());
+    FixedRepositoryOptions opts;
+    opts.controlFile = true;
+    UniformFixedRepositoryImpl<FixedA> reader(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+    UniformFixedRepositoryImpl<FixedA> writer(testFile_, opts, ec_);
+    ASSERT_FALSE(ec_) << ec_.message();
+
+    FixedA a("alice", 25, "001");
+    ASSERT_TRUE(writer.save(a, ec_));
+    ASSERT_NE(reader.findById("001", ec_), nullptr);
+
+    // In-place update by the cooperating writer: seen through the generation
+    FixedA a2("alice", 30, "001");
+    ASSERT_TRUE(writer.save(a2, ec_));
+    auto found = reader.findById("001", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 30);
+
+    // A writer outside the protocol is not noticed until a cooperating write bumps the counter
+    {
+        FixedA bob("bob", 40, "002");
+        std::vector<char> buf(bob.recordSize());
+        bob.serialize(buf.data());
+        int fd = ::open(testFile_.c_str(), O_WRONLY | O_APPEND);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(::write(fd, buf.data(), buf.size()), static_cast<ssize_t>(buf.size()));
+        ::close(fd);
+    }
+    EXPECT_EQ(reader.count(ec_), 1u) << "Reads with an unchanged generation skip fstat()";
+
+    FixedA carol("carol", 50, "003");
+    ASSERT_TRUE(writer.save(carol, ec_));
+    EXPECT_EQ(reader.count(ec_), 3u);
+    EXPECT_NE(reader.findById("002", ec_), nullptr);
+}
+
 // =============================================================================
 // Bizarre File Corruption Tests (기상천외한 파일 손상 테스트)
 // =============================================================================
@@ -13,13 +13,26 @@
  * @brief Unit tests for Variable-length record repositories (A, B types)
  */
 
+#include <atomic>
+#include <fcntl.h>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iterator>
 #include <gtest/gtest.h>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 #include "records/A.hpp"
 #include "records/B.hpp"
+#include <fdfile/repository/ShardedRepository.hpp>
 #include <fdfile/repository/VariableFileRepositoryImpl.hpp>
+#include <fdfile/repository/VariableFormatConverter.hpp>
 
 using namespace FdFile;
 
@@ -111,6 +124,43 @@ TEST_F(VariableRepositoryTest, UpdateExistingRecord) {
     EXPECT_EQ(aPtr->name, "alice_updated");
 }
 
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 RewriteReplacesFileAtomically 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, RewriteReplacesFileAtomically) {
+    for (int i = 0; i < 2000; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_EQ(::chmod(testFile_.c_str(), 0600), 0);
+    struct stat before{};
+    ASSERT_EQ(::stat(testFile_.c_str(), &before), 0);
+
+    // A reader holding the old file still sees the complete old contents
+    std::ifstream oldReader(testFile_);
+
+    A updated("renamed", 1000);
+    ASSERT_TRUE(repo_->save(updated, ec_));
+    ASSERT_TRUE(repo_->deleteById("0", ec_));
+
+    struct stat after{};
+    ASSERT_EQ(::stat(testFile_.c_str(), &after), 0);
+    EXPECT_NE(after.st_ino, before.st_ino);
+    EXPECT_EQ(after.st_mode & 0777, 0600u);
+    EXPECT_NE(::access((testFile_ + ".tmp").c_str(), F_OK), 0);
+
+    size_t oldLines = 0;
+    std::string line;
+    while (std::getline(oldReader, line))
+        ++oldLines;
+    EXPECT_EQ(oldLines, 2000u);
+
+    EXPECT_EQ(repo_->count(ec_), 1999);
+    auto found = repo_->findById("1000", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "renamed");
+}
+
 // 시나리오 상세 설명: VariableRepositoryTest 그룹의 FindById 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
@@ -229,6 +279,1405 @@ TEST_F(VariableRepositoryTest, ReinsertAfterDeleteAll) {
     EXPECT_EQ(repo_->count(ec_), 1);
 }
 
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 IdIndexTracksInsertsAndDeletes 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, IdIndexTracksInsertsAndDeletes) {
+    for (long i = 0; i < 200; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    B other("other", 1000, "pw");
+    ASSERT_TRUE(repo_->save(other, ec_));
+    ASSERT_TRUE(repo_->deleteById("10", ec_));
+
+    EXPECT_EQ(repo_->count(ec_), 200u);
+    EXPECT_FALSE(repo_->existsById("10", ec_));
+    auto found = repo_->findById("150", ec_);
+    ASSERT_NE(found, nullptr);
+    auto* a = dynamic_cast<A*>(found.get());
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->name, "user150");
+    EXPECT_TRUE(repo_->existsById(other.id(), ec_));
+}
+
+namespace {
+
+/// Record implementing only the map-based toKv/fromKv (default view adapters)
+class LegacyRecord : public VariableRecordBase {
+  public:
+    std::string key;
+    std::string note;
+
+    LegacyRecord() = default;
+    LegacyRecord(std::string k, std::string n) : key(std::move(k)), note(std::move(n)) {}
+
+    std::string id() const override { return key; }
+    const char* typeName() const override { return "Legacy"; }
+    std::unique_ptr<RecordBase> clone() const override {
+        return std::make_unique<LegacyRecord>(*this);
+    }
+
+    void
+    toKv(std::vector<std::pair<std::string, std::pair<bool, std::string>>>& out) const override {
+        out.clear();
+        out.push_back({"key", {true, key}});
+        out.push_back({"note", {true, note}});
+    }
+
+    bool fromKv(const std::unordered_map<std::string, std::pair<bool, std::string>>& kv,
+                std::error_code& ec) override {
+        ec.clear();
+        auto k = kv.find("key");
+        auto n = kv.find("note");
+        if (k == kv.end() || n == kv.end())
+            return false;
+        key = k->second.second;
+        note = n->second.second;
+        return true;
+    }
+};
+
+} // namespace
+
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 MapOnlyRecordUsesDefaultViewAdapters 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, MapOnlyRecordUsesDefaultViewAdapters) {
+    repo_.reset();
+    std::vector<std::unique_ptr<VariableRecordBase>> protos;
+    protos.push_back(std::make_unique<LegacyRecord>());
+    protos.push_back(std::make_unique<A>());
+    repo_ = std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), ec_);
+    ASSERT_FALSE(ec_);
+
+    LegacyRecord first("k1", "line\nwith \"escapes\"");
+    LegacyRecord second("k2", "plain");
+    A alice("alice", 1);
+    ASSERT_TRUE(repo_->save(first, ec_));
+    ASSERT_TRUE(repo_->save(second, ec_));
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    LegacyRecord updated("k2", "changed");
+    ASSERT_TRUE(repo_->save(updated, ec_)); // Full rewrite through toKvView()
+
+    auto found = repo_->findById("k1", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<LegacyRecord*>(found.get())->note, "line\nwith \"escapes\"");
+    found = repo_->findById("k2", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<LegacyRecord*>(found.get())->note, "changed");
+    EXPECT_EQ(repo_->count(ec_), 3);
+}
+
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 SharedSnapshotsSurviveUpdates 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, SharedSnapshotsSurviveUpdates) {
+    A alice("alice", 1);
+    B user("user1", 101, "pw");
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    ASSERT_TRUE(repo_->save(user, ec_));
+
+    auto before = repo_->findByIdShared("1", ec_);
+    ASSERT_NE(before, nullptr);
+    // Unchanged cache hands out the same object instead of a copy
+    EXPECT_EQ(repo_->findByIdShared("1", ec_), before);
+    auto all = repo_->findAllShared(ec_);
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0], before);
+
+    A renamed("alicia", 1);
+    ASSERT_TRUE(repo_->save(renamed, ec_));
+    ASSERT_TRUE(repo_->deleteById("101", ec_));
+
+    // Old snapshots are untouched; new lookups see the new version
+    EXPECT_EQ(static_cast<const A*>(before.get())->name, "alice");
+    EXPECT_EQ(all[1]->id(), "101");
+    auto after = repo_->findByIdShared("1", ec_);
+    ASSERT_NE(after, nullptr);
+    EXPECT_NE(after, before);
+    EXPECT_EQ(static_cast<const A*>(after.get())->name, "alicia");
+    EXPECT_EQ(repo_->findByIdShared("101", ec_), nullptr);
+    EXPECT_FALSE(ec_);
+}
+
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 ForEachVisitsInOrderAndStopsEarly 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, ForEachVisitsInOrderAndStopsEarly) {
+    for (long i = 1; i <= 5; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+
+    std::vector<std::string> ids;
+    ASSERT_TRUE(repo_->forEach(
+        [&](const VariableRecordBase& r) {
+            ids.push_back(r.id());
+            return true;
+        },
+        ec_));
+    EXPECT_EQ(ids, (std::vector<std::string>{"1", "2", "3", "4", "5"}));
+
+    ids.clear();
+    ASSERT_TRUE(repo_->forEach(
+        [&](const VariableRecordBase& r) {
+            ids.push_back(r.id());
+            return ids.size() < 2;
+        },
+        ec_));
+    EXPECT_EQ(ids, (std::vector<std::string>{"1", "2"}));
+}
+
+// 시나리오 상세 설명: VariableRepositoryTest 그룹의 CloneVariableKeepsDynamicType 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableRepositoryTest, CloneVariableKeepsDynamicType) {
+    B user("user1", 101, "pw");
+    auto copy = user.cloneVariable();
+    ASSERT_NE(dynamic_cast<B*>(copy.get()), nullptr);
+    EXPECT_EQ(copy->id(), "101");
+
+    // Default implementation (clone() + downcast)
+    LegacyRecord legacy("k1", "note");
+    auto legacyCopy = legacy.cloneVariable();
+    ASSERT_NE(dynamic_cast<LegacyRecord*>(legacyCopy.get()), nullptr);
+    EXPECT_EQ(static_cast<LegacyRecord*>(legacyCopy.get())->note, "note");
+}
+
+// =============================================================================
+// Variable Repository Durability Tests
+// =============================================================================
+
+class VariableDurabilityTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_durability.db";
+        ::remove(testFile_.c_str());
+    }
+
+    void TearDown() override { ::remove(testFile_.c_str()); }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                            ec_);
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: VariableDurabilityTest 그룹의 AsyncFlushPersistsData 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableDurabilityTest, AsyncFlushPersistsData) {
+    VariableRepositoryOptions opts;
+    opts.durability = Durability::Async;
+    {
+        auto repo = open(opts);
+        ASSERT_FALSE(ec_);
+        A alice("alice", 1);
+        B bob("bob", 2, "pw");
+        ASSERT_TRUE(repo->save(alice, ec_));
+        ASSERT_TRUE(repo->save(bob, ec_));
+        EXPECT_EQ(repo->lastWriteTicket(), 2u);
+        EXPECT_TRUE(repo->waitDurable(repo->lastWriteTicket(), ec_)) << ec_.message();
+    }
+
+    auto reopened = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened->count(ec_), 2);
+}
+
+// 시나리오 상세 설명: VariableDurabilityTest 그룹의 GroupCommitBatchesWrites 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableDurabilityTest, GroupCommitBatchesWrites) {
+    VariableRepositoryOptions opts;
+    opts.durability = Durability::GroupCommit;
+    opts.groupCommit.interval = std::chrono::milliseconds(5);
+    {
+        auto repo = open(opts);
+        ASSERT_FALSE(ec_);
+        for (int i = 0; i < 10; ++i) {
+            A rec("user" + std::to_string(i), i);
+            ASSERT_TRUE(repo->save(rec, ec_));
+        }
+        ASSERT_TRUE(repo->deleteById("3", ec_));
+        EXPECT_TRUE(repo->flush(ec_)) << ec_.message();
+        EXPECT_EQ(repo->count(ec_), 9);
+    }
+
+    auto reopened = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened->count(ec_), 9);
+}
+
+// =============================================================================
+// Log-Structured Variable Repository Tests
+// =============================================================================
+
+class VariableLogStructuredTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_log.db";
+        ::remove(testFile_.c_str());
+        opts_.logStructured = true;
+    }
+
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".tmp").c_str());
+    }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                            ec_);
+    }
+
+    size_t lineCount() const {
+        std::ifstream ifs(testFile_);
+        std::string line;
+        size_t n = 0;
+        while (std::getline(ifs, line))
+            ++n;
+        return n;
+    }
+
+    ino_t inode() const {
+        struct stat st{};
+        ::stat(testFile_.c_str(), &st);
+        return st.st_ino;
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    VariableRepositoryOptions opts_;
+};
+
+// 시나리오 상세 설명: VariableLogStructuredTest 그룹의 UpdateAppendsNewVersion 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLogStructuredTest, UpdateAppendsNewVersion) {
+    {
+        auto repo = open(opts_);
+        ASSERT_FALSE(ec_);
+        A v1("alice", 1);
+        A v2("alicia", 1);
+        A bob("bob", 2);
+        ASSERT_TRUE(repo->save(v1, ec_));
+        ASSERT_TRUE(repo->save(bob, ec_));
+        ASSERT_TRUE(repo->save(v2, ec_));
+        EXPECT_EQ(lineCount(), 3u);
+        EXPECT_EQ(repo->count(ec_), 2);
+    }
+
+    // Any reader (log-structured or not) keeps the last version per ID
+    auto reopened = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    auto found = reopened->findById("1", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "alicia");
+    auto all = reopened->findAll(ec_);
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0]->id(), "1");
+    EXPECT_EQ(all[1]->id(), "2");
+}
+
+// 시나리오 상세 설명: VariableLogStructuredTest 그룹의 DeleteAppendsTombstone 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLogStructuredTest, DeleteAppendsTombstone) {
+    {
+        auto repo = open(opts_);
+        ASSERT_FALSE(ec_);
+        A alice("alice", 1);
+        A bob("bob", 2);
+        ASSERT_TRUE(repo->save(alice, ec_));
+        ASSERT_TRUE(repo->save(bob, ec_));
+        ASSERT_TRUE(repo->deleteById("1", ec_));
+        ASSERT_TRUE(repo->deleteById("1", ec_)); // Already gone: no second tombstone
+        EXPECT_EQ(lineCount(), 3u);
+        EXPECT_FALSE(repo->existsById("1", ec_));
+        EXPECT_EQ(repo->count(ec_), 1);
+    }
+
+    std::ifstream ifs(testFile_);
+    std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find(VARIABLE_TOMBSTONE_TYPE), std::string::npos);
+
+    auto reopened = open(opts_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened->count(ec_), 1);
+    EXPECT_EQ(reopened->findById("1", ec_), nullptr);
+
+    // Saving after the tombstone brings the ID back
+    A again("alice2", 1);
+    ASSERT_TRUE(reopened->save(again, ec_));
+    EXPECT_EQ(reopened->count(ec_), 2);
+    auto other = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    auto found = other->findById("1", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "alice2");
+}
+
+// 시나리오 상세 설명: VariableLogStructuredTest 그룹의 CompactRewritesLiveRecords 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLogStructuredTest, CompactRewritesLiveRecords) {
+    auto repo = open(opts_);
+    ASSERT_FALSE(ec_);
+    auto peer = open(opts_);
+    ASSERT_FALSE(ec_);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            A rec("user" + std::to_string(round), i);
+            ASSERT_TRUE(repo->save(rec, ec_));
+        }
+    }
+    ASSERT_TRUE(repo->deleteById("0", ec_));
+    EXPECT_EQ(lineCount(), 13u);
+
+    const ino_t before = inode();
+    ASSERT_TRUE(repo->compact(ec_)) << ec_.message();
+    EXPECT_EQ(lineCount(), 3u);
+    EXPECT_NE(inode(), before);
+    EXPECT_EQ(repo->count(ec_), 3);
+
+    // An instance opened before the rename follows it, and its writes land in the new file
+    EXPECT_EQ(peer->count(ec_), 3);
+    B user("user", 9, "pw");
+    ASSERT_TRUE(peer->save(user, ec_));
+    EXPECT_EQ(lineCount(), 4u);
+    EXPECT_EQ(repo->count(ec_), 4);
+    auto found = repo->findById("3", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "user2");
+}
+
+// 시나리오 상세 설명: VariableLogStructuredTest 그룹의 ThresholdTriggersCompaction 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLogStructuredTest, ThresholdTriggersCompaction) {
+    opts_.compactThreshold = 0.5;
+    auto repo = open(opts_);
+    ASSERT_FALSE(ec_);
+    A a("a", 1);
+    A b("b", 2);
+    ASSERT_TRUE(repo->save(a, ec_));
+    ASSERT_TRUE(repo->save(b, ec_));
+    A a2("a2", 1);
+    ASSERT_TRUE(repo->save(a2, ec_)); // 1 dead of 3 lines: below threshold
+    EXPECT_EQ(lineCount(), 3u);
+
+    A a3("a3", 1);
+    ASSERT_TRUE(repo->save(a3, ec_)); // 2 dead of 4 lines: compacted
+    EXPECT_EQ(lineCount(), 2u);
+    EXPECT_EQ(repo->count(ec_), 2);
+    auto found = repo->findById("1", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "a3");
+}
+
+// =============================================================================
+// Binary Format Variable Repository Tests
+// =============================================================================
+
+class VariableBinaryFormatTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_bin.db";
+        cleanup();
+        opts_.format = VariableFormat::Binary;
+    }
+
+    void TearDown() override { cleanup(); }
+
+    void cleanup() {
+        for (const auto* suffix : {"", ".tmp", ".txt", ".txt.tmp", ".back", ".back.tmp"})
+            ::remove((testFile_ + suffix).c_str());
+    }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const std::string& path,
+                                                     const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(path, std::move(protos), opts, ec_);
+    }
+
+    std::string content(const std::string& path) const {
+        std::ifstream ifs(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(ifs)),
+                           std::istreambuf_iterator<char>());
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    VariableRepositoryOptions opts_;
+};
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 CrudSurvivesReopen 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, CrudSurvivesReopen) {
+    {
+        auto repo = open(testFile_, opts_);
+        ASSERT_FALSE(ec_);
+        A alice("line\n\"quoted\"", 1);
+        B user("user1", 101, "p\\w");
+        A bob("bob", -2);
+        ASSERT_TRUE(repo->save(alice, ec_));
+        ASSERT_TRUE(repo->save(user, ec_));
+        ASSERT_TRUE(repo->save(bob, ec_));
+        A renamed("alicia", 1);
+        ASSERT_TRUE(repo->save(renamed, ec_)); // In-place rewrite with a dictionary header
+        ASSERT_TRUE(repo->deleteById("-2", ec_));
+        EXPECT_EQ(repo->count(ec_), 2);
+    }
+    EXPECT_EQ(content(testFile_).compare(0, detail::BINARY_MAGIC_LEN, detail::BINARY_MAGIC), 0);
+
+    auto reopened = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    auto all = reopened->findAll(ec_);
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(static_cast<A*>(all[0].get())->name, "alicia");
+    auto* b = dynamic_cast<B*>(all[1].get());
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(b->pw, "p\\w");
+    EXPECT_EQ(reopened->findById("-2", ec_), nullptr);
+}
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 LogStructuredAppendsAndCompacts 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, LogStructuredAppendsAndCompacts) {
+    opts_.logStructured = true;
+    auto writer = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    auto reader = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+
+    for (long i = 1; i <= 10; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(writer->save(rec, ec_));
+    }
+    EXPECT_EQ(reader->count(ec_), 10);
+
+    // The reader appends symbols (type B, key "pw") the writer has not seen yet
+    B user("user1", 101, "pw");
+    ASSERT_TRUE(reader->save(user, ec_));
+    A renamed("renamed", 3);
+    ASSERT_TRUE(writer->save(renamed, ec_));
+    ASSERT_TRUE(writer->deleteById("4", ec_));
+    auto found = writer->findById("101", ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(reader->count(ec_), 10);
+    EXPECT_EQ(static_cast<A*>(reader->findById("3", ec_).get())->name, "renamed");
+
+    const size_t before = content(testFile_).size();
+    ASSERT_TRUE(writer->compact(ec_));
+    EXPECT_LT(content(testFile_).size(), before);
+    EXPECT_EQ(reader->count(ec_), 10);
+    EXPECT_EQ(reader->findById("4", ec_), nullptr);
+    ASSERT_TRUE(reader->save(A("after", 11), ec_));
+    EXPECT_EQ(writer->count(ec_), 11);
+}
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 TornTailIsDroppedOnNextAppend 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, TornTailIsDroppedOnNextAppend) {
+    {
+        auto repo = open(testFile_, opts_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(repo->save(A("alice", 1), ec_));
+    }
+    {
+        // A writer that died after the length prefix and part of the payload
+        std::ofstream ofs(testFile_, std::ios::binary | std::ios::app);
+        ofs.write("\x20\x02\x00", 3);
+    }
+
+    auto repo = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(repo->count(ec_), 1);
+    ASSERT_TRUE(repo->save(A("bob", 2), ec_));
+
+    auto reopened = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(reopened->count(ec_), 2);
+    EXPECT_NE(reopened->findById("2", ec_), nullptr);
+}
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 CorruptFrameIsSkipped 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, CorruptFrameIsSkipped) {
+    {
+        auto repo = open(testFile_, opts_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(repo->save(A("alice", 1), ec_));
+        ASSERT_TRUE(repo->save(A("bob", 2), ec_));
+    }
+    // Flip a byte inside the last record's payload ("bob" is stored verbatim)
+    std::string data = content(testFile_);
+    const size_t pos = data.rfind("bob");
+    ASSERT_NE(pos, std::string::npos);
+    data[pos] = 'B';
+    std::ofstream(testFile_, std::ios::binary | std::ios::trunc) << data;
+
+    auto repo = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(repo->count(ec_), 1);
+    EXPECT_NE(repo->findById("1", ec_), nullptr);
+    EXPECT_EQ(repo->findById("2", ec_), nullptr);
+}
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 MismatchedFormatIsRejected 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, MismatchedFormatIsRejected) {
+    const std::string textFile = testFile_ + ".txt";
+    {
+        auto text = open(textFile, VariableRepositoryOptions{});
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(text->save(A("alice", 1), ec_));
+        auto binary = open(testFile_, opts_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(binary->save(A("alice", 1), ec_));
+    }
+
+    open(textFile, opts_);
+    EXPECT_EQ(ec_, std::make_error_code(std::errc::invalid_argument));
+    open(testFile_, VariableRepositoryOptions{});
+    EXPECT_EQ(ec_, std::make_error_code(std::errc::invalid_argument));
+}
+
+// 시나리오 상세 설명: VariableBinaryFormatTest 그룹의 ConverterRoundTrip 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableBinaryFormatTest, ConverterRoundTrip) {
+    const std::string textFile = testFile_ + ".txt";
+    const std::string backFile = testFile_ + ".back";
+    {
+        VariableRepositoryOptions textOpts;
+        textOpts.logStructured = true;
+        auto text = open(textFile, textOpts);
+        ASSERT_FALSE(ec_);
+        for (long i = 1; i <= 100; ++i) {
+            B rec("user" + std::to_string(i), i, "secret\t" + std::to_string(i));
+            ASSERT_TRUE(text->save(rec, ec_));
+        }
+        ASSERT_TRUE(text->deleteById("7", ec_));
+    }
+
+    VariableConvertStats stats;
+    ASSERT_TRUE(convertVariableFile(textFile, testFile_, VariableFormat::Binary, ec_, &stats));
+    EXPECT_EQ(stats.entries, 101u); // Tombstones are carried over
+    EXPECT_EQ(stats.skipped, 0u);
+    EXPECT_LT(content(testFile_).size(), content(textFile).size());
+
+    auto binary = open(testFile_, opts_);
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(binary->count(ec_), 99);
+    EXPECT_EQ(binary->findById("7", ec_), nullptr);
+
+    ASSERT_TRUE(convertVariableFile(testFile_, backFile, VariableFormat::Text, ec_));
+    EXPECT_EQ(content(backFile), content(textFile));
+
+    EXPECT_FALSE(convertVariableFile(testFile_, testFile_, VariableFormat::Text, ec_));
+    EXPECT_EQ(ec_, std::make_error_code(std::errc::invalid_argument));
+}
+
+// =============================================================================
+// Lazy-Load Variable Repository Tests
+// =============================================================================
+
+class VariableLazyLoadTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_lazy.db";
+        ::remove(testFile_.c_str());
+        opts_.lazyLoad = true;
+    }
+
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".tmp").c_str());
+    }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                            ec_);
+    }
+
+    // Same operations in every mode; checks the result through a second instance
+    void exerciseCrud(const VariableRepositoryOptions& opts) {
+        auto repo = open(opts);
+        ASSERT_FALSE(ec_);
+        for (long i = 1; i <= 20; ++i) {
+            A rec("user" + std::to_string(i), i);
+            ASSERT_TRUE(repo->save(rec, ec_));
+        }
+        B user("user100", 100, "pw");
+        ASSERT_TRUE(repo->save(user, ec_));
+        A renamed("renamed", 5);
+        ASSERT_TRUE(repo->save(renamed, ec_));
+        ASSERT_TRUE(repo->deleteById("7", ec_));
+        EXPECT_EQ(repo->count(ec_), 20);
+        EXPECT_FALSE(repo->existsById("7", ec_));
+
+        auto found = repo->findById("5", ec_);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(static_cast<A*>(found.get())->name, "renamed");
+        auto shared = repo->findByIdShared("100", ec_);
+        ASSERT_NE(shared, nullptr);
+        EXPECT_EQ(static_cast<const B*>(shared.get())->pw, "pw");
+
+        auto other = open(opts);
+        ASSERT_FALSE(ec_);
+        auto all = other->findAll(ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_EQ(all.size(), 20u);
+        EXPECT_EQ(all[0]->id(), "1");
+        EXPECT_EQ(static_cast<A*>(all[4].get())->name, "renamed");
+        EXPECT_EQ(all[19]->id(), "100");
+        size_t visited = 0;
+        ASSERT_TRUE(other->forEach(
+            [&](const VariableRecordBase&) {
+                ++visited;
+                return true;
+            },
+            ec_));
+        EXPECT_EQ(visited, 20u);
+        ASSERT_TRUE(other->compact(ec_));
+        EXPECT_EQ(repo->count(ec_), 20);
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    VariableRepositoryOptions opts_;
+};
+
+// 시나리오 상세 설명: VariableLazyLoadTest 그룹의 CrudMatchesEagerMode 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLazyLoadTest, CrudMatchesEagerMode) {
+    exerciseCrud(opts_);
+    ::remove(testFile_.c_str());
+
+    VariableRepositoryOptions logOpts = opts_;
+    logOpts.logStructured = true;
+    logOpts.recordCacheBytes = 1 << 20;
+    exerciseCrud(logOpts);
+    ::remove(testFile_.c_str());
+
+    VariableRepositoryOptions binOpts = logOpts;
+    binOpts.format = VariableFormat::Binary;
+    exerciseCrud(binOpts);
+}
+
+// 시나리오 상세 설명: VariableLazyLoadTest 그룹의 RecordCacheCountsHitsAndEvictions 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLazyLoadTest, RecordCacheCountsHitsAndEvictions) {
+    opts_.recordCacheBytes = 2 * (128 + 64); // Room for about two records
+    auto repo = open(opts_);
+    ASSERT_FALSE(ec_);
+    for (long i = 1; i <= 5; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(repo->save(rec, ec_));
+    }
+
+    ASSERT_NE(repo->findById("1", ec_), nullptr); // Miss
+    ASSERT_NE(repo->findById("1", ec_), nullptr); // Hit
+    auto first = repo->findByIdShared("1", ec_);
+    EXPECT_EQ(repo->findByIdShared("1", ec_), first); // Same cached object
+    ASSERT_NE(repo->findById("2", ec_), nullptr);
+    ASSERT_NE(repo->findById("3", ec_), nullptr); // Evicts "1"
+
+    VariableCacheStats s = repo->cacheStats();
+    EXPECT_EQ(s.misses, 3u);
+    EXPECT_EQ(s.hits, 3u);
+    EXPECT_EQ(s.evictions, 1u);
+    EXPECT_EQ(s.cachedRecords, 2u);
+    EXPECT_LE(s.cachedBytes, opts_.recordCacheBytes);
+    EXPECT_EQ(s.indexedRecords, 5u);
+
+    // Full scans read through the cache without filling it
+    EXPECT_EQ(repo->findAll(ec_).size(), 5u);
+    EXPECT_EQ(repo->cacheStats().cachedRecords, 2u);
+}
+
+// 시나리오 상세 설명: VariableLazyLoadTest 그룹의 TypeQueriesFollowWrites 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLazyLoadTest, TypeQueriesFollowWrites) {
+    VariableRepositoryOptions eager;
+    VariableRepositoryOptions logged = opts_;
+    logged.logStructured = true;
+    for (const auto& opts : {eager, opts_, logged}) {
+        ::remove(testFile_.c_str());
+        auto repo = open(opts);
+        ASSERT_FALSE(ec_);
+        for (long i = 1; i <= 6; ++i) {
+            A a("a" + std::to_string(i), i);
+            ASSERT_TRUE(repo->save(a, ec_));
+        }
+        for (long i = 11; i <= 13; ++i) {
+            B b("b" + std::to_string(i), i, "pw");
+            ASSERT_TRUE(repo->save(b, ec_));
+        }
+        ASSERT_TRUE(repo->deleteById("2", ec_));
+        B retyped("retyped", 4, "pw"); // ID 4 moves from A to B
+        ASSERT_TRUE(repo->save(retyped, ec_));
+
+        auto other = open(opts);
+        ASSERT_FALSE(ec_);
+        EXPECT_EQ(other->countByType("A", ec_), 4u);
+        EXPECT_EQ(other->countByType("B", ec_), 4u);
+        EXPECT_EQ(other->countByType("C", ec_), 0u);
+
+        auto bs = other->findAllByType("B", ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_EQ(bs.size(), 4u);
+        EXPECT_EQ(bs[0]->id(), "4"); // File order of the slot, not of the update
+        EXPECT_EQ(static_cast<B*>(bs[0].get())->name, "retyped");
+        EXPECT_EQ(bs[3]->id(), "13");
+
+        auto as = other->findAllSharedByType("A", ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_EQ(as.size(), 4u);
+        EXPECT_EQ(as[0]->id(), "1");
+        EXPECT_EQ(as[1]->id(), "3");
+        EXPECT_EQ(as[2]->id(), "5");
+        EXPECT_TRUE(other->findAllByType("C", ec_).empty());
+
+        // The RecordRepository template overload stays visible
+        EXPECT_EQ(other->findAllByType<B>(ec_).size(), 4u);
+    }
+}
+
+// 시나리오 상세 설명: VariableLazyLoadTest 그룹의 UnregisteredTypesAreNotParsed 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableLazyLoadTest, UnregisteredTypesAreNotParsed) {
+    {
+        std::ofstream out(testFile_);
+        out << "A { \"name\": \"a1\", \"id\": 1 }\n";
+        out << "A { this body is not valid\n"; // Never parsed: only B is registered below
+        out << "B { \"name\": \"b2\", \"id\": 2, \"pw\": \"x\" }\n";
+    }
+    for (bool lazy : {false, true}) {
+        VariableRepositoryOptions opts;
+        opts.lazyLoad = lazy;
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<B>());
+        VariableFileRepositoryImpl repo(testFile_, std::move(protos), opts, ec_);
+        ASSERT_FALSE(ec_);
+        EXPECT_EQ(repo.count(ec_), 1u);
+        EXPECT_EQ(repo.countByType("A", ec_), 0u);
+        auto bs = repo.findAllByType("B", ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_EQ(bs.size(), 1u);
+        EXPECT_EQ(bs[0]->id(), "2");
+    }
+}
+
+// =============================================================================
+// Lock Session Tests
+// =============================================================================
+
+class VariableSessionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_session.db";
+        cleanup();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        cleanup();
+    }
+
+    void cleanup() {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+        ::remove((testFile_ + ".tmp").c_str());
+    }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                            ec_);
+    }
+
+    /// Lock type (F_UNLCK, F_RDLCK, F_WRLCK) another process finds on the file at the path
+    int lockSeenByOtherProcess() {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int fd = ::open(testFile_.c_str(), O_RDONLY);
+            struct flock fl{};
+            fl.l_type = F_WRLCK;
+            fl.l_whence = SEEK_SET;
+            ::fcntl(fd, F_GETLK, &fl);
+            ::_exit(fl.l_type == F_RDLCK ? 1 : fl.l_type == F_WRLCK ? 2 : 0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        const int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        return code == 1 ? F_RDLCK : code == 2 ? F_WRLCK : code == 0 ? F_UNLCK : -1;
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<VariableFileRepositoryImpl> repo_;
+};
+
+// 시나리오 상세 설명: VariableSessionTest 그룹의 WriteSessionGroupsWrites 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableSessionTest, WriteSessionGroupsWrites) {
+    for (int mode = 0; mode < 3; ++mode) {
+        SCOPED_TRACE(mode == 0 ? "rewrite" : mode == 1 ? "logStructured" : "lazyLoad");
+        repo_.reset();
+        cleanup();
+        VariableRepositoryOptions opts;
+        opts.logStructured = mode == 1;
+        opts.lazyLoad = mode == 2;
+        repo_ = open(opts);
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        auto session = repo_->writeSession(ec_);
+        ASSERT_TRUE(session.valid()) << ec_.message();
+        A a1("alice", 1), a2("bob", 2);
+        B b3("carol", 3, "pw");
+        std::vector<const VariableRecordBase*> batch{&a1, &a2, &b3};
+        ASSERT_TRUE(session.saveAll(batch, ec_)) << ec_.message();
+
+        A renamed("alicia", 1);
+        ASSERT_TRUE(session.save(renamed, ec_)); // Update: a rewrite unless logStructured
+        ASSERT_TRUE(session.deleteById("2", ec_));
+        EXPECT_EQ(lockSeenByOtherProcess(), F_WRLCK) << "The session keeps the (new) file locked";
+
+        EXPECT_EQ(session.count(ec_), 2u);
+        EXPECT_FALSE(session.existsById("2", ec_));
+        auto found = session.findById("1", ec_);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(static_cast<A*>(found.get())->name, "alicia");
+        size_t visited = 0;
+        ASSERT_TRUE(session.forEach(
+            [&](const VariableRecordBase&) {
+                ++visited;
+                return true;
+            },
+            ec_));
+        EXPECT_EQ(visited, 2u);
+
+        ASSERT_TRUE(session.commit(ec_)) << ec_.message();
+        EXPECT_EQ(lockSeenByOtherProcess(), F_UNLCK);
+        EXPECT_FALSE(session.deleteAll(ec_));
+        EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+        auto other = open(opts);
+        ASSERT_FALSE(ec_);
+        EXPECT_EQ(other->count(ec_), 2u);
+        EXPECT_EQ(repo_->count(ec_), 2u);
+        EXPECT_NE(other->findById("3", ec_), nullptr);
+    }
+}
+
+// 시나리오 상세 설명: VariableSessionTest 그룹의 ReadSessionUpgrades 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableSessionTest, ReadSessionUpgrades) {
+    for (bool shared : {false, true}) {
+        SCOPED_TRACE(shared ? "threadSafe + controlFile" : "plain");
+        repo_.reset();
+        cleanup();
+        VariableRepositoryOptions opts;
+        opts.threadSafe = shared;
+        opts.controlFile = shared;
+        repo_ = open(opts);
+        ASSERT_FALSE(ec_) << ec_.message();
+        A a1("alice", 1);
+        ASSERT_TRUE(repo_->save(a1, ec_));
+        ASSERT_EQ(repo_->count(ec_), 1u); // Second read: served from memory with controlFile
+
+        auto read = repo_->readSession(ec_);
+        ASSERT_TRUE(read.valid()) << ec_.message();
+        EXPECT_EQ(read.count(), 1u);
+        EXPECT_TRUE(read.existsById("1"));
+        EXPECT_NE(read.findByIdShared("1", ec_), nullptr);
+        if (!shared) {
+            EXPECT_EQ(lockSeenByOtherProcess(), F_RDLCK);
+        }
+
+        auto write = read.upgrade(ec_);
+        ASSERT_TRUE(write.valid()) << ec_.message();
+        EXPECT_FALSE(read.valid());
+        EXPECT_EQ(lockSeenByOtherProcess(), F_WRLCK);
+
+        A a2("bob", 2);
+        ASSERT_TRUE(write.save(a2, ec_));
+        EXPECT_EQ(write.count(ec_), 2u);
+        write = {}; // Commits
+        EXPECT_EQ(lockSeenByOtherProcess(), F_UNLCK);
+
+        EXPECT_EQ(repo_->count(ec_), 2u);
+        EXPECT_FALSE(read.upgrade(ec_).valid());
+        EXPECT_EQ(ec_, std::errc::invalid_argument);
+    }
+}
+
+// =============================================================================
+// Async Write Tests
+// =============================================================================
+
+class VariableAsyncWriteTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_async.db";
+        cleanup();
+    }
+
+    void TearDown() override {
+        repo_.reset();
+        cleanup();
+    }
+
+    void cleanup() {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".tmp").c_str());
+    }
+
+    std::unique_ptr<VariableFileRepositoryImpl> open(const VariableRepositoryOptions& opts) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        protos.push_back(std::make_unique<B>());
+        return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                            ec_);
+    }
+
+    std::string testFile_;
+    std::error_code ec_;
+    std::unique_ptr<VariableFileRepositoryImpl> repo_;
+};
+
+// 시나리오 상세 설명: VariableAsyncWriteTest 그룹의 FuturesCompleteInSubmissionOrder 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableAsyncWriteTest, FuturesCompleteInSubmissionOrder) {
+    for (int mode = 0; mode < 3; ++mode) {
+        SCOPED_TRACE(mode == 0 ? "rewrite" : mode == 1 ? "logStructured" : "lazyLoad");
+        repo_.reset();
+        cleanup();
+        VariableRepositoryOptions opts;
+        opts.asyncWrites = true;
+        opts.logStructured = mode >= 1;
+        opts.lazyLoad = mode == 2;
+        repo_ = open(opts);
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        std::vector<std::future<std::error_code>> results;
+        for (int i = 0; i < 60; ++i)
+            results.push_back(repo_->saveAsync(A("v" + std::to_string(i), i % 6)));
+        results.push_back(repo_->saveAsync(B("bob", 100, "pw")));
+        results.push_back(repo_->deleteAsync("2"));
+        for (auto& f : results)
+            EXPECT_FALSE(f.get());
+
+        EXPECT_EQ(repo_->count(ec_), 6u);
+        EXPECT_FALSE(repo_->existsById("2", ec_));
+        auto five = repo_->findById("5", ec_);
+        ASSERT_NE(five, nullptr);
+        EXPECT_EQ(static_cast<A*>(five.get())->name, "v59");
+
+        auto other = open(VariableRepositoryOptions{});
+        ASSERT_FALSE(ec_);
+        EXPECT_EQ(other->count(ec_), 6u);
+    }
+}
+
+// 시나리오 상세 설명: VariableAsyncWriteTest 그룹의 CallbacksFromSeveralThreads 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableAsyncWriteTest, CallbacksFromSeveralThreads) {
+    VariableRepositoryOptions opts;
+    opts.asyncWrites = true;
+    opts.logStructured = true;
+    opts.durability = Durability::GroupCommit;
+    repo_ = open(opts);
+    ASSERT_FALSE(ec_);
+
+    std::atomic<int> ok{0};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([this, t, &ok] {
+            for (int i = 0; i < 50; ++i) {
+                repo_->saveAsync(A("user", t * 1000 + i), [&ok](const std::error_code& ec) {
+                    if (!ec)
+                        ++ok;
+                });
+                std::error_code readEc;
+                repo_->count(readEc); // Reads interleave with the writer thread
+                EXPECT_FALSE(readEc);
+            }
+        });
+    }
+    for (auto& w : writers)
+        w.join();
+    repo_->drainAsync();
+
+    EXPECT_EQ(ok.load(), 200);
+    EXPECT_EQ(repo_->count(ec_), 200u);
+    repo_.reset(); // Stops the writer before the flusher
+
+    auto other = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other->count(ec_), 200u);
+}
+
+// 시나리오 상세 설명: VariableAsyncWriteTest 그룹의 MoveKeepsWriterBoundToNewObject 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableAsyncWriteTest, MoveKeepsWriterBoundToNewObject) {
+    VariableRepositoryOptions opts;
+    opts.asyncWrites = true;
+    opts.logStructured = true;
+    repo_ = open(opts);
+    ASSERT_FALSE(ec_);
+    for (int i = 0; i < 50; ++i)
+        repo_->saveAsync(A("user", i), nullptr);
+
+    // Writes queued before the move are applied to the moved-from object first
+    VariableFileRepositoryImpl moved(std::move(*repo_));
+    for (int i = 50; i < 100; ++i)
+        moved.saveAsync(A("user", i), nullptr);
+    EXPECT_FALSE(moved.deleteAsync("7").get());
+    EXPECT_EQ(moved.count(ec_), 99u);
+
+    // Move assignment drains both writers
+    auto target = open(opts);
+    ASSERT_FALSE(ec_);
+    target->saveAsync(A("late", 1000), nullptr);
+    *target = std::move(moved);
+    EXPECT_FALSE(target->saveAsync(A("user", 100)).get());
+    EXPECT_EQ(target->count(ec_), 101u);
+    EXPECT_TRUE(target->existsById("1000", ec_));
+
+    repo_.reset();
+    target.reset();
+    auto other = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    EXPECT_EQ(other->count(ec_), 101u);
+}
+
+// 시나리오 상세 설명: VariableAsyncWriteTest 그룹의 WithoutAsyncWritesRunsInline 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableAsyncWriteTest, WithoutAsyncWritesRunsInline) {
+    repo_ = open(VariableRepositoryOptions{});
+    ASSERT_FALSE(ec_);
+    auto saved = repo_->saveAsync(A("alice", 1));
+    ASSERT_EQ(saved.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(saved.get());
+    EXPECT_TRUE(repo_->existsById("1", ec_));
+
+    bool called = false;
+    repo_->deleteAsync("1", [&called](const std::error_code& ec) {
+        EXPECT_FALSE(ec);
+        called = true;
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(repo_->count(ec_), 0u);
+}
+
+// =============================================================================
+// Parallel Scan Tests
+// =============================================================================
+
+class VariableParallelScanTest : public VariableAsyncWriteTest {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_variable_parallel_scan.db";
+        cleanup();
+    }
+
+    /// @brief Log with updates and tombstones: A 0..499 (0..99 saved twice, every 5th
+    ///        deleted) and B 1000..1099
+    void populate(VariableFormat format) {
+        VariableRepositoryOptions opts;
+        opts.format = format;
+        opts.logStructured = true;
+        opts.durability = Durability::Async;
+        auto repo = open(opts);
+        ASSERT_FALSE(ec_) << ec_.message();
+        for (int i = 0; i < 500; ++i)
+            ASSERT_TRUE(repo->save(A("v1-" + std::to_string(i), i), ec_));
+        for (int i = 0; i < 100; ++i)
+            ASSERT_TRUE(repo->save(B("b" + std::to_string(i), 1000 + i, "pw"), ec_));
+        for (int i = 0; i < 100; ++i)
+            ASSERT_TRUE(repo->save(A("v2-" + std::to_string(i), i), ec_));
+        for (int i = 0; i < 500; i += 5)
+            ASSERT_TRUE(repo->deleteById(std::to_string(i), ec_));
+        ASSERT_TRUE(repo->flush(ec_));
+    }
+
+    static VariableRepositoryOptions parallelOptions(VariableFormat format, bool lazy) {
+        VariableRepositoryOptions opts;
+        opts.format = format;
+        opts.logStructured = true;
+        opts.lazyLoad = lazy;
+        opts.scanThreads = 4;
+        opts.scanMinBytesPerThread = 1;
+        return opts;
+    }
+};
+
+// 시나리오 상세 설명: VariableParallelScanTest 그룹의 LoadMatchesSerialLoad 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableParallelScanTest, LoadMatchesSerialLoad) {
+    for (int mode = 0; mode < 3; ++mode) {
+        SCOPED_TRACE(mode == 0 ? "text" : mode == 1 ? "text lazyLoad" : "binary");
+        cleanup();
+        const VariableFormat format = mode == 2 ? VariableFormat::Binary : VariableFormat::Text;
+        populate(format);
+
+        VariableRepositoryOptions serialOpts;
+        serialOpts.format = format;
+        serialOpts.logStructured = true;
+        auto serial = open(serialOpts);
+        ASSERT_FALSE(ec_) << ec_.message();
+        auto parallel = open(parallelOptions(format, mode == 1));
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        EXPECT_EQ(parallel->count(ec_), 500u);
+        EXPECT_EQ(parallel->countByType("B", ec_), 100u);
+        auto all = parallel->findAll(ec_);
+        ASSERT_FALSE(ec_);
+        auto expected = serial->findAll(ec_);
+        ASSERT_EQ(all.size(), expected.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            EXPECT_EQ(all[i]->id(), expected[i]->id());
+            EXPECT_EQ(all[i]->typeName(), expected[i]->typeName());
+        }
+
+        // Later versions and tombstones win across range boundaries
+        auto updated = parallel->findById("7", ec_);
+        ASSERT_NE(updated, nullptr);
+        EXPECT_EQ(static_cast<A*>(updated.get())->name, "v2-7");
+        EXPECT_FALSE(parallel->existsById("10", ec_));
+        auto untouched = parallel->findById("301", ec_);
+        ASSERT_NE(untouched, nullptr);
+        EXPECT_EQ(static_cast<A*>(untouched.get())->name, "v1-301");
+    }
+}
+
+// 시나리오 상세 설명: VariableParallelScanTest 그룹의 ParallelForEachVisitsEveryRecordOnce 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableParallelScanTest, ParallelForEachVisitsEveryRecordOnce) {
+    populate(VariableFormat::Text);
+    for (bool lazy : {false, true}) {
+        SCOPED_TRACE(lazy ? "lazyLoad" : "eager");
+        auto repo = open(parallelOptions(VariableFormat::Text, lazy));
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        std::mutex mu;
+        std::multiset<std::string> seen;
+        ASSERT_TRUE(repo->parallelForEach(
+            [&](const VariableRecordBase& r) {
+                std::lock_guard<std::mutex> lk(mu);
+                seen.insert(r.id());
+                return true;
+            },
+            ec_, 4))
+            << ec_.message();
+        EXPECT_EQ(seen.size(), 500u);
+        for (int i = 0; i < 500; ++i)
+            EXPECT_EQ(seen.count(std::to_string(i)), i % 5 == 0 ? 0u : 1u) << i;
+        for (int i = 1000; i < 1100; ++i)
+            EXPECT_EQ(seen.count(std::to_string(i)), 1u) << i;
+
+        std::atomic<int> visited{0};
+        ASSERT_TRUE(repo->parallelForEach(
+            [&](const VariableRecordBase&) { return visited.fetch_add(1) < 10; }, ec_, 4));
+        EXPECT_LT(visited.load(), 500);
+    }
+}
+
+// =============================================================================
+// Statistics Tests
+// =============================================================================
+
+// 시나리오 상세 설명: VariableStatsTest 그룹의 RecordsOperationsAndCacheEvents 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(VariableStatsTest, RecordsOperationsAndCacheEvents) {
+    const std::string path = "./test_variable_stats.db";
+    ::remove(path.c_str());
+    auto open = [&path](std::error_code& ec) {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        VariableRepositoryOptions opts;
+        opts.logStructured = true;
+        return std::make_unique<VariableFileRepositoryImpl>(path, std::move(protos), opts, ec);
+    };
+    std::error_code ec;
+    {
+        auto repo = open(ec);
+        ASSERT_FALSE(ec);
+        for (int i = 0; i < 4; ++i)
+            ASSERT_TRUE(repo->save(A("user", i), ec));
+        ASSERT_NE(repo->findById("2", ec), nullptr);
+        ASSERT_TRUE(repo->deleteById("2", ec));
+        {
+            auto other = open(ec);
+            ASSERT_TRUE(other->save(A("other", 9), ec));
+        }
+        EXPECT_EQ(repo->findAllShared(ec).size(), 4u);
+
+        RepositoryStats s = repo->stats();
+#if defined(FDFILE_ENABLE_STATS)
+        EXPECT_TRUE(s.enabled);
+        EXPECT_EQ(s.op(StatOp::Save).count, 4u);
+        EXPECT_EQ(s.op(StatOp::FindById).count, 1u);
+        EXPECT_EQ(s.op(StatOp::Delete).count, 1u);
+        EXPECT_EQ(s.op(StatOp::FindAll).count, 1u);
+        EXPECT_EQ(s.op(StatOp::Sync).count, 5u); // Strict: one fsync per write
+        EXPECT_GE(s.op(StatOp::LockWait).count, 7u);
+        EXPECT_GE(s.counter(StatCounter::TailLoads), 1u);
+        EXPECT_EQ(s.counter(StatCounter::Reloads), 1u);
+        EXPECT_GT(s.cacheHitRate(), 0.0);
+#else
+        EXPECT_FALSE(s.enabled);
+        EXPECT_EQ(s.op(StatOp::Save).count, 0u);
+#endif
+    }
+    ::remove(path.c_str());
+}
+
+// =============================================================================
+// Sharded Variable Repository Tests
+// =============================================================================
+
+class VariableShardedRepositoryTest : public ::testing::Test {
+  protected:
+    using Sharded = ShardedRepository<VariableRecordBase, VariableFileRepositoryImpl>;
+
+    void SetUp() override {
+        base_ = "test_variable_sharded.db";
+        cleanup();
+    }
+
+    void TearDown() override { cleanup(); }
+
+    /// @brief Remove the manifest and every shard file
+    void cleanup() {
+        std::error_code fec;
+        for (std::filesystem::directory_iterator it(".", fec), end; !fec && it != end;
+             it.increment(fec)) {
+            if (it->path().filename().string().compare(0, base_.size(), base_) == 0)
+                std::filesystem::remove(it->path(), fec);
+        }
+    }
+
+    std::unique_ptr<Sharded> open(size_t shards, const VariableRepositoryOptions& opts = {}) {
+        ShardedRepositoryOptions sopts;
+        sopts.shardCount = shards;
+        auto factory = [opts](const std::string& path, std::error_code& fec) {
+            std::vector<std::unique_ptr<VariableRecordBase>> protos;
+            protos.push_back(std::make_unique<A>());
+            protos.push_back(std::make_unique<B>());
+            return std::make_unique<VariableFileRepositoryImpl>(path, std::move(protos), opts,
+                                                                fec);
+        };
+        return std::make_unique<Sharded>(base_, factory, sopts, ec_);
+    }
+
+    std::string base_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: VariableShardedRepositoryTest 그룹의 MixedTypesSurviveReshard 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableShardedRepositoryTest, MixedTypesSurviveReshard) {
+    for (int mode = 0; mode < 2; ++mode) {
+        SCOPED_TRACE(mode == 0 ? "rewrite" : "logStructured");
+        cleanup();
+        VariableRepositoryOptions opts;
+        opts.logStructured = mode == 1;
+        auto repo = open(3, opts);
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        for (int i = 0; i < 60; ++i)
+            ASSERT_TRUE(repo->save(A("a" + std::to_string(i), i), ec_));
+        std::vector<B> bs;
+        for (int i = 0; i < 40; ++i)
+            bs.emplace_back("b" + std::to_string(i), 100 + i, "pw");
+        std::vector<const VariableRecordBase*> ptrs;
+        for (const auto& b : bs)
+            ptrs.push_back(&b);
+        ASSERT_TRUE(repo->saveAll(ptrs, ec_)) << ec_.message();
+        EXPECT_EQ(repo->count(ec_), 100u);
+
+        ASSERT_TRUE(repo->reshard(2, ec_)) << ec_.message();
+        EXPECT_EQ(repo->shardCount(), 2u);
+        EXPECT_EQ(repo->count(ec_), 100u);
+        EXPECT_EQ(repo->findAllByType<A>(ec_).size(), 60u);
+        EXPECT_EQ(repo->findAllByType<B>(ec_).size(), 40u);
+
+        auto a = repo->findByIdAndType<A>("17", ec_);
+        ASSERT_NE(a, nullptr);
+        EXPECT_EQ(a->name, "a17");
+        auto b = repo->findByIdAndType<B>("120", ec_);
+        ASSERT_NE(b, nullptr);
+        EXPECT_EQ(b->name, "b20");
+        for (size_t s = 0; s < 2; ++s)
+            EXPECT_EQ(repo->shard(s).existsById("120", ec_), s == repo->shardOf("120"));
+
+        ASSERT_TRUE(repo->deleteById("17", ec_));
+        EXPECT_EQ(repo->count(ec_), 99u);
+        for (size_t s = 0; s < 3; ++s)
+            EXPECT_FALSE(std::filesystem::exists(Sharded::shardPath(base_, 0, s)));
+    }
+}
+
+// 시나리오 상세 설명: VariableShardedRepositoryTest 그룹의 FactoryErrorFailsConstruction 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableShardedRepositoryTest, FactoryErrorFailsConstruction) {
+    // VariableFileRepositoryImpl needs prototypes: there is no default factory
+    Sharded noFactory(base_, nullptr, ShardedRepositoryOptions{}, ec_);
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+
+    Sharded failing(
+        base_,
+        [](const std::string&, std::error_code& fec) {
+            fec = std::make_error_code(std::errc::permission_denied);
+            return std::unique_ptr<VariableFileRepositoryImpl>();
+        },
+        ShardedRepositoryOptions{}, ec_);
+    EXPECT_EQ(ec_, std::errc::permission_denied);
+}
+
 // =============================================================================
 // Variable Record Format Corruption Tests (JSON-like 형식 손상 테스트)
 // =============================================================================
@@ -524,6 +1973,7 @@ class VariableExternalModificationTest : public ::testing::Test {
     void TearDown() override {
         repo_.reset();
         ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
     }
 
     void appendLineExternally(const std::string& line) {
@@ -559,6 +2009,31 @@ TEST_F(VariableExternalModificationTest, DetectsExternalAppend) {
     EXPECT_TRUE(repo_->existsById("2", ec_));
 }
 
+// 시나리오 상세 설명: VariableExternalModificationTest 그룹의 LargeAppendAcrossPagesIsIndexed 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableExternalModificationTest, LargeAppendAcrossPagesIsIndexed) {
+    A first("first", 0);
+    ASSERT_TRUE(repo_->save(first, ec_));
+    EXPECT_EQ(repo_->count(ec_), 1); // Indexed up to an offset that is not page aligned
+
+    // Many pages of appended lines, including names longer than a page
+    {
+        std::ofstream ofs(testFile_, std::ios::app);
+        for (int i = 1; i <= 3000; ++i) {
+            std::string name = (i % 500 == 0) ? std::string(9000, 'x') : "user" + std::to_string(i);
+            ofs << "A { \"name\": \"" << name << "\", \"id\": " << i << " }\n";
+        }
+    }
+
+    EXPECT_EQ(repo_->count(ec_), 3001);
+    auto longName = repo_->findById("1500", ec_);
+    ASSERT_NE(longName, nullptr);
+    EXPECT_EQ(static_cast<A*>(longName.get())->name.size(), 9000u);
+    auto last = repo_->findById("3000", ec_);
+    ASSERT_NE(last, nullptr);
+}
+
 // 시나리오 상세 설명: VariableExternalModificationTest 그룹의 DetectsExternalAppendImmediately 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
@@ -575,6 +2050,62 @@ TEST_F(VariableExternalModificationTest, DetectsExternalAppendImmediately) {
     EXPECT_EQ(repo_->count(ec_), 2);
 }
 
+// 시나리오 상세 설명: VariableExternalModificationTest 그룹의 PartialAppendedLineStaysPending 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableExternalModificationTest, PartialAppendedLineStaysPending) {
+    A alice("alice", 1);
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    EXPECT_EQ(repo_->count(ec_), 1u);
+
+    // A writer that has not finished its line yet
+    {
+        std::ofstream ofs(testFile_, std::ios::app);
+        ofs << "A { \"name\": \"bob\", \"id\": 2 }";
+    }
+    EXPECT_EQ(repo_->count(ec_), 1u);
+    EXPECT_FALSE(repo_->existsById("2", ec_));
+
+    {
+        std::ofstream ofs(testFile_, std::ios::app);
+        ofs << "\n";
+    }
+    EXPECT_EQ(repo_->count(ec_), 2u);
+
+    // Own inserts are picked up the same way
+    A carol("carol", 3);
+    ASSERT_TRUE(repo_->save(carol, ec_));
+    EXPECT_EQ(repo_->count(ec_), 3u);
+    EXPECT_TRUE(repo_->existsById("2", ec_));
+    EXPECT_TRUE(repo_->existsById("3", ec_));
+}
+
+// 시나리오 상세 설명: VariableExternalModificationTest 그룹의 ExternalRewriteThenGrowthReloads 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableExternalModificationTest, ExternalRewriteThenGrowthReloads) {
+    for (long i = 1; i <= 3; ++i) {
+        A rec("user" + std::to_string(i), i);
+        ASSERT_TRUE(repo_->save(rec, ec_));
+    }
+    ASSERT_EQ(repo_->count(ec_), 3u);
+
+    {
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        VariableFileRepositoryImpl other(testFile_, std::move(protos), ec_);
+        ASSERT_FALSE(ec_);
+        ASSERT_TRUE(other.deleteById("1", ec_));
+        A dave("a-much-longer-name-than-before", 4);
+        ASSERT_TRUE(other.save(dave, ec_));
+    }
+
+    EXPECT_EQ(repo_->count(ec_), 3u);
+    EXPECT_FALSE(repo_->existsById("1", ec_));
+    EXPECT_TRUE(repo_->existsById("2", ec_));
+    EXPECT_TRUE(repo_->existsById("4", ec_));
+}
+
 // 시나리오 상세 설명: VariableExternalModificationTest 그룹의 DetectsExternalDeleteAll 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
@@ -621,6 +2152,81 @@ TEST_F(VariableExternalModificationTest, DetectsExternalModification) {
     EXPECT_FALSE(repo_->existsById("1", ec_));
 }
 
+// 시나리오 상세 설명: VariableExternalModificationTest 그룹의 DetectsSameSizeInPlaceEdit 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableExternalModificationTest, DetectsSameSizeInPlaceEdit) {
+    A alice("alice", 1);
+    ASSERT_TRUE(repo_->save(alice, ec_));
+    ASSERT_NE(repo_->findById("1", ec_), nullptr);
+
+    // Same size, and usually within the same second as the save
+    usleep(10000);
+    std::string content;
+    {
+        std::ifstream ifs(testFile_);
+        content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    const size_t pos = content.find("alice");
+    ASSERT_NE(pos, std::string::npos);
+    int fd = ::open(testFile_.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::pwrite(fd, "bobby", 5, static_cast<off_t>(pos)), 5);
+    ::close(fd);
+
+    auto found = repo_->findById("1", ec_);
+    ASSERT_FALSE(ec_);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(static_cast<A*>(found.get())->name, "bobby")
+        << "Nanosecond mtime must reveal the rewrite";
+}
+
+// 시나리오 상세 설명: VariableExternalModificationTest 그룹의 ControlFileSharesWriteGeneration 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(VariableExternalModificationTest, ControlFileSharesWriteGeneration) {
+    for (bool lazy : {false, true}) {
+        SCOPED_TRACE(lazy ? "lazyLoad" : "eager");
+        repo_.reset();
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+
+        VariableRepositoryOptions opts;
+        opts.controlFile = true;
+        opts.lazyLoad = lazy;
+        auto open = [&] {
+            std::vector<std::unique_ptr<VariableRecordBase>> protos;
+            protos.push_back(std::make_unique<A>());
+            protos.push_back(std::make_unique<B>());
+            return std::make_unique<VariableFileRepositoryImpl>(testFile_, std::move(protos), opts,
+                                                                ec_);
+        };
+        auto reader = open();
+        ASSERT_FALSE(ec_) << ec_.message();
+        auto writer = open();
+        ASSERT_FALSE(ec_) << ec_.message();
+
+        A alice("alice", 1);
+        ASSERT_TRUE(writer->save(alice, ec_));
+        ASSERT_NE(reader->findById("1", ec_), nullptr);
+
+        A renamed("renamed", 1);
+        ASSERT_TRUE(writer->save(renamed, ec_));
+        auto found = reader->findById("1", ec_);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(static_cast<A*>(found.get())->name, "renamed");
+
+        // A writer outside the protocol is not noticed until a cooperating write bumps the counter
+        appendLineExternally("A { \"name\": \"bob\", \"id\": 2 }");
+        EXPECT_EQ(reader->count(ec_), 1u) << "Reads with an unchanged generation skip stat()";
+
+        A carol("carol", 3);
+        ASSERT_TRUE(writer->save(carol, ec_));
+        EXPECT_EQ(reader->count(ec_), 3u);
+        EXPECT_NE(reader->findById("2", ec_), nullptr);
+    }
+}
+
 // 시나리오 상세 설명: VariableExternalModificationTest 그룹의 CacheInvalidationOnSave 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
@@ -11,16 +11,24 @@
 /**
  * @file ConcurrencyTest.cpp
  * @brief Integration tests for concurrent access and file locking
- * @note The repository is NOT thread-safe for shared instance access.
- *       Each thread must use its own repository instance.
+ * @note A repository instance is only thread-safe with the threadSafe option; otherwise
+ *       each thread must use its own instance.
  *       File-level locking (fcntl) is used to prevent data corruption.
  */
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "records/A.hpp"
 #include "records/FixedA.hpp"
 #include <fdfile/repository/UniformFixedRepositoryImpl.hpp>
+#include <fdfile/repository/VariableFileRepositoryImpl.hpp>
 
 using namespace FdFile;
 
@@ -31,7 +39,11 @@ class ConcurrencyTest : public ::testing::Test {
         ::remove(testFile_.c_str());
     }
 
-    void TearDown() override { ::remove(testFile_.c_str()); }
+    void TearDown() override {
+        ::remove(testFile_.c_str());
+        ::remove((testFile_ + ".tmp").c_str());
+        ::remove((testFile_ + ".ctl").c_str());
+    }
 
     std::string testFile_;
 };
@@ -129,3 +141,160 @@ TEST_F(ConcurrencyTest, DataIntegrityAfterMultipleWrites) {
     ASSERT_NE(found, nullptr);
     EXPECT_EQ(found->age, 201);
 }
+
+// 시나리오 상세 설명: ConcurrencyTest 그룹의 SharedFixedInstanceServesReaderThreads 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ConcurrencyTest, SharedFixedInstanceServesReaderThreads) {
+    FixedRepositoryOptions opts;
+    opts.threadSafe = true;
+    opts.deleteMode = DeleteMode::Tombstone;
+    std::error_code ec;
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec);
+    ASSERT_FALSE(ec);
+    for (int i = 0; i < 100; ++i) {
+        FixedA record("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo.save(record, ec));
+    }
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::error_code rec;
+            for (int n = 0; n < 2000; ++n) {
+                const int id = (n * 7 + t) % 100;
+                auto found = repo.findById(std::to_string(id), rec);
+                if (rec || !found || found->age % 1000 != id)
+                    ++failures;
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        std::error_code wec;
+        for (int i = 0; i < 100; ++i) {
+            FixedA update("user", 1000 + i, std::to_string(i).c_str()); // Same ID, new age
+            FixedA insert("user", 100 + i, std::to_string(100 + i).c_str());
+            if (!repo.save(update, wec) || !repo.save(insert, wec))
+                ++failures;
+        }
+    });
+    for (auto& th : threads)
+        th.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(repo.count(ec), 200u);
+    auto found = repo.findById("42", ec);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->age, 1042);
+}
+
+// 시나리오 상세 설명: ConcurrencyTest 그룹의 SharedVariableInstanceServesReaderThreads 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ConcurrencyTest, SharedVariableInstanceServesReaderThreads) {
+    for (bool lazy : {false, true}) {
+        ::remove(testFile_.c_str());
+        VariableRepositoryOptions opts;
+        opts.threadSafe = true;
+        opts.lazyLoad = lazy;
+        opts.recordCacheBytes = 16 * 1024;
+        std::vector<std::unique_ptr<VariableRecordBase>> protos;
+        protos.push_back(std::make_unique<A>());
+        std::error_code ec;
+        VariableFileRepositoryImpl repo(testFile_, std::move(protos), opts, ec);
+        ASSERT_FALSE(ec);
+        for (long i = 0; i < 50; ++i) {
+            A record("user" + std::to_string(i), i);
+            ASSERT_TRUE(repo.save(record, ec));
+        }
+
+        std::atomic<int> failures{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                std::error_code rec;
+                for (int n = 0; n < 500; ++n) {
+                    const long id = (n * 3 + t) % 50;
+                    auto found = repo.findById(std::to_string(id), rec);
+                    const auto* a = dynamic_cast<const A*>(found.get());
+                    if (rec || !a || a->userId != id || repo.count(rec) < 50)
+                        ++failures;
+                }
+            });
+        }
+        threads.emplace_back([&] {
+            std::error_code wec;
+            for (long i = 50; i < 80; ++i) {
+                A record("user" + std::to_string(i), i);
+                if (!repo.save(record, wec))
+                    ++failures;
+            }
+        });
+        for (auto& th : threads)
+            th.join();
+
+        EXPECT_EQ(failures.load(), 0) << "lazy=" << lazy;
+        EXPECT_EQ(repo.count(ec), 80u);
+    }
+}
+
+// 시나리오 상세 설명: ConcurrencyTest 그룹의 SharedInstanceWithForkedWriter 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ConcurrencyTest, SharedInstanceWithForkedWriter) {
+    FixedRepositoryOptions opts;
+    opts.threadSafe = true;
+    std::error_code ec;
+    UniformFixedRepositoryImpl<FixedA> repo(testFile_, opts, ec);
+    ASSERT_FALSE(ec);
+    for (int i = 0; i < 100; ++i) {
+        FixedA record("user", i, std::to_string(i).c_str());
+        ASSERT_TRUE(repo.save(record, ec));
+    }
+
+    // Another process appends through its own instance while our threads read
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        std::error_code cec;
+        FixedRepositoryOptions childOpts;
+        childOpts.durability = Durability::Async;
+        UniformFixedRepositoryImpl<FixedA> writer(testFile_, childOpts, cec);
+        for (int i = 100; i < 300 && !cec; ++i) {
+            FixedA record("child", i, std::to_string(i).c_str());
+            writer.save(record, cec);
+        }
+        ::_exit(cec ? 1 : 0);
+    }
+
+    std::atomic<bool> childDone{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&, t] {
+            std::error_code rec;
+            size_t last = 0;
+            while (!childDone) {
+                const size_t n = repo.count(rec);
+                auto found = repo.findById(std::to_string(t * 30), rec);
+                if (rec || n < last || n > 300 || !found)
+                    ++failures;
+                last = n;
+            }
+        });
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    childDone = true;
+    for (auto& th : readers)
+        th.join();
+
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(repo.count(ec), 300u);
+    auto found = repo.findById("250", ec);
+    ASSERT_NE(found, nullptr);
+    EXPECT_STREQ(found->name, "child");
+}
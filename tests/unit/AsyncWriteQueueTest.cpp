@@ -0,0 +1,182 @@
+/**
+ * @file tests/unit/AsyncWriteQueueTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file AsyncWriteQueueTest.cpp
+ * @brief Unit tests for the batching background writer
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/AsyncWriteQueue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace FdFile::detail;
+
+namespace {
+
+/// Stand-in for a repository write session: records what was applied per batch
+struct FakeLog {
+    std::mutex mu;
+    std::vector<std::vector<int>> batches;
+    std::error_code commitError;
+};
+
+struct FakeSession {
+    FakeLog* log = nullptr;
+    std::vector<int> applied;
+
+    bool commit(std::error_code& ec) {
+        ec = log->commitError;
+        std::lock_guard<std::mutex> lk(log->mu);
+        log->batches.push_back(applied);
+        return !ec;
+    }
+};
+
+using Queue = AsyncWriteQueue<FakeSession>;
+
+Queue::Apply push(int value) {
+    return [value](FakeSession& s, std::error_code&) {
+        s.applied.push_back(value);
+        return true;
+    };
+}
+
+} // namespace
+
+// 시나리오 상세 설명: AsyncWriteQueueTest 그룹의 AppliesInOrderAndBatches 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(AsyncWriteQueueTest, AppliesInOrderAndBatches) {
+    FakeLog log;
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::atomic<int> completed{0};
+    {
+        Queue queue([&log](std::error_code&) { return FakeSession{&log, {}}; });
+
+        // The first operation holds the worker so the next ones queue up behind it
+        queue.submit(
+            [&started, &release](FakeSession& s, std::error_code&) {
+                started = true;
+                while (!release.load())
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                s.applied.push_back(0);
+                return true;
+            },
+            [&completed](const std::error_code& ec) {
+                EXPECT_FALSE(ec);
+                ++completed;
+            });
+        while (!started.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        for (int i = 1; i <= 10; ++i) {
+            queue.submit(push(i), [&completed](const std::error_code& ec) {
+                EXPECT_FALSE(ec);
+                ++completed;
+            });
+        }
+        release = true;
+        queue.drain();
+        EXPECT_EQ(queue.pending(), 0u);
+        EXPECT_EQ(completed.load(), 11);
+    }
+
+    ASSERT_EQ(log.batches.size(), 2u);
+    EXPECT_EQ(log.batches[0], std::vector<int>({0}));
+    EXPECT_EQ(log.batches[1], std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+// 시나리오 상세 설명: AsyncWriteQueueTest 그룹의 MaxBatchSplitsLargeBursts 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(AsyncWriteQueueTest, MaxBatchSplitsLargeBursts) {
+    FakeLog log;
+    {
+        Queue queue([&log](std::error_code&) { return FakeSession{&log, {}}; }, 4);
+        for (int i = 0; i < 20; ++i)
+            queue.submit(push(i), nullptr);
+        queue.drain();
+    }
+    std::vector<int> all;
+    for (const auto& b : log.batches) {
+        EXPECT_LE(b.size(), 4u);
+        all.insert(all.end(), b.begin(), b.end());
+    }
+    ASSERT_EQ(all.size(), 20u);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(all[i], i);
+}
+
+// 시나리오 상세 설명: AsyncWriteQueueTest 그룹의 ReportsPerOperationAndCommitErrors 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(AsyncWriteQueueTest, ReportsPerOperationAndCommitErrors) {
+    FakeLog log;
+    Queue queue([&log](std::error_code&) { return FakeSession{&log, {}}; });
+
+    // An operation's own failure reaches only its callback
+    std::error_code first, second;
+    queue.submit(
+        [](FakeSession&, std::error_code& ec) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        },
+        [&first](const std::error_code& ec) { first = ec; });
+    queue.submit(push(1), [&second](const std::error_code& ec) { second = ec; });
+    queue.drain();
+    EXPECT_EQ(first, std::errc::invalid_argument);
+    EXPECT_FALSE(second);
+
+    // A failed commit fails every operation of its batch
+    log.commitError = std::make_error_code(std::errc::io_error);
+    std::error_code third;
+    queue.submit(push(2), [&third](const std::error_code& ec) { third = ec; });
+    queue.drain();
+    EXPECT_EQ(third, std::errc::io_error);
+}
+
+// 시나리오 상세 설명: AsyncWriteQueueTest 그룹의 OpenFailureFailsWholeBatch 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(AsyncWriteQueueTest, OpenFailureFailsWholeBatch) {
+    FakeLog log;
+    std::atomic<int> applied{0};
+    std::atomic<int> failed{0};
+    {
+        Queue queue([&log](std::error_code& ec) {
+            ec = std::make_error_code(std::errc::no_lock_available);
+            return FakeSession{&log, {}};
+        });
+        for (int i = 0; i < 5; ++i) {
+            queue.submit(
+                [&applied](FakeSession&, std::error_code&) {
+                    ++applied;
+                    return true;
+                },
+                [&failed](const std::error_code& ec) {
+                    if (ec == std::errc::no_lock_available)
+                        ++failed;
+                });
+        }
+    } // The destructor applies what is still queued
+    EXPECT_EQ(applied.load(), 0);
+    EXPECT_EQ(failed.load(), 5);
+    EXPECT_TRUE(log.batches.empty());
+}
@@ -0,0 +1,138 @@
+/**
+ * @file tests/unit/BinaryCodecTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file BinaryCodecTest.cpp
+ * @brief Unit tests for CRC-32C, varints and the binary record frames
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/BinaryCodec.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace FdFile;
+using namespace FdFile::detail;
+
+// 시나리오 상세 설명: Crc32cTest 그룹의 KnownVectorsAndKernelsAgree 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(Crc32cTest, KnownVectorsAndKernelsAgree) {
+    EXPECT_EQ(crc32c("", 0), 0u);
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+        data.push_back(static_cast<char>(i * 31 + 7));
+    const uint32_t whole = crc32c(data.data(), data.size());
+    EXPECT_EQ(~crc32cScalar(~0u, data.data(), data.size()), whole);
+    // Seeded continuation equals one pass
+    const uint32_t head = crc32c(data.data(), 333);
+    EXPECT_EQ(crc32c(data.data() + 333, data.size() - 333, head), whole);
+}
+
+// 시나리오 상세 설명: VarintTest 그룹의 RoundTripAndTruncation 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(VarintTest, RoundTripAndTruncation) {
+    for (uint64_t v : {uint64_t{0}, uint64_t{127}, uint64_t{128}, uint64_t{300}, UINT64_MAX}) {
+        std::string buf;
+        appendVarint(buf, v);
+        const char* p = buf.data();
+        uint64_t out = 1;
+        ASSERT_TRUE(readVarint(p, buf.data() + buf.size(), out));
+        EXPECT_EQ(out, v);
+        EXPECT_EQ(p, buf.data() + buf.size());
+
+        p = buf.data();
+        EXPECT_FALSE(readVarint(p, buf.data() + buf.size() - 1, out)) << v;
+    }
+    for (int64_t v : {int64_t{0}, int64_t{-1}, int64_t{1}, INT64_MIN, INT64_MAX})
+        EXPECT_EQ(zigzagDecode(zigzagEncode(v)), v);
+    EXPECT_EQ(zigzagEncode(-1), 1u);
+}
+
+// 시나리오 상세 설명: BinaryFrameTest 그룹의 RecordRoundTripThroughDictionary 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(BinaryFrameTest, RecordRoundTripThroughDictionary) {
+    util::KvViews kv;
+    kv.add("name", true, "quote\"and\\backslash\n");
+    kv.add("id", false, "-42");
+    kv.add("ratio", false, "007"); // Not canonical: kept as text
+
+    BinaryEncoder enc;
+    std::string file;
+    enc.appendRecord(file, "A", kv);
+    const size_t firstLen = file.size();
+    enc.appendRecord(file, "A", kv); // Symbols known: no dictionary frame
+    EXPECT_LT(file.size() - firstLen, firstLen);
+
+    BinaryDictionary dict;
+    util::KvViews out;
+    const char* p = file.data();
+    const char* end = p + file.size();
+    int records = 0;
+    while (p < end) {
+        std::string_view payload, type;
+        ASSERT_EQ(readBinaryFrame(p, end, payload), BinaryFrameStatus::Ok);
+        if (decodeBinaryPayload(payload, dict, type, out) != BinaryPayloadKind::Record)
+            continue;
+        ++records;
+        EXPECT_EQ(type, "A");
+        ASSERT_EQ(out.size(), 3u);
+        EXPECT_EQ(out[0].key, "name");
+        EXPECT_TRUE(out[0].isString);
+        EXPECT_EQ(out[0].value, "quote\"and\\backslash\n");
+        EXPECT_EQ(out[1].value, "-42");
+        EXPECT_FALSE(out[1].isString);
+        EXPECT_EQ(out[2].value, "007");
+    }
+    EXPECT_EQ(records, 2);
+}
+
+// 시나리오 상세 설명: BinaryFrameTest 그룹의 TornAndCorruptFramesAreReported 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(BinaryFrameTest, TornAndCorruptFramesAreReported) {
+    util::KvViews kv;
+    kv.add("id", true, "k1");
+    BinaryEncoder enc;
+    std::string frame;
+    enc.appendRecord(frame, "T", kv, /*defineSymbols=*/false);
+
+    std::string_view payload;
+    for (size_t cut = 0; cut < frame.size(); ++cut) {
+        const char* p = frame.data();
+        EXPECT_EQ(readBinaryFrame(p, frame.data() + cut, payload), BinaryFrameStatus::Incomplete);
+        EXPECT_EQ(p, frame.data());
+    }
+
+    std::string bad = frame;
+    bad[bad.size() - 6] ^= 0x20; // Payload byte
+    const char* p = bad.data();
+    EXPECT_EQ(readBinaryFrame(p, bad.data() + bad.size(), payload),
+              BinaryFrameStatus::BadChecksum);
+    EXPECT_EQ(p, bad.data() + bad.size());
+
+    const std::string zero(1, '\0');
+    p = zero.data();
+    EXPECT_EQ(readBinaryFrame(p, zero.data() + 1, payload), BinaryFrameStatus::Malformed);
+
+    // Record referring to ids the reader has never seen
+    BinaryDictionary empty;
+    util::KvViews out;
+    std::string_view type;
+    p = frame.data();
+    ASSERT_EQ(readBinaryFrame(p, frame.data() + frame.size(), payload), BinaryFrameStatus::Ok);
+    EXPECT_EQ(decodeBinaryPayload(payload, empty, type, out), BinaryPayloadKind::Invalid);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file tests/unit/ControlFileTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file ControlFileTest.cpp
+ * @brief Unit tests for the shared-memory write generation
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/ControlFile.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace FdFile::detail;
+
+class ControlFileTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        path_ = "./test_control_file.ctl";
+        ::remove(path_.c_str());
+    }
+
+    void TearDown() override { ::remove(path_.c_str()); }
+
+    std::string path_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: ControlFileTest 그룹의 GenerationIsSharedBetweenMappings 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ControlFileTest, GenerationIsSharedBetweenMappings) {
+    ControlFile a;
+    ASSERT_TRUE(a.open(path_, ec_)) << ec_.message();
+    ControlFile b;
+    ASSERT_TRUE(b.open(path_, ec_)) << ec_.message();
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+
+    const uint64_t start = a.generation();
+    EXPECT_EQ(b.generation(), start) << "Opening an initialized file must not bump it";
+
+    EXPECT_EQ(a.bump(), start + 1);
+    EXPECT_EQ(b.generation(), start + 1);
+    EXPECT_EQ(b.bump(), start + 2);
+    EXPECT_EQ(a.generation(), start + 2);
+}
+
+// 시나리오 상세 설명: ControlFileTest 그룹의 LayoutGenerationIsIndependent 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ControlFileTest, LayoutGenerationIsIndependent) {
+    ControlFile a;
+    ASSERT_TRUE(a.open(path_, ec_)) << ec_.message();
+    ControlFile b;
+    ASSERT_TRUE(b.open(path_, ec_)) << ec_.message();
+
+    const uint64_t gen = a.generation();
+    const uint64_t layout = a.layoutGeneration();
+    a.bump();
+    EXPECT_EQ(b.layoutGeneration(), layout) << "A plain write keeps the layout";
+
+    EXPECT_EQ(b.bumpLayout(), layout + 1);
+    EXPECT_EQ(a.layoutGeneration(), layout + 1);
+    EXPECT_EQ(a.generation(), gen + 1);
+}
+
+// 시나리오 상세 설명: ControlFileTest 그룹의 ForeignContentIsReinitialized 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ControlFileTest, ForeignContentIsReinitialized) {
+    {
+        int fd = ::open(path_.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+        ASSERT_GE(fd, 0);
+        const char junk[] = "not a control file";
+        ASSERT_EQ(::write(fd, junk, sizeof(junk)), static_cast<ssize_t>(sizeof(junk)));
+        ::close(fd);
+    }
+
+    ControlFile ctl;
+    ASSERT_TRUE(ctl.open(path_, ec_)) << ec_.message();
+    const uint64_t gen = ctl.generation();
+
+    // The short file was grown to a full header carrying the magic
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    ControlFile::Header h{};
+    ASSERT_EQ(::pread(fd, &h, sizeof(h), 0), static_cast<ssize_t>(sizeof(h)));
+    ::close(fd);
+    EXPECT_EQ(std::memcmp(h.magic, "FDCTL01", 8), 0);
+    EXPECT_EQ(h.version, ControlFile::VERSION);
+
+    ControlFile again;
+    ASSERT_TRUE(again.open(path_, ec_));
+    EXPECT_EQ(again.generation(), gen);
+}
+
+// 시나리오 상세 설명: ControlFileTest 그룹의 OpenFailureReportsError 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ControlFileTest, OpenFailureReportsError) {
+    ControlFile ctl;
+    EXPECT_FALSE(ctl.open("./no_such_dir_for_ctl/x.ctl", ec_));
+    EXPECT_TRUE(ec_);
+    EXPECT_FALSE(ctl);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file tests/unit/FieldIndexTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file FieldIndexTest.cpp
+ * @brief Unit tests for the secondary field index
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/FieldIndex.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace FdFile::detail;
+
+// 시나리오 상세 설명: FieldIndexTest 그룹의 HashIndexTracksStringValues 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FieldIndexTest, HashIndexTracksStringValues) {
+    FieldIndex index(0, false, false);
+    index.add("red", 7);
+    index.add("blue", 1);
+    index.add("red", 2);
+    index.add("red", 5);
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_EQ(index.equal("red"), (std::vector<size_t>{2, 5, 7})); // Slot order
+    EXPECT_EQ(index.equal("blue"), (std::vector<size_t>{1}));
+    EXPECT_TRUE(index.equal("green").empty());
+
+    index.remove("red", 5);
+    index.remove("red", 99); // Not indexed: no effect
+    index.remove("blue", 1);
+    EXPECT_EQ(index.equal("red"), (std::vector<size_t>{2, 7}));
+    EXPECT_TRUE(index.equal("blue").empty());
+    EXPECT_EQ(index.size(), 2u);
+
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.equal("red").empty());
+}
+
+// 시나리오 상세 설명: FieldIndexTest 그룹의 HashIndexTracksNumericValues 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FieldIndexTest, HashIndexTracksNumericValues) {
+    FieldIndex index(1, true, false);
+    EXPECT_TRUE(index.numeric());
+    EXPECT_FALSE(index.ordered());
+    index.add(int64_t{-3}, 4);
+    index.add(int64_t{-3}, 0);
+    index.add(int64_t{10}, 1);
+    EXPECT_EQ(index.equal(int64_t{-3}), (std::vector<size_t>{0, 4}));
+    index.remove(int64_t{-3}, 0);
+    EXPECT_EQ(index.equal(int64_t{-3}), (std::vector<size_t>{4}));
+    EXPECT_EQ(index.equal(int64_t{10}), (std::vector<size_t>{1}));
+}
+
+// 시나리오 상세 설명: FieldIndexTest 그룹의 OrderedIndexAnswersRanges 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FieldIndexTest, OrderedIndexAnswersRanges) {
+    FieldIndex index(1, true, true);
+    const int64_t values[] = {50, 10, 30, 30, INT64_MIN, INT64_MAX};
+    for (size_t slot = 0; slot < 6; ++slot)
+        index.add(values[slot], slot);
+
+    // By value, then by slot; both bounds inclusive
+    EXPECT_EQ(index.range(10, 30), (std::vector<size_t>{1, 2, 3}));
+    EXPECT_EQ(index.range(INT64_MIN, INT64_MAX), (std::vector<size_t>{4, 1, 2, 3, 0, 5}));
+    EXPECT_EQ(index.range(31, 49), std::vector<size_t>());
+    EXPECT_EQ(index.range(30, 10), std::vector<size_t>()); // Empty interval
+    EXPECT_EQ(index.equal(int64_t{30}), (std::vector<size_t>{2, 3}));
+
+    index.remove(int64_t{30}, 2);
+    index.remove(int64_t{30}, 0); // Slot 0 holds 50: no effect
+    EXPECT_EQ(index.range(0, 100), (std::vector<size_t>{1, 3, 0}));
+    EXPECT_EQ(index.size(), 5u);
+}
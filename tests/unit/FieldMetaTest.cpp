@@ -132,6 +132,22 @@ TEST(FieldMetaNumericTest, GetMinInt64) {
     EXPECT_STREQ(buf, "-9223372036854775808");
 }
 
+// 시나리오 상세 설명: FieldMetaNumericTest 그룹의 GetWritesExactlyFieldLength 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FieldMetaNumericTest, GetWritesExactlyFieldLength) {
+    int64_t val = 7;
+    auto field = makeNumField("val", val);
+
+    // Fields are written in place, so the byte after the field must survive
+    char buf[21];
+    std::memset(buf, '}', sizeof(buf));
+    field.get(buf);
+
+    EXPECT_EQ(std::string(buf, 20), "+0000000000000000007");
+    EXPECT_EQ(buf[20], '}');
+}
+
 // 시나리오 상세 설명: FieldMetaNumericTest 그룹의 SetPositiveNumber 케이스 동작을 검증한다.
 // - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
 // - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
@@ -15,6 +15,7 @@
 
 #include <fcntl.h>
 #include <gtest/gtest.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #include <fdfile/util/FileLockGuard.hpp>
@@ -154,3 +155,39 @@ TEST_F(FileLockGuardTest, UnlockIgnore) {
     lock.unlockIgnore();
     EXPECT_FALSE(lock.locked());
 }
+
+// 시나리오 상세 설명: FileLockGuardTest 그룹의 ConvertUpgradesInPlace 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(FileLockGuardTest, ConvertUpgradesInPlace) {
+    // Lock type another process would be blocked by (F_UNLCK if none)
+    auto heldType = [this](short probe) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            struct flock fl{};
+            fl.l_type = probe;
+            fl.l_whence = SEEK_SET;
+            ::fcntl(fd_, F_GETLK, &fl);
+            ::_exit(fl.l_type == F_RDLCK ? 1 : fl.l_type == F_WRLCK ? 2 : 0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    };
+
+    std::error_code ec;
+    FileLockGuard lock(fd_, FileLockGuard::Mode::Shared, ec);
+    ASSERT_TRUE(lock.locked());
+    EXPECT_EQ(heldType(F_WRLCK), 1);
+
+    ASSERT_TRUE(lock.convert(FileLockGuard::Mode::Exclusive, ec)) << ec.message();
+    EXPECT_TRUE(lock.locked());
+    EXPECT_EQ(heldType(F_RDLCK), 2);
+
+    ASSERT_TRUE(lock.convert(FileLockGuard::Mode::Shared, ec));
+    EXPECT_EQ(heldType(F_WRLCK), 1);
+
+    lock.unlockIgnore();
+    EXPECT_FALSE(lock.convert(FileLockGuard::Mode::Exclusive, ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+}
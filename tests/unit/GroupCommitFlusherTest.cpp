@@ -0,0 +1,99 @@
+/**
+ * @file tests/unit/GroupCommitFlusherTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file GroupCommitFlusherTest.cpp
+ * @brief Unit tests for the group-commit background flusher
+ */
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fdfile/util/GroupCommitFlusher.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace FdFile::detail;
+
+class GroupCommitFlusherTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_group_commit.tmp";
+        ::remove(testFile_.c_str());
+        fd_ = ::open(testFile_.c_str(), O_CREAT | O_RDWR, 0644);
+        ASSERT_GE(fd_, 0);
+    }
+
+    void TearDown() override {
+        ::close(fd_);
+        ::remove(testFile_.c_str());
+    }
+
+    std::string testFile_;
+    int fd_ = -1;
+};
+
+// 시나리오 상세 설명: GroupCommitFlusherTest 그룹의 TicketsIncreaseAndBecomeDurable 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(GroupCommitFlusherTest, TicketsIncreaseAndBecomeDurable) {
+    GroupCommitFlusher flusher(fd_, std::chrono::milliseconds(2), 16);
+    EXPECT_EQ(flusher.lastTicket(), 0u);
+
+    uint64_t t1 = flusher.noteWrite();
+    uint64_t t2 = flusher.noteWrite();
+    EXPECT_EQ(t1, 1u);
+    EXPECT_EQ(t2, 2u);
+    EXPECT_EQ(flusher.lastTicket(), 2u);
+
+    std::error_code ec;
+    EXPECT_TRUE(flusher.waitDurable(t2, ec));
+    EXPECT_FALSE(ec);
+    // Already durable tickets return immediately
+    EXPECT_TRUE(flusher.waitDurable(t1, ec));
+}
+
+// 시나리오 상세 설명: GroupCommitFlusherTest 그룹의 ConcurrentWritersShareFlushes 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(GroupCommitFlusherTest, ConcurrentWritersShareFlushes) {
+    GroupCommitFlusher flusher(fd_, std::chrono::milliseconds(5), 8);
+
+    std::vector<std::thread> writers;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 25; ++i) {
+                std::error_code ec;
+                if (!flusher.waitDurable(flusher.noteWrite(), ec))
+                    ++failures;
+            }
+        });
+    }
+    for (auto& w : writers)
+        w.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(flusher.lastTicket(), 100u);
+}
+
+// 시나리오 상세 설명: GroupCommitFlusherTest 그룹의 FlushFailureReportsError 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(GroupCommitFlusherTest, FlushFailureReportsError) {
+    GroupCommitFlusher flusher(-1, std::chrono::milliseconds(1), 1);
+
+    std::error_code ec;
+    EXPECT_FALSE(flusher.waitDurable(flusher.noteWrite(), ec));
+    EXPECT_EQ(ec, std::errc::bad_file_descriptor);
+}
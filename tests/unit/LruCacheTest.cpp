@@ -0,0 +1,65 @@
+/**
+ * @file tests/unit/LruCacheTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file LruCacheTest.cpp
+ * @brief Unit tests for the byte-budgeted LRU cache
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/LruCache.hpp>
+
+#include <string>
+
+using namespace FdFile::detail;
+
+// 시나리오 상세 설명: LruCacheTest 그룹의 EvictsLeastRecentlyUsedWithinBudget 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(LruCacheTest, EvictsLeastRecentlyUsedWithinBudget) {
+    LruCache<int, std::string> cache(100);
+    cache.put(1, "one", 40);
+    cache.put(2, "two", 40);
+    ASSERT_NE(cache.get(1), nullptr); // 1 becomes most recent
+    cache.put(3, "three", 40);        // Evicts 2
+
+    EXPECT_EQ(cache.get(2), nullptr);
+    ASSERT_NE(cache.get(1), nullptr);
+    EXPECT_EQ(*cache.get(3), "three");
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.usedBytes(), 80u);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+    EXPECT_EQ(cache.stats().hits, 3u);
+}
+
+// 시나리오 상세 설명: LruCacheTest 그룹의 ReplaceEraseAndOversizedEntries 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(LruCacheTest, ReplaceEraseAndOversizedEntries) {
+    LruCache<int, std::string> cache(100);
+    cache.put(1, "a", 30);
+    cache.put(1, "b", 50); // Replaces, cost updated
+    EXPECT_EQ(*cache.get(1), "b");
+    EXPECT_EQ(cache.usedBytes(), 50u);
+
+    cache.put(2, "huge", 101); // Larger than the budget: not stored, nothing evicted
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.erase(1);
+    EXPECT_EQ(cache.usedBytes(), 0u);
+    EXPECT_EQ(cache.stats().evictions, 0u);
+
+    LruCache<int, std::string> disabled(0);
+    disabled.put(1, "x", 1);
+    EXPECT_EQ(disabled.get(1), nullptr);
+}
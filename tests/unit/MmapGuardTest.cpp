@@ -20,8 +20,32 @@
 
 #include <fdfile/util/MmapGuard.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+
 using namespace FdFile::detail;
 
+namespace {
+
+/// @brief VmFlags line of the mapping that starts at addr ("" if not found or not Linux)
+std::string vmFlags(const void* addr) {
+    char start[32];
+    std::snprintf(start, sizeof(start), "%lx-", reinterpret_cast<unsigned long>(addr));
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inMapping = false;
+    while (std::getline(smaps, line)) {
+        if (line.rfind(start, 0) == 0)
+            inMapping = true;
+        else if (inMapping && line.rfind("VmFlags:", 0) == 0)
+            return line;
+    }
+    return "";
+}
+
+} // namespace
+
 class MmapGuardTest : public ::testing::Test {
   protected:
     void SetUp() override {
@@ -176,3 +200,138 @@ TEST_F(MmapGuardTest, SyncInvalidMapping) {
     MmapGuard mmap;
     EXPECT_FALSE(mmap.sync());
 }
+
+// 시나리오 상세 설명: MmapGuardTest 그룹의 SyncRange 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(MmapGuardTest, SyncRange) {
+    int fd = ::open(testFile_.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+
+    struct stat st;
+    ::fstat(fd, &st);
+
+    void* ptr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    MmapGuard mmap(ptr, st.st_size);
+    mmap.data()[5] = 'Y';
+
+    // Unaligned offsets are rounded down to the page boundary
+    EXPECT_TRUE(mmap.syncRange(5, 1));
+    EXPECT_TRUE(mmap.syncRange(3, 1000, true)); // Length clamped to mapping size
+    EXPECT_FALSE(mmap.syncRange(mmap.size(), 1)); // Offset out of range
+
+    ::close(fd);
+}
+
+// 시나리오 상세 설명: MmapGuardTest 그룹의 ReleaseKeepsMapping 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(MmapGuardTest, ReleaseKeepsMapping) {
+    int fd = ::open(testFile_.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+
+    struct stat st;
+    ::fstat(fd, &st);
+
+    void* ptr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* released = nullptr;
+    {
+        MmapGuard mmap(ptr, st.st_size);
+        released = mmap.release();
+        EXPECT_FALSE(mmap.valid());
+        EXPECT_EQ(mmap.size(), 0);
+    }
+
+    // Mapping survives the guard and is still readable
+    EXPECT_EQ(released, ptr);
+    EXPECT_EQ(static_cast<char*>(released)[0], 'H');
+    ::munmap(released, st.st_size);
+    ::close(fd);
+}
+
+// 시나리오 상세 설명: MmapGuardTest 그룹의 MapSharedPopulate 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(MmapGuardTest, MapSharedPopulate) {
+    int fd = ::open(testFile_.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+
+    struct stat st;
+    ::fstat(fd, &st);
+
+    for (bool populate : {false, true}) {
+        MmapGuard mmap(MmapGuard::mapShared(fd, st.st_size, populate), st.st_size);
+        ASSERT_TRUE(mmap.valid());
+        EXPECT_EQ(mmap.data()[0], 'H');
+    }
+    EXPECT_EQ(MmapGuard::mapShared(-1, 16), MAP_FAILED);
+
+    ::close(fd);
+}
+
+// 시나리오 상세 설명: MmapGuardTest 그룹의 AdviseRanges 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(MmapGuardTest, AdviseRanges) {
+    int fd = ::open(testFile_.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+
+    struct stat st;
+    ::fstat(fd, &st);
+
+    MmapGuard mmap(MmapGuard::mapShared(fd, st.st_size), st.st_size);
+    EXPECT_TRUE(mmap.advise(MmapGuard::Advice::Random));
+    const std::string randomFlags = vmFlags(mmap.get());
+    if (!randomFlags.empty()) { // The kernel records the advice on the mapping
+        EXPECT_NE(randomFlags.find(" rr"), std::string::npos) << randomFlags;
+    }
+    EXPECT_TRUE(mmap.advise(MmapGuard::Advice::Sequential, 5, 3)); // Rounded to the page
+    const std::string seqFlags = vmFlags(mmap.get());
+    if (!seqFlags.empty()) {
+        EXPECT_NE(seqFlags.find(" sr"), std::string::npos) << seqFlags;
+    }
+    EXPECT_TRUE(mmap.advise(MmapGuard::Advice::WillNeed));
+    EXPECT_TRUE(mmap.advise(MmapGuard::Advice::Normal));
+    (void)mmap.advise(MmapGuard::Advice::HugePages); // Depends on the kernel configuration
+    EXPECT_FALSE(mmap.advise(MmapGuard::Advice::Normal, mmap.size())); // Offset out of range
+    EXPECT_EQ(mmap.data()[0], 'H'); // Hints never change the contents
+
+    MmapGuard empty;
+    EXPECT_FALSE(empty.advise(MmapGuard::Advice::Random));
+
+    ::close(fd);
+}
+
+// 시나리오 상세 설명: MmapGuardTest 그룹의 LockFollowsOwnership 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(MmapGuardTest, LockFollowsOwnership) {
+    int fd = ::open(testFile_.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+
+    struct stat st;
+    ::fstat(fd, &st);
+
+    MmapGuard empty;
+    EXPECT_FALSE(empty.lock());
+
+    MmapGuard mmap(MmapGuard::mapShared(fd, st.st_size), st.st_size);
+    EXPECT_FALSE(mmap.locked());
+    if (!mmap.lock()) {
+        ::close(fd);
+        GTEST_SKIP() << "mlock not permitted (RLIMIT_MEMLOCK)";
+    }
+    EXPECT_TRUE(mmap.locked());
+
+    MmapGuard moved(std::move(mmap));
+    EXPECT_TRUE(moved.locked());
+    EXPECT_FALSE(mmap.locked());
+    moved.unlock();
+    EXPECT_FALSE(moved.locked());
+
+    EXPECT_TRUE(moved.lock());
+    moved.reset();
+    EXPECT_FALSE(moved.locked());
+
+    ::close(fd);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file tests/unit/NumericCodecTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file NumericCodecTest.cpp
+ * @brief Unit tests for the fixed-width int64 encoder/decoder
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include <fdfile/util/NumericCodec.hpp>
+
+using namespace FdFile::detail;
+
+namespace {
+std::string encode(int64_t v) {
+    char buf[FIXED_INT64_LEN];
+    encodeFixedInt64(v, buf);
+    return std::string(buf, sizeof(buf));
+}
+} // namespace
+
+// 시나리오 상세 설명: NumericCodecTest 그룹의 EncodeMatchesLegacyFormat 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(NumericCodecTest, EncodeMatchesLegacyFormat) {
+    EXPECT_EQ(encode(0), "+0000000000000000000");
+    EXPECT_EQ(encode(25), "+0000000000000000025");
+    EXPECT_EQ(encode(-12345), "-0000000000000012345");
+    EXPECT_EQ(encode(INT64_MAX), "+9223372036854775807");
+    EXPECT_EQ(encode(INT64_MIN), "-9223372036854775808");
+
+    // Compare against the snprintf-based format for random values
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 1000; ++i) {
+        int64_t v = static_cast<int64_t>(rng());
+        uint64_t absVal = v >= 0 ? static_cast<uint64_t>(v) : 0 - static_cast<uint64_t>(v);
+        char ref[FIXED_INT64_LEN + 1];
+        std::snprintf(ref, sizeof(ref), "%c%019llu", v >= 0 ? '+' : '-',
+                      static_cast<unsigned long long>(absVal));
+        ASSERT_EQ(encode(v), std::string(ref)) << v;
+    }
+}
+
+// 시나리오 상세 설명: NumericCodecTest 그룹의 DecodeRoundTrip 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(NumericCodecTest, DecodeRoundTrip) {
+    std::mt19937_64 rng(7);
+    std::error_code ec;
+    for (int64_t v : {int64_t{0}, int64_t{1}, int64_t{-1}, INT64_MAX, INT64_MIN}) {
+        int64_t out = 42;
+        ASSERT_TRUE(decodeFixedInt64(encode(v).data(), FIXED_INT64_LEN, out, ec)) << v;
+        EXPECT_EQ(out, v);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        int64_t v = static_cast<int64_t>(rng());
+        int64_t out = 0;
+        ASSERT_TRUE(decodeFixedInt64(encode(v).data(), FIXED_INT64_LEN, out, ec)) << v;
+        ASSERT_EQ(out, v);
+    }
+}
+
+// 시나리오 상세 설명: NumericCodecTest 그룹의 DecodeShortAndPaddedInput 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(NumericCodecTest, DecodeShortAndPaddedInput) {
+    std::error_code ec;
+    int64_t out = 0;
+    const char padded[FIXED_INT64_LEN] = {'-', '4', '2'}; // NUL padding
+    ASSERT_TRUE(decodeFixedInt64(padded, FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(out, -42);
+
+    ASSERT_TRUE(decodeFixedInt64("+7", 2, out, ec));
+    EXPECT_EQ(out, 7);
+}
+
+// 시나리오 상세 설명: NumericCodecTest 그룹의 DecodeRejectsMalformedInput 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(NumericCodecTest, DecodeRejectsMalformedInput) {
+    std::error_code ec;
+    int64_t out = 99;
+
+    EXPECT_FALSE(decodeFixedInt64("X0000000000000000025", FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    EXPECT_FALSE(decodeFixedInt64("+00000000000000000a5", FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    EXPECT_FALSE(decodeFixedInt64("+000000000*000000025", FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    const char signOnly[FIXED_INT64_LEN] = {'+'};
+    EXPECT_FALSE(decodeFixedInt64(signOnly, FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+
+    EXPECT_FALSE(decodeFixedInt64("+9223372036854775808", FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::result_out_of_range);
+    EXPECT_FALSE(decodeFixedInt64("-9999999999999999999", FIXED_INT64_LEN, out, ec));
+    EXPECT_EQ(ec, std::errc::result_out_of_range);
+
+    EXPECT_EQ(out, 99); // Untouched on failure
+}
@@ -0,0 +1,103 @@
+/**
+ * @file tests/unit/ParallelScanTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file ParallelScanTest.cpp
+ * @brief Unit tests for the parallel scan helpers
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/ParallelScan.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FdFile::detail;
+
+// 시나리오 상세 설명: ParallelScanTest 그룹의 ChunkCountHonorsThreadsAndMinimum 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParallelScanTest, ChunkCountHonorsThreadsAndMinimum) {
+    EXPECT_EQ(scanChunkCount(1000, 1, 1), 1u);
+    EXPECT_EQ(scanChunkCount(1000, 4, 1), 4u);
+    EXPECT_EQ(scanChunkCount(1000, 4, 400), 2u); // Only two ranges of 400 fit
+    EXPECT_EQ(scanChunkCount(10, 4, 400), 1u);
+    EXPECT_EQ(scanChunkCount(0, 4, 1), 1u);
+    EXPECT_GE(scanChunkCount(1 << 20, 0, 1), 1u); // One per core
+
+    // Even split covers [0, n) without gaps
+    for (size_t n : {0u, 1u, 7u, 1000u}) {
+        for (size_t chunks = 1; chunks <= 5; ++chunks) {
+            EXPECT_EQ(chunkBegin(n, chunks, 0), 0u);
+            EXPECT_EQ(chunkBegin(n, chunks, chunks), n);
+            for (size_t c = 0; c < chunks; ++c)
+                EXPECT_LE(chunkBegin(n, chunks, c), chunkBegin(n, chunks, c + 1));
+        }
+    }
+}
+
+// 시나리오 상세 설명: ParallelScanTest 그룹의 SplitsTextAfterNewlines 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParallelScanTest, SplitsTextAfterNewlines) {
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+        text += "line " + std::to_string(i) + "\n";
+    const auto bounds = splitAtNewlines(text.data(), text.size(), 4);
+    ASSERT_EQ(bounds.size(), 5u);
+    EXPECT_EQ(bounds.front(), 0u);
+    EXPECT_EQ(bounds.back(), text.size());
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        EXPECT_LT(bounds[i - 1], bounds[i]);
+        EXPECT_EQ(text[bounds[i] - 1], '\n') << bounds[i];
+    }
+
+    // A line longer than a range merges the ranges it spans
+    const std::string longLine = std::string(1000, 'x') + "\nshort\n";
+    const auto merged = splitAtNewlines(longLine.data(), longLine.size(), 4);
+    ASSERT_EQ(merged.size(), 3u);
+    EXPECT_EQ(merged[1], 1001u);
+    EXPECT_EQ(merged[2], longLine.size());
+}
+
+// 시나리오 상세 설명: ParallelScanTest 그룹의 RunsEveryTaskOnceAndRethrows 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParallelScanTest, RunsEveryTaskOnceAndRethrows) {
+    std::vector<std::atomic<int>> runs(8);
+    const auto caller = std::this_thread::get_id();
+    std::atomic<bool> firstOnCaller{false};
+    runParallel(runs.size(), [&](size_t t) {
+        runs[t].fetch_add(1);
+        if (t == 0)
+            firstOnCaller = std::this_thread::get_id() == caller;
+    });
+    for (auto& r : runs)
+        EXPECT_EQ(r.load(), 1);
+    EXPECT_TRUE(firstOnCaller.load());
+
+    // Every task still runs; the lowest task's exception is the one rethrown
+    std::atomic<int> finished{0};
+    try {
+        runParallel(4, [&](size_t t) {
+            finished.fetch_add(1);
+            if (t >= 2)
+                throw std::runtime_error("task " + std::to_string(t));
+        });
+        FAIL() << "Exception should be rethrown";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "task 2");
+    }
+    EXPECT_EQ(finished.load(), 4);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file tests/unit/RepositoryStatsTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file RepositoryStatsTest.cpp
+ * @brief Unit tests for the latency histograms and the stats recorder
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/repository/RepositoryStats.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace FdFile;
+using namespace FdFile::detail;
+
+// 시나리오 상세 설명: LatencyHistogramTest 그룹의 BucketsCoverValues 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(LatencyHistogramTest, BucketsCoverValues) {
+    size_t prev = 0;
+    for (uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456789ull,
+                       (1ull << 40), (1ull << 41) - 1}) {
+        const size_t b = LatencyHistogram::bucketOf(v);
+        ASSERT_LT(b, LatencyHistogram::BUCKETS);
+        EXPECT_GE(b, prev) << v;
+        prev = b;
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(b), v) << v;
+        if (b > 0 && b < LatencyHistogram::BUCKETS - 1) {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(b - 1), v) << v;
+        }
+    }
+    // Relative width stays within one sub-bucket (12.5%)
+    const size_t b = LatencyHistogram::bucketOf(1000000);
+    const double width = static_cast<double>(LatencyHistogram::bucketUpperBound(b) -
+                                             LatencyHistogram::bucketUpperBound(b - 1));
+    EXPECT_LE(width / 1000000.0, 0.125);
+    EXPECT_EQ(LatencyHistogram::bucketOf(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+}
+
+// 시나리오 상세 설명: StatsRecorderTest 그룹의 SnapshotPercentilesAndReset 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(StatsRecorderTest, SnapshotPercentilesAndReset) {
+    StatsRecorder rec;
+    std::vector<std::pair<StatOp, uint64_t>> seen;
+    rec.setHook([&seen](StatOp op, uint64_t ns) { seen.emplace_back(op, ns); });
+    for (uint64_t v = 1; v <= 100; ++v)
+        rec.record(StatOp::Save, v * 1000);
+    rec.count(StatCounter::CacheHits);
+    rec.count(StatCounter::CacheHits);
+    rec.count(StatCounter::CacheHits);
+    rec.count(StatCounter::Reloads);
+
+    RepositoryStats s = rec.snapshot();
+    EXPECT_TRUE(s.enabled);
+    const LatencyHistogram& save = s.op(StatOp::Save);
+    EXPECT_EQ(save.count, 100u);
+    EXPECT_EQ(save.maxNs, 100000u);
+    EXPECT_DOUBLE_EQ(save.meanNs(), 50500.0);
+    // Percentiles are bucket upper bounds: within 12.5% above the exact value
+    EXPECT_GE(save.percentileNs(0.5), 50000u);
+    EXPECT_LE(save.percentileNs(0.5), 50000u * 9 / 8);
+    EXPECT_GE(save.percentileNs(0.99), 99000u);
+    EXPECT_EQ(save.percentileNs(1.0), 100000u);
+    EXPECT_EQ(s.op(StatOp::Delete).count, 0u);
+    EXPECT_EQ(s.op(StatOp::Delete).percentileNs(0.5), 0u);
+    EXPECT_EQ(s.counter(StatCounter::CacheHits), 3u);
+    EXPECT_DOUBLE_EQ(s.cacheHitRate(), 0.75);
+    ASSERT_EQ(seen.size(), 100u);
+    EXPECT_EQ(seen.back().second, 100000u);
+
+    rec.reset();
+    s = rec.snapshot();
+    EXPECT_EQ(s.op(StatOp::Save).count, 0u);
+    EXPECT_EQ(s.counter(StatCounter::Reloads), 0u);
+    EXPECT_STREQ(statOpName(StatOp::LockWait), "lock_wait");
+    EXPECT_STREQ(statCounterName(StatCounter::TailLoads), "tail_loads");
+}
+
+// 시나리오 상세 설명: StatsRecorderTest 그룹의 ConcurrentRecording 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(StatsRecorderTest, ConcurrentRecording) {
+    StatsRecorder rec;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&rec, t] {
+            for (int i = 0; i < 10000; ++i) {
+                rec.record(StatOp::FindById, static_cast<uint64_t>(t * 10000 + i));
+                rec.count(StatCounter::CacheHits);
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    StatsRecorder moved = std::move(rec);
+    RepositoryStats s = moved.snapshot();
+    EXPECT_EQ(s.op(StatOp::FindById).count, 40000u);
+    EXPECT_EQ(s.op(StatOp::FindById).maxNs, 39999u);
+    EXPECT_EQ(s.counter(StatCounter::CacheHits), 40000u);
+    uint64_t total = 0;
+    for (uint64_t b : s.op(StatOp::FindById).buckets)
+        total += b;
+    EXPECT_EQ(total, 40000u);
+}
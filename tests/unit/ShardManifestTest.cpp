@@ -0,0 +1,176 @@
+/**
+ * @file tests/unit/ShardManifestTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file ShardManifestTest.cpp
+ * @brief Unit tests for the shard layout manifest
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/ShardManifest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace FdFile::detail;
+
+class ShardManifestTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        path_ = "./test_shard_manifest.manifest";
+        cleanup();
+    }
+
+    void TearDown() override { cleanup(); }
+
+    void cleanup() {
+        ::remove(path_.c_str());
+        ::remove((path_ + ".tmp").c_str());
+    }
+
+    std::string path_;
+    std::error_code ec_;
+};
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 FormatParseRoundTrip 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, FormatParseRoundTrip) {
+    const ShardManifest::Layout layout{42, 8};
+    const std::string text = ShardManifest::format(layout);
+    EXPECT_EQ(text, "FDSHARD 1\ngeneration 42\nshards 8\n");
+
+    ShardManifest::Layout parsed;
+    ASSERT_TRUE(ShardManifest::parse(text, parsed));
+    EXPECT_EQ(parsed.generation, 42u);
+    EXPECT_EQ(parsed.shards, 8u);
+
+    // Later versions may add keys
+    ASSERT_TRUE(ShardManifest::parse("FDSHARD 1\nshards 3\nowner 7\ngeneration 1", parsed));
+    EXPECT_EQ(parsed.generation, 1u);
+    EXPECT_EQ(parsed.shards, 3u);
+}
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 ParseRejectsMalformedText 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, ParseRejectsMalformedText) {
+    ShardManifest::Layout parsed{5, 5};
+    EXPECT_FALSE(ShardManifest::parse("", parsed));
+    EXPECT_FALSE(ShardManifest::parse("FDSHARD 2\ngeneration 0\nshards 1\n", parsed));
+    EXPECT_FALSE(ShardManifest::parse("generation 0\nshards 1\n", parsed));
+    EXPECT_FALSE(ShardManifest::parse("FDSHARD 1\ngeneration 0\n", parsed));
+    EXPECT_FALSE(ShardManifest::parse("FDSHARD 1\ngeneration 0\nshards 0\n", parsed));
+    EXPECT_FALSE(ShardManifest::parse("FDSHARD 1\ngeneration x\nshards 1\n", parsed));
+    EXPECT_FALSE(ShardManifest::parse("FDSHARD 1\ngeneration\nshards 1\n", parsed));
+
+    // A failed parse leaves the output untouched
+    EXPECT_EQ(parsed.generation, 5u);
+    EXPECT_EQ(parsed.shards, 5u);
+}
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 OpenCreatesOnceAndKeepsLayout 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, OpenCreatesOnceAndKeepsLayout) {
+    {
+        ShardManifest m;
+        ASSERT_TRUE(m.open(path_, 4, ec_)) << ec_.message();
+        EXPECT_EQ(m.layout().generation, 0u);
+        EXPECT_EQ(m.layout().shards, 4u);
+    }
+
+    // The default only applies to a new manifest
+    ShardManifest m;
+    ASSERT_TRUE(m.open(path_, 9, ec_)) << ec_.message();
+    EXPECT_EQ(m.layout().shards, 4u);
+
+    ShardManifest zero;
+    EXPECT_FALSE(zero.open(path_, 0, ec_));
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+}
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 MalformedFileFailsOpen 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, MalformedFileFailsOpen) {
+    {
+        std::ofstream out(path_);
+        out << "not a manifest\n";
+    }
+    ShardManifest m;
+    EXPECT_FALSE(m.open(path_, 4, ec_));
+    EXPECT_EQ(ec_, std::errc::invalid_argument);
+}
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 LockFollowsReplacement 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, LockFollowsReplacement) {
+    ShardManifest writer, reader;
+    ASSERT_TRUE(writer.open(path_, 2, ec_)) << ec_.message();
+    ASSERT_TRUE(reader.open(path_, 2, ec_)) << ec_.message();
+
+    {
+        ShardManifest::Guard guard;
+        ASSERT_TRUE(writer.lock(guard, FileLockGuard::Mode::Exclusive, ec_)) << ec_.message();
+        ASSERT_TRUE(writer.replace(ShardManifest::Layout{1, 6}, ec_)) << ec_.message();
+        EXPECT_EQ(writer.layout().shards, 6u);
+    }
+
+    // The reader still holds the replaced file open; locking re-opens the path
+    EXPECT_EQ(reader.layout().shards, 2u);
+    ShardManifest::Guard guard;
+    ASSERT_TRUE(reader.lock(guard, FileLockGuard::Mode::Shared, ec_)) << ec_.message();
+    EXPECT_EQ(reader.layout().generation, 1u);
+    EXPECT_EQ(reader.layout().shards, 6u);
+
+    ShardManifest::Layout onDisk;
+    std::ifstream in(path_);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_TRUE(ShardManifest::parse(text, onDisk));
+    EXPECT_EQ(onDisk.shards, 6u);
+    EXPECT_FALSE(std::ifstream(path_ + ".tmp").good());
+}
+
+// 시나리오 상세 설명: ShardManifestTest 그룹의 InstancesOfOneProcessExcludeEachOther 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ShardManifestTest, InstancesOfOneProcessExcludeEachOther) {
+    ShardManifest resharder, reader;
+    ASSERT_TRUE(resharder.open(path_, 2, ec_)) << ec_.message();
+    ASSERT_TRUE(reader.open(path_, 2, ec_)) << ec_.message();
+
+    // A shared lock by another instance of this process waits for the exclusive one
+    auto exclusive = std::make_unique<ShardManifest::Guard>();
+    ASSERT_TRUE(resharder.lock(*exclusive, FileLockGuard::Mode::Exclusive, ec_));
+    std::atomic<bool> entered{false};
+    std::thread t([&] {
+        std::error_code tec;
+        ShardManifest::Guard shared;
+        if (reader.lock(shared, FileLockGuard::Mode::Shared, tec))
+            entered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(entered.load());
+
+    ASSERT_TRUE(resharder.replace(ShardManifest::Layout{1, 3}, ec_)) << ec_.message();
+    exclusive.reset();
+    t.join();
+    EXPECT_TRUE(entered.load());
+    EXPECT_EQ(reader.layout().shards, 3u);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file tests/unit/SimdScanTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file SimdScanTest.cpp
+ * @brief Unit tests for the vectorized special-character scan kernels
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/SimdScan.hpp>
+#include <fdfile/util/textFormatUtil.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace FdFile;
+
+namespace {
+
+/// Every kernel compiled for this target, including the one not picked at runtime
+template <detail::ScanSet S> std::vector<detail::ScanKernel> compiledKernels() {
+    std::vector<detail::ScanKernel> kernels{&detail::findScanChar<S>};
+#if defined(FDFILE_SIMD_X86)
+    kernels.push_back(&detail::findScanCharSse2<S>);
+    if (__builtin_cpu_supports("avx2"))
+        kernels.push_back(&detail::findScanCharAvx2<S>);
+#elif defined(FDFILE_SIMD_NEON)
+    kernels.push_back(&detail::findScanCharNeon<S>);
+#endif
+    return kernels;
+}
+
+template <detail::ScanSet S> void expectKernelsMatchScalar(const std::string& buf) {
+    const char* base = buf.data();
+    for (auto kernel : compiledKernels<S>()) {
+        for (size_t from = 0; from < 40 && from <= buf.size(); ++from) {
+            const char* expected = detail::findScanCharScalar<S>(base + from, base + buf.size());
+            EXPECT_EQ(kernel(base + from, base + buf.size()), expected) << "from " << from;
+        }
+    }
+}
+
+} // namespace
+
+// 시나리오 상세 설명: SimdScanTest 그룹의 KernelsMatchScalarAtEveryPosition 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SimdScanTest, KernelsMatchScalarAtEveryPosition) {
+    // One special character at every position of a 100-byte buffer, on either side of the
+    // 16/32-byte block edges
+    for (char special : {'"', '\\', '\n', '\t'}) {
+        for (size_t pos = 0; pos < 100; ++pos) {
+            std::string buf(100, 'a');
+            buf[pos] = special;
+            expectKernelsMatchScalar<detail::ScanSet::QuoteOrBackslash>(buf);
+            expectKernelsMatchScalar<detail::ScanSet::NeedsEscape>(buf);
+        }
+    }
+    expectKernelsMatchScalar<detail::ScanSet::NeedsEscape>(std::string(70, 'z')); // Not found
+}
+
+// 시나리오 상세 설명: SimdScanTest 그룹의 RandomBuffersMatchScalar 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SimdScanTest, RandomBuffersMatchScalar) {
+    std::mt19937 rng(7);
+    const char alphabet[] = "abc \"\\\n\t\x80\xff";
+    for (int round = 0; round < 200; ++round) {
+        std::string buf(rng() % 300, 'x');
+        for (auto& c : buf)
+            c = (rng() % 40 == 0) ? alphabet[rng() % (sizeof(alphabet) - 1)] : 'x';
+        expectKernelsMatchScalar<detail::ScanSet::QuoteOrBackslash>(buf);
+        expectKernelsMatchScalar<detail::ScanSet::NeedsEscape>(buf);
+    }
+    EXPECT_NE(std::string(detail::activeScanKernelName()), "");
+}
+
+// 시나리오 상세 설명: SimdScanTest 그룹의 LongFieldsRoundTrip 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SimdScanTest, LongFieldsRoundTrip) {
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        text += "word";
+        if (i % 37 == 0)
+            text += "\"quoted\"";
+        if (i % 101 == 0)
+            text += "\\path\n\tnext";
+    }
+
+    const std::string escaped = util::escapeString(text);
+    std::vector<std::pair<std::string, std::pair<bool, std::string>>> fields = {
+        {"desc", {true, text}}, {"n", {false, "1"}}};
+    std::string line = util::formatLine("Doc", fields);
+    line.pop_back(); // newline
+    EXPECT_NE(line.find(escaped), std::string::npos);
+
+    std::string_view type;
+    util::KvViews kv;
+    std::error_code ec;
+    ASSERT_TRUE(util::parseLineView(line, type, kv, ec)) << ec.message();
+    EXPECT_EQ(kv.find("desc")->value, text);
+
+    // Unterminated long string and trailing lone backslash
+    std::string_view dummy;
+    EXPECT_FALSE(util::parseLineView("Doc { \"desc\": \"" + std::string(100, 'y'), dummy, kv, ec));
+    EXPECT_FALSE(util::parseLineView("Doc { \"desc\": \"" + std::string(100, 'y') + "\\", dummy,
+                                     kv, ec));
+}
@@ -0,0 +1,130 @@
+/**
+ * @file tests/unit/SlotHashTableTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file SlotHashTableTest.cpp
+ * @brief Unit tests for the open-addressing ID hash → slot table
+ */
+
+#include <gtest/gtest.h>
+
+#include <fdfile/util/SlotHashTable.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace FdFile::detail;
+
+namespace {
+
+/// Table over a vector, keyed by strings stored in "slots" (like IDs in a record file)
+struct Fixture {
+    std::vector<std::string> slots;
+    std::vector<SlotBucket> storage;
+    SlotHashTable table;
+
+    explicit Fixture(size_t capacity) : storage(capacity, SlotBucket{0, 0}) {
+        table.attach(storage.data(), storage.size());
+    }
+
+    uint64_t h(const std::string& id) const { return hashId(id.data(), id.size()); }
+
+    void put(const std::string& id) {
+        slots.push_back(id);
+        table.insert(h(id), slots.size() - 1);
+    }
+
+    std::optional<size_t> find(const std::string& id) const {
+        return table.find(h(id), [&](size_t s) { return slots[s] == id; });
+    }
+
+    bool erase(const std::string& id) {
+        return table.erase(h(id), [&](size_t s) { return slots[s] == id; });
+    }
+};
+
+} // namespace
+
+// 시나리오 상세 설명: SlotHashTableTest 그룹의 InsertFindErase 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SlotHashTableTest, InsertFindErase) {
+    Fixture f(SlotHashTable::capacityFor(3));
+    f.put("a");
+    f.put("b");
+    f.put("c");
+
+    EXPECT_EQ(f.find("b"), std::optional<size_t>(1));
+    EXPECT_FALSE(f.find("zzz").has_value());
+
+    EXPECT_TRUE(f.erase("b"));
+    EXPECT_FALSE(f.find("b").has_value());
+    EXPECT_FALSE(f.erase("b"));
+    EXPECT_EQ(f.find("a"), std::optional<size_t>(0));
+    EXPECT_EQ(f.find("c"), std::optional<size_t>(2));
+}
+
+// 시나리오 상세 설명: SlotHashTableTest 그룹의 BackwardShiftKeepsProbeChains 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SlotHashTableTest, BackwardShiftKeepsProbeChains) {
+    // Small table at 75% load forces long, wrapping probe chains
+    Fixture f(64);
+    for (int i = 0; i < 48; ++i)
+        f.put("id" + std::to_string(i));
+
+    for (int i = 0; i < 48; i += 2)
+        ASSERT_TRUE(f.erase("id" + std::to_string(i)));
+
+    for (int i = 0; i < 48; ++i) {
+        auto slot = f.find("id" + std::to_string(i));
+        if (i % 2 == 0) {
+            EXPECT_FALSE(slot.has_value()) << i;
+        } else {
+            ASSERT_TRUE(slot.has_value()) << i;
+            EXPECT_EQ(*slot, static_cast<size_t>(i));
+        }
+    }
+}
+
+// 시나리오 상세 설명: SlotHashTableTest 그룹의 RemapAndUpdateSlots 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SlotHashTableTest, RemapAndUpdateSlots) {
+    Fixture f(16);
+    f.put("x");
+    f.put("y");
+
+    // Renumber like a compaction that removed slot 0
+    f.table.remapSlots([](size_t s) { return s == 0 ? 0 : s - 1; });
+    f.slots.erase(f.slots.begin());
+    EXPECT_EQ(f.find("y"), std::optional<size_t>(0));
+
+    f.slots.push_back("y");
+    EXPECT_TRUE(f.table.update(f.h("y"), 1, [&](size_t s) { return f.slots[s] == "y"; }));
+    EXPECT_EQ(f.find("y"), std::optional<size_t>(1));
+
+    size_t entries = 0;
+    f.table.forEach([&](uint64_t, size_t) { ++entries; });
+    EXPECT_EQ(entries, 2u);
+
+    f.table.clear();
+    EXPECT_FALSE(f.find("y").has_value());
+}
+
+// 시나리오 상세 설명: SlotHashTableTest 그룹의 CapacityForKeepsLoadUnderThreeQuarters 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(SlotHashTableTest, CapacityForKeepsLoadUnderThreeQuarters) {
+    EXPECT_EQ(SlotHashTable::capacityFor(0), 16u);
+    EXPECT_EQ(SlotHashTable::capacityFor(12), 16u);
+    EXPECT_EQ(SlotHashTable::capacityFor(13), 32u);
+    EXPECT_EQ(SlotHashTable::capacityFor(1000), 2048u);
+}
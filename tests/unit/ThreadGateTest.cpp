@@ -0,0 +1,116 @@
+/**
+ * @file tests/unit/ThreadGateTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file ThreadGateTest.cpp
+ * @brief Unit tests for the in-process reader/writer gate
+ */
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fdfile/util/ThreadGate.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace FdFile::detail;
+
+class ThreadGateTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        testFile_ = "./test_threadgate.tmp";
+        ::remove(testFile_.c_str());
+        fd_ = ::open(testFile_.c_str(), O_CREAT | O_RDWR, 0644);
+        ASSERT_GE(fd_, 0);
+    }
+
+    void TearDown() override {
+        if (fd_ >= 0)
+            ::close(fd_);
+        ::remove(testFile_.c_str());
+    }
+
+    // Whether another process could take an exclusive lock right now
+    bool writableByOtherProcess() {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int fd = ::open(testFile_.c_str(), O_RDWR);
+            struct flock fl{};
+            fl.l_type = F_WRLCK;
+            fl.l_whence = SEEK_SET;
+            ::fcntl(fd, F_GETLK, &fl);
+            ::_exit(fl.l_type == F_UNLCK ? 0 : 1);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    std::string testFile_;
+    int fd_ = -1;
+};
+
+// 시나리오 상세 설명: ThreadGateTest 그룹의 LastReaderReleasesFileLock 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ThreadGateTest, LastReaderReleasesFileLock) {
+    ThreadGate gate;
+    std::error_code ec;
+    SharedGateLock first, second;
+    ASSERT_TRUE(first.lock(gate, fd_, ec));
+    ASSERT_TRUE(second.lock(gate, fd_, ec));
+    EXPECT_FALSE(writableByOtherProcess());
+
+    // A plain fcntl unlock here would drop the lock for both readers
+    first.unlock();
+    EXPECT_FALSE(first.locked());
+    EXPECT_FALSE(writableByOtherProcess());
+
+    SharedGateLock moved(std::move(second));
+    EXPECT_TRUE(moved.locked());
+    moved.unlock();
+    EXPECT_TRUE(writableByOtherProcess());
+}
+
+// 시나리오 상세 설명: ThreadGateTest 그룹의 ExclusiveWaitsForReaders 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(ThreadGateTest, ExclusiveWaitsForReaders) {
+    ThreadGate gate;
+    std::error_code ec;
+    SharedGateLock reader;
+    ASSERT_TRUE(reader.lock(gate, fd_, ec));
+
+    std::atomic<bool> entered{false};
+    std::thread writer([&] {
+        auto exclusive = gate.lockExclusive();
+        entered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(entered.load());
+
+    reader.unlock();
+    writer.join();
+    EXPECT_TRUE(entered.load());
+
+    // Readers run side by side
+    SharedGateLock a, b;
+    std::thread other([&] {
+        std::error_code otherEc;
+        EXPECT_TRUE(b.lock(gate, fd_, otherEc));
+    });
+    EXPECT_TRUE(a.lock(gate, fd_, ec));
+    other.join();
+    EXPECT_TRUE(a.locked() && b.locked());
+}
@@ -84,6 +84,21 @@ TEST(ParseLongStrictTest, MixedContent) {
     EXPECT_TRUE(ec);
 }
 
+// 시나리오 상세 설명: ParseLongStrictTest 그룹의 SignsAndOverflow 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParseLongStrictTest, SignsAndOverflow) {
+    long result = 0;
+    std::error_code ec;
+
+    EXPECT_TRUE(parseLongStrict(std::string_view("+42 tail", 3), result, ec));
+    EXPECT_EQ(result, 42);
+    EXPECT_FALSE(parseLongStrict("+-1", result, ec));
+    EXPECT_FALSE(parseLongStrict("", result, ec));
+    EXPECT_FALSE(parseLongStrict("99999999999999999999999", result, ec));
+    EXPECT_EQ(ec, std::make_error_code(std::errc::invalid_argument));
+}
+
 // =============================================================================
 // parseLine Tests
 // =============================================================================
@@ -165,6 +180,99 @@ TEST(ParseLineTest, InvalidMissingBrace) {
     EXPECT_FALSE(parseLine(line, type, kv, ec));
 }
 
+// =============================================================================
+// parseLineView / KvViews Tests
+// =============================================================================
+
+// 시나리오 상세 설명: ParseLineViewTest 그룹의 ViewsPointIntoLine 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParseLineViewTest, ViewsPointIntoLine) {
+    const std::string line = R"(User { "name": "bob", "id": -7 })";
+    std::string_view type;
+    KvViews kv;
+    std::error_code ec;
+
+    ASSERT_TRUE(parseLineView(line, type, kv, ec));
+    EXPECT_EQ(type, "User");
+    ASSERT_EQ(kv.size(), 2u);
+    EXPECT_EQ(kv[0].key, "name");
+    EXPECT_TRUE(kv[0].isString);
+    EXPECT_EQ(kv[0].value, "bob");
+    EXPECT_FALSE(kv[1].isString);
+    EXPECT_EQ(kv.find("id")->value, "-7");
+    EXPECT_EQ(kv.find("missing"), nullptr);
+
+    // Without escapes nothing is copied
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    EXPECT_TRUE(kv[0].value.data() >= begin && kv[0].value.data() < end);
+    EXPECT_TRUE(type.data() == begin);
+}
+
+// 시나리오 상세 설명: ParseLineViewTest 그룹의 EscapesAreDecodedIntoOwnedStorage 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParseLineViewTest, EscapesAreDecodedIntoOwnedStorage) {
+    std::string line = "T { ";
+    for (int i = 0; i < 40; ++i) {
+        if (i)
+            line += ", ";
+        line += "\"k" + std::to_string(i) + "\": \"a\\\"b\\\\c\\n" + std::to_string(i) + "\"";
+    }
+    line += " }";
+
+    std::string_view type;
+    KvViews kv;
+    std::error_code ec;
+    ASSERT_TRUE(parseLineView(line, type, kv, ec)) << ec.message();
+    ASSERT_EQ(kv.size(), 40u);
+    // Earlier decoded values stay valid while later ones are added
+    for (int i = 0; i < 40; ++i)
+        EXPECT_EQ(kv[i].value, "a\"b\\c\n" + std::to_string(i));
+}
+
+// 시나리오 상세 설명: ParseLineViewTest 그룹의 ReuseAndErrors 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParseLineViewTest, ReuseAndErrors) {
+    std::string_view type;
+    KvViews kv;
+    std::error_code ec;
+
+    ASSERT_TRUE(parseLineView(R"(A { "x": 1, "y": "2" })", type, kv, ec));
+    EXPECT_EQ(kv.size(), 2u);
+    ASSERT_TRUE(parseLineView("B { }", type, kv, ec));
+    EXPECT_TRUE(kv.empty());
+
+    EXPECT_FALSE(parseLineView(R"(A { "x": 1, "x": 2 })", type, kv, ec));
+    EXPECT_EQ(ec, std::make_error_code(std::errc::invalid_argument));
+    EXPECT_FALSE(parseLineView(R"(A { "x": "bad\q" })", type, kv, ec));
+    EXPECT_FALSE(parseLineView(R"(A { "x": "open })", type, kv, ec));
+}
+
+// 시나리오 상세 설명: ParseLineViewTest 그룹의 FormatRoundTrip 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(ParseLineViewTest, FormatRoundTrip) {
+    KvViews out;
+    out.add("name", true, "tab\there \"q\"");
+    out.add("id", false, out.store(std::to_string(12)));
+
+    std::string buf;
+    appendFormattedLine(buf, "Rec", out);
+    std::vector<std::pair<std::string, std::pair<bool, std::string>>> legacy = {
+        {"name", {true, "tab\there \"q\""}}, {"id", {false, "12"}}};
+    EXPECT_EQ(buf, formatLine("Rec", legacy));
+
+    std::string_view type;
+    KvViews in;
+    std::error_code ec;
+    ASSERT_TRUE(parseLineView(std::string_view(buf.data(), buf.size() - 1), type, in, ec));
+    EXPECT_EQ(in.find("name")->value, "tab\there \"q\"");
+    EXPECT_EQ(in.find("id")->value, "12");
+}
+
 // =============================================================================
 // formatLine Tests
 // =============================================================================
@@ -210,6 +318,22 @@ TEST(FormatLineTest, SpecialCharacters) {
     EXPECT_NE(result.find("\\n"), std::string::npos);
 }
 
+// 시나리오 상세 설명: FormatLineTest 그룹의 AppendMatchesFormatLine 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST(FormatLineTest, AppendMatchesFormatLine) {
+    std::vector<std::pair<std::string, std::pair<bool, std::string>>> fields;
+    fields.push_back({"name", {true, "a \"quoted\"\tname"}});
+    fields.push_back({"id", {false, "7"}});
+
+    std::string buf = "prefix\n";
+    appendFormattedLine(buf, "TypeA", fields);
+    appendFormattedLine(buf, "TypeA", fields);
+
+    const std::string line = formatLine("TypeA", fields);
+    EXPECT_EQ(buf, "prefix\n" + line + line);
+}
+
 // =============================================================================
 // escapeString Tests
 // =============================================================================
@@ -0,0 +1,97 @@
+/**
+ * @file tests/unit/WriteBatchTest.cpp
+ * @brief 코드 이해를 위한 한국어 상세 주석 블록.
+ * @details
+ * - 이 파일은 라이브러리의 동작 계약(contract)을 검증하기 위한 테스트 시나리오를 정의합니다.
+ * - 테스트는 정상 경로뿐 아니라 경계값, 실패 경로, 파일 I/O 예외 상황을 분리해 원인 추적이 쉽도록 구성되어야 합니다.
+ * - 각 assertion은 '무엇이 실패했는지'가 즉시 드러나도록 작성하며, 상태 공유를 피하기 위해 테스트 간 파일/데이터 독립성을 유지해야 합니다.
+ * - 저장 포맷/락 정책/캐시 정책이 바뀌면 해당 변화가 기존 계약을 깨지 않는지 회귀 테스트를 반드시 확장해야 합니다.
+ * - 향후 테스트 추가 시에는 재현 가능한 입력, 명확한 기대 결과, 실패 시 진단 가능한 메시지를 함께 유지하는 것을 권장합니다.
+ */
+/**
+ * @file WriteBatchTest.cpp
+ * @brief Unit tests for the chunked writev output buffer
+ */
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fdfile/util/WriteBatch.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace FdFile::detail;
+
+class WriteBatchTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        path_ = "./test_write_batch.bin";
+        ::remove(path_.c_str());
+    }
+
+    void TearDown() override { ::remove(path_.c_str()); }
+
+    std::string readBack() const {
+        std::ifstream ifs(path_, std::ios::binary);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    }
+
+    std::string path_;
+};
+
+// 시나리오 상세 설명: WriteBatchTest 그룹의 WritesChunksInOrder 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(WriteBatchTest, WritesChunksInOrder) {
+    // Tiny chunks force more iovecs than one writev() call accepts
+    WriteBatch batch(16, 2);
+    std::string expected;
+    for (int i = 0; i < 5000; ++i) {
+        std::string line = "line " + std::to_string(i) + "\n";
+        batch.buffer() += line;
+        expected += line;
+    }
+    EXPECT_EQ(batch.size(), expected.size());
+
+    int fd = ::open(path_.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    ASSERT_GE(fd, 0);
+    std::error_code ec;
+    EXPECT_TRUE(batch.writeTo(fd, ec)) << ec.message();
+    ::close(fd);
+    EXPECT_EQ(readBack(), expected);
+}
+
+// 시나리오 상세 설명: WriteBatchTest 그룹의 ClearAllowsReuse 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(WriteBatchTest, ClearAllowsReuse) {
+    WriteBatch batch(8, 1);
+    for (int i = 0; i < 10; ++i)
+        batch.buffer() += "0123456789";
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+
+    batch.buffer() += "second";
+    int fd = ::open(path_.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    ASSERT_GE(fd, 0);
+    std::error_code ec;
+    EXPECT_TRUE(batch.writeTo(fd, ec));
+    ::close(fd);
+    EXPECT_EQ(readBack(), "second");
+}
+
+// 시나리오 상세 설명: WriteBatchTest 그룹의 WriteErrorIsReported 케이스 동작을 검증한다.
+// - 검증 포인트: 정상 경로, 경계값, 오류 경로에서 API 계약이 일관되게 유지되는지 확인한다.
+// - 실패 시 점검 순서: 입력 데이터 준비 -> repository/API 호출 결과 -> 최종 assertion 순으로 원인을 좁힌다.
+TEST_F(WriteBatchTest, WriteErrorIsReported) {
+    WriteBatch batch;
+    batch.buffer() += "data";
+    std::error_code ec;
+    EXPECT_FALSE(batch.writeTo(-1, ec));
+    EXPECT_EQ(ec, std::error_code(EBADF, std::generic_category()));
+}
@@ -0,0 +1,31 @@
+/// @file fdfile_convert.cpp
+/// @brief Command-line converter between the text and binary variable-record formats
+///
+/// Usage: fdfile_convert (--to-binary | --to-text) <src> <dst>
+
+#include <fdfile/repository/VariableFormatConverter.hpp>
+
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc != 4 || (std::strcmp(argv[1], "--to-binary") != 0 &&
+                      std::strcmp(argv[1], "--to-text") != 0)) {
+        std::cerr << "usage: " << argv[0] << " (--to-binary | --to-text) <src> <dst>\n";
+        return 2;
+    }
+    const auto to = std::strcmp(argv[1], "--to-binary") == 0 ? FdFile::VariableFormat::Binary
+                                                             : FdFile::VariableFormat::Text;
+
+    std::error_code ec;
+    FdFile::VariableConvertStats stats;
+    if (!FdFile::convertVariableFile(argv[2], argv[3], to, ec, &stats)) {
+        std::cerr << "fdfile_convert: " << ec.message() << "\n";
+        return 1;
+    }
+    std::cout << stats.entries << " entries converted";
+    if (stats.skipped > 0)
+        std::cout << ", " << stats.skipped << " unreadable entries skipped";
+    std::cout << "\n";
+    return 0;
+}